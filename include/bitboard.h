@@ -0,0 +1,155 @@
+/**
+ * @file bitboard.h
+ * @brief Packed one-bit-per-tile grid with word-parallel operations
+ * @author Veyrm Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include "point.h"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class Bitboard
+ * @brief 2D grid of bits, 64 tiles per word, rows padded to whole words
+ *
+ * Used for the Map's walkable/transparent/wall layers so neighbourhood
+ * tests, masks and connectivity run on 64 tiles at a time. Bulk kernels
+ * use AVX2 when the build enables it (ENABLE_AVX2) and fall back to
+ * scalar loops otherwise; results are identical either way.
+ *
+ * Padding bits past the right edge of each row are always zero.
+ *
+ * @see Map::getWalkableBits()
+ */
+class Bitboard {
+public:
+    Bitboard() = default;
+
+    /**
+     * @brief Construct an all-clear bitboard
+     * @param width Width in tiles
+     * @param height Height in tiles
+     */
+    Bitboard(int width, int height);
+
+    /**
+     * @brief Resize and clear
+     * @param width Width in tiles
+     * @param height Height in tiles
+     */
+    void resize(int width, int height);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    size_t getWordsPerRow() const { return words_per_row; }
+
+    /**
+     * @brief Test a bit
+     * @return false for out-of-bounds positions
+     */
+    bool test(int x, int y) const {
+        if (x < 0 || x >= width || y < 0 || y >= height) return false;
+        return (words[static_cast<size_t>(y) * words_per_row + (x >> 6)] >> (x & 63)) & 1;
+    }
+    bool test(const Point& p) const { return test(p.x, p.y); }
+
+    /**
+     * @brief Set or clear a bit
+     * @warning Does nothing if position is out of bounds
+     */
+    void set(int x, int y, bool value = true) {
+        if (x < 0 || x >= width || y < 0 || y >= height) return;
+        uint64_t& word = words[static_cast<size_t>(y) * words_per_row + (x >> 6)];
+        uint64_t bit = uint64_t{1} << (x & 63);
+        word = value ? (word | bit) : (word & ~bit);
+    }
+
+    /**
+     * @brief Set or clear every bit
+     * @param value Value for all in-bounds bits
+     */
+    void fill(bool value);
+
+    /// Number of set bits
+    size_t count() const;
+
+    /// Whether no bit is set
+    bool none() const;
+
+    /**
+     * @brief Find the first set bit in row-major order
+     * @return Position, or (-1, -1) if none
+     */
+    Point findFirst() const;
+
+    /// Raw words of a row (words_per_row entries)
+    const uint64_t* row(int y) const { return words.data() + static_cast<size_t>(y) * words_per_row; }
+    uint64_t* row(int y) { return words.data() + static_cast<size_t>(y) * words_per_row; }
+
+    // Word-parallel set operations (operands must have equal dimensions)
+    Bitboard& operator&=(const Bitboard& other);
+    Bitboard& operator|=(const Bitboard& other);
+    Bitboard& andNot(const Bitboard& other);
+    bool operator==(const Bitboard& other) const;
+
+    /**
+     * @brief Get the neighbour layer in one direction
+     * @param dx Horizontal offset (-1, 0 or 1)
+     * @param dy Vertical offset (-1, 0 or 1)
+     * @return Bitboard whose bit (x, y) is this bitboard's bit (x + dx, y + dy),
+     *         clear where that lies out of bounds
+     */
+    Bitboard neighbor(int dx, int dy) const;
+
+    /**
+     * @brief Find the 4-connected region of set bits containing a seed
+     * @param seed Start position
+     * @return Region bitboard; empty if the seed bit is clear
+     *
+     * Whole runs within a row are filled per word with a carry trick, and
+     * rows exchange seeds in alternating top-down/bottom-up sweeps until
+     * nothing changes.
+     */
+    Bitboard floodFill(const Point& seed) const;
+
+    /**
+     * @brief Call a function for every set bit in row-major order
+     * @param func Callable taking (int x, int y)
+     */
+    template<typename Func>
+    void forEach(Func&& func) const {
+        for (int y = 0; y < height; y++) {
+            const uint64_t* r = row(y);
+            for (size_t w = 0; w < words_per_row; w++) {
+                for (uint64_t bits = r[w]; bits; bits &= bits - 1) {
+                    func(static_cast<int>(w * 64) + std::countr_zero(bits), y);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Check whether the bulk kernels were built with AVX2
+     * @return true if AVX2 code paths are compiled in
+     */
+    static bool simdEnabled();
+
+private:
+    int width = 0;
+    int height = 0;
+    size_t words_per_row = 0;
+    std::vector<uint64_t> words;  ///< Row-major, words_per_row words per row
+
+    /// Mask of valid bits in the last word of each row
+    uint64_t lastWordMask() const {
+        int used = width & 63;
+        return used ? (uint64_t{1} << used) - 1 : ~uint64_t{0};
+    }
+
+    void clearPadding();
+};
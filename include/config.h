@@ -252,6 +252,27 @@ public:
     /** @brief Get target frames per second @return Target FPS */
     int getTargetFPS() const { return target_fps; }
 
+    /** @brief Get worker thread count @return Worker threads (0 = one per spare core) */
+    int getWorkerThreads() const { return worker_threads; }
+
+    /** @brief Check if independent ECS systems run in parallel @return Parallel systems state */
+    bool getParallelSystems() const { return parallel_systems; }
+
+    /** @brief Enable or disable parallel ECS system updates @param enabled New state */
+    void setParallelSystems(bool enabled) { parallel_systems = enabled; }
+
+    /** @brief Check if monster path searches run on worker threads @return Parallel pathfinding state */
+    bool getParallelPathfinding() const { return parallel_pathfinding; }
+
+    /** @brief Enable or disable batched monster path searches on worker threads @param enabled New state */
+    void setParallelPathfinding(bool enabled) { parallel_pathfinding = enabled; }
+
+    /** @brief Check if distant monsters are simulated coarsely @return AI level-of-detail state */
+    bool getAILevelOfDetail() const { return ai_level_of_detail; }
+
+    /** @brief Enable or disable AI level of detail @param enabled New state */
+    void setAILevelOfDetail(bool enabled) { ai_level_of_detail = enabled; }
+
     // === Development Settings ===
 
     /** @brief Check if verbose logging is enabled @return Verbose logging state */
@@ -305,6 +326,10 @@ private:
 
     // Performance
     int target_fps = 60;                ///< Target frames per second
+    int worker_threads = 0;             ///< Worker thread count (0 = auto)
+    bool parallel_systems = false;      ///< Run non-conflicting systems concurrently
+    bool parallel_pathfinding = false;  ///< Batch monster path searches onto worker threads
+    bool ai_level_of_detail = true;     ///< Update far-off monsters less often and more cheaply
 
     // Database settings
     bool database_enabled = false;      ///< Database features enabled
@@ -0,0 +1,115 @@
+/**
+ * @file dijkstra_map.h
+ * @brief Shared distance fields for goal seeking and fleeing
+ * @author Veyrm Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include "point.h"
+#include <cstdint>
+#include <vector>
+
+class Map;
+
+/**
+ * @class DijkstraMap
+ * @brief Distance-to-goal value for every walkable tile ("Dijkstra map")
+ *
+ * One field answers "which way to the nearest goal" for every entity on
+ * the map: nextStep() picks the lowest neighbour, so a pack chasing the
+ * player costs one field computation per turn instead of one search
+ * per monster. Any set of goals works (player, stairs, items).
+ *
+ * A flee field is an approach field scaled by a negative factor and
+ * re-relaxed, so following it downhill leads away from the threats but
+ * prefers escapes that open up over corners close to them.
+ *
+ * Values are in STEP_COST units per move. compute() and computeFlee()
+ * skip the work while the goals, options and the map's walkability
+ * version are unchanged.
+ *
+ * @code
+ * DijkstraMap chase;
+ * chase.compute(map, {player_pos});
+ * Point step = chase.nextStep(monster_pos);
+ * @endcode
+ *
+ * @see Pathfinding for single-route searches
+ */
+class DijkstraMap {
+public:
+    /// Value of tiles no goal can be reached from
+    static constexpr int32_t UNREACHABLE = INT32_MAX;
+    /// Value added per move
+    static constexpr int32_t STEP_COST = 10;
+    /// Default flee scale (percent of the approach distance, negated)
+    static constexpr int DEFAULT_FLEE_SCALE = 120;
+
+    /**
+     * @brief Build an approach field
+     * @param map Map to cover
+     * @param goals Tiles with value 0
+     * @param allow_diagonals Whether moves (and nextStep()) include diagonals
+     * @return true if the field was recomputed
+     */
+    bool compute(const Map& map, const std::vector<Point>& goals, bool allow_diagonals = false);
+
+    /**
+     * @brief Build a flee field
+     * @param map Map to cover
+     * @param threats Tiles to get away from
+     * @param scale_percent Approach distances are multiplied by -scale_percent/100
+     * @param allow_diagonals Whether moves (and nextStep()) include diagonals
+     * @return true if the field was recomputed
+     */
+    bool computeFlee(const Map& map, const std::vector<Point>& threats,
+                     int scale_percent = DEFAULT_FLEE_SCALE, bool allow_diagonals = false);
+
+    /**
+     * @brief Get a tile's value
+     * @return Value, or UNREACHABLE (also out of bounds)
+     */
+    int32_t getValue(int x, int y) const {
+        if (x < 0 || x >= width || y < 0 || y >= height) return UNREACHABLE;
+        return values[static_cast<size_t>(y) * width + x];
+    }
+    int32_t getValue(const Point& p) const { return getValue(p.x, p.y); }
+
+    /**
+     * @brief Pick the neighbouring tile with the lowest value
+     * @param from Current position
+     * @return Neighbour strictly lower than from, or from if none is
+     */
+    Point nextStep(const Point& from) const;
+
+    /// Drop the field so the next compute recomputes
+    void invalidate() { valid = false; }
+
+    bool isValid() const { return valid; }
+    bool isFlee() const { return flee; }
+    const std::vector<Point>& getGoals() const { return goals; }
+
+private:
+    int width = 0;
+    int height = 0;
+    const Map* map = nullptr;            ///< Map the field covers
+    uint32_t walkability_version = 0;    ///< Map version the field reflects
+    std::vector<Point> goals;            ///< Goals (or threats) used
+    bool flee = false;
+    int scale_percent = 0;
+    bool diagonals = false;
+    bool valid = false;
+
+    std::vector<int32_t> values;         ///< Row-major field values
+    std::vector<uint32_t> frontier;      ///< Scratch: BFS queue
+    std::vector<std::pair<int32_t, uint32_t>> heap;  ///< Scratch: relax heap
+
+    bool isCurrent(const Map& map, const std::vector<Point>& goals, bool flee,
+                   int scale_percent, bool allow_diagonals) const;
+    void remember(const Map& map, const std::vector<Point>& goals, bool flee,
+                  int scale_percent, bool allow_diagonals);
+    void scan(const Map& map, const std::vector<Point>& goals);
+    void relax(const Map& map);
+};
@@ -0,0 +1,109 @@
+/**
+ * @file ai_lod.h
+ * @brief Level-of-detail tiers for monster AI
+ * @author Veyrm Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include "entity_id.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace ecs {
+
+/**
+ * @enum AITier
+ * @brief How closely a monster is simulated this turn
+ *
+ * Tiers come from the walking distance to the player (so a monster
+ * behind a closed door or in an unconnected part of the level counts as
+ * far away). Seeing the player, being seen, hearing a noise or hunting a
+ * remembered position makes a monster ACTIVE at once, whatever its
+ * distance.
+ */
+enum class AITier : uint8_t {
+    ACTIVE,     ///< Full behaviour every turn
+    NEARBY,     ///< Full behaviour every NEARBY_PERIOD turns
+    DISTANT,    ///< Cheap approximate movement every DISTANT_PERIOD turns
+    DORMANT     ///< Cheap approximate movement every DORMANT_PERIOD turns
+};
+
+/// Number of AITier values
+constexpr size_t AI_TIER_COUNT = 4;
+
+/**
+ * @struct AILevelOfDetail
+ * @brief Tier thresholds and update schedule
+ */
+struct AILevelOfDetail {
+    /// Walking steps from the player up to which monsters stay ACTIVE
+    static constexpr int ACTIVE_STEPS = 20;
+    /// Steps up to which monsters are NEARBY
+    static constexpr int NEARBY_STEPS = 40;
+    /// Steps up to which monsters are DISTANT (DORMANT beyond, or unreachable)
+    static constexpr int DISTANT_STEPS = 80;
+
+    static constexpr int NEARBY_PERIOD = 2;
+    static constexpr int DISTANT_PERIOD = 4;
+    static constexpr int DORMANT_PERIOD = 16;
+
+    /**
+     * @brief Pick the tier for a walking distance
+     * @param steps Steps to the player, or a negative value if unreachable
+     */
+    static constexpr AITier classify(int steps) {
+        if (steps < 0 || steps > DISTANT_STEPS) return AITier::DORMANT;
+        if (steps > NEARBY_STEPS) return AITier::DISTANT;
+        if (steps > ACTIVE_STEPS) return AITier::NEARBY;
+        return AITier::ACTIVE;
+    }
+
+    /// Turns between updates of a tier
+    static constexpr int getPeriod(AITier tier) {
+        switch (tier) {
+            case AITier::NEARBY: return NEARBY_PERIOD;
+            case AITier::DISTANT: return DISTANT_PERIOD;
+            case AITier::DORMANT: return DORMANT_PERIOD;
+            default: return 1;
+        }
+    }
+
+    /**
+     * @brief Whether a monster in a tier acts on a turn
+     *
+     * @param turn The monster's own turn count
+     *
+     * Entities are staggered by ID so a tier's work spreads evenly over
+     * its period instead of landing on one turn.
+     */
+    static constexpr bool isDue(AITier tier, EntityID id, uint64_t turn) {
+        return (turn + id) % static_cast<uint64_t>(getPeriod(tier)) == 0;
+    }
+
+    static constexpr const char* getTierName(AITier tier) {
+        switch (tier) {
+            case AITier::ACTIVE: return "active";
+            case AITier::NEARBY: return "nearby";
+            case AITier::DISTANT: return "distant";
+            default: return "dormant";
+        }
+    }
+};
+
+/**
+ * @struct AITierStats
+ * @brief Per-tier monster counts and AI time for one update
+ */
+struct AITierStats {
+    std::array<int, AI_TIER_COUNT> counts{};     ///< Monsters in each tier
+    std::array<int, AI_TIER_COUNT> updated{};    ///< Monsters that acted
+    std::array<double, AI_TIER_COUNT> time_ms{}; ///< Time spent on each tier (awake tiers share one batch)
+
+    int& count(AITier tier) { return counts[static_cast<size_t>(tier)]; }
+    int count(AITier tier) const { return counts[static_cast<size_t>(tier)]; }
+};
+
+} // namespace ecs
@@ -7,16 +7,26 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <random>
 #include <vector>
-#include <deque>
 
 #include "system.h"
 #include "entity.h"
 #include "position_component.h"
+#include "health_component.h"
 #include "logger_interface.h"
+#include "ai_lod.h"
 #include "../map.h"
+#include "../sight_map.h"
+#include "../pathfinding.h"
+#include "../dijkstra_map.h"
+#include "../hierarchical_pathfinder.h"
+#include "../moving_target_search.h"
+#include "../path_cache.h"
+
+class ThreadPool;
 
 namespace ecs {
 
@@ -39,6 +49,9 @@ enum class AIBehavior {
     SUPPORT       ///< Healing/helping allies
 };
 
+/// Number of AIBehavior values
+constexpr size_t AI_BEHAVIOR_COUNT = 7;
+
 /**
  * @class AIComponent
  * @brief Component for AI-controlled entities
@@ -49,10 +62,14 @@ public:
     int vision_range = 6;                          ///< How far the AI can see
     int aggro_range = 4;                           ///< Range at which AI becomes hostile
     EntityID target_id = 0;                        ///< Current target entity ID
-    std::deque<Point> path;                        ///< Current pathfinding path
+    SharedPath path;                               ///< Rest of the current path (may share cached steps)
+    MovingTargetSearch search;                     ///< Search tree repaired as this monster and its target move
     bool has_seen_player = false;                  ///< Whether AI has spotted player
     int turns_since_player_seen = 0;               ///< Turns since last saw player
     Point last_player_position{-1, -1};            ///< Last known player position
+    AITier tier = AITier::ACTIVE;                  ///< Level of detail from the last update
+    uint32_t lod_turns = 0;                        ///< Turns tiered so far (staggers low-tier updates)
+    int speed = 100;                               ///< Turn speed (100 acts once per normal turn)
 
     // Patrol behavior
     std::vector<Point> patrol_points;              ///< Points to patrol
@@ -94,12 +111,43 @@ public:
      */
     void update(const std::vector<std::unique_ptr<Entity>>& entities, double delta_time) override;
 
+    /**
+     * @brief Update AI for entities with an AIComponent only
+     * @param world World to query
+     * @param delta_time Time since last update
+     */
+    void update(World& world, double delta_time) override;
+
+    /**
+     * @brief Update AI for the monsters whose turn has come
+     * @param world World owning the monsters
+     * @param actors Monsters to run, in turn order (from the TurnManager)
+     */
+    void updateActors(World& world, const std::vector<EntityID>& actors);
+
     /**
      * @brief Get system priority
      * @return Priority value (lower = earlier execution)
      */
     int getPriority() const override { return 30; } // After input, before movement
 
+    /**
+     * @brief Get declared access
+     * @return Reads positions and health, queues moves and attacks
+     */
+    SystemAccess getAccess() const override {
+        return SystemAccess().read<PositionComponent, HealthComponent>()
+                             .write<AIComponent>()
+                             .readResource(SystemResource::MAP)
+                             .writeResource(SystemResource::ACTIONS | SystemResource::MESSAGE_LOG);
+    }
+
+    /**
+     * @brief Get system name
+     * @return "AISystem"
+     */
+    std::string getName() const override { return "AISystem"; }
+
     /**
      * @brief Check if system should process an entity
      * @param entity Entity to check
@@ -115,122 +163,354 @@ public:
      */
     void setPlayerId(EntityID id) { this->player_id = id; }
 
+    /**
+     * @brief Set world for O(1) entity lookups
+     * @param w World owning the entities (nullptr to scan the entity list)
+     */
+    void setWorld(World* w) { this->world = w; }
+
+    /**
+     * @brief Get the player's sight bitset from the last update
+     * @return Bitset answering "can this tile see the player"
+     */
+    const SightMap& getPlayerSight() const { return player_sight; }
+
+    /**
+     * @brief Get the shared distance field towards the player
+     * @return Field used by every monster chasing the player (may be
+     *         invalid if nobody chased this turn)
+     */
+    const DijkstraMap& getChaseField() const { return chase_field; }
+
+    /**
+     * @brief Get the shared flee field away from the player
+     * @return Field used by every monster fleeing the player
+     */
+    const DijkstraMap& getFleeField() const { return flee_field; }
+
+    /**
+     * @brief Build the room-level route graph for a freshly generated map
+     *
+     * Long paths are planned on this graph; it is repaired as doors
+     * change and rebuilt on first use if this was never called.
+     */
+    void buildRouteGraph() { if (map) route_planner.build(*map); }
+
+    /**
+     * @brief Get the room-level route planner used for long paths
+     */
+    const HierarchicalPathfinder& getRoutePlanner() const { return route_planner; }
+
+    /// Paths at least this long (Manhattan) go through the route planner
+    static constexpr int LONG_PATH_DISTANCE = 32;
+
+    /**
+     * @brief Get the cache of paths shared between monsters
+     * @return Cache whose hit/miss counts cover the last update()
+     */
+    const PathCache& getPathCache() const { return path_cache; }
+
+    /**
+     * @brief Set the pool that runs this turn's monster path searches
+     * @param pool Thread pool (not owned), or nullptr to search on the
+     *        calling thread as each monster decides
+     *
+     * With a pool, update() collects every monster's path request, runs
+     * the searches as jobs and applies the results in entity order before
+     * any move is queued. Jobs only read the map (nothing changes it
+     * until the movement phase) and each monster's own search tree, so
+     * the outcome is the same for any number of workers, and the same as
+     * without a pool.
+     */
+    void setThreadPool(::ThreadPool* pool) { path_pool = pool; }
+
+    /**
+     * @brief Get the pool used for path searches
+     * @return Thread pool or nullptr
+     */
+    ::ThreadPool* getThreadPool() const { return path_pool; }
+
+    /// Path searches run as jobs by the last update() (0 without a pool)
+    size_t getPathJobCount() const { return path_jobs; }
+
+    /**
+     * @brief Simulate distant monsters coarsely (on by default)
+     * @param enabled false to run full behaviour for every monster every turn
+     *
+     * @see AILevelOfDetail for the tiers and their schedules
+     */
+    void setLevelOfDetail(bool enabled) { lod_enabled = enabled; }
+    bool getLevelOfDetail() const { return lod_enabled; }
+
+    /**
+     * @brief Run awake monsters in behaviour passes (on by default)
+     * @param enabled false to perceive and act one monster at a time, in
+     *                entity order, dispatching on behaviour per monster
+     *
+     * The per-monster order is the pre-batching AI loop, kept as the
+     * baseline for the batched update benchmark.
+     */
+    void setBatched(bool enabled) { batched = enabled; }
+    bool getBatched() const { return batched; }
+
+    /**
+     * @brief Make a noise monsters can hear on the next update()
+     * @param origin Where the noise was made
+     * @param radius Distance (Manhattan) it carries
+     *
+     * Monsters within earshot are simulated in full (AITier::ACTIVE)
+     * whatever their distance from the player.
+     */
+    void makeNoise(const Point& origin, int radius) { noises.push_back({origin, radius}); }
+
+    /**
+     * @brief Get per-tier counts and time from the last update()
+     */
+    const AITierStats& getTierStats() const { return tier_stats; }
+
+    /// Monsters run through full behaviour by the last update()
+    size_t getAwakeCount() const { return awake.size(); }
+
+    /// Turns a monster keeps hunting the player's last known position
+    static constexpr int HUNT_TURNS = 5;
+    /// How far the sounds of a fight carry
+    static constexpr int COMBAT_NOISE_RADIUS = 12;
+
 private:
     Map* map;                           ///< Game map
     MovementSystem* movement_system;    ///< Movement system
     CombatSystem* combat_system;       ///< Combat system
     ILogger* logger;                                    ///< Logger for messages and debug output
     EntityID player_id = 0;             ///< Player entity ID
+    World* world = nullptr;             ///< World for entity lookups
     std::mt19937 rng;                  ///< Random number generator
+    SightMap player_sight;             ///< Player FOV shared by all LOS checks this turn
+    mutable PathfindingContext path_context;  ///< A* scratch reused by findPath()
+    std::vector<Point> player_goal;    ///< Player position this turn (empty if none)
+    DijkstraMap chase_field;           ///< Distances to the player, shared by chasers
+    DijkstraMap flee_field;            ///< Flee field from the player, shared by fleers
+    mutable std::vector<Point> path_buffer;   ///< Path scratch reused by findPath()
+    mutable HierarchicalPathfinder route_planner;  ///< Room-level graph for long paths
+    mutable PathCache path_cache;             ///< Paths shared by findPath() callers
+
+    /// A monster's move for this turn, queued in entity order at the end
+    struct StagedMove {
+        EntityID entity_id;
+        int dx = 0;
+        int dy = 0;
+        bool held = true;                 ///< No move decided (yet)
+    };
+
+    /// A monster's request to walk towards a target, answered in a batch
+    struct PathRequest {
+        AIComponent* ai;
+        Point from;
+        Point target;
+        size_t move_slot;                 ///< Index into staged_moves
+        bool found = false;               ///< Result of the job's search
+        std::vector<Point> steps;         ///< Steps found by the job
+    };
+
+    ::ThreadPool* path_pool = nullptr;        ///< Runs batched searches (not owned)
+    bool batching = false;                    ///< Inside an update() with a pool
+    size_t path_jobs = 0;
+    std::vector<PathRequest> path_requests;   ///< This turn's requests, in entity order
+    std::vector<StagedMove> staged_moves;     ///< One slot per monster due this turn, in entity order
+
+    /// A monster found by this turn's scan
+    struct Monster {
+        Entity* entity;
+        AIComponent* ai;
+        Point pos;
+    };
 
     /**
-     * @brief Process AI for a single entity
-     * @param entity Entity with AI component
-     * @param entities All entities (for targeting)
+     * Monsters running full behaviour this turn, as parallel arrays so
+     * each pass is a tight loop over the fields it needs
      */
-    void processEntityAI(std::shared_ptr<Entity> entity,
-                        const std::vector<std::unique_ptr<Entity>>& entities);
+    struct AwakeBatch {
+        std::vector<Entity*> entities;
+        std::vector<AIComponent*> ai;
+        std::vector<size_t> move_slot;        ///< Index into staged_moves
+        std::vector<int> x;
+        std::vector<int> y;
+        std::vector<int> vision_range;
+        std::vector<int> aggro_range;
+        std::vector<float> hp_ratio;          ///< Health fraction (negative without health)
+        std::vector<int> player_distance;     ///< Manhattan distance to the player
+        std::vector<uint8_t> adjacent;        ///< Next to the player (diagonals count)
+        std::vector<uint8_t> sees_player;
+        std::array<std::vector<uint32_t>, AI_BEHAVIOR_COUNT> buckets;  ///< Indices by behaviour
+
+        size_t size() const { return entities.size(); }
+        Point position(size_t i) const { return Point(x[i], y[i]); }
+        void clear();
+    };
+
+    std::vector<Monster> roster;              ///< Every monster this turn, in entity order
+    AwakeBatch awake;                         ///< Monsters due for full behaviour
+
+    /// A noise made since the last update
+    struct Noise {
+        Point origin;
+        int radius;
+    };
+
+    bool lod_enabled = true;                  ///< Tier monsters by distance to the player
+    bool batched = true;                      ///< Behaviour passes, not per-monster dispatch
+    std::vector<Noise> noises;                ///< Heard on the next update
+    AITierStats tier_stats;                   ///< Filled by the last update
 
     /**
-     * @brief Handle passive behavior
-     * @param entity AI entity
+     * @brief Cast the player's field of view once for this turn's AI
+     * @param player Player entity (nullptr if gone)
+     * @param range Largest vision range among AI entities
+     *
+     * Also records the player's position for the shared chase and flee
+     * fields, which are built on first use each turn.
      */
-    void handlePassiveBehavior(std::shared_ptr<Entity> entity);
+    void refreshPlayerSight(const Entity* player, int range);
 
     /**
-     * @brief Handle wandering behavior
-     * @param entity AI entity
+     * @brief Add a monster to this turn's roster
+     * @param entity Entity with an AI component
+     * @param ai Its AI component
      */
-    void handleWanderingBehavior(std::shared_ptr<Entity> entity);
+    void addToRoster(Entity& entity, AIComponent& ai);
 
     /**
-     * @brief Handle aggressive behavior
-     * @param entity AI entity
-     * @param player Player entity
+     * @brief Run the roster through this turn's passes
+     * @param player Player entity, looked up once for the turn
      */
-    void handleAggressiveBehavior(std::shared_ptr<Entity> entity,
-                                 std::shared_ptr<Entity> player);
+    void runTurn(const Entity* player);
 
     /**
-     * @brief Handle defensive behavior
-     * @param entity AI entity
-     * @param player Player entity
+     * @brief Tier every monster, simulate the distant ones and gather
+     *        the rest into the awake batch
+     * @param distances Walking distances to the player (nullptr: no LOD)
      */
-    void handleDefensiveBehavior(std::shared_ptr<Entity> entity,
-                                std::shared_ptr<Entity> player);
+    void schedule(const DijkstraMap* distances);
 
     /**
-     * @brief Handle patrol behavior
-     * @param entity AI entity
+     * @brief Add a monster to the awake batch and its behaviour bucket
      */
-    void handlePatrolBehavior(std::shared_ptr<Entity> entity);
+    void wake(const Monster& monster, size_t move_slot);
 
     /**
-     * @brief Handle fleeing behavior
-     * @param entity AI entity
-     * @param threat Threat to flee from
+     * @brief Distance, adjacency and sight of the player for part of the
+     *        awake batch, then each monster's memory of the player
+     * @param begin First awake index
+     * @param end One past the last awake index
      */
-    void handleFleeingBehavior(std::shared_ptr<Entity> entity,
-                               std::shared_ptr<Entity> threat);
+    void perceive(size_t begin, size_t end);
 
     /**
-     * @brief Handle support behavior (healing/helping allies)
-     * @param entity AI entity
-     * @param player Player entity
+     * @brief Run one awake monster's behaviour
+     * @param i Awake index
      */
-    void handleSupportBehavior(std::shared_ptr<Entity> entity,
-                              std::shared_ptr<Entity> player);
+    void runOne(uint32_t i);
 
     /**
-     * @brief Check if entity can see target
-     * @param entity Observer entity
-     * @param target Target entity
-     * @return true if target is visible
+     * @brief Pick a monster's level of detail
+     * @param pos Monster position
+     * @param ai Its AI component
+     * @param distances Walking distances to the player
      */
-    bool canSeeEntity(std::shared_ptr<Entity> entity,
-                     std::shared_ptr<Entity> target) const;
+    AITier classify(const Point& pos, const AIComponent& ai, const DijkstraMap& distances) const;
 
     /**
-     * @brief Calculate distance between entities
-     * @param e1 First entity
-     * @param e2 Second entity
-     * @return Manhattan distance
+     * @brief Cheap stand-in for behaviour far from the player
+     * @param monster Monster to move
+     * @param move_slot Its staged move
+     *
+     * Keeps walking the current path, or drifts one step if the monster
+     * would be wandering; never searches or checks sight.
      */
-    int getDistance(std::shared_ptr<Entity> e1,
-                   std::shared_ptr<Entity> e2) const;
+    void simulateDistant(const Monster& monster, size_t move_slot);
 
     /**
-     * @brief Find path to target using BFS
+     * @brief Record a monster's move for this turn
+     * @param move_slot Index into staged_moves
+     */
+    void queueMove(size_t move_slot, int dx, int dy);
+
+    /**
+     * @brief Run the batched path searches and apply their results
+     */
+    void resolvePathRequests();
+
+    /**
+     * @brief Hand this turn's moves to the movement system in entity order
+     */
+    void flushMoves();
+
+    /**
+     * @brief Pick the next step towards a target by searching
+     * @param ai Walker's AI state (its search tree and path)
+     * @param current Walker position
+     * @param target Target position
+     * @param solved Batched result of the near search, or nullptr to run it here
+     * @param next Receives the tile to step onto
+     * @return false if there is nowhere to step
+     */
+    bool followPath(AIComponent& ai, const Point& current, const Point& target,
+                    const PathRequest* solved, Point& next);
+
+    /**
+     * @brief Get a shared field around the player, computing it if stale
+     * @param fleeing Flee field instead of chase field
+     * @return Field, or nullptr without a map or player
+     */
+    const DijkstraMap* getPlayerField(bool fleeing);
+
+    /// @name Behaviour passes
+    /// Each runs every awake monster in one behaviour bucket
+    /// @{
+    void runWandering(const std::vector<uint32_t>& bucket);
+    void runAggressive(const std::vector<uint32_t>& bucket);
+    void runDefensive(const std::vector<uint32_t>& bucket);
+    void runPatrol(const std::vector<uint32_t>& bucket);
+    void runFleeing(const std::vector<uint32_t>& bucket);
+    void runSupport(const std::vector<uint32_t>& bucket);
+    /// @}
+
+    /**
+     * @brief Step an awake monster to a random adjacent tile
+     * @param i Index into the awake batch
+     */
+    void wander(size_t i);
+
+    /**
+     * @brief Find a 4-directional path to target, sharing cached paths
      * @param from Starting position
      * @param to Target position
-     * @return Path as deque of points
+     * @return Steps after from (empty if unreachable); targets
+     *         LONG_PATH_DISTANCE or more away are planned over the room graph
      */
-    std::deque<Point> findPath(const Point& from, const Point& to) const;
+    SharedPath findPath(const Point& from, const Point& to) const;
 
     /**
-     * @brief Move entity towards target
-     * @param entity AI entity
+     * @brief Move an awake monster towards target
+     * @param i Index into the awake batch
      * @param target Target position
-     * @return true if moved
+     * @return true if moved (or waiting on a batched search)
      */
-    bool moveTowards(std::shared_ptr<Entity> entity, const Point& target);
+    bool moveTowards(size_t i, const Point& target);
 
     /**
-     * @brief Move entity away from target
-     * @param entity AI entity
+     * @brief Move an awake monster away from target
+     * @param i Index into the awake batch
      * @param threat Threat position to flee from
      * @return true if moved
      */
-    bool moveAway(std::shared_ptr<Entity> entity, const Point& threat);
+    bool moveAway(size_t i, const Point& threat);
 
     /**
-     * @brief Try to attack target if adjacent
-     * @param entity Attacking entity
-     * @param target Target entity
+     * @brief Attack the player if adjacent
+     * @param i Index into the awake batch
      * @return true if attack was made
      */
-    bool tryAttack(std::shared_ptr<Entity> entity,
-                  std::shared_ptr<Entity> target);
+    bool tryAttack(size_t i);
 
     /**
      * @brief Get random adjacent position
@@ -245,9 +525,7 @@ private:
      * @param id Entity ID
      * @return Entity or nullptr
      */
-    std::shared_ptr<Entity> findEntity(
-        const std::vector<std::unique_ptr<Entity>>& entities,
-        EntityID id) const;
+    Entity* findEntity(const std::vector<std::unique_ptr<Entity>>& entities, EntityID id) const;
 };
 
 } // namespace ecs
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include "combat_component.h"
 #include "health_component.h"
 #include "position_component.h"
+#include "renderable_component.h"
 #include "logger_interface.h"
 #include <memory>
 #include <random>
@@ -112,9 +113,33 @@ public:
      */
     int getPriority() const override { return 50; } // Mid priority
 
+    /**
+     * @brief Get declared access
+     * @return Drains the attack queue, damaging health and logging results
+     */
+    SystemAccess getAccess() const override {
+        return SystemAccess().read<CombatComponent, PositionComponent, RenderableComponent>()
+                             .write<HealthComponent>()
+                             .writeResource(SystemResource::ACTIONS | SystemResource::EVENTS |
+                                            SystemResource::MESSAGE_LOG);
+    }
+
+    /**
+     * @brief Get system name
+     * @return "CombatSystem"
+     */
+    std::string getName() const override { return "CombatSystem"; }
+
+    /**
+     * @brief Set world for O(1) entity lookups
+     * @param w World owning the entities (nullptr to scan the entity list)
+     */
+    void setWorld(World* w) { this->world = w; }
+
 private:
     ILogger* logger;                            ///< Logger for combat messages and debug output
     std::mt19937 rng;                           ///< Random number generator
+    World* world = nullptr;                     ///< World for entity lookups
 
     // Pending attacks to process
     struct PendingAttack {
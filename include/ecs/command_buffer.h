@@ -0,0 +1,172 @@
+/**
+ * @file command_buffer.h
+ * @brief Deferred structural changes to an ecs::World
+ * @author Veyrm Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include "entity.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace ecs {
+
+// Forward declarations
+class World;
+
+/**
+ * @class CommandBuffer
+ * @brief Records entity creation/destruction and component add/remove
+ *
+ * Adding or removing entities and components while a view or the
+ * entity list is being iterated reshuffles the very arrays being walked.
+ * Systems record those changes here instead; they are applied in one
+ * batch, in recording order, when the buffer is flushed at a sync point
+ * (World::update() flushes the world's buffer after all systems ran).
+ *
+ * Recording is thread-safe, so systems running in parallel may share a
+ * buffer. Staged entities get their IDs from the owning world's
+ * allocator when they are recorded. Commands aimed at an entity that no longer exists when the
+ * buffer is flushed are dropped. Command storage is reused between
+ * flushes, so steady-state recording does not reallocate.
+ *
+ * @code
+ * auto& commands = world.getCommandBuffer();
+ * world.view<HealthComponent>().each([&](Entity& entity, HealthComponent& health) {
+ *     if (health.hp <= 0) {
+ *         commands.destroy(entity.getID());
+ *     }
+ * });
+ * world.flushCommands();
+ * @endcode
+ */
+class CommandBuffer {
+public:
+    /**
+     * @brief Construct a buffer for one world
+     * @param ids The world's ID allocator, used for staged entities
+     */
+    explicit CommandBuffer(EntityIdAllocator& ids) : ids(ids) {}
+    ~CommandBuffer() = default;
+
+    CommandBuffer(const CommandBuffer&) = delete;
+    CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+    /**
+     * @brief Stage a new, empty entity
+     * @return Staged entity; add components to it directly
+     * @note The entity joins the world on flush. Its ID is valid right
+     *       away and may be used in later commands.
+     */
+    Entity& create();
+
+    /**
+     * @brief Stage an already built entity (e.g. from EntityFactory)
+     * @param entity Entity to add on flush (ownership transferred)
+     * @return ID of the staged entity
+     * @note An entity without an ID (e.g. factory-built) is given one now.
+     *       One with an ID is claimed on flush, which throws if the ID is
+     *       already in use (see World::addEntity()).
+     */
+    EntityID create(std::unique_ptr<Entity> entity);
+
+    /**
+     * @brief Destroy an entity on flush
+     * @param id Entity ID
+     */
+    void destroy(EntityID id);
+
+    /**
+     * @brief Add (or replace) a component on flush
+     * @tparam T Component type
+     * @param id Entity ID
+     * @param args Arguments forwarded to the component constructor now
+     */
+    template<typename T, typename... Args>
+    void addComponent(EntityID id, Args&&... args) {
+        addComponent(id, std::make_unique<T>(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief Add (or replace) an existing component on flush
+     * @param id Entity ID
+     * @param component Component (ownership transferred)
+     */
+    void addComponent(EntityID id, std::unique_ptr<IComponent> component);
+
+    /**
+     * @brief Remove a component on flush
+     * @tparam T Component type
+     * @param id Entity ID
+     */
+    template<typename T>
+    void removeComponent(EntityID id) {
+        record({Op::REMOVE_COMPONENT, id, nullptr, nullptr, &removeOne<T>});
+    }
+
+    /**
+     * @brief Apply all recorded commands to a world
+     * @param world Target world
+     * @return Number of commands applied (dropped ones excluded)
+     *
+     * Commands recorded while flushing (e.g. by component listeners) are
+     * applied in the same call.
+     */
+    size_t flush(World& world);
+
+    /**
+     * @brief Discard recorded commands without applying them
+     * @note IDs reserved for discarded entities are released.
+     */
+    void clear();
+
+    /**
+     * @brief Get number of recorded commands
+     * @return Command count
+     */
+    size_t size() const;
+
+    /**
+     * @brief Check if no commands are recorded
+     * @return true if empty
+     */
+    bool empty() const { return size() == 0; }
+
+private:
+    enum class Op : uint8_t {
+        CREATE,
+        DESTROY,
+        ADD_COMPONENT,
+        REMOVE_COMPONENT
+    };
+
+    using Remover = bool (*)(Entity&);
+
+    struct Command {
+        Op op;                                  ///< Operation
+        EntityID id;                            ///< Target entity
+        std::unique_ptr<Entity> entity;         ///< Staged entity (CREATE)
+        std::unique_ptr<IComponent> component;  ///< Component to add (ADD_COMPONENT)
+        Remover remove;                         ///< Typed removal (REMOVE_COMPONENT)
+        bool reserved = false;                  ///< ID was allocated for this CREATE
+    };
+
+    EntityIdAllocator& ids;          ///< Owning world's ID allocator
+    mutable std::mutex mutex;        ///< Guards commands
+    std::vector<Command> commands;   ///< Recorded commands
+    std::vector<Command> applying;   ///< Batch being flushed (keeps capacity)
+
+    void record(Command command);
+
+    template<typename T>
+    static bool removeOne(Entity& entity) {
+        return entity.removeComponent<T>();
+    }
+};
+
+} // namespace ecs
@@ -7,9 +7,14 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <new>
+#include <type_traits>
 #include <typeindex>
 #include <string>
+#include <utility>
 
 namespace ecs {
 
@@ -32,6 +37,42 @@ enum class ComponentType {
     CUSTOM        ///< User-defined components
 };
 
+/**
+ * @brief Dense identifier for a concrete component class
+ *
+ * Assigned on first use, so IDs are small consecutive integers that
+ * can index per-type arrays directly (no RTTI or hashing involved).
+ */
+using ComponentTypeId = std::uint32_t;
+
+namespace detail {
+
+/**
+ * @brief Register a component class layout and allocate its type ID
+ * @param size sizeof() of the component class
+ * @param align alignof() of the component class
+ * @return Newly assigned type ID
+ */
+ComponentTypeId registerComponentType(std::size_t size, std::size_t align);
+
+template<typename T>
+ComponentTypeId typeIdOf() {
+    static const ComponentTypeId id = registerComponentType(sizeof(T), alignof(T));
+    return id;
+}
+
+} // namespace detail
+
+/**
+ * @brief Get the type ID of a component class
+ * @tparam T Concrete component type (cv-qualifiers are ignored)
+ * @return Type ID, stable for the lifetime of the process
+ */
+template<typename T>
+ComponentTypeId componentTypeId() {
+    return detail::typeIdOf<std::remove_cv_t<T>>();
+}
+
 /**
  * @class IComponent
  * @brief Base interface for all entity components
@@ -60,6 +101,26 @@ public:
      * @return Unique pointer to cloned component
      */
     virtual std::unique_ptr<IComponent> clone() const = 0;
+
+    /**
+     * @brief Get the dense type ID of this component's concrete class
+     * @return Type ID used to index component pools
+     */
+    virtual ComponentTypeId getTypeId() const = 0;
+
+    /**
+     * @brief Move-construct this component into raw storage
+     * @param storage Suitably sized and aligned memory for the concrete type
+     * @return Pointer to the newly constructed component
+     */
+    virtual IComponent* relocateTo(void* storage) = 0;
+
+    /**
+     * @brief Copy-construct this component into raw storage
+     * @param storage Suitably sized and aligned memory for the concrete type
+     * @return Pointer to the newly constructed copy
+     */
+    virtual IComponent* copyTo(void* storage) const = 0;
 };
 
 /**
@@ -75,6 +136,18 @@ public:
     std::unique_ptr<IComponent> clone() const override {
         return std::make_unique<Derived>(static_cast<const Derived&>(*this));
     }
+
+    ComponentTypeId getTypeId() const override {
+        return componentTypeId<Derived>();
+    }
+
+    IComponent* relocateTo(void* storage) override {
+        return ::new (storage) Derived(std::move(static_cast<Derived&>(*this)));
+    }
+
+    IComponent* copyTo(void* storage) const override {
+        return ::new (storage) Derived(static_cast<const Derived&>(*this));
+    }
 };
 
 } // namespace ecs
\ No newline at end of file
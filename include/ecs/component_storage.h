@@ -0,0 +1,628 @@
+/**
+ * @file component_storage.h
+ * @brief Per-type component pools backing ecs::World
+ * @author Veyrm Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include "component.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace ecs {
+
+// Forward declarations
+class Entity;
+
+/**
+ * @class ComponentPool
+ * @brief Sparse set holding every component of one concrete type
+ *
+ * Components are constructed in fixed-size pages, so each type lives in
+ * its own contiguous blocks and a component never moves once created
+ * (pointers handed out stay valid until the component is removed).
+ * Freed slots are recycled. A dense owner/component array supports
+ * tight iteration, and a sparse array maps an entity's storage index
+ * to its dense position for O(1) lookup and swap-remove deletion.
+ *
+ * Each component also carries the change tick at which it was added and
+ * last marked changed (see ComponentStorage::getChangeTick()), so
+ * consumers can find what changed since they last looked.
+ */
+class ComponentPool {
+public:
+    /// Components per page
+    static constexpr std::uint32_t PAGE_SIZE = 64;
+
+    /**
+     * @brief Construct pool for one component type
+     * @param type Component type ID
+     * @param size sizeof() the component class
+     * @param align alignof() the component class
+     * @param clock Change tick source (nullptr stamps every change as 0)
+     */
+    ComponentPool(ComponentTypeId type, std::size_t size, std::size_t align,
+                  const std::atomic<std::uint32_t>* clock = nullptr);
+    ~ComponentPool();
+
+    ComponentPool(const ComponentPool&) = delete;
+    ComponentPool& operator=(const ComponentPool&) = delete;
+
+    /**
+     * @brief Construct a component in place for an entity
+     * @tparam T Concrete component type (must match the pool type)
+     * @param owner Owning entity
+     * @param index Owner's storage index
+     * @param args Constructor arguments
+     * @return Pointer to the new component (replaces any existing one)
+     */
+    template<typename T, typename... Args>
+    T* emplace(Entity* owner, std::uint32_t index, Args&&... args) {
+        std::uint32_t slot = allocateSlot();
+        T* component = nullptr;
+        try {
+            component = ::new (slotAddress(slot)) T(std::forward<Args>(args)...);
+        } catch (...) {
+            free_slots.push_back(slot);
+            throw;
+        }
+        commit(owner, index, slot, component);
+        return component;
+    }
+
+    /**
+     * @brief Move an existing component into the pool
+     * @param owner Owning entity
+     * @param index Owner's storage index
+     * @param source Component to move from (left in moved-from state)
+     * @return Pointer to the pooled component
+     */
+    IComponent* adopt(Entity* owner, std::uint32_t index, IComponent& source);
+
+    /**
+     * @brief Copy a component into the pool
+     * @param owner Owning entity
+     * @param index Owner's storage index
+     * @param source Component to copy (e.g. a prototype's)
+     * @return Pointer to the pooled copy
+     */
+    IComponent* copy(Entity* owner, std::uint32_t index, const IComponent& source);
+
+    /**
+     * @brief Destroy an entity's component
+     * @param index Owner's storage index
+     * @return true if a component was removed
+     */
+    bool erase(std::uint32_t index);
+
+    /**
+     * @brief Get an entity's component
+     * @param index Owner's storage index
+     * @return Component or nullptr
+     */
+    IComponent* get(std::uint32_t index) const {
+        if (index >= sparse.size() || sparse[index] == NPOS) {
+            return nullptr;
+        }
+        return components[sparse[index]];
+    }
+
+    /**
+     * @brief Check if an entity has a component in this pool
+     * @param index Owner's storage index
+     * @return true if present
+     */
+    bool contains(std::uint32_t index) const {
+        return index < sparse.size() && sparse[index] != NPOS;
+    }
+
+    /**
+     * @brief Stamp an entity's component as changed at the current tick
+     * @param index Owner's storage index
+     * @return true if the entity has a component in this pool
+     */
+    bool touch(std::uint32_t index) {
+        if (!contains(index)) {
+            return false;
+        }
+        changed_ticks[sparse[index]] = last_change_tick = now();
+        return true;
+    }
+
+    /**
+     * @brief Get the tick an entity's component was last changed
+     * @param index Owner's storage index
+     * @return Change tick, or 0 if absent
+     */
+    std::uint32_t getChangedTick(std::uint32_t index) const {
+        return contains(index) ? changed_ticks[sparse[index]] : 0;
+    }
+
+    /**
+     * @brief Get the tick an entity's component was added
+     * @param index Owner's storage index
+     * @return Add tick, or 0 if absent
+     */
+    std::uint32_t getAddedTick(std::uint32_t index) const {
+        return contains(index) ? added_ticks[sparse[index]] : 0;
+    }
+
+    /**
+     * @brief Check if anything in the pool was added, changed or removed
+     * @param tick Tick to compare against
+     * @return true if the pool changed after the tick
+     */
+    bool changedSince(std::uint32_t tick) const { return last_change_tick > tick; }
+
+    /**
+     * @brief Get change ticks in dense order
+     * @return Tick array parallel to getOwners()
+     */
+    const std::vector<std::uint32_t>& getChangedTicks() const { return changed_ticks; }
+
+    /**
+     * @brief Get add ticks in dense order
+     * @return Tick array parallel to getOwners()
+     */
+    const std::vector<std::uint32_t>& getAddedTicks() const { return added_ticks; }
+
+    /**
+     * @brief Get component type stored in this pool
+     * @return Component type ID
+     */
+    ComponentTypeId getType() const { return type; }
+
+    /**
+     * @brief Get number of live components
+     * @return Component count
+     */
+    std::size_t size() const { return owners.size(); }
+
+    /**
+     * @brief Get owners in dense order
+     * @return Owner array parallel to getComponents()
+     */
+    const std::vector<Entity*>& getOwners() const { return owners; }
+
+    /**
+     * @brief Get components in dense order
+     * @return Component array parallel to getOwners()
+     */
+    const std::vector<IComponent*>& getComponents() const { return components; }
+
+    /**
+     * @brief Get owner storage indices in dense order
+     * @return Index array parallel to getOwners()
+     */
+    const std::vector<std::uint32_t>& getIndices() const { return dense_index; }
+
+    /**
+     * @brief Get number of slots allocated across all pages
+     * @return Capacity in components
+     */
+    std::size_t capacity() const { return pages.size() * PAGE_SIZE; }
+
+private:
+    static constexpr std::uint32_t NPOS = UINT32_MAX;
+
+    ComponentTypeId type;    ///< Stored component type
+    std::size_t stride;      ///< Bytes between consecutive components
+    std::size_t alignment;   ///< Required alignment
+    const std::atomic<std::uint32_t>* clock;  ///< Change tick source
+    std::uint32_t last_change_tick = 0;       ///< Latest add/change/remove
+
+    std::vector<void*> pages;                ///< Page blocks of PAGE_SIZE components
+    std::vector<std::uint32_t> free_slots;   ///< Recyclable slots
+    std::uint32_t used_slots = 0;            ///< High-water mark of handed-out slots
+
+    std::vector<std::uint32_t> sparse;       ///< Storage index -> dense index
+    std::vector<Entity*> owners;             ///< Dense owners
+    std::vector<IComponent*> components;     ///< Dense components
+    std::vector<std::uint32_t> dense_slots;  ///< Dense index -> slot
+    std::vector<std::uint32_t> dense_index;  ///< Dense index -> storage index
+    std::vector<std::uint32_t> added_ticks;  ///< Dense index -> tick added
+    std::vector<std::uint32_t> changed_ticks; ///< Dense index -> tick last changed
+
+    std::uint32_t now() const {
+        return clock ? clock->load(std::memory_order_relaxed) : 0;
+    }
+
+    std::uint32_t allocateSlot();
+    void* slotAddress(std::uint32_t slot) const;
+    void commit(Entity* owner, std::uint32_t index, std::uint32_t slot,
+                IComponent* component);
+};
+
+/**
+ * @brief Identifier of a cached view signature
+ *
+ * Assigned once per distinct View<Ts...> instantiation.
+ */
+using ViewId = std::uint32_t;
+
+namespace detail {
+
+/**
+ * @brief Allocate a new view ID
+ * @return Newly assigned view ID
+ */
+ViewId registerView();
+
+} // namespace detail
+
+/**
+ * @brief Get the view ID for a component signature
+ * @tparam Ts Required component types
+ * @return View ID, stable for the lifetime of the process
+ */
+template<typename... Ts>
+ViewId viewId() {
+    static const ViewId id = detail::registerView();
+    return id;
+}
+
+/**
+ * @class ViewCache
+ * @brief Cached set of entities matching a component signature
+ *
+ * Maintained by ComponentStorage as components are added and removed,
+ * so iterating a view never visits entities outside the signature.
+ *
+ * While a pass is open (beginPass()), removals leave a null hole instead
+ * of swap-moving the last entry, so entries never shift under the pass;
+ * the holes are compacted away when the last pass ends.
+ */
+class ViewCache {
+public:
+    /**
+     * @brief Construct empty cache
+     * @param signature Required component type IDs
+     */
+    explicit ViewCache(std::vector<ComponentTypeId> signature)
+        : signature(std::move(signature)) {}
+
+    /**
+     * @brief Get required component types
+     * @return Signature type IDs
+     */
+    const std::vector<ComponentTypeId>& getSignature() const { return signature; }
+
+    /**
+     * @brief Get matching entities
+     * @return Entities in cache order; null entries are holes left by
+     *         removals during an open pass
+     */
+    const std::vector<Entity*>& getEntities() const { return entities; }
+
+    /**
+     * @brief Get number of matching entities
+     * @return Entity count, holes excluded
+     */
+    size_t size() const { return entities.size() - holes; }
+
+    /**
+     * @brief Open an iteration pass; removals are deferred until it ends
+     */
+    void beginPass() { ++passes; }
+
+    /**
+     * @brief Close an iteration pass, compacting holes after the last one
+     */
+    void endPass();
+
+    /**
+     * @brief Check if an entity is in the cache
+     * @param index Entity storage index
+     * @return true if cached
+     */
+    bool contains(std::uint32_t index) const {
+        return index < positions.size() && positions[index] != NPOS;
+    }
+
+    /**
+     * @brief Add a matching entity
+     * @param entity Entity to add
+     * @param index Entity storage index
+     */
+    void insert(Entity* entity, std::uint32_t index);
+
+    /**
+     * @brief Remove an entity (swap-remove)
+     * @param index Entity storage index
+     */
+    void erase(std::uint32_t index);
+
+private:
+    static constexpr std::uint32_t NPOS = UINT32_MAX;
+
+    std::vector<ComponentTypeId> signature;  ///< Required component types
+    std::vector<Entity*> entities;           ///< Matching entities
+    std::vector<std::uint32_t> indices;      ///< Storage index per entry
+    std::vector<std::uint32_t> positions;    ///< Storage index -> entry
+    std::uint32_t passes = 0;                ///< Open iteration passes
+    std::uint32_t holes = 0;                 ///< Null entries awaiting compaction
+
+    /// Drop null entries, keeping the order of the rest
+    void compact();
+};
+
+/**
+ * @class ComponentListener
+ * @brief Callback interface for component lifecycle in a ComponentStorage
+ *
+ * Registered per component type. Used by indexes that must track a
+ * component's value (e.g. the spatial index over PositionComponent).
+ */
+class ComponentListener {
+public:
+    virtual ~ComponentListener() = default;
+
+    /**
+     * @brief Called after a component is added or replaced
+     * @param entity Owning entity
+     * @param component New component
+     */
+    virtual void onComponentSet(Entity& entity, IComponent& component) = 0;
+
+    /**
+     * @brief Called before a component is destroyed
+     * @param entity Owning entity
+     * @param component Component about to be removed
+     */
+    virtual void onComponentRemoved(Entity& entity, IComponent& component) = 0;
+
+    /**
+     * @brief Called after a component was marked changed
+     * @param entity Owning entity
+     * @param component Changed component
+     */
+    virtual void onComponentChanged([[maybe_unused]] Entity& entity,
+                                    [[maybe_unused]] IComponent& component) {}
+};
+
+/**
+ * @class ComponentObserver
+ * @brief ComponentListener that forwards one kind of event to a callback
+ *
+ * Created by World::onAdd(), World::onChange() and World::onRemove().
+ */
+class ComponentObserver : public ComponentListener {
+public:
+    /// Which lifecycle event triggers the callback
+    enum class Trigger {
+        ADDED,    ///< Component added or replaced
+        CHANGED,  ///< Component marked changed
+        REMOVED   ///< Component about to be removed
+    };
+
+    using Callback = std::function<void(Entity&, IComponent&)>;
+
+    /**
+     * @brief Construct observer
+     * @param trigger Event to react to
+     * @param callback Function to call
+     */
+    ComponentObserver(Trigger trigger, Callback callback)
+        : trigger(trigger), callback(std::move(callback)) {}
+
+    void onComponentSet(Entity& entity, IComponent& component) override {
+        if (trigger == Trigger::ADDED) callback(entity, component);
+    }
+
+    void onComponentRemoved(Entity& entity, IComponent& component) override {
+        if (trigger == Trigger::REMOVED) callback(entity, component);
+    }
+
+    void onComponentChanged(Entity& entity, IComponent& component) override {
+        if (trigger == Trigger::CHANGED) callback(entity, component);
+    }
+
+private:
+    Trigger trigger;    ///< Event to react to
+    Callback callback;  ///< Function to call
+};
+
+/**
+ * @class ComponentStorage
+ * @brief Set of component pools, one per component type
+ *
+ * Owned by a World. Entities attached to the storage keep their
+ * components in its pools and are identified inside it by a small
+ * recycled storage index.
+ *
+ * The storage also keeps the change tick. Components are stamped with
+ * it when added and when marked changed; a consumer calls
+ * captureChangeTick() and later asks for changes after that tick.
+ */
+class ComponentStorage {
+public:
+    ComponentStorage() = default;
+    ~ComponentStorage() = default;
+
+    ComponentStorage(const ComponentStorage&) = delete;
+    ComponentStorage& operator=(const ComponentStorage&) = delete;
+
+    /// Maximum number of distinct component types per storage
+    static constexpr std::size_t MAX_COMPONENT_TYPES = 256;
+
+    /**
+     * @brief Get pool for a type, creating it on first use
+     * @param type Component type ID
+     * @return Pool reference
+     */
+    ComponentPool& getPool(ComponentTypeId type);
+
+    /**
+     * @brief Get pool for a component class
+     * @tparam T Component type
+     * @return Pool reference
+     */
+    template<typename T>
+    ComponentPool& getPool() {
+        return getPool(componentTypeId<T>());
+    }
+
+    /**
+     * @brief Find pool for a type without creating it
+     * @param type Component type ID
+     * @return Pool or nullptr
+     */
+    ComponentPool* findPool(ComponentTypeId type) const {
+        return type < MAX_COMPONENT_TYPES ? pools[type].load(std::memory_order_acquire) : nullptr;
+    }
+
+    /**
+     * @brief Find pool for a component class without creating it
+     * @tparam T Component type
+     * @return Pool or nullptr
+     */
+    template<typename T>
+    ComponentPool* findPool() const {
+        return findPool(componentTypeId<T>());
+    }
+
+    /**
+     * @brief Get the current change tick
+     * @return Tick stamped on changes made now
+     */
+    std::uint32_t getChangeTick() const {
+        return change_tick.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get a tick to compare later changes against
+     * @return Current tick; every change made after this call is stamped
+     *         with a greater tick
+     */
+    std::uint32_t captureChangeTick() {
+        return change_tick.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Stamp a component as changed and inform listeners
+     * @param type Component type
+     * @param entity Owning entity
+     * @param index Entity storage index
+     * @param component Changed component
+     */
+    void markChanged(ComponentTypeId type, Entity& entity, std::uint32_t index,
+                     IComponent& component) {
+        ComponentPool* pool = findPool(type);
+        if (pool && pool->touch(index) && type < listeners.size()) {
+            for (ComponentListener* listener : listeners[type]) {
+                listener->onComponentChanged(entity, component);
+            }
+        }
+    }
+
+    /**
+     * @brief Reserve a storage index for a newly attached entity
+     * @return Storage index
+     */
+    std::uint32_t acquireIndex();
+
+    /**
+     * @brief Return a storage index once its entity is detached
+     * @param index Storage index to recycle
+     */
+    void releaseIndex(std::uint32_t index);
+
+    /**
+     * @brief Get number of pools created so far
+     * @return Pool count
+     */
+    std::size_t getPoolCount() const;
+
+    /**
+     * @brief Get a cached view, building it on first use
+     * @param id View ID
+     * @param signature Required component type IDs
+     * @return View cache reference
+     * @note Safe to call from systems running in parallel (view and
+     *       pool creation is locked).
+     */
+    ViewCache& getView(ViewId id, std::vector<ComponentTypeId> signature);
+
+    /**
+     * @brief Update cached views after an entity gained a component type
+     * @param type Added component type
+     * @param entity Entity that changed
+     * @param index Entity storage index
+     */
+    void notifyAdded(ComponentTypeId type, Entity* entity, std::uint32_t index);
+
+    /**
+     * @brief Update cached views after an entity lost a component type
+     * @param type Removed component type
+     * @param index Entity storage index
+     */
+    void notifyRemoved(ComponentTypeId type, std::uint32_t index);
+
+    /**
+     * @brief Register a listener for one component type
+     * @param type Component type ID
+     * @param listener Listener (must outlive registration)
+     */
+    void addListener(ComponentTypeId type, ComponentListener* listener);
+
+    /**
+     * @brief Unregister a listener
+     * @param type Component type ID
+     * @param listener Listener to remove
+     */
+    void removeListener(ComponentTypeId type, ComponentListener* listener);
+
+    /**
+     * @brief Inform listeners that a component was added or replaced
+     * @param type Component type
+     * @param entity Owning entity
+     * @param component New component
+     */
+    void notifySet(ComponentTypeId type, Entity& entity, IComponent& component) {
+        if (type < listeners.size()) {
+            for (ComponentListener* listener : listeners[type]) {
+                listener->onComponentSet(entity, component);
+            }
+        }
+    }
+
+    /**
+     * @brief Inform listeners that a component is about to be removed
+     * @param type Component type
+     * @param entity Owning entity
+     * @param component Component being removed
+     */
+    void notifyRemoving(ComponentTypeId type, Entity& entity, IComponent& component) {
+        if (type < listeners.size()) {
+            for (ComponentListener* listener : listeners[type]) {
+                listener->onComponentRemoved(entity, component);
+            }
+        }
+    }
+
+private:
+    /// Pools by type ID; fixed size so lookups never race with pool creation
+    std::array<std::atomic<ComponentPool*>, MAX_COMPONENT_TYPES> pools{};
+    std::vector<std::unique_ptr<ComponentPool>> owned_pools;  ///< Pool ownership
+    std::vector<std::unique_ptr<ViewCache>> views;      ///< Cached views by view ID
+    std::mutex view_mutex;                              ///< Guards lazy view and pool creation
+    std::atomic<std::uint32_t> change_tick{1};          ///< Current change tick
+    std::vector<std::vector<ViewCache*>> views_by_type; ///< Views depending on each type
+    std::vector<std::vector<ComponentListener*>> listeners; ///< Listeners by type ID
+    std::vector<std::uint32_t> free_indices;            ///< Recyclable storage indices
+    std::uint32_t next_index = 0;                       ///< Next fresh storage index
+
+    bool matches(const ViewCache& view, std::uint32_t index) const;
+    ComponentPool& createPool(ComponentTypeId type);  ///< Caller holds view_mutex
+};
+
+} // namespace ecs
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <memory>
@@ -31,7 +32,7 @@ struct MonsterTemplate {
     int hp;
     int attack;
     int defense;
-    int speed;
+    int speed = 100;
     int xp_value;
     int min_depth;
     int max_depth;
@@ -150,6 +151,12 @@ public:
      */
     bool isLoaded() const { return data_loaded; }
 
+    /**
+     * @brief Get data revision
+     * @return Counter bumped whenever templates are loaded or cleared
+     */
+    uint32_t getRevision() const { return revision; }
+
 private:
     DataLoader() = default;
     ~DataLoader() = default;
@@ -180,6 +187,7 @@ private:
     std::unordered_map<std::string, MonsterTemplate> monster_templates;
     std::unordered_map<std::string, ItemTemplate> item_templates;
     bool data_loaded = false;
+    uint32_t revision = 0;
 };
 
 } // namespace ecs
\ No newline at end of file
@@ -8,17 +8,16 @@
 #pragma once
 
 #include "component.h"
-#include <unordered_map>
+#include "component_storage.h"
+#include "entity_id.h"
 #include <unordered_set>
 #include <memory>
-#include <typeindex>
+#include <utility>
 #include <vector>
 #include <string>
 
 namespace ecs {
 
-using EntityID = uint64_t;
-
 /**
  * @class Entity
  * @brief Component container for game objects
@@ -26,20 +25,38 @@ using EntityID = uint64_t;
  * An entity is just an ID with a collection of components.
  * All behavior is implemented by systems that operate on
  * components, not in the entity itself.
+ *
+ * Components are indexed by their dense ComponentTypeId, so typed
+ * lookups are a single array access. A standalone entity owns its
+ * components on the heap; once added to a World the components are
+ * moved into the world's per-type pools. References obtained before
+ * the entity is added to a World are invalidated by that move.
  */
 class Entity {
+    friend class World;
+    friend class CommandBuffer;
+
 public:
     /**
-     * @brief Construct entity with unique ID
+     * @brief Construct entity without an ID
+     * @note The World it is added to assigns the ID.
      */
     Entity();
 
     /**
-     * @brief Construct entity with specific ID
-     * @param id Entity identifier
+     * @brief Construct entity with specific ID (e.g. one restored from a save)
+     * @param id Entity identifier, claimed by the World it is added to
      */
     explicit Entity(EntityID id);
 
+    /**
+     * @brief Destroy entity and all of its components
+     */
+    ~Entity();
+
+    Entity(const Entity&) = delete;
+    Entity& operator=(const Entity&) = delete;
+
     /**
      * @brief Get entity's unique identifier
      * @return Entity ID
@@ -55,10 +72,16 @@ public:
      */
     template<typename T, typename... Args>
     T& addComponent(Args&&... args) {
-        auto component = std::make_unique<T>(std::forward<Args>(args)...);
-        T& ref = *component;
-        components[component->getType()] = std::move(component);
-        return ref;
+        const ComponentTypeId type_id = componentTypeId<T>();
+        T* component = nullptr;
+        if (storage) {
+            component = storage->getPool(type_id).template emplace<T>(
+                this, storage_index, std::forward<Args>(args)...);
+        } else {
+            component = new T(std::forward<Args>(args)...);
+        }
+        setSlot(type_id, component);
+        return *component;
     }
 
     /**
@@ -67,6 +90,15 @@ public:
      */
     void addComponent(std::unique_ptr<IComponent> component);
 
+    /**
+     * @brief Add a copy of a component to this entity
+     * @param component Component to copy
+     *
+     * In a world the copy is constructed directly in the pool, with no
+     * intermediate heap allocation.
+     */
+    void copyComponent(const IComponent& component);
+
     /**
      * @brief Get a component by type
      * @tparam T Component type to retrieve
@@ -74,13 +106,7 @@ public:
      */
     template<typename T>
     T* getComponent() {
-        // Find by type
-        for (auto& [type, comp] : components) {
-            if (auto* typed = dynamic_cast<T*>(comp.get())) {
-                return typed;
-            }
-        }
-        return nullptr;
+        return static_cast<T*>(getSlot(componentTypeId<T>()));
     }
 
     /**
@@ -90,12 +116,7 @@ public:
      */
     template<typename T>
     const T* getComponent() const {
-        for (const auto& [type, comp] : components) {
-            if (auto* typed = dynamic_cast<const T*>(comp.get())) {
-                return typed;
-            }
-        }
-        return nullptr;
+        return static_cast<const T*>(getSlot(componentTypeId<T>()));
     }
 
     /**
@@ -113,7 +134,7 @@ public:
      */
     template<typename T>
     bool hasComponent() const {
-        return getComponent<T>() != nullptr;
+        return getSlot(componentTypeId<T>()) != nullptr;
     }
 
     /**
@@ -130,13 +151,7 @@ public:
      */
     template<typename T>
     bool removeComponent() {
-        for (auto it = components.begin(); it != components.end(); ++it) {
-            if (dynamic_cast<T*>(it->second.get())) {
-                components.erase(it);
-                return true;
-            }
-        }
-        return false;
+        return eraseSlot(componentTypeId<T>());
     }
 
     /**
@@ -146,17 +161,53 @@ public:
      */
     bool removeComponent(ComponentType type);
 
+    /**
+     * @brief Record that a component's data was modified
+     * @tparam T Component type
+     *
+     * Stamps the component with the world's current change tick so
+     * reactive queries (World::eachChanged()) and change observers see
+     * it. Call after writing to a component in place. No-op for
+     * entities not in a world.
+     */
+    template<typename T>
+    void markChanged() {
+        markChanged(componentTypeId<T>());
+    }
+
+    /**
+     * @brief Record that a component's data was modified
+     * @param type_id Component type ID
+     */
+    void markChanged(ComponentTypeId type_id);
+
+    /**
+     * @brief Get the tick at which a component was last changed
+     * @tparam T Component type
+     * @return Change tick, or 0 if absent or not in a world
+     */
+    template<typename T>
+    uint32_t getChangedTick() const {
+        const ComponentPool* pool = storage ? storage->findPool<T>() : nullptr;
+        return pool ? pool->getChangedTick(storage_index) : 0;
+    }
+
     /**
      * @brief Get all components
-     * @return Map of all components
+     * @return List of (type, component) pairs in type ID order
      */
-    const std::unordered_map<ComponentType, std::unique_ptr<IComponent>>&
-    getComponents() const { return components; }
+    std::vector<std::pair<ComponentType, IComponent*>> getComponents() const;
+
+    /**
+     * @brief Get number of attached components
+     * @return Component count
+     */
+    size_t getComponentCount() const { return component_count; }
 
     /**
      * @brief Clear all components from entity
      */
-    void clearComponents() { components.clear(); }
+    void clearComponents();
 
     /**
      * @brief Clone this entity (deep copy of all components)
@@ -168,7 +219,7 @@ public:
      * @brief Check if entity is valid (has any components)
      * @return true if entity has at least one component
      */
-    bool isValid() const { return !components.empty(); }
+    bool isValid() const { return component_count > 0; }
 
     /**
      * @brief Add a tag to this entity
@@ -198,11 +249,26 @@ public:
     const std::unordered_set<std::string>& getTags() const { return tags; }
 
 private:
-    static EntityID next_id;  ///< Next available entity ID
-    EntityID id;              ///< This entity's unique ID
+    EntityID id;              ///< Unique ID (INVALID_ENTITY_ID until added to a World)
 
-    std::unordered_map<ComponentType, std::unique_ptr<IComponent>> components;
+    ComponentStorage* storage = nullptr;  ///< World storage (nullptr while standalone)
+    uint32_t storage_index = 0;           ///< Index within storage pools
+    std::vector<IComponent*> slots;       ///< Components indexed by type ID
+    size_t component_count = 0;           ///< Number of non-null slots
     std::unordered_set<std::string> tags;  ///< Entity tags for categorization
+
+    /**
+     * @brief Move all components into a world's pools
+     * @param target Storage to attach to
+     */
+    void attach(ComponentStorage& target);
+
+    IComponent* getSlot(ComponentTypeId type_id) const {
+        return type_id < slots.size() ? slots[type_id] : nullptr;
+    }
+
+    void setSlot(ComponentTypeId type_id, IComponent* component);
+    bool eraseSlot(ComponentTypeId type_id);
 };
 
 } // namespace ecs
\ No newline at end of file
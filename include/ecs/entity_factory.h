@@ -18,7 +18,9 @@
 #include "stats_component.h"
 #include "ai_component.h"
 #include "loot_component.h"
+#include "light_component.h"
 #include "data_loader.h"
+#include "entity_prototype.h"
 #include "ai_system.h"
 #include "../color_scheme.h"
 #include <memory>
@@ -32,6 +34,9 @@ namespace ecs {
 /**
  * @class EntityFactory
  * @brief Factory for creating configured entities
+ *
+ * Entities are returned without an ID; the World they are added to
+ * allocates one.
  */
 class EntityFactory {
 public:
@@ -402,9 +407,10 @@ public:
 class MonsterFactoryECS {
 public:
     std::unique_ptr<Entity> create(const std::string& type, int x, int y) {
-        // Get monster template from DataLoader
-        const auto* template_data = DataLoader::getInstance().getMonsterTemplate(type);
-        if (!template_data) {
+        // Get compiled monster prototype
+        auto& registry = PrototypeRegistry::getInstance();
+        const auto* prototype = registry.get(registry.findMonster(type));
+        if (!prototype) {
             // Unknown type - create generic monster
             auto entity = EntityBuilder()
                 .withPosition(x, y)
@@ -417,56 +423,8 @@ public:
             return entity;
         }
 
-        // Create entity from template
-        auto entity = std::make_unique<Entity>();
-
-        // Position component
-        entity->addComponent<PositionComponent>(x, y);
-
-        // Renderable component
-        std::string glyph(1, template_data->glyph);
-        auto& renderable = entity->addComponent<RenderableComponent>(glyph, template_data->color);
-        renderable.name = template_data->name;
-
-        // Health component
-        entity->addComponent<HealthComponent>(template_data->hp, template_data->hp);
-
-        // Combat component - extract from JSON data
-        const auto* full_template = DataLoader::getInstance().getMonsterTemplate(type);
-        if (full_template) {
-            // Get combat stats from JSON
-            int min_damage = 1;
-            int max_damage = 4;
-            int attack_bonus = template_data->attack;
-            int defense_bonus = template_data->defense;
-
-            // Parse from original JSON if available
-            auto& combat = entity->addComponent<CombatComponent>(
-                (min_damage + max_damage) / 2,
-                attack_bonus,
-                defense_bonus
-            );
-            combat.setDamageRange(min_damage, max_damage);
-            combat.combat_name = template_data->name;
-        }
-
-        // AI component
-        auto& ai = entity->addComponent<AIComponent>();
-        ai.behavior = template_data->aggressive ? AIBehavior::AGGRESSIVE : AIBehavior::WANDERING;
-        ai.vision_range = 5;  // Default values
-        ai.aggro_range = 3;
-
-        // Loot component
-        auto& loot = entity->addComponent<LootComponent>();
-        loot.guaranteed_gold = 0;
-        loot.random_gold_max = template_data->xp_value / 2;  // Use XP as basis for gold
-        loot.experience_value = template_data->xp_value;
-
-        // Add tags
-        entity->addTag("monster");
-        entity->addTag(type);
-
-        return entity;
+        // Stamp from the compiled prototype
+        return prototype->instantiate(x, y);
     }
 
     std::unique_ptr<Entity> create(int x, int y) {
@@ -490,9 +448,10 @@ public:
 class ItemFactoryECS {
 public:
     std::unique_ptr<Entity> create(const std::string& type, int x, int y) {
-        // Get item template from DataLoader
-        const auto* template_data = DataLoader::getInstance().getItemTemplate(type);
-        if (!template_data) {
+        // Get compiled item prototype
+        auto& registry = PrototypeRegistry::getInstance();
+        const auto* prototype = registry.get(registry.findItem(type));
+        if (!prototype) {
             // Unknown item - create generic
             auto entity = EntityBuilder()
                 .withPosition(x, y)
@@ -506,66 +465,8 @@ public:
             return entity;
         }
 
-        // Create entity from template
-        auto entity = std::make_unique<Entity>();
-
-        // Position component
-        entity->addComponent<PositionComponent>(x, y);
-
-        // Renderable component
-        std::string glyph(1, template_data->symbol);
-        auto& renderable = entity->addComponent<RenderableComponent>(glyph, template_data->color);
-        renderable.name = template_data->name;
-
-        // Item component
-        auto& item_comp = entity->addComponent<ItemComponent>();
-        item_comp.name = template_data->name;
-        item_comp.description = template_data->description;
-        item_comp.value = template_data->value;
-        item_comp.weight = static_cast<float>(template_data->weight);
-        item_comp.max_stack = template_data->stackable ? template_data->max_stack : 1;
-        item_comp.stack_size = 1;
-
-        // Map item type string to enum
-        if (template_data->type == "weapon") {
-            item_comp.item_type = ItemType::WEAPON;
-            item_comp.equippable = true;
-            item_comp.min_damage = template_data->min_damage;
-            item_comp.max_damage = template_data->max_damage;
-            item_comp.attack_bonus = template_data->attack_bonus;
-        } else if (template_data->type == "armor") {
-            item_comp.item_type = ItemType::ARMOR;
-            item_comp.equippable = true;
-            item_comp.defense_bonus = template_data->defense_bonus;
-        } else if (template_data->type == "potion") {
-            item_comp.item_type = ItemType::POTION;
-            item_comp.consumable = true;
-            item_comp.heal_amount = template_data->heal_amount;
-        } else if (template_data->type == "scroll") {
-            item_comp.item_type = ItemType::SCROLL;
-            item_comp.consumable = true;
-            item_comp.damage_amount = template_data->damage_amount;
-        } else if (template_data->type == "food") {
-            item_comp.item_type = ItemType::FOOD;
-            item_comp.consumable = true;
-            item_comp.heal_amount = template_data->heal_amount;
-        } else if (template_data->type == "ring") {
-            item_comp.item_type = ItemType::RING;
-            item_comp.equippable = true;
-        } else if (template_data->type == "shield") {
-            item_comp.item_type = ItemType::SHIELD;
-            item_comp.equippable = true;
-            item_comp.defense_bonus = template_data->defense_bonus;
-        } else {
-            item_comp.item_type = ItemType::MISC;
-        }
-
-        // Add tags
-        entity->addTag("item");
-        entity->addTag(type);
-        entity->addTag(template_data->type);
-
-        return entity;
+        // Stamp from the compiled prototype
+        return prototype->instantiate(x, y);
     }
 
     std::unique_ptr<Entity> create(int x, int y) {
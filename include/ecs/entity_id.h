@@ -0,0 +1,127 @@
+/**
+ * @file entity_id.h
+ * @brief Generational entity identifiers and their allocator
+ * @author Veyrm Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace ecs {
+
+/**
+ * @brief Entity identifier
+ *
+ * Low 32 bits hold a slot index, high 32 bits the slot's generation.
+ * Slot 0 is reserved, so an ID of 0 never refers to an entity. When an
+ * entity is destroyed its slot is recycled with a bumped generation,
+ * which keeps stale IDs from matching the new occupant.
+ */
+using EntityID = uint64_t;
+
+/// ID value that never refers to an entity
+constexpr EntityID INVALID_ENTITY_ID = 0;
+
+/**
+ * @brief Build an entity ID from slot index and generation
+ * @param index Slot index
+ * @param generation Slot generation
+ * @return Combined entity ID
+ */
+constexpr EntityID makeEntityID(uint32_t index, uint32_t generation) {
+    return (static_cast<EntityID>(generation) << 32) | index;
+}
+
+/**
+ * @brief Get the slot index of an entity ID
+ * @param id Entity ID
+ * @return Slot index
+ */
+constexpr uint32_t entityIndex(EntityID id) {
+    return static_cast<uint32_t>(id & 0xFFFFFFFFu);
+}
+
+/**
+ * @brief Get the generation of an entity ID
+ * @param id Entity ID
+ * @return Slot generation
+ */
+constexpr uint32_t entityGeneration(EntityID id) {
+    return static_cast<uint32_t>(id >> 32);
+}
+
+/**
+ * @class EntityIdAllocator
+ * @brief Hands out generational entity IDs and recycles released slots
+ *
+ * Each World owns one allocator and hands out IDs as entities join it,
+ * so separate worlds number their entities independently. Released
+ * slots are reused FIFO once enough have accumulated, which spreads
+ * generation bumps out and keeps freshly freed IDs from being handed
+ * straight back. All operations are thread-safe, so systems running in
+ * parallel can reserve IDs through a shared CommandBuffer.
+ */
+class EntityIdAllocator {
+public:
+    /// Free slots kept in reserve before any is recycled
+    static constexpr size_t MIN_FREE_SLOTS = 1024;
+
+    EntityIdAllocator();
+
+    EntityIdAllocator(const EntityIdAllocator&) = delete;
+    EntityIdAllocator& operator=(const EntityIdAllocator&) = delete;
+
+    /**
+     * @brief Allocate a new entity ID
+     * @return Unused ID
+     */
+    EntityID allocate();
+
+    /**
+     * @brief Reserve a specific ID (e.g. one restored from a save)
+     * @param id ID to reserve
+     * @return true if reserved; false if its slot is in use, or if the
+     *         slot has moved past the ID's generation (the ID is stale)
+     */
+    bool claim(EntityID id);
+
+    /**
+     * @brief Release an ID so its slot can be recycled
+     * @param id ID to release (ignored if stale)
+     */
+    void release(EntityID id);
+
+    /**
+     * @brief Check if an ID is currently allocated
+     * @param id ID to check
+     * @return true if live
+     */
+    bool isAlive(EntityID id) const;
+
+    /**
+     * @brief Get number of live IDs
+     * @return Live count
+     */
+    size_t getAliveCount() const;
+
+    /**
+     * @brief Forget every ID and start numbering afresh
+     * @note Only safe once nothing holds an ID from this allocator that
+     *       it still means to use, since old IDs may be handed out again.
+     */
+    void reset();
+
+private:
+    mutable std::mutex mutex;                ///< Guards all state
+    std::vector<uint32_t> generations;       ///< Current generation per slot
+    std::vector<bool> alive;                 ///< Whether a slot is in use
+    std::vector<uint32_t> free_slots;        ///< Released slots (FIFO ring)
+    size_t free_head = 0;                    ///< Next slot to reuse
+    size_t alive_count = 0;                  ///< Live slots
+};
+
+} // namespace ecs
@@ -0,0 +1,218 @@
+/**
+ * @file entity_prototype.h
+ * @brief Precompiled monster and item prototypes for fast spawning
+ * @author Veyrm Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include "entity.h"
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ecs {
+
+// Forward declarations
+class World;
+class DataLoader;
+struct MonsterTemplate;
+struct ItemTemplate;
+
+/**
+ * @brief Interned identifier of a compiled prototype
+ *
+ * Indexes PrototypeRegistry directly; resolve a template ID once with
+ * findMonster()/findItem() and keep the integer.
+ */
+using PrototypeId = uint32_t;
+
+/// Returned when no prototype matches
+constexpr PrototypeId INVALID_PROTOTYPE_ID = std::numeric_limits<PrototypeId>::max();
+
+/**
+ * @class EntityPrototype
+ * @brief Ready-made component set an entity is stamped from
+ *
+ * Holds one fully configured instance of every component except
+ * PositionComponent. Instantiating copies those components and adds a
+ * position, so no template lookup or field-by-field setup happens per
+ * spawn.
+ */
+class EntityPrototype {
+public:
+    /**
+     * @brief Construct empty prototype
+     * @param template_id Template ID the prototype was compiled from
+     */
+    explicit EntityPrototype(std::string template_id) : template_id(std::move(template_id)) {}
+
+    /**
+     * @brief Add a component to the prototype
+     * @tparam T Component type
+     * @param args Arguments forwarded to component constructor
+     * @return Reference to the prototype's component for further setup
+     */
+    template<typename T, typename... Args>
+    T& addComponent(Args&&... args) {
+        auto component = std::make_unique<T>(std::forward<Args>(args)...);
+        T& ref = *component;
+        components.push_back(std::move(component));
+        return ref;
+    }
+
+    /**
+     * @brief Add a tag given to every instance
+     * @param tag Tag string
+     */
+    void addTag(const std::string& tag) { tags.push_back(tag); }
+
+    /**
+     * @brief Create a standalone entity
+     * @param x X position
+     * @param y Y position
+     * @return New entity (not in a world, so without an ID until added)
+     */
+    std::unique_ptr<Entity> instantiate(int x, int y) const;
+
+    /**
+     * @brief Create an entity directly in a world
+     * @param world Destination world
+     * @param x X position
+     * @param y Y position
+     * @return Reference to the new entity
+     *
+     * The ID comes from the world's allocator and components are
+     * copy-constructed straight into the world's pools.
+     */
+    Entity& instantiate(World& world, int x, int y) const;
+
+    /**
+     * @brief Get the template ID
+     * @return Template ID string
+     */
+    const std::string& getTemplateId() const { return template_id; }
+
+    /**
+     * @brief Get the prototype's components
+     * @return Components copied into each instance
+     */
+    const std::vector<std::unique_ptr<IComponent>>& getComponents() const { return components; }
+
+private:
+    std::string template_id;                             ///< Source template ID
+    std::vector<std::unique_ptr<IComponent>> components; ///< Configured components
+    std::vector<std::string> tags;                       ///< Tags for each instance
+
+    void stamp(Entity& entity, int x, int y) const;
+};
+
+/**
+ * @struct SpawnRequest
+ * @brief One entity to create in a batch spawn
+ */
+struct SpawnRequest {
+    PrototypeId prototype = INVALID_PROTOTYPE_ID;  ///< Prototype to instantiate
+    int x = 0;                                     ///< X position
+    int y = 0;                                     ///< Y position
+};
+
+/**
+ * @class PrototypeRegistry
+ * @brief Compiles DataLoader templates into prototypes and spawns them
+ *
+ * Prototypes are compiled the first time they are needed after the
+ * DataLoader's data changes, then reused for every spawn.
+ */
+class PrototypeRegistry {
+public:
+    /**
+     * @brief Get singleton instance
+     * @return Reference to PrototypeRegistry instance
+     */
+    static PrototypeRegistry& getInstance();
+
+    /**
+     * @brief Look up a monster prototype
+     * @param monster_id Monster template ID
+     * @return Prototype ID or INVALID_PROTOTYPE_ID
+     */
+    PrototypeId findMonster(std::string_view monster_id);
+
+    /**
+     * @brief Look up an item prototype
+     * @param item_id Item template ID
+     * @return Prototype ID or INVALID_PROTOTYPE_ID
+     */
+    PrototypeId findItem(std::string_view item_id);
+
+    /**
+     * @brief Get a prototype
+     * @param id Prototype ID
+     * @return Prototype or nullptr for an unknown ID
+     */
+    const EntityPrototype* get(PrototypeId id) const {
+        return id < prototypes.size() ? prototypes[id].get() : nullptr;
+    }
+
+    /**
+     * @brief Spawn a batch of entities into a world
+     * @param world Destination world
+     * @param requests Entities to create (unknown prototypes are skipped)
+     * @param customize Optional per-instance hook, e.g. for randomisation
+     * @return IDs of the created entities, in request order
+     */
+    std::vector<EntityID> spawnBatch(World& world, const std::vector<SpawnRequest>& requests,
+                                     const std::function<void(Entity&)>& customize = {});
+
+    /**
+     * @brief Recompile all prototypes from a data loader
+     * @param loader Source of monster and item templates
+     */
+    void compile(const DataLoader& loader);
+
+    /**
+     * @brief Get number of compiled prototypes
+     * @return Prototype count
+     */
+    size_t size() const { return prototypes.size(); }
+
+private:
+    PrototypeRegistry() = default;
+    PrototypeRegistry(const PrototypeRegistry&) = delete;
+    PrototypeRegistry& operator=(const PrototypeRegistry&) = delete;
+
+    /// Heterogeneous hash so string_view lookups need no temporary string
+    struct NameHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view name) const {
+            return std::hash<std::string_view>{}(name);
+        }
+    };
+
+    using NameMap = std::unordered_map<std::string, PrototypeId, NameHash, std::equal_to<>>;
+
+    std::vector<std::unique_ptr<EntityPrototype>> prototypes; ///< Prototypes by ID
+    NameMap monster_ids;                                      ///< Monster template ID -> prototype
+    NameMap item_ids;                                         ///< Item template ID -> prototype
+    uint32_t compiled_revision = 0;                           ///< DataLoader revision compiled from
+    bool compiled = false;                                    ///< Whether compile() has run
+
+    /**
+     * @brief Recompile if the DataLoader has new data
+     */
+    void ensureCompiled();
+
+    static PrototypeId find(const NameMap& ids, std::string_view name);
+
+    static std::unique_ptr<EntityPrototype> compileMonster(const MonsterTemplate& data);
+    static std::unique_ptr<EntityPrototype> compileItem(const ItemTemplate& data);
+};
+
+} // namespace ecs
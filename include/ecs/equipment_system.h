@@ -125,6 +125,15 @@ public:
 
     int getPriority() const override { return 30; }
 
+    /**
+     * @brief Get declared access
+     * @return Applies bonuses of equipped items to stats and combat
+     */
+    SystemAccess getAccess() const override {
+        return SystemAccess().read<EquipmentComponent, ItemComponent>()
+                             .write<StatsComponent, CombatComponent>();
+    }
+
     bool shouldProcess(const Entity& entity) const override {
         return entity.hasComponent<EquipmentComponent>();
     }
@@ -7,10 +7,16 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <span>
 #include <vector>
 #include <functional>
 #include <string>
+#include <string_view>
 #include "entity.h"
 
 namespace ecs {
@@ -34,9 +40,50 @@ enum class EventType {
     CUSTOM
 };
 
+/// Number of EventType values
+constexpr size_t EVENT_TYPE_COUNT = static_cast<size_t>(EventType::CUSTOM) + 1;
+
+/**
+ * @class EventText
+ * @brief Non-owning event text that never allocates per event
+ *
+ * Holds a string literal, which lives for the rest of the program, so
+ * events can be copied and queued freely without carrying a heap string.
+ */
+class EventText {
+public:
+    constexpr EventText() = default;
+
+    /**
+     * @brief Wrap a string literal
+     * @param literal Null-terminated character array with static storage
+     *
+     * Evaluated at compile time, so a local buffer, whose view would
+     * dangle once it goes out of scope, is rejected.
+     */
+    template<size_t N>
+    consteval EventText(const char (&literal)[N]) : text(literal, N - 1) {}
+
+    /** @brief Get the text @return View of the text */
+    constexpr std::string_view view() const { return text; }
+
+    /** @brief Check if empty @return true if no text */
+    constexpr bool empty() const { return text.empty(); }
+
+    /** @brief Convert to std::string @return Copy of the text */
+    std::string str() const { return std::string(text); }
+
+    bool operator==(std::string_view other) const { return text == other; }
+
+private:
+    std::string_view text;  ///< Literal storage
+};
+
 /**
  * @struct BaseEvent
  * @brief Base event data
+ *
+ * Trivially copyable, so queuing an event never allocates.
  */
 struct BaseEvent {
     EventType type;
@@ -44,22 +91,167 @@ struct BaseEvent {
     EntityID target_id = 0;
     int value1 = 0;
     int value2 = 0;
-    std::string text;
+    EventText text;
     double timestamp = 0.0;
 
-    BaseEvent(EventType t, EntityID src = 0, EntityID tgt = 0)
+    BaseEvent(EventType t = EventType::CUSTOM, EntityID src = 0, EntityID tgt = 0)
         : type(t), source_id(src), target_id(tgt) {}
 };
 
 // Event handler function type
 using EventHandler = std::function<void(const BaseEvent&)>;
 
+/// Handler taking every queued event of one type at once, oldest first
+using EventBatchHandler = std::function<void(std::span<const BaseEvent>)>;
+
+/// Handle returned by EventSystem::subscribe()
+using SubscriptionId = uint32_t;
+
+/**
+ * @class EventRing
+ * @brief Growable FIFO ring of events
+ *
+ * Storage is kept between frames, so once it has grown to the busiest
+ * turn's size, pushing and draining never allocate.
+ */
+class EventRing {
+public:
+    /**
+     * @brief Append an event
+     * @param event Event to queue
+     */
+    void push(const BaseEvent& event) {
+        if (count == slots.size()) {
+            grow();
+        }
+        slots[(head + count) & (slots.size() - 1)] = event;
+        ++count;
+    }
+
+    /**
+     * @brief Get the oldest event
+     * @return Front event (ring must not be empty)
+     */
+    const BaseEvent& front() const { return slots[head]; }
+
+    /**
+     * @brief Drop the oldest event
+     */
+    void pop() {
+        head = (head + 1) & (slots.size() - 1);
+        --count;
+    }
+
+    /** @brief Get queued event count @return Event count */
+    size_t size() const { return count; }
+
+    /** @brief Get allocated slot count @return Capacity */
+    size_t capacity() const { return slots.size(); }
+
+    /** @brief Drop all queued events (keeps storage) */
+    void clear() {
+        head = 0;
+        count = 0;
+    }
+
+    /**
+     * @brief View the queued events as one contiguous span
+     * @return Events, oldest first
+     *
+     * Rotates the storage first if the events wrap around its end. The
+     * span is valid until the ring is next modified.
+     */
+    std::span<const BaseEvent> view();
+
+    /**
+     * @brief Exchange contents and storage with another ring
+     * @param other Ring to swap with
+     */
+    void swap(EventRing& other) noexcept {
+        slots.swap(other.slots);
+        std::swap(head, other.head);
+        std::swap(count, other.count);
+    }
+
+private:
+    std::vector<BaseEvent> slots;  ///< Power-of-two sized storage
+    size_t head = 0;               ///< Index of the oldest event
+    size_t count = 0;              ///< Queued events
+
+    void grow();
+};
+
+/**
+ * @class EventMailbox
+ * @brief Bounded lock-free multi-producer single-consumer event queue
+ *
+ * Lets background threads (cloud sync, database) hand events to the
+ * game thread without a mutex. Each slot carries a sequence number that
+ * tells producers and the consumer whose turn it is.
+ */
+class EventMailbox {
+public:
+    /**
+     * @brief Construct mailbox
+     * @param capacity Slot count (rounded up to a power of two)
+     */
+    explicit EventMailbox(size_t capacity);
+
+    EventMailbox(const EventMailbox&) = delete;
+    EventMailbox& operator=(const EventMailbox&) = delete;
+
+    /**
+     * @brief Enqueue an event (any thread)
+     * @param event Event to enqueue
+     * @return false if the mailbox is full
+     */
+    bool push(const BaseEvent& event);
+
+    /**
+     * @brief Dequeue an event (consumer thread only)
+     * @param event Receives the event
+     * @return false if the mailbox is empty
+     */
+    bool pop(BaseEvent& event);
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence{0};  ///< Turn marker for this slot
+        BaseEvent event;                  ///< Payload
+    };
+
+    std::unique_ptr<Cell[]> cells;        ///< Slots
+    size_t mask;                          ///< Capacity - 1
+    std::atomic<size_t> enqueue_pos{0};   ///< Next slot for producers
+    size_t dequeue_pos = 0;               ///< Next slot for the consumer
+};
+
 /**
  * @class EventSystem
- * @brief Simple event system for ECS
+ * @brief Event bus for ECS
+ *
+ * Events are queued in one ring and dispatched by update() in emission
+ * order, across types: a DROP emitted before a PICKUP is delivered first.
+ *
+ * Batch handlers (subscribeBatch()) receive all of a type's events at
+ * once, gathered into a span per type before any per-event handler runs;
+ * per-event handlers are then called event by event, each event going to
+ * every handler of its type in turn.
+ *
+ * Events emitted by handlers during update() are delivered on the next
+ * update(). Handlers may subscribe, unsubscribe (themselves included) or
+ * reset() while being dispatched: removals take effect at once but the
+ * handler entries are only dropped after dispatch ends, and new handlers
+ * join from the next update(). A nested update() from a handler does
+ * nothing. emit() and update() belong to the game thread; other
+ * threads use post(), which goes through a lock-free mailbox drained at
+ * the start of update().
  */
 class EventSystem {
 public:
+    /// Capacity of the cross-thread mailbox
+    static constexpr size_t MAILBOX_CAPACITY = 1024;
+
     static EventSystem& getInstance() {
         static EventSystem instance;
         return instance;
@@ -69,55 +261,108 @@ public:
      * @brief Subscribe to an event type
      * @param type Event type
      * @param handler Handler function
+     * @return Subscription handle for unsubscribe()
      */
-    void subscribe(EventType type, EventHandler handler) {
-        handlers[static_cast<int>(type)].push_back(handler);
-    }
+    SubscriptionId subscribe(EventType type, EventHandler handler);
+
+    /**
+     * @brief Subscribe to all of an update's events of one type at once
+     * @param type Event type
+     * @param handler Handler called once per update with the type's events
+     * @return Subscription handle for unsubscribe()
+     */
+    SubscriptionId subscribeBatch(EventType type, EventBatchHandler handler);
+
+    /**
+     * @brief Remove a handler
+     * @param type Event type it was subscribed to
+     * @param id Handle returned by subscribe()
+     */
+    void unsubscribe(EventType type, SubscriptionId id);
 
     /**
-     * @brief Emit an event
+     * @brief Emit an event (game thread)
      * @param event Event to emit
      */
     void emit(const BaseEvent& event) {
-        event_queue.push_back(event);
+        queue.push(event);
+        ++queued_counts[static_cast<size_t>(event.type)];
+    }
+
+    /**
+     * @brief Emit an event from any thread
+     * @param event Event to emit
+     * @return false if the mailbox is full and the event was dropped
+     */
+    bool post(const BaseEvent& event) {
+        return mailbox.push(event);
     }
 
     /**
      * @brief Process all queued events
      */
-    void update() {
-        auto queue = event_queue;
-        event_queue.clear();
+    void update();
 
-        for (const auto& event : queue) {
-            auto& type_handlers = handlers[static_cast<int>(event.type)];
-            for (const auto& handler : type_handlers) {
-                handler(event);
-            }
-        }
+    /**
+     * @brief Get number of queued events of one type
+     * @param type Event type
+     * @return Queued count (posted events not yet drained excluded)
+     */
+    size_t getQueuedCount(EventType type) const {
+        return queued_counts[static_cast<size_t>(type)];
     }
 
+    /**
+     * @brief Drop all queued events and handlers
+     */
+    void reset();
+
 private:
-    EventSystem() = default;
-    std::vector<std::vector<EventHandler>> handlers{static_cast<size_t>(EventType::CUSTOM) + 1};
-    std::vector<BaseEvent> event_queue;
+    EventSystem() : mailbox(MAILBOX_CAPACITY) {}
+
+    struct Subscription {
+        SubscriptionId id;      ///< Handle
+        EventHandler handler;   ///< Callback
+        bool active = true;     ///< False once unsubscribed
+    };
+
+    struct BatchSubscription {
+        SubscriptionId id;           ///< Handle
+        EventBatchHandler handler;   ///< Callback
+        bool active = true;          ///< False once unsubscribed
+    };
+
+    /// Drop unsubscribed handlers and add those subscribed while dispatching
+    void endDispatch();
+
+    std::vector<std::vector<Subscription>> handlers{EVENT_TYPE_COUNT};  ///< Handlers by type
+    std::vector<std::vector<BatchSubscription>> batch_handlers{EVENT_TYPE_COUNT};  ///< Batch handlers by type
+    EventRing queue;                                                    ///< Queued events, in emission order
+    EventRing dispatching;                                              ///< Events being dispatched
+    std::vector<EventRing> batches{EVENT_TYPE_COUNT};                   ///< Dispatched events by type, for batch handlers
+    std::array<size_t, EVENT_TYPE_COUNT> queued_counts{};               ///< Queued events by type
+    std::vector<std::pair<EventType, Subscription>> added_handlers;     ///< Subscribed while dispatching
+    std::vector<std::pair<EventType, BatchSubscription>> added_batch_handlers;  ///< Batch-subscribed while dispatching
+    EventMailbox mailbox;                                               ///< Cross-thread events
+    SubscriptionId next_subscription = 1;                               ///< Next handle
+    bool in_dispatch = false;                                           ///< update() is calling handlers
 };
 
 // Convenience functions for creating events
-inline BaseEvent DamageEvent(EntityID source, EntityID target, int damage, const std::string& text = "") {
+inline BaseEvent DamageEvent(EntityID source, EntityID target, int damage, EventText text = {}) {
     BaseEvent e(EventType::DAMAGE, source, target);
     e.value1 = damage;
     e.text = text;
     return e;
 }
 
-inline BaseEvent DeathEvent(EntityID entity, EntityID killer = 0, const std::string& text = "") {
+inline BaseEvent DeathEvent(EntityID entity, EntityID killer = 0, EventText text = {}) {
     BaseEvent e(EventType::DEATH, entity, killer);
     e.text = text;
     return e;
 }
 
-inline BaseEvent AttackEvent(EntityID attacker, EntityID target, const std::string& text = "") {
+inline BaseEvent AttackEvent(EntityID attacker, EntityID target, EventText text = {}) {
     BaseEvent e(EventType::ATTACK, attacker, target);
     e.text = text;
     return e;
@@ -141,4 +386,4 @@ inline BaseEvent UseItemEvent(EntityID user, EntityID item, EntityID target = 0)
     return e;
 }
 
-} // namespace ecs
\ No newline at end of file
+} // namespace ecs
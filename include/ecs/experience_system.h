@@ -104,6 +104,12 @@ public:
 
     int getPriority() const override { return 35; }
 
+    /**
+     * @brief Get declared access
+     * @return Nothing; experience is awarded outside update
+     */
+    SystemAccess getAccess() const override { return SystemAccess::none(); }
+
     bool shouldProcess(const Entity& entity) const override {
         return entity.hasComponent<ExperienceComponent>();
     }
@@ -13,6 +13,9 @@
 #include <string>
 
 #include "system_manager.h"
+#include "spatial_index.h"
+#include "event.h"
+#include "entity_prototype.h"
 #include "../log.h"
 #include "health_component.h"
 // Bridge classes removed - no longer needed in full ECS mode
@@ -22,6 +25,7 @@
 class MessageLog;
 class CombatSystem;
 class Map;
+class ThreadPool;
 
 // Only now open the namespace
 namespace ecs {
@@ -33,6 +37,7 @@ class RenderSystem;
 class CombatSystem;
 class AISystem;
 class InventorySystem;
+class LightSystem;
 class HealthComponent;
 
 /**
@@ -62,8 +67,13 @@ public:
     void initialize(bool migrate_existing = true);
 
     /**
-     * @brief Update all ECS systems
+     * @brief Run the world turn through the system scheduler
      * @param delta_time Time since last update (seconds)
+     *
+     * Called once per player action, after the monsters it gave time to
+     * have acted. Systems driven directly by the turn (AI, equipment) are
+     * disabled in the schedule; the rest run concurrently where their
+     * declared access allows.
      */
     void update(double delta_time);
 
@@ -73,6 +83,13 @@ public:
      */
     void updateRenderSystem();
 
+    /**
+     * @brief Bring the light map up to date outside a full update
+     * @return true if any light level changed
+     * @note Used before recomputing visibility, which reads the light map
+     */
+    bool updateLights();
+
     /**
      * @brief Create player entity using ECS
      * @param x Initial X position
@@ -104,6 +121,13 @@ public:
      */
     EntityID createItem(const std::string& type, int x, int y);
 
+    /**
+     * @brief Create many monsters and items at once
+     * @param requests Prototypes and positions (see PrototypeRegistry)
+     * @return IDs of the created entities, in request order
+     */
+    std::vector<EntityID> spawnBatch(const std::vector<SpawnRequest>& requests);
+
     /**
      * @brief Get entity by ID
      * @param id Entity ID
@@ -137,9 +161,19 @@ public:
     ActionSpeed processPlayerAction(int action, int dx = 0, int dy = 0);
 
     /**
-     * @brief Process AI for all monsters
+     * @brief Process AI for the monsters whose turn has come
+     * @param actors Monsters due at the current world time, in turn order
      */
-    void processMonsterAI();
+    void processMonsterAI(const std::vector<EntityID>& actors);
+
+    /**
+     * @brief Give monsters turns from a turn manager
+     * @param turns Turn manager (nullptr to disconnect)
+     *
+     * Entities gaining or losing an AIComponent join or leave the
+     * schedule as it happens, at their AIComponent speed.
+     */
+    void setTurnManager(::TurnManager* turns);
 
     /**
      * @brief Update field of view
@@ -175,6 +209,12 @@ public:
      */
     RenderSystem* getRenderSystem();
 
+    /**
+     * @brief Get light system
+     * @return Light system pointer
+     */
+    LightSystem* getLightSystem();
+
     // Entity bridge removed - no longer needed in full ECS mode
 
     /**
@@ -218,11 +258,9 @@ public:
 
     /**
      * @brief Clear all entities
+     * @note Their turns are dropped from the turn manager as well
      */
-    void clearEntities() {
-        world.clearEntities();
-        player_id = 0; // Reset player ID when clearing entities
-    }
+    void clearEntities();
 
     /**
      * @brief Add an entity and update player tracking if needed
@@ -254,7 +292,21 @@ public:
         return health && health->hp <= 0;
     }
 
+    /**
+     * @brief Get tile occupancy index of positioned entities
+     * @return Spatial index reference
+     */
+    SpatialIndex& getSpatialIndex() { return spatial_index; }
+
+    /**
+     * @brief Get worker pool (created when parallel systems or pathfinding are enabled)
+     * @return Thread pool or nullptr
+     */
+    ::ThreadPool* getThreadPool() { return thread_pool.get(); }
+
 private:
+    std::unique_ptr<::ThreadPool> thread_pool;  ///< Workers for parallel system updates and path searches
+    SpatialIndex spatial_index;  ///< Entity-by-tile index (declared before world: outlives it)
     World world;                                          ///< ECS world container
     // Bridge members removed - no longer needed in full ECS mode
 
@@ -268,6 +320,10 @@ private:
     Map* game_map;                   ///< Game map
 
     EntityID player_id = 0;  ///< Player entity ID
+    ::TurnManager* turn_manager = nullptr;          ///< Schedules monster turns (not owned)
+    ComponentObserver* actor_added = nullptr;       ///< Adds AI entities to turn_manager
+    ComponentObserver* actor_removed = nullptr;     ///< Removes them again
+    SubscriptionId drop_subscription = 0;  ///< DROP handler (removed on destruction)
     bool player_died = false;  ///< Flag set when player dies
 
     /**
@@ -133,6 +133,12 @@ public:
      */
     int getPriority() const override { return 5; }
 
+    /**
+     * @brief Get declared access
+     * @return Exclusive: commands move, attack and pick up items directly
+     */
+    SystemAccess getAccess() const override { return SystemAccess(); }
+
     /**
      * @brief Check if system should process entity
      * @param entity Entity to check
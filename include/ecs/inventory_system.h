@@ -107,6 +107,15 @@ public:
      */
     int getPriority() const override { return 40; }
 
+    /**
+     * @brief Get declared access
+     * @return Recomputes carried weight from the items held
+     */
+    SystemAccess getAccess() const override {
+        return SystemAccess().read<PositionComponent, ItemComponent>()
+                             .write<InventoryComponent>();
+    }
+
     /**
      * @brief Check if system should process entity
      * @param entity Entity to check
@@ -119,6 +128,7 @@ public:
 private:
     [[maybe_unused]] Map* map;          ///< Game map
     ILogger* logger;                    ///< Logger interface
+    std::vector<std::pair<EventType, SubscriptionId>> subscriptions; ///< Event handlers to remove on destruction
 
     /**
      * @brief Handle pickup event
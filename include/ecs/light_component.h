@@ -0,0 +1,43 @@
+/**
+ * @file light_component.h
+ * @brief Light source component
+ * @author Veyrm Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include "component.h"
+#include "../color_scheme.h"
+#include "../light_map.h"
+
+namespace ecs {
+
+/**
+ * @class LightComponent
+ * @brief Makes an entity a light source
+ *
+ * Read by LightSystem, which keeps the shared LightMap in step with
+ * every lit entity's position and settings. Call
+ * Entity::markChanged<LightComponent>() after editing the fields.
+ */
+class LightComponent : public Component<LightComponent> {
+public:
+    int radius = 5;                           ///< Reach in tiles
+    int intensity = LightMap::MAX_LEVEL;      ///< Level at the source tile
+    ftxui::Color color = ftxui::Color::RGB(255, 255, 200);  ///< Light tint
+    bool is_lit = true;                       ///< Whether the light is on
+
+    /**
+     * @brief Construct light component
+     * @param radius Reach in tiles
+     * @param intensity Level at the source tile
+     */
+    explicit LightComponent(int radius = 5, int intensity = LightMap::MAX_LEVEL)
+        : radius(radius), intensity(intensity) {}
+
+    ComponentType getType() const override { return ComponentType::CUSTOM; }
+    std::string getTypeName() const override { return "LightComponent"; }
+};
+
+} // namespace ecs
@@ -0,0 +1,102 @@
+/**
+ * @file light_system.h
+ * @brief System keeping the light map in step with light entities
+ * @author Veyrm Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include "system.h"
+#include "position_component.h"
+#include "light_component.h"
+#include "../light_map.h"
+#include <vector>
+
+class Map;
+
+namespace ecs {
+
+/**
+ * @class LightSystem
+ * @brief Feeds entities with position and light components into a LightMap
+ *
+ * Lights are re-registered only when a position or light component
+ * changed since the previous update; the LightMap then recasts just the
+ * lights that moved or changed, plus those near tiles whose
+ * transparency changed. Unchanged torches cost nothing per turn.
+ *
+ * @see LightMap
+ */
+class LightSystem : public System<LightSystem> {
+public:
+    /**
+     * @brief Construct light system
+     * @param map Map the lights shine on
+     */
+    explicit LightSystem(Map* map = nullptr) : game_map(map) {}
+
+    /**
+     * @brief Rebuild the light map from an entity list
+     * @param entities All entities
+     * @param delta_time Time since last update
+     */
+    void update(const std::vector<std::unique_ptr<Entity>>& entities,
+                double delta_time) override;
+
+    /**
+     * @brief Bring the light map up to date from world queries
+     * @param world World holding the lights
+     * @param delta_time Time since last update
+     */
+    void update(World& world, double delta_time) override;
+
+    bool shouldProcess(const Entity& entity) const override {
+        return entity.hasComponent<PositionComponent>() &&
+               entity.hasComponent<LightComponent>();
+    }
+
+    std::string getName() const override { return "LightSystem"; }
+
+    /**
+     * @brief Get execution priority
+     * @return Priority value (85 = after movement, before rendering)
+     */
+    int getPriority() const override { return 85; }
+
+    /**
+     * @brief Get declared access
+     * @return Reads position and light components and the map, advances the change tick
+     */
+    SystemAccess getAccess() const override {
+        return SystemAccess().read<PositionComponent, LightComponent>()
+                             .readResource(SystemResource::MAP)
+                             .writeResource(SystemResource::CHANGE_TICK);
+    }
+
+    /// Accumulated light levels
+    const LightMap& getLightMap() const { return light_map; }
+
+    /// Whether the last update changed any light level
+    bool levelsChanged() const { return levels_changed; }
+
+    /**
+     * @brief Set the game map
+     * @param map New map reference
+     */
+    void setMap(Map* map) { game_map = map; }
+
+private:
+    Map* game_map;                        ///< Map the lights shine on
+    LightMap light_map;                   ///< Accumulated light levels
+    uint32_t sync_tick = 0;               ///< Change tick of the last sync
+    bool synced = false;                  ///< Whether lights were registered once
+    bool levels_changed = false;          ///< Result of the last update
+    std::vector<LightMap::LightId> live;  ///< Scratch: lights seen this sync
+
+    void registerLight(Entity& entity, const PositionComponent& pos,
+                       const LightComponent& light);
+    void finishUpdate();
+};
+
+} // namespace ecs
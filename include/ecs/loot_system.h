@@ -69,6 +69,12 @@ public:
 
     int getPriority() const override { return 45; }
 
+    /**
+     * @brief Get declared access
+     * @return Nothing; loot is generated outside update
+     */
+    SystemAccess getAccess() const override { return SystemAccess::none(); }
+
     bool shouldProcess(const Entity& entity) const override {
         return entity.hasComponent<LootComponent>();
     }
@@ -9,6 +9,8 @@
 
 #include "system.h"
 #include "position_component.h"
+#include "combat_component.h"
+#include "spatial_index.h"
 #include "../map.h"
 #include <memory>
 #include <queue>
@@ -126,12 +128,35 @@ public:
      */
     int getPriority() const override { return 10; }
 
+    /**
+     * @brief Get declared access
+     * @return Drains the move queue, moving positions and the spatial index
+     */
+    SystemAccess getAccess() const override {
+        return SystemAccess().read<CombatComponent>()
+                             .write<PositionComponent>()
+                             .readResource(SystemResource::MAP)
+                             .writeResource(SystemResource::SPATIAL | SystemResource::ACTIONS);
+    }
+
     /**
      * @brief Set the game map
      * @param map New map reference
      */
     void setMap(Map* map) { game_map = map; }
 
+    /**
+     * @brief Set world for O(1) entity lookups
+     * @param w World owning the entities (nullptr to scan the entity list)
+     */
+    void setWorld(World* w) { this->world = w; }
+
+    /**
+     * @brief Set spatial index kept in sync with moves
+     * @param index Index used for blocking checks (nullptr to scan entities)
+     */
+    void setSpatialIndex(SpatialIndex* index) { spatial_index = index; }
+
     /**
      * @brief Clear all queued movements
      */
@@ -144,6 +169,8 @@ public:
 private:
     Map* game_map;                      ///< Map for collision checking
     std::queue<MoveCommand> move_queue; ///< Pending movement commands
+    World* world = nullptr;             ///< World for entity lookups
+    SpatialIndex* spatial_index = nullptr; ///< Entity-by-tile index
 
     /**
      * @brief Process all queued movement commands
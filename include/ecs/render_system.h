@@ -52,6 +52,16 @@ public:
     void update(const std::vector<std::unique_ptr<Entity>>& entities,
                 double delta_time) override;
 
+    /**
+     * @brief Update render data cache from world queries
+     * @param world World being rendered
+     * @param delta_time Time since last update
+     *
+     * Skips the rebuild when no position or renderable component was
+     * added, removed or marked changed since the previous call.
+     */
+    void update(World& world, double delta_time) override;
+
     /**
      * @brief Check if entity can be rendered
      * @param entity Entity to check
@@ -118,6 +128,7 @@ public:
      */
     void clearCache() {
         render_cache.clear();
+        cache_valid = false;
     }
 
     /**
@@ -132,6 +143,15 @@ public:
      */
     int getPriority() const override { return 90; }
 
+    /**
+     * @brief Get declared access
+     * @return Reads position and renderable components, advances the change tick
+     */
+    SystemAccess getAccess() const override {
+        return SystemAccess().read<PositionComponent, RenderableComponent>()
+                             .writeResource(SystemResource::CHANGE_TICK);
+    }
+
     /**
      * @brief Set the game map
      * @param map New map reference
@@ -148,6 +168,15 @@ private:
     Map* game_map;                                ///< Map for bounds checking
     std::vector<RenderData> render_cache;         ///< Cached render data
     std::vector<std::vector<bool>> field_of_view; ///< Current FOV
+    uint32_t cache_tick = 0;                      ///< Change tick the cache was built at
+    bool cache_valid = false;                     ///< Cache built from a World
+
+    /**
+     * @brief Append render data for a visible entity
+     * @param pos Entity position
+     * @param render Entity renderable
+     */
+    void cacheEntity(const PositionComponent& pos, const RenderableComponent& render);
 
     /**
      * @brief Sort render cache by position and priority
@@ -19,6 +19,8 @@ namespace ecs {
  *
  * This component stores all data needed to render an entity
  * including its glyph (character), color, and visibility state.
+ * RenderSystem caches it, so call
+ * Entity::markChanged<RenderableComponent>() after editing the fields.
  */
 class RenderableComponent : public Component<RenderableComponent> {
 public:
@@ -41,12 +43,6 @@ public:
         return "RenderableComponent";
     }
 
-    /**
-     * @brief Set visibility state
-     * @param visible Whether entity should be rendered
-     */
-    void setVisible(bool visible) { is_visible = visible; }
-
     /**
      * @brief Check if entity is visible
      * @return true if entity should be rendered
@@ -0,0 +1,244 @@
+/**
+ * @file spatial_index.h
+ * @brief Tile occupancy index for positioned entities
+ * @author Veyrm Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include "entity.h"
+#include "component_storage.h"
+#include "../point.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace ecs {
+
+/**
+ * @class SpatialIndex
+ * @brief Answers "which entities are at/near this tile" without scanning
+ *
+ * Two layers are kept in sync:
+ * - a per-tile occupancy grid (intrusive list per tile) for point queries
+ * - a coarse grid of BUCKET_SIZE x BUCKET_SIZE buckets for rectangle and
+ *   radius queries, which skip empty buckets entirely
+ *
+ * Registered as a ComponentListener for PositionComponent, so entities
+ * are inserted and removed as their position component comes and goes.
+ * Position changes must go through move() (MovementSystem does this).
+ * The grid grows to fit non-negative coordinates; entities at negative
+ * coordinates are kept in a small overflow list.
+ */
+class SpatialIndex : public ComponentListener {
+public:
+    /// Side length of a coarse bucket in tiles
+    static constexpr int BUCKET_SIZE = 16;
+
+    /**
+     * @brief Construct index sized for a map
+     * @param width Map width in tiles
+     * @param height Map height in tiles
+     */
+    explicit SpatialIndex(int width = 0, int height = 0);
+
+    /**
+     * @brief Resize the grid (existing entries are kept)
+     * @param width New width in tiles
+     * @param height New height in tiles
+     */
+    void resize(int width, int height);
+
+    /**
+     * @brief Add an entity, or move it if already indexed
+     * @param entity Entity to index
+     * @param pos Entity position
+     */
+    void insert(Entity& entity, const Point& pos);
+
+    /**
+     * @brief Remove an entity
+     * @param id Entity ID
+     */
+    void remove(EntityID id);
+
+    /**
+     * @brief Update an indexed entity's position
+     * @param id Entity ID
+     * @param pos New position
+     */
+    void move(EntityID id, const Point& pos);
+
+    /**
+     * @brief Check if an entity is indexed
+     * @param id Entity ID
+     * @return true if indexed
+     */
+    bool contains(EntityID id) const;
+
+    /**
+     * @brief Remove all entries
+     */
+    void clear();
+
+    /**
+     * @brief Get number of indexed entities
+     * @return Entity count
+     */
+    size_t size() const { return count; }
+
+    /**
+     * @brief Visit entities on a tile
+     * @param x Tile X
+     * @param y Tile Y
+     * @param func Callable taking Entity*; return true to stop early
+     * @return Entity that stopped the visit, or nullptr
+     */
+    template<typename Func>
+    Entity* findAt(int x, int y, Func&& func) const {
+        if (!inGrid(x, y)) {
+            return findInOverflow(x, y, x, y, func);
+        }
+        for (uint32_t node = tile_heads[tileIndex(x, y)]; node != NONE; node = nodes[node].tile_next) {
+            if (func(nodes[node].entity)) {
+                return nodes[node].entity;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Visit entities inside an inclusive rectangle
+     * @param x0 Left
+     * @param y0 Top
+     * @param x1 Right (inclusive)
+     * @param y1 Bottom (inclusive)
+     * @param func Callable taking (Entity*, const Point&)
+     */
+    template<typename Func>
+    void forEachInRect(int x0, int y0, int x1, int y1, Func&& func) const {
+        if (x0 > x1 || y0 > y1) {
+            return;
+        }
+        findInOverflow(x0, y0, x1, y1, [&func, this](Entity* entity) {
+            func(entity, nodes[entityIndex(entity->getID())].pos);
+            return false;
+        });
+
+        if (x1 < 0 || y1 < 0 || x0 >= width || y0 >= height) {
+            return;
+        }
+        int bx0 = std::max(0, x0) / BUCKET_SIZE;
+        int by0 = std::max(0, y0) / BUCKET_SIZE;
+        int bx1 = std::min(x1, width - 1) / BUCKET_SIZE;
+        int by1 = std::min(y1, height - 1) / BUCKET_SIZE;
+
+        for (int by = by0; by <= by1; ++by) {
+            for (int bx = bx0; bx <= bx1; ++bx) {
+                for (uint32_t node : buckets[by * buckets_x + bx]) {
+                    const Point& pos = nodes[node].pos;
+                    if (pos.x >= x0 && pos.x <= x1 && pos.y >= y0 && pos.y <= y1) {
+                        func(nodes[node].entity, pos);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Visit entities within a Euclidean radius
+     * @param center Center tile
+     * @param radius Radius in tiles
+     * @param func Callable taking (Entity*, const Point&)
+     */
+    template<typename Func>
+    void forEachInRadius(const Point& center, int radius, Func&& func) const {
+        const int r2 = radius * radius;
+        forEachInRect(center.x - radius, center.y - radius,
+                      center.x + radius, center.y + radius,
+                      [&](Entity* entity, const Point& pos) {
+                          int dx = pos.x - center.x;
+                          int dy = pos.y - center.y;
+                          if (dx * dx + dy * dy <= r2) {
+                              func(entity, pos);
+                          }
+                      });
+    }
+
+    /**
+     * @brief Get entities on a tile
+     * @param x Tile X
+     * @param y Tile Y
+     * @return Entities at the tile
+     */
+    std::vector<Entity*> queryPoint(int x, int y) const;
+
+    /**
+     * @brief Get entities inside an inclusive rectangle
+     * @return Matching entities
+     */
+    std::vector<Entity*> queryRect(int x0, int y0, int x1, int y1) const;
+
+    /**
+     * @brief Get entities within a Euclidean radius
+     * @param center Center tile
+     * @param radius Radius in tiles
+     * @return Matching entities
+     */
+    std::vector<Entity*> queryRadius(const Point& center, int radius) const;
+
+    // ComponentListener (PositionComponent)
+    void onComponentSet(Entity& entity, IComponent& component) override;
+    void onComponentRemoved(Entity& entity, IComponent& component) override;
+
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    /// Index entry, stored at the entity's ID slot
+    struct Node {
+        Entity* entity = nullptr;   ///< Indexed entity (nullptr if unused)
+        Point pos;                  ///< Indexed position
+        uint32_t tile_prev = NONE;  ///< Previous node on the same tile
+        uint32_t tile_next = NONE;  ///< Next node on the same tile
+        uint32_t bucket_slot = 0;   ///< Position in bucket (or overflow) list
+    };
+
+    int width = 0;
+    int height = 0;
+    int buckets_x = 0;
+    int buckets_y = 0;
+    size_t count = 0;
+
+    std::vector<Node> nodes;                     ///< Entries by entity slot index
+    std::vector<uint32_t> tile_heads;            ///< First node per tile
+    std::vector<std::vector<uint32_t>> buckets;  ///< Nodes per coarse bucket
+    std::vector<uint32_t> overflow;              ///< Nodes outside the grid
+
+    bool inGrid(int x, int y) const {
+        return x >= 0 && y >= 0 && x < width && y < height;
+    }
+
+    size_t tileIndex(int x, int y) const {
+        return static_cast<size_t>(y) * width + x;
+    }
+
+    std::vector<uint32_t>& listFor(const Point& pos);
+    void link(uint32_t node);
+    void unlink(uint32_t node);
+    bool growToFit(const Point& pos);
+
+    template<typename Func>
+    Entity* findInOverflow(int x0, int y0, int x1, int y1, Func&& func) const {
+        for (uint32_t node : overflow) {
+            const Point& pos = nodes[node].pos;
+            if (pos.x >= x0 && pos.x <= x1 && pos.y >= y0 && pos.y <= y1 &&
+                func(nodes[node].entity)) {
+                return nodes[node].entity;
+            }
+        }
+        return nullptr;
+    }
+};
+
+} // namespace ecs
@@ -13,6 +13,7 @@
 #include "health_component.h"
 #include "stats_component.h"
 #include "combat_component.h"
+#include "renderable_component.h"
 #include "logger_interface.h"
 #include <memory>
 #include <string>
@@ -30,6 +31,13 @@ public:
 
     void update(const std::vector<std::unique_ptr<Entity>>& entities, double delta_time) override;
 
+    /**
+     * @brief Update only entities that have an EffectsComponent
+     * @param world World to query
+     * @param delta_time Time since last update
+     */
+    void update(World& world, double delta_time) override;
+
     /**
      * @brief Apply a status effect to an entity
      * @param entity Target entity
@@ -63,6 +71,23 @@ public:
 
     int getPriority() const override { return 25; }
 
+    /**
+     * @brief Get system name
+     * @return "StatusEffectSystem"
+     */
+    std::string getName() const override { return "StatusEffectSystem"; }
+
+    /**
+     * @brief Get declared access
+     * @return Effect ticking writes effects, health, stats, combat and the log
+     */
+    SystemAccess getAccess() const override {
+        return SystemAccess()
+            .read<RenderableComponent>()
+            .write<EffectsComponent, HealthComponent, StatsComponent, CombatComponent>()
+            .writeResource(SystemResource::MESSAGE_LOG);
+    }
+
     bool shouldProcess(const Entity& entity) const override {
         return entity.hasComponent<EffectsComponent>();
     }
@@ -70,6 +95,13 @@ public:
 private:
     ILogger* logger;
 
+    /**
+     * @brief Run one turn of effects on an entity
+     * @param entity Entity with effects
+     * @param effects Effects component
+     */
+    void processEntity(Entity* entity, EffectsComponent* effects);
+
     /**
      * @brief Process damage over time effects
      * @param entity Entity with effects
@@ -8,6 +8,8 @@
 #pragma once
 
 #include "entity.h"
+#include <algorithm>
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <functional>
@@ -16,6 +18,131 @@ namespace ecs {
 
 // Forward declarations
 class SystemManager;
+class World;
+
+/**
+ * @brief Shared state outside component pools that systems may touch
+ *
+ * Declared in SystemAccess alongside component access so the scheduler
+ * can keep systems that share a singleton from running concurrently.
+ */
+namespace SystemResource {
+    constexpr uint32_t MESSAGE_LOG = 1u << 0;  ///< ILogger / MessageLog
+    constexpr uint32_t EVENTS      = 1u << 1;  ///< EventSystem queue and handlers
+    constexpr uint32_t MAP         = 1u << 2;  ///< Game map tiles
+    constexpr uint32_t SPATIAL     = 1u << 3;  ///< Spatial index
+    constexpr uint32_t ACTIONS     = 1u << 4;  ///< Queued moves and attacks
+    constexpr uint32_t CHANGE_TICK = 1u << 5;  ///< World change tick (captureChangeTick() advances it)
+}
+
+/**
+ * @struct SystemAccess
+ * @brief Components and resources a system reads and writes during update
+ *
+ * Used by SystemManager to decide which systems may run at the same
+ * time. A default-constructed access is exclusive: the system conflicts
+ * with every other system and always runs alone, which is the safe
+ * choice for systems that have not declared anything. Calling any of the
+ * builder methods makes the access non-exclusive.
+ *
+ * Non-exclusive systems must not add or remove entities or components
+ * while updating; they record such changes in World::getCommandBuffer()
+ * instead, which is applied after all systems ran.
+ *
+ * @code
+ * SystemAccess getAccess() const override {
+ *     return SystemAccess().read<PositionComponent>()
+ *                          .write<HealthComponent>()
+ *                          .writeResource(SystemResource::MESSAGE_LOG);
+ * }
+ * @endcode
+ */
+struct SystemAccess {
+    std::vector<ComponentTypeId> reads;   ///< Component types read
+    std::vector<ComponentTypeId> writes;  ///< Component types written
+    uint32_t resource_reads = 0;          ///< SystemResource flags read
+    uint32_t resource_writes = 0;         ///< SystemResource flags written
+    bool exclusive = true;                ///< Conflicts with everything
+
+    /**
+     * @brief Access of a system whose update touches no shared state
+     * @return Non-exclusive access that conflicts with nothing
+     */
+    static SystemAccess none() {
+        SystemAccess access;
+        access.exclusive = false;
+        return access;
+    }
+
+    /**
+     * @brief Declare components as read
+     * @tparam Ts Component types
+     * @return This access, for chaining
+     */
+    template<typename... Ts>
+    SystemAccess& read() {
+        (reads.push_back(componentTypeId<Ts>()), ...);
+        exclusive = false;
+        return *this;
+    }
+
+    /**
+     * @brief Declare components as written
+     * @tparam Ts Component types
+     * @return This access, for chaining
+     */
+    template<typename... Ts>
+    SystemAccess& write() {
+        (writes.push_back(componentTypeId<Ts>()), ...);
+        exclusive = false;
+        return *this;
+    }
+
+    /**
+     * @brief Declare resources as read
+     * @param flags SystemResource flags
+     * @return This access, for chaining
+     */
+    SystemAccess& readResource(uint32_t flags) {
+        resource_reads |= flags;
+        exclusive = false;
+        return *this;
+    }
+
+    /**
+     * @brief Declare resources as written
+     * @param flags SystemResource flags
+     * @return This access, for chaining
+     */
+    SystemAccess& writeResource(uint32_t flags) {
+        resource_writes |= flags;
+        exclusive = false;
+        return *this;
+    }
+
+    /**
+     * @brief Check if two systems may not run concurrently
+     * @param other Access of the other system
+     * @return true if either is exclusive or one writes what the other uses
+     */
+    bool conflictsWith(const SystemAccess& other) const {
+        if (exclusive || other.exclusive) {
+            return true;
+        }
+        if ((resource_writes & (other.resource_reads | other.resource_writes)) ||
+            (other.resource_writes & resource_reads)) {
+            return true;
+        }
+        auto overlaps = [](const std::vector<ComponentTypeId>& a,
+                           const std::vector<ComponentTypeId>& b) {
+            return std::any_of(a.begin(), a.end(), [&b](ComponentTypeId type) {
+                return std::find(b.begin(), b.end(), type) != b.end();
+            });
+        };
+        return overlaps(writes, other.reads) || overlaps(writes, other.writes) ||
+               overlaps(other.writes, reads);
+    }
+};
 
 /**
  * @class ISystem
@@ -37,6 +164,17 @@ public:
     virtual void update(const std::vector<std::unique_ptr<Entity>>& entities,
                        double delta_time) = 0;
 
+    /**
+     * @brief Update system logic with access to world queries
+     * @param world World being updated
+     * @param delta_time Time elapsed since last update (seconds)
+     *
+     * Called by SystemManager. The default forwards every entity to the
+     * vector overload; systems override it to iterate a World::view()
+     * instead of filtering the full entity list.
+     */
+    virtual void update(World& world, double delta_time);
+
     /**
      * @brief Get system name for debugging
      * @return Human-readable system name
@@ -56,6 +194,15 @@ public:
      */
     virtual int getPriority() const { return 100; }
 
+    /**
+     * @brief Get components and resources touched by update(World&)
+     * @return Declared access (exclusive unless overridden)
+     *
+     * Queried when the system schedule is rebuilt, so the result must
+     * not change while the system is registered.
+     */
+    virtual SystemAccess getAccess() const { return SystemAccess(); }
+
     /**
      * @brief Check if system is enabled
      * @return true if system should run
@@ -9,14 +9,33 @@
 
 #include "system.h"
 #include "entity.h"
+#include "component_storage.h"
+#include "command_buffer.h"
+#include "view.h"
 #include <vector>
 #include <memory>
 #include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
 #include <typeindex>
 #include <unordered_map>
 
+class ThreadPool;
+
 namespace ecs {
 
+/**
+ * @struct SystemTiming
+ * @brief Per-system update timing collected by SystemManager
+ */
+struct SystemTiming {
+    std::string name;       ///< System name
+    double last_ms = 0.0;   ///< Duration of the most recent update
+    double total_ms = 0.0;  ///< Accumulated duration of all updates
+    uint64_t calls = 0;     ///< Number of updates run
+};
+
 /**
  * @class SystemManager
  * @brief Manages and coordinates all ECS systems
@@ -26,6 +45,11 @@ namespace ecs {
  * - Managing system execution order
  * - Updating all systems each frame
  * - Providing access to specific systems
+ *
+ * With a thread pool set, update(World&, double) runs systems whose
+ * declared SystemAccess does not conflict at the same time. Conflicting
+ * systems keep their priority order, so the result matches a sequential
+ * update as long as the declarations are accurate.
  */
 class SystemManager {
 public:
@@ -60,6 +84,7 @@ public:
 
         // Re-sort by priority
         sortSystems();
+        schedule_dirty = true;
 
         return ref;
     }
@@ -106,6 +131,69 @@ public:
         }
     }
 
+    /**
+     * @brief Update all enabled systems with world access
+     * @param world World being updated
+     * @param delta_time Time since last update (seconds)
+     *
+     * Runs on the thread pool when one is set, otherwise in priority
+     * order on the calling thread. Either way each system's time is
+     * recorded in getTimings(). If a system throws, systems that have
+     * not started yet are skipped and the exception is rethrown.
+     */
+    void update(World& world, double delta_time);
+
+    /**
+     * @brief Set the pool used to run independent systems concurrently
+     * @param pool Thread pool (not owned), or nullptr to run sequentially
+     */
+    void setThreadPool(ThreadPool* pool) { thread_pool = pool; }
+
+    /**
+     * @brief Get the thread pool used for system updates
+     * @return Thread pool or nullptr
+     */
+    ThreadPool* getThreadPool() const { return thread_pool; }
+
+    /**
+     * @brief Get per-system timings
+     * @return Timings in priority order (parallel to getSystems())
+     */
+    const std::vector<SystemTiming>& getTimings() const { return timings; }
+
+    /**
+     * @brief Record a run of a system made outside update()
+     * @param system Registered system that ran
+     * @param ms Duration in milliseconds
+     *
+     * Turn-based play calls the AI, movement and combat systems directly
+     * for the actors whose turn it is; recording those runs keeps
+     * getTimings() complete. Unregistered systems are ignored.
+     */
+    void recordTiming(const ISystem& system, double ms);
+
+    /**
+     * @brief Get wall-clock duration of the last world update
+     * @return Duration in milliseconds
+     */
+    double getLastUpdateTime() const { return last_update_ms; }
+
+    /**
+     * @brief Get how much work overlapped in the last world update
+     * @return Sum of system times divided by wall time (1.0 = sequential)
+     */
+    double getParallelSpeedup() const;
+
+    /**
+     * @brief Check if two registered systems must not run concurrently
+     * @param a First system
+     * @param b Second system
+     * @return true if their declared access conflicts
+     */
+    static bool conflicts(const ISystem& a, const ISystem& b) {
+        return a.getAccess().conflictsWith(b.getAccess());
+    }
+
     /**
      * @brief Enable or disable a system
      * @tparam T System type
@@ -147,6 +235,7 @@ public:
 
         if (vec_it != systems.end()) {
             systems.erase(vec_it);
+            schedule_dirty = true;
             return true;
         }
 
@@ -159,6 +248,7 @@ public:
     void clear() {
         systems.clear();
         system_map.clear();
+        schedule_dirty = true;
     }
 
     /**
@@ -181,6 +271,37 @@ private:
     std::vector<std::unique_ptr<ISystem>> systems;  ///< All registered systems
     std::unordered_map<std::type_index, ISystem*> system_map; ///< Type lookup
 
+    ThreadPool* thread_pool = nullptr;               ///< Pool for parallel updates (not owned)
+    std::vector<std::vector<size_t>> dependents;     ///< Systems that must wait for each system
+    std::vector<uint32_t> dependency_counts;         ///< Systems each system waits for
+    std::vector<SystemTiming> timings;               ///< Timing per system
+    double last_update_ms = 0.0;                     ///< Wall time of last world update
+    bool schedule_dirty = true;                      ///< Dependency graph needs rebuilding
+
+    struct ScheduleRun;
+
+    /**
+     * @brief Rebuild the dependency graph from declared access
+     *
+     * A system depends on every earlier (higher priority) system it
+     * conflicts with.
+     */
+    void rebuildSchedule();
+
+    /**
+     * @brief Run one system and record its timing
+     * @param index System index
+     * @param world World being updated
+     * @param delta_time Time since last update
+     */
+    void runSystem(size_t index, World& world, double delta_time);
+
+    /**
+     * @brief Run a system as a pool task, then release its dependents
+     */
+    void runScheduled(const std::shared_ptr<ScheduleRun>& run, size_t index,
+                      World& world, double delta_time);
+
     /**
      * @brief Sort systems by priority
      */
@@ -198,12 +319,24 @@ private:
  * @brief Container for entities and systems
  *
  * The World class combines entity storage with system management,
- * providing a complete ECS environment.
+ * providing a complete ECS environment. Components of entities owned
+ * by the world live in per-type pools (see ComponentStorage).
  */
 class World {
 public:
     World() = default;
-    ~World() = default;
+
+    /**
+     * @brief Destroy the world
+     *
+     * Observers are detached first, so tearing down the remaining
+     * entities does not call them.
+     */
+    ~World() {
+        for (auto& [type, observer] : observers) {
+            storage.removeListener(type, observer.get());
+        }
+    }
 
     // Entity management
 
@@ -212,57 +345,110 @@ public:
      * @return Reference to created entity
      */
     Entity& createEntity() {
-        entities.push_back(std::make_unique<Entity>());
-        return *entities.back();
+        return insertEntity(std::make_unique<Entity>());
     }
 
     /**
      * @brief Add an existing entity to the world
      * @param entity Entity to add (ownership transferred)
      * @return Reference to added entity
+     * @throws std::invalid_argument if the entity's ID cannot be claimed:
+     *         another entity in the world uses its slot, or the slot has
+     *         moved past its generation. The entity is discarded, since
+     *         quietly renumbering it would break references to it.
+     * @note An entity without an ID is given one here. The entity's
+     *       components are moved into the world's pools, so component
+     *       pointers taken before this call are invalidated.
      */
     Entity& addEntity(std::unique_ptr<Entity> entity) {
-        entities.push_back(std::move(entity));
-        return *entities.back();
+        EntityID id = entity->getID();
+        if (id == INVALID_ENTITY_ID) {
+            return insertEntity(std::move(entity));
+        }
+
+        // IDs reserved through this world (see CommandBuffer::create()) are
+        // already live; any other ID must still be free to claim
+        uint32_t index = entityIndex(id);
+        bool in_use = index < lookup.size() && lookup[index] != NPOS;
+        if (in_use || !(ids.isAlive(id) || ids.claim(id))) {
+            throw std::invalid_argument("Entity ID " + std::to_string(id) +
+                                        (in_use ? " is already in use" : " is stale"));
+        }
+        return insertEntity(std::move(entity));
+    }
+
+    /**
+     * @brief Reserve room for entities about to be added
+     * @param count Number of additional entities
+     */
+    void reserveEntities(size_t count) {
+        entities.reserve(entities.size() + count);
     }
 
     /**
      * @brief Remove an entity by ID
      * @param id Entity ID to remove
      * @return true if entity was removed
+     *
+     * O(1): the last entity is moved into the freed position, so the
+     * order of getEntities() changes.
      */
     bool removeEntity(EntityID id) {
-        auto it = std::find_if(entities.begin(), entities.end(),
-            [id](const std::unique_ptr<Entity>& e) {
-                return e->getID() == id;
-            });
+        uint32_t dense = findDense(id);
+        if (dense == NPOS) {
+            return false;
+        }
 
-        if (it != entities.end()) {
-            entities.erase(it);
-            return true;
+        // Unlink first so the entity is out of the world while it is destroyed
+        std::unique_ptr<Entity> removed = std::move(entities[dense]);
+        lookup[entityIndex(id)] = NPOS;
+        if (dense != entities.size() - 1) {
+            entities[dense] = std::move(entities.back());
+            lookup[entityIndex(entities[dense]->getID())] = dense;
         }
-        return false;
+        entities.pop_back();
+        ids.release(id);
+        return true;
     }
 
     /**
      * @brief Get entity by ID
      * @param id Entity ID to find
-     * @return Pointer to entity or nullptr
+     * @return Pointer to entity or nullptr (also for stale IDs)
      */
     Entity* getEntity(EntityID id) {
-        for (auto& entity : entities) {
-            if (entity->getID() == id) {
-                return entity.get();
-            }
-        }
-        return nullptr;
+        uint32_t dense = findDense(id);
+        return dense != NPOS ? entities[dense].get() : nullptr;
+    }
+
+    /**
+     * @brief Get entity by ID (const version)
+     * @param id Entity ID to find
+     * @return Const pointer to entity or nullptr (also for stale IDs)
+     */
+    const Entity* getEntity(EntityID id) const {
+        uint32_t dense = findDense(id);
+        return dense != NPOS ? entities[dense].get() : nullptr;
+    }
+
+    /**
+     * @brief Check if an entity with this exact ID is in the world
+     * @param id Entity ID
+     * @return true if present
+     */
+    bool hasEntity(EntityID id) const {
+        return findDense(id) != NPOS;
     }
 
     /**
      * @brief Clear all entities
+     * @note ID numbering starts afresh, so a restored save can claim its
+     *       IDs again; IDs from before the clear may be reused.
      */
     void clearEntities() {
         entities.clear();
+        lookup.clear();
+        ids.reset();
     }
 
     /**
@@ -308,9 +494,28 @@ public:
     /**
      * @brief Update all systems
      * @param delta_time Time since last update
+     *
+     * Commands recorded by the systems are applied once all of them ran.
      */
     void update(double delta_time) {
-        systems.update(entities, delta_time);
+        systems.update(*this, delta_time);
+        commands.flush(*this);
+    }
+
+    /**
+     * @brief Get the buffer for deferred structural changes
+     * @return Command buffer flushed at the end of update()
+     */
+    CommandBuffer& getCommandBuffer() {
+        return commands;
+    }
+
+    /**
+     * @brief Apply recorded commands now (a sync point)
+     * @return Number of commands applied
+     */
+    size_t flushCommands() {
+        return commands.flush(*this);
     }
 
     /**
@@ -321,9 +526,195 @@ public:
         return systems;
     }
 
+    /**
+     * @brief Get entities that have all of the given components
+     * @tparam Components Required component types
+     * @return View over the cached matching set
+     */
+    template<typename... Components>
+    View<Components...> view() {
+        static_assert(sizeof...(Components) > 0, "view requires at least one component");
+        return View<Components...>(storage.getView(
+            viewId<Components...>(), {componentTypeId<Components>()...}));
+    }
+
+    /**
+     * @brief Get the component storage
+     * @return Reference to per-type component pools
+     */
+    ComponentStorage& getComponentStorage() {
+        return storage;
+    }
+
+    // Change tracking
+
+    /**
+     * @brief Get the current change tick
+     * @return Tick stamped on changes made now
+     */
+    uint32_t getChangeTick() const {
+        return storage.getChangeTick();
+    }
+
+    /**
+     * @brief Get a tick to pass to eachChanged()/eachAdded() later
+     * @return Tick; every change made after this call compares greater
+     * @note Systems calling this from update() declare
+     *       SystemResource::CHANGE_TICK as written.
+     */
+    uint32_t captureChangeTick() {
+        return storage.captureChangeTick();
+    }
+
+    /**
+     * @brief Visit entities whose component changed after a tick
+     * @tparam T Component type
+     * @param since Tick from captureChangeTick()
+     * @param func Callable taking (Entity&, T&)
+     *
+     * Covers components added or replaced after the tick as well as
+     * those marked with Entity::markChanged(). Iterates from the back,
+     * so the callback may remove the visited component.
+     */
+    template<typename T, typename Func>
+    void eachChanged(uint32_t since, Func&& func) {
+        eachAfter<T>(since, [](const ComponentPool& pool) -> const std::vector<uint32_t>& {
+            return pool.getChangedTicks();
+        }, func);
+    }
+
+    /**
+     * @brief Visit entities whose component was added after a tick
+     * @tparam T Component type
+     * @param since Tick from captureChangeTick()
+     * @param func Callable taking (Entity&, T&)
+     */
+    template<typename T, typename Func>
+    void eachAdded(uint32_t since, Func&& func) {
+        eachAfter<T>(since, [](const ComponentPool& pool) -> const std::vector<uint32_t>& {
+            return pool.getAddedTicks();
+        }, func);
+    }
+
+    /**
+     * @brief Check if any component of a type was added, changed or removed after a tick
+     * @tparam T Component type
+     * @param since Tick from captureChangeTick()
+     * @return true if something changed
+     */
+    template<typename T>
+    bool anyChanged(uint32_t since) const {
+        const ComponentPool* pool = storage.findPool<T>();
+        return pool && pool->changedSince(since);
+    }
+
+    /**
+     * @brief Call a function whenever a component is added or replaced
+     * @tparam T Component type
+     * @param callback Callable taking (Entity&, T&)
+     * @return Observer handle for removeObserver()
+     */
+    template<typename T, typename Func>
+    ComponentObserver* onAdd(Func&& callback) {
+        return addObserver<T>(ComponentObserver::Trigger::ADDED, std::forward<Func>(callback));
+    }
+
+    /**
+     * @brief Call a function whenever a component is marked changed
+     * @tparam T Component type
+     * @param callback Callable taking (Entity&, T&)
+     * @return Observer handle for removeObserver()
+     */
+    template<typename T, typename Func>
+    ComponentObserver* onChange(Func&& callback) {
+        return addObserver<T>(ComponentObserver::Trigger::CHANGED, std::forward<Func>(callback));
+    }
+
+    /**
+     * @brief Call a function just before a component is removed
+     * @tparam T Component type
+     * @param callback Callable taking (Entity&, T&)
+     * @return Observer handle for removeObserver()
+     */
+    template<typename T, typename Func>
+    ComponentObserver* onRemove(Func&& callback) {
+        return addObserver<T>(ComponentObserver::Trigger::REMOVED, std::forward<Func>(callback));
+    }
+
+    /**
+     * @brief Unregister an observer
+     * @param observer Handle returned by onAdd()/onChange()/onRemove()
+     */
+    void removeObserver(ComponentObserver* observer) {
+        for (auto it = observers.begin(); it != observers.end(); ++it) {
+            if (it->second.get() == observer) {
+                storage.removeListener(it->first, observer);
+                observers.erase(it);
+                return;
+            }
+        }
+    }
+
 private:
+    static constexpr uint32_t NPOS = UINT32_MAX;
+
+    ComponentStorage storage;  ///< Must outlive entities (declared first)
+    std::vector<std::pair<ComponentTypeId, std::unique_ptr<ComponentObserver>>> observers; ///< Registered observers
     std::vector<std::unique_ptr<Entity>> entities;  ///< All entities
+    std::vector<uint32_t> lookup;                   ///< ID slot index -> entities index
+    EntityIdAllocator ids;                          ///< Hands out this world's entity IDs
     SystemManager systems;                          ///< System manager
+    CommandBuffer commands{ids};                    ///< Deferred structural changes
+
+    Entity& insertEntity(std::unique_ptr<Entity> entity) {
+        if (entity->id == INVALID_ENTITY_ID) {
+            entity->id = ids.allocate();
+        }
+        uint32_t index = entityIndex(entity->getID());
+        if (index >= lookup.size()) {
+            lookup.resize(index + 1, NPOS);
+        }
+        lookup[index] = static_cast<uint32_t>(entities.size());
+
+        entity->attach(storage);
+        entities.push_back(std::move(entity));
+        return *entities.back();
+    }
+
+    template<typename T, typename Func>
+    ComponentObserver* addObserver(ComponentObserver::Trigger trigger, Func&& callback) {
+        auto observer = std::make_unique<ComponentObserver>(trigger,
+            [callback = std::forward<Func>(callback)](Entity& entity, IComponent& component) mutable {
+                callback(entity, static_cast<T&>(component));
+            });
+        ComponentObserver* handle = observer.get();
+        storage.addListener(componentTypeId<T>(), handle);
+        observers.emplace_back(componentTypeId<T>(), std::move(observer));
+        return handle;
+    }
+
+    template<typename T, typename TicksOf, typename Func>
+    void eachAfter(uint32_t since, TicksOf&& ticks_of, Func& func) {
+        ComponentPool* pool = storage.findPool<T>();
+        if (!pool || !pool->changedSince(since)) {
+            return;
+        }
+        const auto& ticks = ticks_of(*pool);
+        for (size_t i = ticks.size(); i-- > 0;) {
+            if (i < ticks.size() && ticks[i] > since) {
+                func(*pool->getOwners()[i], static_cast<T&>(*pool->getComponents()[i]));
+            }
+        }
+    }
+
+    uint32_t findDense(EntityID id) const {
+        uint32_t index = entityIndex(id);
+        if (index >= lookup.size() || lookup[index] == NPOS) {
+            return NPOS;
+        }
+        uint32_t dense = lookup[index];
+        return entities[dense]->getID() == id ? dense : NPOS;
+    }
 };
 
 } // namespace ecs
\ No newline at end of file
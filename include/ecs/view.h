@@ -0,0 +1,105 @@
+/**
+ * @file view.h
+ * @brief Typed multi-component queries over a World
+ * @author Veyrm Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include "entity.h"
+#include "component_storage.h"
+#include <cstddef>
+#include <vector>
+
+namespace ecs {
+
+/**
+ * @class View
+ * @brief Iterable set of entities that have all of the given components
+ * @tparam Components Required component types
+ *
+ * Obtained from World::view(). The matching set is cached by the world
+ * and kept current as components are added and removed, so iteration
+ * only visits matching entities.
+ *
+ * @code
+ * world.view<PositionComponent, HealthComponent>().each(
+ *     [](Entity& entity, PositionComponent& pos, HealthComponent& health) {
+ *         ...
+ *     });
+ * @endcode
+ */
+template<typename... Components>
+class View {
+public:
+    using iterator = std::vector<Entity*>::const_iterator;
+
+    /**
+     * @brief Construct view over a cache
+     * @param cache Cached matching set
+     */
+    explicit View(ViewCache& cache) : cache(&cache) {}
+
+    /**
+     * @brief Get iterator to first matching entity
+     * @note Adding or removing components while iterating this way is
+     *       not safe; use each() for that. Inside an each() pass over
+     *       the same view, removed entries read as nullptr.
+     */
+    iterator begin() const { return cache->getEntities().begin(); }
+
+    /**
+     * @brief Get end iterator
+     */
+    iterator end() const { return cache->getEntities().end(); }
+
+    /**
+     * @brief Get number of matching entities
+     * @return Entity count
+     */
+    size_t size() const { return cache->size(); }
+
+    /**
+     * @brief Check if no entities match
+     * @return true if empty
+     */
+    bool empty() const { return cache->size() == 0; }
+
+    /**
+     * @brief Call a function for every matching entity
+     * @param func Callable taking (Entity&, Components&...)
+     *
+     * Runs as a pass over the cache (ViewCache::beginPass()), so the
+     * callback may add or remove components on any entity, or destroy
+     * entities. Each entity is visited at most once: those that stop
+     * matching before their turn are skipped, and those that start
+     * matching during the pass, including new entities in a reused
+     * slot, are not visited until the next call.
+     */
+    template<typename Func>
+    void each(Func&& func) const {
+        // Ends the pass even if the callback throws
+        struct Pass {
+            ViewCache& cache;
+            explicit Pass(ViewCache& cache) : cache(cache) { cache.beginPass(); }
+            ~Pass() { cache.endPass(); }
+        } pass(*cache);
+
+        // Entries only append during a pass; indexed because appends may reallocate
+        const auto& entities = cache->getEntities();
+        const size_t count = entities.size();
+        for (size_t i = 0; i < count; ++i) {
+            Entity* entity = entities[i];
+            if (!entity) {
+                continue;  // removed earlier in this pass
+            }
+            func(*entity, *entity->template getComponent<Components>()...);
+        }
+    }
+
+private:
+    ViewCache* cache;  ///< Matching set owned by the world
+};
+
+} // namespace ecs
@@ -22,9 +22,11 @@ class Map;
  * are visible from a given point on the map. This system handles line-of-sight
  * calculations for both the player's view and AI visibility checks.
  *
- * The implementation uses the recursive shadowcasting algorithm that divides
- * the field of view into 8 octants and calculates visibility for each.
- * This provides smooth, realistic visibility that respects opaque obstacles.
+ * The field of view is split into 8 octants and each is scanned row by row,
+ * recursing past opaque tiles with exact (integer) slopes. A transparent
+ * tile is lit only if its centre lies inside the visible slope range, while
+ * opaque tiles are lit if any part of them is. This makes visibility between
+ * transparent tiles symmetric: if A sees B, B sees A.
  *
  * @see Map
  * @see TileType
@@ -35,6 +37,9 @@ public:
     /// Default field of view radius in tiles
     static constexpr int DEFAULT_RADIUS = 10;
 
+    /// Number of octants the field of view is split into
+    static constexpr int OCTANT_COUNT = 8;
+
     /**
      * @brief Calculate field of view from a point using shadowcasting
      * @param map The map to calculate FOV on
@@ -44,7 +49,8 @@ public:
      *
      * This method fills the visible array with true/false values indicating
      * which tiles can be seen from the origin point within the given radius.
-     * The array dimensions must match the map dimensions.
+     * The array is resized to the map dimensions ([y][x]) if needed.
+     * Opaque tiles that bound the view are themselves visible.
      *
      * @see isVisible()
      * @see getVisibleTiles()
@@ -82,30 +88,65 @@ public:
      * @see isVisible()
      */
     static std::set<Point> getVisibleTiles(const Map& map, const Point& origin, int radius);
+
+    /**
+     * @brief Calculate the tiles lit in a single octant
+     * @param map The map to calculate FOV on
+     * @param origin The point from which to calculate visibility
+     * @param radius Maximum visibility distance
+     * @param octant Octant index in [0, OCTANT_COUNT)
+     * @param lit Receives the lit tiles (origin excluded)
+     *
+     * Tiles on the axes and diagonals belong to two octants and may be
+     * reported by both.
+     *
+     * @see FOVCache
+     */
+    static void calculateOctant(const Map& map, const Point& origin, int radius,
+                                int octant, std::vector<Point>& lit);
+
+    /**
+     * @brief Find which octants around an origin a tile falls in
+     * @param origin Center of the field of view
+     * @param tile Tile to classify
+     * @return Bitmask with bit i set for each octant i containing tile
+     *         (0 for the origin itself)
+     */
+    static unsigned octantsContaining(const Point& origin, const Point& tile);
     
 private:
     /**
-     * @brief Recursive shadowcasting implementation for one octant
+     * @struct Slope
+     * @brief Exact slope (columns per row) of a line from the origin
+     */
+    struct Slope {
+        int num;  ///< Numerator
+        int den;  ///< Denominator (positive)
+    };
+
+    /**
+     * @brief Symmetric shadowcasting for one row of an octant and beyond
      * @param map The map to cast shadows on
      * @param origin The center point of the field of view
      * @param radius Maximum casting distance
-     * @param row Current row being processed (distance from origin)
-     * @param start Start slope of the current shadow
-     * @param end End slope of the current shadow
+     * @param depth Current row being processed (distance from origin)
+     * @param start Slope bounding the light on the axis side
+     * @param end Slope bounding the light on the diagonal side
      * @param xx X component of octant transform matrix
      * @param xy Y component of octant transform matrix
      * @param yx X component of octant transform matrix
      * @param yy Y component of octant transform matrix
-     * @param visible 2D array to mark visible tiles
+     * @param light Called with (x, y) for each in-bounds tile within radius
      *
-     * This is the core recursive shadowcasting algorithm that processes
-     * one octant of the field of view. The transform matrix parameters
-     * allow the same algorithm to work for all 8 octants.
+     * Scans the row's columns between the slopes and recurses into the
+     * next row for each run of transparent tiles. The transform matrix
+     * parameters allow the same algorithm to work for all 8 octants.
      */
+    template<typename LightFn>
     static void castLight(const Map& map, const Point& origin, int radius,
-                         int row, float start, float end,
+                         int depth, Slope start, Slope end,
                          int xx, int xy, int yx, int yy,
-                         std::vector<std::vector<bool>>& visible);
+                         LightFn& light);
 
     /**
      * @brief Check if a tile blocks line of sight
@@ -0,0 +1,115 @@
+/**
+ * @file fov_cache.h
+ * @brief Incremental field of view with change deltas
+ * @author Veyrm Team
+ * @date 2025
+ */
+
+#ifndef FOV_CACHE_H
+#define FOV_CACHE_H
+
+#include "point.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+class Map;
+
+/**
+ * @class FOVCache
+ * @brief Keeps the last field of view and recomputes only what changed
+ *
+ * The cached result is keyed by map, origin, radius and the map's
+ * transparency version. Waiting, picking things up or monsters moving
+ * leave all of those untouched, so update() returns immediately. When a
+ * door opens or closes within range only the octants containing that
+ * tile are recast; moving the origin or changing the radius recasts all
+ * of them.
+ *
+ * Each update reports the tiles that entered and left view so callers
+ * such as MapMemory and the map's visibility flags can be patched
+ * instead of swept.
+ *
+ * @see FOV
+ * @see Map::getTransparencyChanges()
+ */
+class FOVCache {
+public:
+    /// Outcome of an update
+    enum class Result {
+        UNCHANGED,  ///< Cached view still valid; deltas are empty
+        UPDATED     ///< View recomputed; deltas describe the difference
+    };
+
+    /**
+     * @brief Bring the cached view up to date
+     * @param map The map to calculate FOV on
+     * @param origin The point from which to calculate visibility
+     * @param radius Maximum visibility distance
+     * @return Whether anything was recomputed
+     */
+    Result update(const Map& map, const Point& origin, int radius);
+
+    /**
+     * @brief Drop the cached view (e.g. when a new level is generated)
+     *
+     * The next update() starts from nothing visible, so every visible
+     * tile is reported as entered.
+     */
+    void invalidate();
+
+    /**
+     * @brief Get the cached visibility grid
+     * @return Grid indexed [y][x], same layout as FOV::calculate()
+     */
+    const std::vector<std::vector<bool>>& getVisible() const { return visible; }
+
+    /**
+     * @brief Check if a tile is in the cached view
+     * @param x X coordinate
+     * @param y Y coordinate
+     * @return true if visible
+     */
+    bool isVisible(int x, int y) const {
+        return y >= 0 && y < static_cast<int>(visible.size()) &&
+               x >= 0 && x < width && visible[y][x];
+    }
+
+    /// Tiles that became visible in the last update
+    const std::vector<Point>& getEntered() const { return entered; }
+
+    /// Tiles that stopped being visible in the last update
+    const std::vector<Point>& getLeft() const { return left; }
+
+    /// Octants recast in the last update (0 to FOV::OCTANT_COUNT)
+    int getRecomputedOctants() const { return recomputed_octants; }
+
+private:
+    /// Per-octant tiles plus one list holding just the origin
+    static constexpr int LIST_COUNT = 9;
+    static constexpr int ORIGIN_LIST = LIST_COUNT - 1;
+
+    const Map* map = nullptr;           ///< Map the view was cast on
+    Point origin{-1, -1};               ///< Cached origin
+    int radius = -1;                    ///< Cached radius
+    uint32_t transparency_version = 0;  ///< Map version the view reflects
+    bool valid = false;                 ///< Whether the cache holds a view
+
+    int width = 0;                                 ///< Grid width
+    std::vector<std::vector<bool>> visible;        ///< Current view [y][x]
+    std::vector<uint8_t> light_count;              ///< Lists lighting each tile (row-major)
+    std::array<std::vector<Point>, LIST_COUNT> lit; ///< Tiles lit by each list
+
+    std::vector<Point> entered;  ///< Delta: tiles now visible
+    std::vector<Point> left;     ///< Delta: tiles no longer visible
+    std::vector<Point> touched;  ///< Scratch: tiles whose count changed
+    std::vector<Point> changes;  ///< Scratch: transparency changes
+    int recomputed_octants = 0;
+
+    void reset(const Map& map);
+    void recompute(const Map& map, unsigned octant_mask);
+    void recomputeList(const Map& map, int list);
+    void publishDelta();
+};
+
+#endif // FOV_CACHE_H
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <array>
 #include <string>
 #include <deque>
 
@@ -25,6 +26,8 @@
  * - Update time (game logic)
  * - Render time (drawing)
  * - Min/max FPS over time
+ * - Path queries answered from the path cache in the last monster turn
+ * - Monsters and AI time per level-of-detail tier in the last monster turn
  *
  * @see Config::getTargetFPS()
  * @see Config::getShowFPS()
@@ -46,6 +49,24 @@ public:
      */
     void update(double fps, double frameTime, double updateTime, double renderTime);
 
+    /**
+     * @brief Record the last monster turn's path queries
+     * @param hits Queries answered from the path cache
+     * @param misses Queries that needed a search
+     */
+    void recordPathQueries(int hits, int misses);
+
+    /// Number of AI level-of-detail tiers (active, nearby, distant, dormant)
+    static constexpr size_t AI_TIERS = 4;
+
+    /**
+     * @brief Record one AI tier from the last monster turn
+     * @param tier Tier index (0 = active ... 3 = dormant)
+     * @param count Monsters in the tier
+     * @param time AI time spent on the tier in milliseconds
+     */
+    void recordAITier(size_t tier, int count, double time);
+
     // Get current frame stats
 
     /** @brief Get current FPS @return Current frames per second */
@@ -60,6 +81,18 @@ public:
     /** @brief Get current render time @return Render time in milliseconds */
     double getRenderTime() const { return currentRenderTime; }
 
+    /** @brief Get path cache hits in the last monster turn */
+    int getPathHits() const { return pathHits; }
+
+    /** @brief Get path cache misses in the last monster turn */
+    int getPathMisses() const { return pathMisses; }
+
+    /** @brief Get monsters in an AI tier in the last monster turn */
+    int getAITierCount(size_t tier) const { return tier < AI_TIERS ? aiTierCounts[tier] : 0; }
+
+    /** @brief Get AI time for a tier in the last monster turn @return Milliseconds */
+    double getAITierTime(size_t tier) const { return tier < AI_TIERS ? aiTierTimes[tier] : 0.0; }
+
     // Get averages over time
 
     /**
@@ -106,6 +139,10 @@ private:
     double currentFrameTime;    ///< Current total frame time (ms)
     double currentUpdateTime;   ///< Current update time (ms)
     double currentRenderTime;   ///< Current render time (ms)
+    int pathHits = 0;           ///< Cached path queries last monster turn
+    int pathMisses = 0;         ///< Searched path queries last monster turn
+    std::array<int, AI_TIERS> aiTierCounts{};     ///< Monsters per AI tier last monster turn
+    std::array<double, AI_TIERS> aiTierTimes{};   ///< AI time per tier last monster turn (ms)
 
     // Historical data (last 60 frames)
     std::deque<double> fpsHistory;       ///< FPS history buffer
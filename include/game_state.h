@@ -10,6 +10,9 @@
 #include <memory>
 #include <vector>
 #include "map_generator.h"
+#include "fov_cache.h"
+#include "sight_map.h"
+#include "ecs/entity_id.h"
 
 /**
  * @enum GameState
@@ -192,7 +195,12 @@ public:
     const std::vector<std::vector<bool>>& getCurrentFOV() const { return current_fov; }
 
     // Monster AI
-    void updateMonsters();
+
+    /**
+     * @brief Run the monsters whose turn has come
+     * @param actors Monsters due at the current world time (from the TurnManager)
+     */
+    void updateMonsters(const std::vector<ecs::EntityID>& actors);
 
 
     // Item system - Legacy (using ECS item system)
@@ -262,6 +270,20 @@ private:
     std::unique_ptr<MapMemory> map_memory;
     std::unique_ptr<ecs::GameWorld> ecs_world;  ///< ECS world manager
     std::vector<std::vector<bool>> current_fov;
+    FOVCache fov_cache;           ///< Incremental FOV behind current_fov
+    bool fov_full_sync = true;    ///< Next updateFOV() must rewrite all visibility state
+    SightMap light_sight;         ///< Long-range sight for tiles lit by light sources
+    std::vector<Point> light_revealed;  ///< Visible only because a light reaches them
+
+    /// How far away the player can make out tiles lit by a light source
+    static constexpr int LIGHT_SIGHT_RADIUS = 40;
+
+    /**
+     * @brief Find lit tiles in sight but outside the FOV radius
+     * @param tiles Receives the tiles
+     * @note Part of updateFOV(), so ecs_world is known to be set.
+     */
+    void collectLightRevealed(std::vector<Point>& tiles) const;
     bool use_ecs = false;  ///< Flag to enable ECS mode
 
     // Auto-save database components
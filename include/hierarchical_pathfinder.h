@@ -0,0 +1,203 @@
+/**
+ * @file hierarchical_pathfinder.h
+ * @brief Room-level abstract graph for long-range pathfinding (HPA*)
+ * @author Veyrm Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include "pathfinding.h"
+#include "point.h"
+#include <cstdint>
+#include <vector>
+
+class Map;
+
+/**
+ * @class HierarchicalPathfinder
+ * @brief Answers long-range queries on a graph of room and corridor entrances
+ *
+ * The map is cut into clusters: the interior of every room the generator
+ * recorded (Map::getRooms()), and SECTOR_SIZE squares over everything
+ * else (corridors, doorways, caves and maps without rooms). Each
+ * cluster's walkable tiles split into 4-connected regions. Where two
+ * regions touch, every straight run of crossings gets an entrance: a
+ * node on each side joined by a one-step edge. Nodes inside a region are
+ * joined by edges carrying their walking distance.
+ *
+ * A query only searches the start and goal regions on the tile grid; the
+ * rest is an A* over a few hundred nodes instead of thousands of tiles.
+ * findNextSegment() then refines just the stretch leaving the start
+ * region, so a monster crossing the level pays for tile-level search one
+ * region at a time. Routes are close to, but not always exactly,
+ * shortest.
+ *
+ * Movement is cardinal (like monster movement). update() repairs the
+ * graph from the map's walkability log, rebuilding only clusters whose
+ * tiles changed.
+ *
+ * @code
+ * HierarchicalPathfinder planner;
+ * planner.build(map);            // after generation
+ * planner.update(map);           // each turn: repairs changed clusters
+ * planner.findNextSegment(monster_pos, target, path);
+ * @endcode
+ *
+ * @see Pathfinding for exact single searches
+ */
+class HierarchicalPathfinder {
+public:
+    /// Side of the square sectors covering tiles outside rooms
+    static constexpr int SECTOR_SIZE = 16;
+    /// Crossing runs longer than this get an entrance at both ends
+    static constexpr int MAX_ENTRANCE_WIDTH = 6;
+
+    /**
+     * @brief Build the graph for a map
+     * @param map Map to cover (must outlive the pathfinder's use of it)
+     */
+    void build(const Map& map);
+
+    /**
+     * @brief Bring the graph up to date with the map
+     * @param map Map to cover
+     * @return true if anything was rebuilt
+     *
+     * A different map, a resize or a lost change history rebuilds
+     * everything; otherwise only clusters with changed tiles.
+     */
+    bool update(const Map& map);
+
+    /**
+     * @brief Find the abstract route between two tiles
+     * @param start Start position
+     * @param goal Goal position
+     * @param route Receives waypoints after start, ending with goal;
+     *        consecutive waypoints share a region or are adjacent
+     * @return false if goal is unreachable (route is empty)
+     */
+    bool findRoute(const Point& start, const Point& goal, std::vector<Point>& route);
+
+    /**
+     * @brief Find a full tile path via the abstract route
+     * @param path Receives the steps after start, ending with goal
+     * @return false if goal is unreachable (path is empty)
+     */
+    bool findPath(const Point& start, const Point& goal, std::vector<Point>& path);
+
+    /**
+     * @brief Refine only the part of the route that leaves start's region
+     * @param path Receives the steps up to and including the first tile
+     *        outside start's region (or up to goal if it is in the region)
+     * @return false if goal is unreachable (path is empty)
+     */
+    bool findNextSegment(const Point& start, const Point& goal, std::vector<Point>& path);
+
+    bool isBuilt() const { return built; }
+    int getClusterCount() const { return static_cast<int>(clusters.size()); }
+    /// Number of live regions
+    int getRegionCount() const;
+    /// Number of live abstract nodes
+    int getNodeCount() const;
+    /// Clusters rebuilt by the last build() or update()
+    int getRebuiltClusterCount() const { return rebuilt_clusters; }
+    /// Abstract nodes expanded by the last route search
+    int getExpandedCount() const { return expanded; }
+
+private:
+    struct Edge {
+        uint32_t to;
+        uint32_t cost;   ///< Steps
+    };
+
+    struct Node {
+        Point pos;
+        int32_t region = -1;       ///< -1 when free
+        std::vector<Edge> edges;
+    };
+
+    struct Region {
+        int32_t cluster = -1;      ///< -1 when free
+        std::vector<uint32_t> nodes;
+    };
+
+    /// Bounding box of a cluster (inclusive)
+    struct Cluster {
+        int x0, y0, x1, y1;
+    };
+
+    /// A crossing between neighbouring tiles of different regions
+    struct Transition {
+        int32_t from_region;
+        int32_t to_region;
+        int direction;             ///< Index into Pathfinding::DIRECTIONS_4
+        Point from;
+    };
+
+    struct HeapEntry {
+        uint32_t f;
+        uint32_t g;
+        uint32_t node;             ///< GOAL_NODE for the goal
+        bool operator>(const HeapEntry& other) const { return f > other.f; }
+    };
+
+    static constexpr uint32_t GOAL_NODE = UINT32_MAX;
+
+    const Map* map = nullptr;
+    int width = 0;
+    int height = 0;
+    uint32_t walkability_version = 0;    ///< Map version the graph reflects
+    bool built = false;
+    int rebuilt_clusters = 0;
+    int expanded = 0;
+
+    std::vector<Cluster> clusters;
+    std::vector<int32_t> cluster_of;     ///< Per tile; fixed until the next build()
+    std::vector<int32_t> region_of;      ///< Per tile; -1 if not walkable
+    std::vector<int32_t> node_of;        ///< Per tile; -1 if no node there
+    std::vector<std::vector<int32_t>> cluster_regions;
+    std::vector<Region> regions;
+    std::vector<int32_t> free_regions;
+    std::vector<Node> nodes;
+    std::vector<uint32_t> free_nodes;
+
+    // Scratch reused between calls
+    std::vector<Point> changes;
+    std::vector<uint8_t> dirty_mark;     ///< Per cluster
+    std::vector<Transition> transitions;
+    std::vector<uint32_t> tile_stamp;    ///< Per tile, for region searches
+    std::vector<uint32_t> tile_dist;
+    std::vector<uint32_t> frontier;
+    uint32_t tile_generation = 0;
+    std::vector<uint32_t> node_stamp;    ///< Per node, for route searches
+    std::vector<uint32_t> node_g;
+    std::vector<uint32_t> node_parent;
+    std::vector<uint32_t> goal_cost;
+    std::vector<uint32_t> goal_stamp;
+    uint32_t node_generation = 0;
+    std::vector<HeapEntry> open;
+    std::vector<uint32_t> route_nodes;
+    std::vector<Point> waypoints;
+    PathfindingContext context;
+    std::vector<Point> segment;
+
+    size_t index(int x, int y) const { return static_cast<size_t>(y) * width + x; }
+    size_t index(const Point& p) const { return index(p.x, p.y); }
+
+    void assignClusters();
+    void rebuildClusters(const std::vector<int32_t>& dirty);
+    void fillRegions(int32_t cluster);
+    void collectTransitions(int32_t cluster);
+    void addEntrances(std::vector<int32_t>& touched);
+    void connectRegion(int32_t region);
+    void searchRegion(const Point& from);
+
+    int32_t allocateRegion(int32_t cluster);
+    uint32_t nodeAt(const Point& pos, int32_t region);
+    void freeNode(uint32_t node);
+    void addEdge(uint32_t from, uint32_t to, uint32_t cost);
+    void removeEdge(uint32_t from, uint32_t to);
+
+    bool refineTo(const Point& from, const Point& to, std::vector<Point>& path);
+};
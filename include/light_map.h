@@ -0,0 +1,133 @@
+/**
+ * @file light_map.h
+ * @brief Accumulated illumination from dynamic light sources
+ * @author Veyrm Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include "bitboard.h"
+#include "point.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class Map;
+
+/**
+ * @class LightMap
+ * @brief Per-tile light levels summed over every light source
+ *
+ * Each light keeps the contribution it last cast (tile indices and
+ * amounts), so a light that has not moved costs nothing per update.
+ * A light is recast only when it is added, moved or changed, or when
+ * a tile within its radius changed transparency (see
+ * Map::getTransparencyChanges()); its old contribution is subtracted
+ * and the new one added, leaving every other light untouched.
+ *
+ * Light spreads like the player's field of view (FOV shadowcasting)
+ * and falls off linearly with distance. Levels saturate at MAX_LEVEL.
+ *
+ * @code
+ * LightMap lights;
+ * lights.setLight(torch_id, Point(10, 5), 6);
+ * lights.update(map);
+ * if (lights.isLit(12, 5)) { ... }
+ * @endcode
+ *
+ * @see ecs::LightSystem
+ */
+class LightMap {
+public:
+    using LightId = uint64_t;
+
+    /// Brightest level a tile reports
+    static constexpr int MAX_LEVEL = 255;
+
+    /**
+     * @brief Add a light or change an existing one
+     * @param id Caller-chosen identifier (e.g. entity ID)
+     * @param position Light position
+     * @param radius Reach in tiles
+     * @param intensity Level at the light's own tile (clamped to MAX_LEVEL)
+     *
+     * Only marks the light for recasting when something differs; the
+     * work happens in update().
+     */
+    void setLight(LightId id, const Point& position, int radius, int intensity = MAX_LEVEL);
+
+    /**
+     * @brief Remove a light and its contribution
+     * @param id Light identifier
+     */
+    void removeLight(LightId id);
+
+    /**
+     * @brief Remove every light not listed
+     * @param ids Lights to keep
+     */
+    void retain(const std::vector<LightId>& ids);
+
+    /// Check if a light is registered
+    bool hasLight(LightId id) const { return lights.count(id) > 0; }
+
+    /// Remove every light
+    void clear();
+
+    /**
+     * @brief Recast changed lights and fold them into the light levels
+     * @param map Map the lights shine on
+     * @return true if any tile's level changed since the previous update
+     *
+     * A different map, or a map whose size changed, recasts every light.
+     */
+    bool update(const Map& map);
+
+    /**
+     * @brief Get the light level of a tile
+     * @return Level 0..MAX_LEVEL (0 out of bounds)
+     */
+    uint8_t getLevel(int x, int y) const {
+        if (x < 0 || x >= width || y < 0 || y >= height) return 0;
+        uint16_t level = levels[static_cast<size_t>(y) * width + x];
+        return static_cast<uint8_t>(level < MAX_LEVEL ? level : MAX_LEVEL);
+    }
+
+    /// Check if any light reaches a tile
+    bool isLit(int x, int y) const { return lit.test(x, y); }
+
+    /// Tiles with a non-zero level
+    const Bitboard& getLitTiles() const { return lit; }
+
+    size_t getLightCount() const { return lights.size(); }
+
+    /// Number of lights recast by the last update()
+    int getRecastCount() const { return recast_count; }
+
+private:
+    struct Light {
+        Point position;
+        int radius = 0;
+        int intensity = 0;
+        bool dirty = true;                ///< Needs recasting
+        std::vector<uint32_t> tiles;      ///< Tile indices last lit
+        std::vector<uint16_t> amounts;    ///< Level added to each tile
+    };
+
+    const Map* map = nullptr;             ///< Map the levels belong to
+    int width = 0;
+    int height = 0;
+    uint32_t transparency_version = 0;    ///< Map version the casts reflect
+    std::unordered_map<LightId, Light> lights;
+    std::vector<uint16_t> levels;         ///< Summed levels, row-major
+    Bitboard lit;                         ///< levels != 0
+    bool levels_changed = false;          ///< Set between updates
+    int recast_count = 0;
+    std::vector<Point> changes;           ///< Scratch for transparency changes
+    std::vector<Point> scratch;           ///< Scratch for octant casts
+
+    void subtract(Light& light);
+    void cast(Light& light);
+    void markDirtyNear(const Point& tile);
+};
@@ -10,8 +10,10 @@
 #include "tile.h"
 #include "point.h"
 #include "room.h"
+#include "bitboard.h"
+#include <cstdint>
+#include <string>
 #include <vector>
-#include <map>
 
 /**
  * @class Map
@@ -21,6 +23,13 @@
  * It handles tile storage, visibility tracking, exploration state,
  * and provides methods for querying tile properties.
  *
+ * Tiles live in one row-major array alongside a byte of cached
+ * walkable/transparent flags per tile, so movement and sight queries
+ * are a bounds check and a load. Visibility and exploration are kept
+ * as bitplanes (one bit per tile), and the walkable, transparent and
+ * wall layers are also mirrored into Bitboards for word-parallel
+ * neighbourhood and connectivity work.
+ *
  * @note Uses classic Angband dimensions (198x66) by default
  * @see TileType
  * @see MapGenerator
@@ -77,20 +86,106 @@ public:
      */
     void setTile(const Point& pos, TileType type);
     
-    // Properties
-    bool isWalkable(int x, int y) const;
-    bool isWalkable(const Point& pos) const;
-    bool isTransparent(int x, int y) const;
-    bool isTransparent(const Point& pos) const;
-    bool inBounds(int x, int y) const;
-    bool inBounds(const Point& pos) const;
+    // Properties (inline: these sit in FOV and pathfinding inner loops)
+    bool isWalkable(int x, int y) const {
+        return inBounds(x, y) && (flags[index(x, y)] & FLAG_WALKABLE);
+    }
+    bool isWalkable(const Point& pos) const { return isWalkable(pos.x, pos.y); }
+    bool isTransparent(int x, int y) const {
+        return inBounds(x, y) && (flags[index(x, y)] & FLAG_TRANSPARENT);
+    }
+    bool isTransparent(const Point& pos) const { return isTransparent(pos.x, pos.y); }
+    bool inBounds(int x, int y) const {
+        return x >= 0 && x < width && y >= 0 && y < height;
+    }
+    bool inBounds(const Point& pos) const { return inBounds(pos.x, pos.y); }
     
-    // Visibility (for future FOV)
-    bool isVisible(int x, int y) const;
+    // Visibility
+    bool isVisible(int x, int y) const {
+        return inBounds(x, y) && testBit(visible, index(x, y));
+    }
     void setVisible(int x, int y, bool visible);
-    bool isExplored(int x, int y) const;
+    bool isExplored(int x, int y) const {
+        return inBounds(x, y) && testBit(explored, index(x, y));
+    }
     void setExplored(int x, int y, bool explored);
 
+    // Bitboard layers (kept in sync by setTile()/fill())
+
+    /// Walkable tiles, one bit each
+    const Bitboard& getWalkableBits() const { return walkable_bits; }
+    /// Tiles sight passes through
+    const Bitboard& getTransparentBits() const { return transparent_bits; }
+    /// Walls and closed doors (what wall connection treats as wall)
+    const Bitboard& getWallBits() const { return wall_bits; }
+
+    /**
+     * @brief Check whether a tile type counts as a wall for connections
+     * @param type Tile type
+     * @return true for walls and closed doors
+     */
+    static constexpr bool isWallLike(TileType type) {
+        return type == TileType::WALL || type == TileType::DOOR_CLOSED;
+    }
+
+    // Transparency tracking (for incremental FOV)
+
+    /**
+     * @brief Get the transparency version
+     * @return Counter bumped whenever a tile's transparency changes
+     */
+    uint32_t getTransparencyVersion() const { return transparency.version; }
+
+    /**
+     * @brief Get tiles whose transparency changed after a version
+     * @param since Version previously read from getTransparencyVersion()
+     * @param changes Receives the changed positions (may repeat)
+     * @return false if the history no longer reaches back to since
+     *         (e.g. after fill()); treat everything as changed
+     */
+    bool getTransparencyChanges(uint32_t since, std::vector<Point>& changes) const;
+
+    // Walkability tracking (for cached fields and paths)
+
+    /**
+     * @brief Get the walkability version
+     * @return Counter bumped whenever a tile's walkability changes
+     *
+     * Not implied by the transparency version: water and lava block
+     * movement but not sight.
+     */
+    uint32_t getWalkabilityVersion() const { return walkability.version; }
+
+    /**
+     * @brief Get tiles whose walkability changed after a version
+     * @param since Version previously read from getWalkabilityVersion()
+     * @param changes Receives the changed positions (may repeat)
+     * @return false if the history no longer reaches back to since
+     *         (e.g. after fill()); treat everything as changed
+     */
+    bool getWalkabilityChanges(uint32_t since, std::vector<Point>& changes) const {
+        return walkability.changesSince(since, changes);
+    }
+
+    /// Side of the square chunks walkability versions are kept for
+    static constexpr int CHUNK_SIZE = 16;
+
+    /**
+     * @brief Get the chunk holding a tile
+     * @return Chunk index for getChunkVersion(); the tile must be in bounds
+     */
+    int getChunkIndex(int x, int y) const {
+        return (y / CHUNK_SIZE) * chunks_wide + x / CHUNK_SIZE;
+    }
+    int getChunkIndex(const Point& pos) const { return getChunkIndex(pos.x, pos.y); }
+
+    /**
+     * @brief Get a chunk's walkability version
+     * @param chunk Index from getChunkIndex()
+     * @return Counter bumped whenever a tile in the chunk changes walkability
+     */
+    uint32_t getChunkVersion(int chunk) const { return chunk_versions[static_cast<size_t>(chunk)]; }
+
     // Clear visibility/exploration (for level transitions)
     void clearVisibility();
     void clearExploration();
@@ -109,8 +204,15 @@ public:
     int getWidth() const { return width; }
     int getHeight() const { return height; }
     
-    // Get tile properties for a given tile type
-    static TileProperties getTileProperties(TileType type);
+    /**
+     * @brief Get tile properties for a given tile type
+     * @param type Tile type
+     * @return Entry in the constexpr TILE_PROPERTIES table
+     */
+    static constexpr const TileProperties& getTileProperties(TileType type) {
+        auto i = static_cast<size_t>(type);
+        return i < TILE_PROPERTIES.size() ? TILE_PROPERTIES[i] : TILE_PROPERTIES[static_cast<size_t>(TileType::VOID)];
+    }
     
     // Room management
     void addRoom(const Room& room);
@@ -122,13 +224,53 @@ public:
     void clearRooms() { rooms.clear(); }
     
 private:
+    static constexpr uint8_t FLAG_WALKABLE = 1 << 0;     ///< Tile can be walked on
+    static constexpr uint8_t FLAG_TRANSPARENT = 1 << 1;  ///< Tile lets sight through
+
     int width;
     int height;
-    std::vector<std::vector<TileType>> tiles;
-    std::vector<std::vector<bool>> visible;
-    std::vector<std::vector<bool>> explored;
+    std::vector<TileType> tiles;     ///< Row-major tile types
+    std::vector<uint8_t> flags;      ///< Row-major FLAG_* bits, kept in sync with tiles
+    std::vector<uint64_t> visible;   ///< Visibility bitplane
+    std::vector<uint64_t> explored;  ///< Exploration bitplane
+    Bitboard walkable_bits;          ///< Bitboard mirror of FLAG_WALKABLE
+    Bitboard transparent_bits;       ///< Bitboard mirror of FLAG_TRANSPARENT
+    Bitboard wall_bits;              ///< Bitboard of isWallLike() tiles
     std::vector<Room> rooms;  // Store all rooms in the map
-    
-    // Tile properties lookup
-    static const std::map<TileType, TileProperties> tileProperties;
+
+    /**
+     * @struct TileChangeLog
+     * @brief Version counter with a bounded history of changed tiles
+     */
+    struct TileChangeLog {
+        /// Most changes remembered for changesSince()
+        static constexpr size_t MAX_LOG = 256;
+
+        uint32_t version = 0;         ///< Bumped per change
+        uint32_t log_start = 0;       ///< Version the log starts after
+        std::vector<Point> log;       ///< Change i produced version log_start + i + 1
+
+        void record(int x, int y);
+        void reset();                 ///< Bump the version and drop the history
+        bool changesSince(uint32_t since, std::vector<Point>& changes) const;
+    };
+
+    TileChangeLog transparency;                ///< Transparency changes
+    TileChangeLog walkability;                 ///< Walkability changes
+
+    int chunks_wide;                           ///< Chunks per row
+    std::vector<uint32_t> chunk_versions;      ///< Walkability version per chunk
+
+    size_t index(int x, int y) const {
+        return static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x);
+    }
+
+    static bool testBit(const std::vector<uint64_t>& plane, size_t i) {
+        return (plane[i >> 6] >> (i & 63)) & 1;
+    }
+
+    static uint8_t flagsFor(TileType type) {
+        const TileProperties& props = getTileProperties(type);
+        return (props.walkable ? FLAG_WALKABLE : 0) | (props.transparent ? FLAG_TRANSPARENT : 0);
+    }
 };
\ No newline at end of file
@@ -9,6 +9,7 @@
 
 #include "point.h"
 #include "room.h"
+#include "bitboard.h"
 #include <string>
 #include <vector>
 #include <random>
@@ -541,6 +542,18 @@ public:
      */
     static void checkAndPlaceDoor(Map& map, int x, int y);
 
+    /**
+     * @brief Find every tile that could hold a doorway
+     * @param map The map to analyze
+     * @return Bitboard of wall tiles with walkable tiles on two opposite
+     *         sides and walls on the other two
+     *
+     * Computed from the map's bitboard layers a word at a time. This is a
+     * superset of the positions checkAndPlaceDoor() accepts, so callers
+     * can skip every tile outside it.
+     */
+    static Bitboard findDoorwayCandidates(const Map& map);
+
     /**
      * @brief Find all points where corridors intersect with rooms
      * @param map The map to analyze
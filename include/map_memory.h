@@ -25,6 +25,10 @@ public:
     
     // Update visibility based on FOV calculation
     void updateVisibility(const Map& map, const std::vector<std::vector<bool>>& fov);
+
+    // Apply only the tiles that entered or left view (see FOVCache)
+    void updateVisibility(const Map& map, const std::vector<Point>& entered,
+                          const std::vector<Point>& left);
     
     // Query methods
     bool isExplored(int x, int y) const;
@@ -87,10 +87,6 @@ public:
     static Point findFirstFloorTile(const Map& map);
     
 private:
-    // Flood fill to check connectivity
-    static void floodFill(const Map& map, int x, int y, 
-                          std::vector<std::vector<bool>>& visited);
-    
     // Enhanced BFS flood fill
     static std::set<Point> bfsFloodFill(const Map& map, const Point& start);
     
@@ -0,0 +1,130 @@
+/**
+ * @file moving_target_search.h
+ * @brief Incremental A* that survives moves of the searcher and its target
+ * @author Veyrm Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include "point.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class Map;
+
+/**
+ * @class MovingTargetSearch
+ * @brief One monster's A* search tree, repaired between turns
+ *
+ * Replanning from scratch every time a chased target takes a step
+ * repeats almost all of the previous search. This keeps the search
+ * tree (rooted at the searcher) and repairs it instead:
+ *
+ * - The searcher stepped onto a tile it had already expanded: the
+ *   subtree under that tile keeps exact distances, so it becomes the
+ *   new tree and the rest is dropped (fringe-retrieving A*).
+ * - The target moved: distances from the root do not depend on the
+ *   goal, so the open list is re-keyed for the new goal and the search
+ *   resumes; a goal inside the expanded area costs no expansions.
+ * - A tile in the tree became blocked (a door closed): only the subtree
+ *   that ran through it is dropped. A tile next to the tree opening up
+ *   may shorten any route, so that restarts the search.
+ *
+ * Moves are cardinal and cost one step, matching monster movement.
+ * The tree holds at most the node limit given at construction; a search
+ * that needs more gives up (and forgets its state) so callers can fall
+ * back to a one-off search, bounding the memory each monster keeps.
+ *
+ * @code
+ * MovingTargetSearch search;
+ * if (search.findPath(map, monster_pos, target_pos, path)) {
+ *     step(path.front());
+ * }
+ * @endcode
+ *
+ * @see Pathfinding for one-off searches
+ */
+class MovingTargetSearch {
+public:
+    /// Default cap on remembered tiles (roughly 50 bytes each with hashing)
+    static constexpr size_t DEFAULT_NODE_LIMIT = 2048;
+
+    explicit MovingTargetSearch(size_t node_limit = DEFAULT_NODE_LIMIT) : node_limit(node_limit) {}
+
+    /**
+     * @brief Find a path, reusing the previous search where possible
+     * @param map Map to search
+     * @param start Searcher position
+     * @param goal Target position
+     * @param path Receives the steps after start, ending with goal
+     * @return false if goal is unreachable or the node limit was hit
+     *        (path is empty)
+     */
+    bool findPath(const Map& map, const Point& start, const Point& goal, std::vector<Point>& path);
+
+    /// Forget the search tree
+    void reset();
+
+    /// Whether the last findPath() gave up at the node limit
+    bool hitNodeLimit() const { return limit_hit; }
+    /// Tiles expanded by the last findPath()
+    int getExpandedCount() const { return expanded; }
+    /// Tiles currently remembered
+    size_t getNodeCount() const { return records.size(); }
+    size_t getNodeLimit() const { return node_limit; }
+
+private:
+    enum : uint8_t { OPEN, CLOSED };
+
+    struct Record {
+        uint32_t g;          ///< Steps from the root plus g_offset (exact once CLOSED)
+        uint32_t parent;     ///< Tile index, or NONE for the root
+        uint32_t first_child = NONE;
+        uint32_t next_sibling = NONE;
+        uint8_t state = OPEN;
+    };
+
+    struct HeapEntry {
+        uint32_t f;
+        uint32_t g;          ///< Record::g when pushed, to spot stale entries
+        uint32_t index;
+        bool operator>(const HeapEntry& other) const {
+            // Prefer deeper entries on ties, like Pathfinding
+            return f > other.f || (f == other.f && g < other.g);
+        }
+    };
+
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    size_t node_limit;
+    const Map* map = nullptr;
+    int width = 0;
+    int height = 0;
+    uint32_t walkability_version = 0;
+    bool valid = false;
+    bool limit_hit = false;
+    int expanded = 0;
+    uint32_t root = 0;
+    uint32_t g_offset = 0;   ///< Subtracted from Record::g; rerooting adds to it
+
+    std::unordered_map<uint32_t, Record> records;
+    std::vector<HeapEntry> open;
+    std::vector<Point> changes;
+    std::vector<uint32_t> removed;
+    std::vector<uint32_t> chain;
+
+    uint32_t index(const Point& p) const { return static_cast<uint32_t>(p.y * width + p.x); }
+    Point position(uint32_t i) const { return Point(static_cast<int>(i % width), static_cast<int>(i / width)); }
+
+    void restart(const Map& map, const Point& start);
+    bool applyMapChanges(const Map& map);
+    bool reroot(uint32_t new_root);
+    void detach(uint32_t subtree);
+    bool refillFringe();
+    void link(uint32_t child, uint32_t parent);
+    void unlink(uint32_t child);
+    void rebuildOpen(const Point& goal);
+    bool search(const Point& goal);
+};
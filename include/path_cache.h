@@ -0,0 +1,171 @@
+/**
+ * @file path_cache.h
+ * @brief Paths shared between monsters heading for the same place
+ * @author Veyrm Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include "point.h"
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class Map;
+
+/**
+ * @class SharedPath
+ * @brief Remaining steps of a path, possibly shared with other walkers
+ *
+ * Holds a reference to an immutable step list plus a read position, so
+ * handing a cached path to a monster and walking it never copies the
+ * steps. A short leg of its own may lead onto the shared steps.
+ * Supports the deque operations monsters use on their paths.
+ */
+class SharedPath {
+public:
+    using Steps = std::shared_ptr<const std::vector<Point>>;
+
+    SharedPath() = default;
+
+    /**
+     * @brief Walk shared steps
+     * @param steps Steps to share
+     * @param offset Index of the first remaining step
+     * @param lead Steps walked before reaching steps[offset]
+     */
+    explicit SharedPath(Steps steps, size_t offset = 0, std::vector<Point> lead = {})
+        : lead(std::move(lead)), steps(std::move(steps)), offset(offset) {}
+
+    bool empty() const { return size() == 0; }
+    size_t size() const { return lead.size() - lead_offset + (steps ? steps->size() - offset : 0); }
+
+    const Point& front() const { return lead_offset < lead.size() ? lead[lead_offset] : (*steps)[offset]; }
+    const Point& back() const { return steps && offset < steps->size() ? steps->back() : lead.back(); }
+    const Point& operator[](size_t i) const;
+
+    void pop_front();
+    void clear();
+
+    /// Replace with a private copy of [first, last)
+    template <typename It>
+    void assign(It first, It last) {
+        *this = SharedPath(std::make_shared<const std::vector<Point>>(first, last));
+    }
+
+    /// Remaining shared steps (after any lead leg), without copying
+    std::span<const Point> span() const;
+
+    /// Whether the steps are shared with a cache or other walkers
+    bool isShared() const { return steps && steps.use_count() > 1; }
+
+private:
+    std::vector<Point> lead;   ///< Own steps onto the shared ones
+    size_t lead_offset = 0;
+    Steps steps;
+    size_t offset = 0;
+};
+
+/**
+ * @class PathCache
+ * @brief Recently found paths, shared by walkers with the same errand
+ *
+ * Monsters in one room often want nearly the same path: to the stairs,
+ * to where the player was last seen, to a patrol point. Entries are keyed
+ * by (start region, goal, movement mode), the start region being the
+ * Map chunk the path begins in. A walker anywhere in that chunk reuses
+ * the entry: from a tile on the path it gets the rest of the steps as a
+ * shared span; from elsewhere a breadth-first search confined to the
+ * chunk finds the cheapest way onto the path.
+ *
+ * Each entry remembers the walkability version of every chunk it passes
+ * through and is dropped as soon as one of them changes, so cached paths
+ * are never blocked. A change elsewhere that opens a shortcut does not
+ * invalidate them; they may then be a little longer than necessary.
+ *
+ * Not thread-safe.
+ *
+ * @code
+ * SharedPath path;
+ * if (!cache.lookup(map, from, to, false, path)) {
+ *     if (Pathfinding::findPath(from, to, map, context, steps, false)) {
+ *         path = cache.store(map, from, to, false, std::move(steps));
+ *     }
+ * }
+ * @endcode
+ */
+class PathCache {
+public:
+    /// Default number of entries kept
+    static constexpr size_t DEFAULT_CAPACITY = 256;
+
+    explicit PathCache(size_t capacity = DEFAULT_CAPACITY) : capacity(capacity) {}
+
+    /**
+     * @brief Look up a path
+     * @param map Map walked
+     * @param start Walker position
+     * @param goal Destination
+     * @param allow_diagonals Movement mode
+     * @param path Receives the steps after start, ending with goal
+     * @return true on a hit; counts a hit or a miss
+     */
+    bool lookup(const Map& map, const Point& start, const Point& goal, bool allow_diagonals, SharedPath& path);
+
+    /**
+     * @brief Add a freshly found path
+     * @param map Map walked
+     * @param start Where the path begins
+     * @param goal Destination
+     * @param allow_diagonals Movement mode the path was found with
+     * @param steps Steps after start, ending with goal
+     * @return The stored steps, shared with the cache
+     */
+    SharedPath store(const Map& map, const Point& start, const Point& goal, bool allow_diagonals,
+                     std::vector<Point> steps);
+
+    /// Drop every entry
+    void clear();
+
+    size_t size() const { return entries.size(); }
+    size_t getCapacity() const { return capacity; }
+
+    /// Hits since resetStats()
+    int getHits() const { return hits; }
+    /// Misses since resetStats()
+    int getMisses() const { return misses; }
+    void resetStats() { hits = 0; misses = 0; }
+
+private:
+    struct Entry {
+        Point start;                                     ///< Where the steps begin
+        SharedPath::Steps steps;                         ///< Steps after start
+        std::vector<std::pair<int, uint32_t>> chunks;    ///< (chunk, version) of chunks crossed
+        uint64_t last_used = 0;
+    };
+
+    size_t capacity;
+    const Map* map = nullptr;
+    int width = 0;
+    int height = 0;
+    uint64_t tick = 0;
+    int hits = 0;
+    int misses = 0;
+    std::unordered_map<uint64_t, Entry> entries;
+
+    // Scratch for join(), one slot per tile of a chunk
+    static constexpr int NONE = -1;
+    std::vector<int> join_remaining;  ///< Steps left after reaching a path tile
+    std::vector<int> join_parent;
+    std::vector<int> join_depth;
+    std::vector<int> join_queue;
+
+    void bind(const Map& map);
+    uint64_t key(const Point& start, const Point& goal, bool allow_diagonals) const;
+    bool isCurrent(const Map& map, const Entry& entry) const;
+    bool join(const Map& map, const Point& start, const Entry& entry, SharedPath& path);
+};
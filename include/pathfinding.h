@@ -8,13 +8,54 @@
 #pragma once
 
 #include "point.h"
+#include <cstddef>
+#include <cstdint>
 #include <vector>
-#include <queue>
-#include <map>
-#include <functional>
 
 class Map;
 
+/**
+ * @class PathfindingContext
+ * @brief Reusable scratch state for A* searches
+ *
+ * Holds flat per-tile cost and parent arrays sized to the map, plus the
+ * open-list heap. Nothing is cleared between searches: each search bumps
+ * a generation counter and a tile's entries only count when its stamp
+ * matches, so after the first search on a map size a search allocates
+ * nothing but its result.
+ *
+ * Not thread-safe; use one context per thread.
+ *
+ * @see Pathfinding::findPath()
+ */
+class PathfindingContext {
+public:
+    /// Nodes taken off the open list by the last search
+    size_t getExpandedCount() const { return expanded; }
+
+private:
+    friend class Pathfinding;
+
+    /// Open-list entry; costs are in Pathfinding::STRAIGHT_COST units
+    struct HeapEntry {
+        uint32_t f;      ///< g + heuristic
+        uint32_t g;      ///< Cost from the start
+        uint32_t index;  ///< Tile index (y * width + x)
+    };
+
+    int width = 0;
+    int height = 0;
+    uint32_t generation = 0;           ///< Stamp of the current search
+    std::vector<uint32_t> stamps;      ///< Search a tile was last reached in
+    std::vector<uint32_t> g_scores;    ///< Best known cost, valid when stamped
+    std::vector<uint32_t> parents;     ///< Predecessor tile index, valid when stamped
+    std::vector<HeapEntry> open;       ///< Binary min-heap on (f, -g)
+    size_t expanded = 0;
+
+    /// Size the arrays for a map and start a new generation
+    void begin(int map_width, int map_height);
+};
+
 /**
  * @class Pathfinding
  * @brief Static utilities for pathfinding and spatial analysis
@@ -35,6 +76,11 @@ class Map;
  */
 class Pathfinding {
 public:
+    /// Cost of a cardinal step
+    static constexpr uint32_t STRAIGHT_COST = 100;
+    /// Cost of a diagonal step (~sqrt(2) * STRAIGHT_COST)
+    static constexpr uint32_t DIAGONAL_COST = 141;
+
     /**
      * @brief Find optimal path using A* algorithm
      * @param start Starting position
@@ -42,9 +88,26 @@ public:
      * @param map Map to navigate
      * @param allow_diagonals Allow diagonal movement (default: true)
      * @return Vector of points forming path (empty if no path found)
+     *
+     * Uses a per-thread PathfindingContext, so repeated calls do not
+     * reallocate search state.
      */
     static std::vector<Point> findPath(const Point& start, const Point& goal, const Map& map, bool allow_diagonals = true);
 
+    /**
+     * @brief Find optimal path using caller-owned search state
+     * @param start Starting position
+     * @param goal Target position
+     * @param map Map to navigate
+     * @param context Scratch state reused across searches
+     * @param path Receives the path, start excluded, goal included
+     * @param allow_diagonals Allow diagonal movement (default: true)
+     * @return true if a path was found (path is cleared otherwise)
+     */
+    static bool findPath(const Point& start, const Point& goal, const Map& map,
+                         PathfindingContext& context, std::vector<Point>& path,
+                         bool allow_diagonals = true);
+
     /**
      * @brief Check if there's unobstructed line of sight between points
      * @param from Source position
@@ -69,42 +132,11 @@ public:
 
 private:
     /**
-     * @struct Node
-     * @brief A* algorithm node for pathfinding
-     */
-    struct Node {
-        Point pos;        ///< Position of this node
-        float g_cost;     ///< Distance from start to this node
-        float f_cost;     ///< Total estimated cost (g_cost + heuristic)
-
-        /** @brief Priority queue comparison (lower f_cost has higher priority) */
-        bool operator>(const Node& other) const {
-            return f_cost > other.f_cost;
-        }
-    };
-
-    /**
-     * @brief Calculate heuristic distance for A*
+     * @brief Octile distance heuristic for A*
      * @param a Starting point
      * @param b Target point
-     * @return Heuristic cost estimate
-     */
-    static float heuristic(const Point& a, const Point& b);
-
-    /**
-     * @brief Get walkable neighbor positions
-     * @param pos Current position
-     * @param map Map to check walkability
-     * @param allow_diagonals Include diagonal neighbors
-     * @return Vector of walkable neighbor positions
-     */
-    static std::vector<Point> getNeighbors(const Point& pos, const Map& map, bool allow_diagonals);
-
-    /**
-     * @brief Reconstruct path from A* came_from map
-     * @param came_from Map of position -> previous position
-     * @param current Final position reached
-     * @return Complete path from start to goal
+     * @param allow_diagonals Whether diagonal steps are allowed
+     * @return Cost estimate in STRAIGHT_COST units (Manhattan without diagonals)
      */
-    static std::vector<Point> reconstructPath(const std::map<Point, Point>& came_from, const Point& current);
-};
\ No newline at end of file
+    static uint32_t heuristic(const Point& a, const Point& b, bool allow_diagonals);
+};
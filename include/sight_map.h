@@ -0,0 +1,93 @@
+/**
+ * @file sight_map.h
+ * @brief Shared per-turn visibility bitset for line-of-sight queries
+ * @author Veyrm Team
+ * @date 2025
+ */
+
+#ifndef SIGHT_MAP_H
+#define SIGHT_MAP_H
+
+#include "point.h"
+#include <cstdint>
+#include <vector>
+
+class Map;
+
+/**
+ * @class SightMap
+ * @brief One field of view, stored as a bitset, answering many LOS queries
+ *
+ * Computed once from a focal point (normally the player) per turn. FOV
+ * uses symmetric shadowcasting, so between transparent tiles "can a
+ * monster at P see the focus" is the same question as "is P lit from the
+ * focus", which is a single bit test instead of a field of view per
+ * monster. (An observer standing inside an opaque tile, such as a closed
+ * door, gets the answer for the tile, not its own view.)
+ *
+ * Tiles inside a smaller radius are lit exactly as a field of view of
+ * that radius would light them, so one SightMap cast at the largest
+ * vision range serves every observer; canSee() applies each observer's
+ * own range.
+ *
+ * Recomputing is skipped while the focus, radius and the map's
+ * transparency version are unchanged.
+ *
+ * @see FOV
+ */
+class SightMap {
+public:
+    /**
+     * @brief Bring the bitset up to date
+     * @param map Map to cast on
+     * @param focus Point every query is answered against
+     * @param radius Largest range any query will use
+     * @return true if the bitset was recomputed
+     */
+    bool compute(const Map& map, const Point& focus, int radius);
+
+    /**
+     * @brief Check mutual visibility between a tile and the focus
+     * @param x X coordinate
+     * @param y Y coordinate
+     * @return true if the tile and the focus can see each other
+     */
+    bool canSee(int x, int y) const {
+        if (x < 0 || x >= width || y < 0 || y >= height) return false;
+        size_t i = static_cast<size_t>(y) * width + x;
+        return (bits[i >> 6] >> (i & 63)) & 1;
+    }
+
+    /**
+     * @brief Check mutual visibility within an observer's range
+     * @param from Observer position
+     * @param range Observer's vision range (Euclidean)
+     * @return true if in range and in sight
+     */
+    bool canSee(const Point& from, int range) const {
+        int dx = from.x - focus.x;
+        int dy = from.y - focus.y;
+        return range <= radius && dx * dx + dy * dy <= range * range && canSee(from.x, from.y);
+    }
+
+    /// Clear the bitset so the next compute() recasts
+    void invalidate() { valid = false; }
+
+    const Point& getFocus() const { return focus; }
+    int getRadius() const { return radius; }
+    bool isValid() const { return valid; }
+
+private:
+    const Map* map = nullptr;           ///< Map the bitset was cast on
+    Point focus{-1, -1};                ///< Focal point
+    int radius = -1;                    ///< Radius cast with
+    uint32_t transparency_version = 0;  ///< Map version the bitset reflects
+    bool valid = false;                 ///< Whether bits hold a result
+
+    int width = 0;
+    int height = 0;
+    std::vector<uint64_t> bits;         ///< Row-major visibility bits
+    std::vector<Point> lit;             ///< Scratch for octant results
+};
+
+#endif // SIGHT_MAP_H
@@ -0,0 +1,148 @@
+/**
+ * @file simulation.h
+ * @brief Headless fast-forward of the game for soak and balance testing
+ * @author Veyrm Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "map_generator.h"
+#include "dijkstra_map.h"
+#include "frame_stats.h"
+#include "point.h"
+#include "ecs/system_manager.h"
+
+class GameManager;
+
+namespace ecs {
+    class ComponentObserver;
+}
+
+/**
+ * @struct SimulationOptions
+ * @brief What a headless run plays
+ */
+struct SimulationOptions {
+    int turns = 1000;                         ///< Player actions to simulate
+    unsigned int seed = 1;                    ///< Map and spawn seed (0 = random)
+    MapType map_type = MapType::PROCEDURAL;   ///< Level to play on
+};
+
+/**
+ * @struct SimulationReport
+ * @brief Results and timings of a headless run
+ *
+ * Times are totals over the run in milliseconds. The world turn covers
+ * everything the TurnManager runs between player actions (monster AI,
+ * movement and combat); the AI tier times are the part of it spent in
+ * the AI system. The per-system times come from the ECS SystemManager
+ * and cut across the phases above.
+ */
+struct SimulationReport {
+    int turns = 0;               ///< Player actions taken
+    int world_time = 0;          ///< World time at the end
+    int levels = 0;              ///< Levels played (a new one after each death)
+    int deaths = 0;              ///< Times the player died
+    int kills = 0;               ///< Monsters killed
+    size_t monsters_left = 0;    ///< Monsters alive at the end
+
+    double seconds = 0.0;        ///< Wall-clock time of the turn loop
+    double policy_ms = 0.0;      ///< Choosing the player's moves
+    double player_ms = 0.0;      ///< Carrying out the player's moves
+    double world_ms = 0.0;       ///< World turns (monsters)
+    double fov_ms = 0.0;         ///< Field of view updates
+    std::array<double, FrameStats::AI_TIERS> ai_tier_ms{};  ///< AI time per level-of-detail tier
+    std::vector<ecs::SystemTiming> systems;  ///< ECS system times over the run
+
+    size_t peak_memory_kb = 0;   ///< Peak resident memory of the process (0 if unknown)
+
+    /// Player actions per wall-clock second
+    double getTurnsPerSecond() const { return seconds > 0.0 ? turns / seconds : 0.0; }
+
+    /**
+     * @brief Format the report for the console
+     * @return Multi-line summary
+     */
+    std::string format() const;
+};
+
+/**
+ * @class Simulation
+ * @brief Plays the game without a screen
+ *
+ * Runs the same GameManager, ECS world and TurnManager as the game, but
+ * nothing is rendered and no input is read: a scripted player fights any
+ * monster next to it, chases monsters in view and otherwise explores the
+ * nearest unexplored tiles (a Dijkstra map over the level). When the
+ * player dies a fresh level is generated from the next seed and the run
+ * carries on, so a run always lasts the requested number of turns.
+ *
+ * @code
+ * Simulation simulation({.turns = 10000, .seed = 42});
+ * std::cout << simulation.run().format();
+ * @endcode
+ *
+ * @see GameManager
+ * @see TurnManager
+ */
+class Simulation {
+public:
+    /**
+     * @brief Set up the game for a run
+     * @param options Turns, seed and map
+     */
+    explicit Simulation(const SimulationOptions& options);
+
+    /// Destructor
+    ~Simulation();
+
+    Simulation(const Simulation&) = delete;
+    Simulation& operator=(const Simulation&) = delete;
+
+    /**
+     * @brief Play every turn
+     * @return Results and timings
+     */
+    SimulationReport run();
+
+    /// Game being played
+    GameManager& getGameManager() { return *game_manager; }
+
+    /**
+     * @brief Get the peak resident memory of this process
+     * @return Kilobytes, or 0 where the platform cannot tell
+     */
+    static size_t getPeakMemoryKB();
+
+private:
+    SimulationOptions options;
+    std::unique_ptr<GameManager> game_manager;
+    ecs::ComponentObserver* death_observer = nullptr;  ///< Counts monster kills
+
+    SimulationReport report;
+    std::mt19937 rng;
+    DijkstraMap guide;                ///< Field towards the player's current goals
+    std::vector<Point> goals;         ///< Reused goal list for the guide
+    Point last_position{-1, -1};
+    int stuck_turns = 0;              ///< Turns without moving
+
+    /// Generate a level from a seed and start playing it
+    void startLevel(unsigned int seed);
+
+    /**
+     * @brief Pick the player's next move
+     * @param from Player position
+     * @return Direction to move or attack in (0, 0 to wait)
+     */
+    Point choosePlayerStep(const Point& from);
+
+    /// Hook the kill counter into the current ECS world
+    void watchDeaths();
+};
@@ -0,0 +1,120 @@
+/**
+ * @file thread_pool.h
+ * @brief Work-stealing thread pool for parallel game work
+ * @author Veyrm Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief Fixed set of worker threads with per-worker task queues
+ *
+ * Each worker owns a deque. Tasks submitted from a worker go to its own
+ * queue and are popped LIFO (cache-warm); tasks submitted from other
+ * threads are spread round-robin. An idle worker steals the oldest task
+ * from another worker's queue before going to sleep.
+ *
+ * The thread waiting on a batch of work should call helpUntil(), which
+ * runs queued tasks on the calling thread instead of blocking it.
+ *
+ * @code
+ * ThreadPool pool;
+ * std::atomic<int> left{2};
+ * pool.submit([&] { work_a(); --left; });
+ * pool.submit([&] { work_b(); --left; });
+ * pool.helpUntil([&] { return left == 0; });
+ * @endcode
+ */
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * @brief Start worker threads
+     * @param thread_count Number of workers (0 = defaultThreadCount())
+     */
+    explicit ThreadPool(size_t thread_count = 0);
+
+    /**
+     * @brief Stop workers after draining queued tasks
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Queue a task
+     * @param task Task to run (must not throw)
+     */
+    void submit(Task task);
+
+    /**
+     * @brief Run one queued task on the calling thread
+     * @return true if a task was run
+     */
+    bool runPendingTask();
+
+    /**
+     * @brief Run queued tasks on the calling thread until a condition holds
+     * @param done Predicate checked between tasks
+     */
+    template<typename Pred>
+    void helpUntil(Pred&& done) {
+        while (!done()) {
+            if (!runPendingTask()) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    /**
+     * @brief Get number of worker threads
+     * @return Worker count
+     */
+    size_t getThreadCount() const { return workers.size(); }
+
+    /**
+     * @brief Get number of queued tasks not yet started
+     * @return Pending task count
+     */
+    size_t getPendingCount() const { return pending.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Get default worker count for this host
+     * @return Hardware threads minus one (the caller helps), at least 1
+     */
+    static size_t defaultThreadCount();
+
+private:
+    /// Task queue owned by one worker
+    struct WorkerQueue {
+        std::mutex mutex;         ///< Guards tasks
+        std::deque<Task> tasks;   ///< Own end is back, thieves take front
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;  ///< One queue per worker
+    std::vector<std::thread> workers;                  ///< Worker threads
+    std::atomic<size_t> pending{0};                    ///< Queued (not started) tasks
+    std::atomic<size_t> next_queue{0};                 ///< Round-robin cursor
+    std::atomic<bool> stopping{false};                 ///< Set by destructor
+
+    std::mutex sleep_mutex;                 ///< Guards sleeping workers
+    std::condition_variable wake;           ///< Signalled when tasks arrive
+
+    void workerLoop(size_t index);
+    bool popTask(size_t index, Task& task);
+    bool stealTask(size_t thief, Task& task);
+};
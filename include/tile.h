@@ -8,7 +8,9 @@
 #pragma once
 
 #include <ftxui/screen/color.hpp>
-#include <string>
+#include <array>
+#include <cstddef>
+#include <string_view>
 
 using Color = ftxui::Color;
 
@@ -40,23 +42,40 @@ enum class TileType {
     UNKNOWN         ///< '?' - Unexplored tile (for saved memory)
 };
 
+/// Number of TileType values
+constexpr size_t TILE_TYPE_COUNT = static_cast<size_t>(TileType::UNKNOWN) + 1;
+
 /**
  * @struct TileProperties
  * @brief Properties that define tile appearance and behavior
  *
  * Contains all the data needed to render and simulate a tile type,
  * including visual representation, movement rules, and gameplay
- * mechanics.
+ * mechanics. Literal-only, so the whole table is constexpr.
  *
  * @see Map::getTileProperties()
  * @see ColorScheme
  */
 struct TileProperties {
-    std::string glyph;    ///< Display character (supports Unicode)
-    Color foreground;     ///< Text/glyph color
-    Color background;     ///< Background fill color
-    bool walkable;        ///< True if entities can move through
-    bool transparent;     ///< True if sight passes through (FOV)
-    bool destructible;    ///< True if tile can be modified/destroyed
-    std::string name;     ///< Human-readable name ("Stone Wall", etc.)
-};
\ No newline at end of file
+    std::string_view glyph;       ///< Display character (supports Unicode)
+    Color::Palette16 foreground;  ///< Text/glyph color
+    Color::Palette16 background;  ///< Background fill color
+    bool walkable;                ///< True if entities can move through
+    bool transparent;             ///< True if sight passes through (FOV)
+    bool destructible;            ///< True if tile can be modified/destroyed
+    std::string_view name;        ///< Human-readable name ("Stone Wall", etc.)
+};
+
+/// Properties of every tile type, indexed by TileType
+inline constexpr std::array<TileProperties, TILE_TYPE_COUNT> TILE_PROPERTIES = {{
+    {"·", Color::White,    Color::Black, true,  true,  false, "Stone Floor"},  // FLOOR
+    {"█", Color::Yellow,   Color::Black, false, false, true,  "Stone Wall"},   // WALL
+    {"▼", Color::Yellow,   Color::Black, true,  true,  false, "Stairs Down"},  // STAIRS_DOWN
+    {"▲", Color::Yellow,   Color::Black, true,  true,  false, "Stairs Up"},    // STAIRS_UP
+    {"▦", Color::Yellow,   Color::Black, false, false, true,  "Closed Door"},  // DOOR_CLOSED
+    {"▢", Color::Yellow,   Color::Black, true,  true,  false, "Open Door"},    // DOOR_OPEN
+    {"≈", Color::Cyan,     Color::Black, false, true,  false, "Water"},        // WATER
+    {"≈", Color::Red,      Color::Black, false, true,  false, "Lava"},         // LAVA
+    {" ", Color::Black,    Color::Black, false, false, false, "Void"},         // VOID
+    {"?", Color::GrayDark, Color::Black, false, false, false, "Unknown"},      // UNKNOWN
+}};
@@ -0,0 +1,116 @@
+/**
+ * @file timing_wheel.h
+ * @brief Hierarchical timing wheel for world-time events
+ * @author Veyrm Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @struct TimerNode
+ * @brief Intrusive entry of a TimingWheel
+ *
+ * Embed (or derive from) a node in whatever is being scheduled; the
+ * wheel links nodes together and never allocates.
+ */
+struct TimerNode {
+    int64_t when = 0;             ///< World time the node is due
+    TimerNode* prev = nullptr;
+    TimerNode* next = nullptr;
+    uint16_t bucket = 0;          ///< Slot list holding the node
+    bool linked = false;          ///< Currently scheduled
+};
+
+/**
+ * @class TimingWheel
+ * @brief Due-time queue with O(1) schedule and cancel
+ *
+ * Four levels of 64 slots. Level 0 holds one slot per time unit for the
+ * 64-unit window around the current time, and each level above covers
+ * 64 times the span of the one below. A node is filed in the lowest
+ * level whose window contains its due time; when the current time moves
+ * into a higher-level slot, that slot's nodes are refiled further down.
+ * Each node is therefore moved at most once per level. Occupancy bitmaps
+ * let the wheel skip empty slots, so a long stretch with nothing due
+ * costs a few bit scans. Nodes due more than 2^24 units ahead wait in an
+ * overflow list.
+ *
+ * Nodes due at the same time come out in the order they were scheduled.
+ */
+class TimingWheel {
+public:
+    static constexpr int SLOT_BITS = 6;
+    static constexpr int SLOTS = 1 << SLOT_BITS;
+    static constexpr int LEVELS = 4;
+
+    TimingWheel() = default;
+    TimingWheel(const TimingWheel&) = delete;
+    TimingWheel& operator=(const TimingWheel&) = delete;
+
+    /**
+     * @brief Schedule a node (rescheduling it if already linked)
+     * @param node Node to file
+     * @param when Due time; times before now() are due at once
+     */
+    void schedule(TimerNode& node, int64_t when);
+
+    /**
+     * @brief Remove a node if it is scheduled
+     */
+    void cancel(TimerNode& node);
+
+    /**
+     * @brief Get the earliest node due at or before a time
+     * @param until Latest due time wanted
+     * @return Node (still scheduled), or nullptr if none is due by then
+     *
+     * Advances now() to the node's due time.
+     */
+    TimerNode* peek(int64_t until);
+
+    /**
+     * @brief Remove and return the earliest node due at or before a time
+     * @param until Latest due time wanted
+     * @return Node, or nullptr if none is due by then
+     */
+    TimerNode* pop(int64_t until);
+
+    /// Time of the last node reached (new nodes are filed relative to it)
+    int64_t now() const { return current; }
+
+    /// Number of scheduled nodes
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    /**
+     * @brief Unlink every node and rewind to a time
+     * @param time New current time
+     */
+    void clear(int64_t time = 0);
+
+private:
+    static constexpr uint16_t OVERFLOW_BUCKET = LEVELS * SLOTS;
+
+    /// Doubly-linked slot list with a tail for FIFO order
+    struct List {
+        TimerNode* head = nullptr;
+        TimerNode* tail = nullptr;
+    };
+
+    std::array<List, LEVELS * SLOTS + 1> lists{};   ///< Level slots, then overflow
+    std::array<uint64_t, LEVELS> occupied{};        ///< Non-empty slots per level
+    int64_t current = 0;
+    size_t count = 0;
+
+    void file(TimerNode& node);
+    void link(TimerNode& node, uint16_t bucket);
+    void unlink(TimerNode& node);
+
+    /// Move the nodes of a bucket down to the levels they now belong in
+    void cascade(uint16_t bucket);
+};
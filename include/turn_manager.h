@@ -7,10 +7,11 @@
 
 #pragma once
 
+#include <deque>
 #include <vector>
-#include <functional>
-#include <queue>
 #include <memory>
+#include "timing_wheel.h"
+#include "ecs/entity_id.h"
 
 /**
  * @enum TurnPhase
@@ -38,22 +39,36 @@ enum class ActionSpeed {
 // Forward declarations
 class GameManager;
 
+/**
+ * @brief Callback of a scheduled action
+ * @param context Pointer given to TurnManager::scheduleAction()
+ */
+using ActionCallback = void (*)(void* context);
+
+/**
+ * @brief Runs the actors whose turn has come
+ * @param context Pointer given to TurnManager::setActorHandler()
+ * @param actors Actors due at the same world time, in schedule order
+ */
+using ActorHandler = void (*)(void* context, const std::vector<ecs::EntityID>& actors);
+
 /**
  * @struct ScheduledAction
  * @brief Action scheduled for future execution
  */
-struct ScheduledAction {
-    int executionTime;              ///< World time when action executes
-    std::function<void()> action;   ///< Function to execute
+struct ScheduledAction : TimerNode {
+    ActionCallback callback = nullptr;  ///< Function to execute
+    void* context = nullptr;            ///< Passed to callback
+};
 
-    /**
-     * @brief Comparison for priority queue (min-heap)
-     * @param other Action to compare with
-     * @return true if this executes later than other
-     */
-    bool operator>(const ScheduledAction& other) const {
-        return executionTime > other.executionTime;
-    }
+/**
+ * @struct ScheduledActor
+ * @brief Actor (monster) taking turns at its own speed
+ */
+struct ScheduledActor : TimerNode {
+    ecs::EntityID id = ecs::INVALID_ENTITY_ID;
+    int speed = 100;    ///< 100 acts once per normal turn, 200 twice
+    int carry = 0;      ///< Energy left over from rounding the last delay
 };
 
 /**
@@ -65,6 +80,15 @@ struct ScheduledAction {
  * point system where different actions have different time costs, allowing
  * for varied action speeds.
  *
+ * Monsters are actors with a speed: after acting, an actor waits the
+ * action's cost scaled by NORMAL_SPEED / speed (remainders carry over, so
+ * a speed-130 monster averages exactly 1.3 actions per normal turn).
+ * Actors and scheduled actions sit in timing wheels keyed by world time.
+ * Scheduling, cancelling and waking an actor are O(1), and nothing is
+ * allocated per action. After each player action, everything due before
+ * the player's next action runs in time order. Actors due at the same
+ * time are handed over together so the AI can batch them.
+ *
  * @see GameManager
  * @see ActionSpeed
  */
@@ -104,15 +128,66 @@ public:
     /**
      * @brief Schedule action for future execution
      * @param delay Delay in action points
-     * @param action Function to execute
+     * @param callback Function to execute
+     * @param context Passed to callback
+     *
+     * Runs in the world turn that reaches its time.
      */
-    void scheduleAction(int delay, std::function<void()> action);
+    void scheduleAction(int delay, ActionCallback callback, void* context = nullptr);
 
     /**
      * @brief Process all scheduled actions due
      */
     void processScheduledActions();
 
+    // Actor scheduling
+
+    /// Speed that acts once per NORMAL action
+    static constexpr int NORMAL_SPEED = 100;
+    static constexpr int MIN_SPEED = 10;
+    static constexpr int MAX_SPEED = 1000;
+
+    /**
+     * @brief Give an actor turns (updating its speed if it has them)
+     * @param id Actor entity
+     * @param speed Actor speed (clamped to MIN_SPEED..MAX_SPEED)
+     *
+     * A new actor first acts in the next world turn.
+     */
+    void addActor(ecs::EntityID id, int speed = NORMAL_SPEED);
+
+    /**
+     * @brief Stop giving an actor turns
+     * @param id Actor entity
+     */
+    void removeActor(ecs::EntityID id);
+
+    /**
+     * @brief Stop giving every actor turns (level change)
+     */
+    void clearActors();
+
+    /**
+     * @brief Change an actor's speed from its next turn on
+     */
+    void setActorSpeed(ecs::EntityID id, int speed);
+
+    /// Whether an actor has turns
+    bool hasActor(ecs::EntityID id) const { return findActor(id) != nullptr; }
+
+    /// Number of actors with turns
+    size_t getActorCount() const { return actor_count; }
+
+    /**
+     * @brief Run due actors somewhere other than GameManager::updateMonsters()
+     * @param handler Callback (nullptr for the game manager)
+     * @param context Passed to handler
+     */
+    void setActorHandler(ActorHandler handler, void* context = nullptr) {
+        actor_handler = handler;
+        actor_context = context;
+    }
+
     // Turn information
 
     /**
@@ -161,8 +236,22 @@ private:
     int player_next_action_time;
     TurnPhase current_phase;
     
-    // Priority queue for scheduled actions
-    std::priority_queue<ScheduledAction, 
-                       std::vector<ScheduledAction>, 
-                       std::greater<ScheduledAction>> action_queue;
+    TimingWheel action_wheel;                  ///< Scheduled actions by due time
+    std::deque<ScheduledAction> action_pool;   ///< Stable storage for actions
+    std::vector<ScheduledAction*> free_actions;
+
+    TimingWheel actor_wheel;                   ///< Actors by next turn
+    std::deque<ScheduledActor> actors;         ///< Indexed by entity slot (stable addresses)
+    size_t actor_count = 0;
+    std::vector<ecs::EntityID> ready_actors;   ///< Actors acting at the current time
+    ActorHandler actor_handler = nullptr;
+    void* actor_context = nullptr;
+
+    ScheduledActor* findActor(ecs::EntityID id);
+    const ScheduledActor* findActor(ecs::EntityID id) const;
+
+    /**
+     * @brief Run every actor due at world_time, then schedule its next turn
+     */
+    void runActors();
 };
\ No newline at end of file
@@ -8,7 +8,9 @@
 #pragma once
 
 #include "point.h"
+#include <cstdint>
 #include <string>
+#include <vector>
 
 class Map;
 
@@ -18,6 +20,17 @@ public:
     // Get the appropriate wall character based on neighboring walls
     static std::string getWallChar(const Map& map, int x, int y);
     static std::string getWallString(const Map& map, int x, int y);
+
+    // Connection bits for computeConnectionMasks()
+    static constexpr uint8_t CONNECT_NORTH = 1 << 0;
+    static constexpr uint8_t CONNECT_SOUTH = 1 << 1;
+    static constexpr uint8_t CONNECT_EAST = 1 << 2;
+    static constexpr uint8_t CONNECT_WEST = 1 << 3;
+
+    // Compute CONNECT_* bits for every wall tile at once (row-major,
+    // width * height entries, 0 for non-wall tiles) from the map's wall
+    // bitboard, 64 tiles per step
+    static void computeConnectionMasks(const Map& map, std::vector<uint8_t>& masks);
     
     // Check if using Unicode mode
     static bool isUnicodeEnabled();
@@ -0,0 +1,277 @@
+#include "bitboard.h"
+#include <algorithm>
+#include <bit>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Bulk word kernels. Each has an AVX2 body for four words at a time and a
+// scalar loop that handles the tail (or everything without AVX2).
+
+void andWords(uint64_t* dst, const uint64_t* src, size_t n) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 4 <= n; i += 4) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_and_si256(a, b));
+    }
+#endif
+    for (; i < n; i++) dst[i] &= src[i];
+}
+
+void orWords(uint64_t* dst, const uint64_t* src, size_t n) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 4 <= n; i += 4) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_or_si256(a, b));
+    }
+#endif
+    for (; i < n; i++) dst[i] |= src[i];
+}
+
+void andNotWords(uint64_t* dst, const uint64_t* src, size_t n) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 4 <= n; i += 4) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        // andnot computes ~first & second
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_andnot_si256(b, a));
+    }
+#endif
+    for (; i < n; i++) dst[i] &= ~src[i];
+}
+
+// dst = (a | b) & mask; returns whether dst differs from a
+bool seedWords(uint64_t* dst, const uint64_t* a, const uint64_t* b, const uint64_t* mask, size_t n) {
+    size_t i = 0;
+    uint64_t diff = 0;
+#if defined(__AVX2__)
+    __m256i diff_v = _mm256_setzero_si256();
+    for (; i + 4 <= n; i += 4) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        __m256i vm = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mask + i));
+        __m256i r = _mm256_and_si256(_mm256_or_si256(va, vb), vm);
+        diff_v = _mm256_or_si256(diff_v, _mm256_xor_si256(r, va));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), r);
+    }
+    diff = !_mm256_testz_si256(diff_v, diff_v);
+#endif
+    for (; i < n; i++) {
+        dst[i] = (a[i] | b[i]) & mask[i];
+        diff |= dst[i] ^ a[i];
+    }
+    return diff != 0;
+}
+
+// dst bit x = src bit x - 1 (shift toward higher x, carrying across words)
+void shiftRowUp(uint64_t* dst, const uint64_t* src, size_t n) {
+    if (n == 0) return;
+    dst[0] = src[0] << 1;
+    size_t i = 1;
+#if defined(__AVX2__)
+    for (; i + 4 <= n; i += 4) {
+        __m256i cur = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m256i prev = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i - 1));
+        __m256i r = _mm256_or_si256(_mm256_slli_epi64(cur, 1), _mm256_srli_epi64(prev, 63));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), r);
+    }
+#endif
+    for (; i < n; i++) dst[i] = (src[i] << 1) | (src[i - 1] >> 63);
+}
+
+// dst bit x = src bit x + 1 (shift toward lower x, carrying across words)
+void shiftRowDown(uint64_t* dst, const uint64_t* src, size_t n) {
+    if (n == 0) return;
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 4 < n; i += 4) {
+        __m256i cur = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 1));
+        __m256i r = _mm256_or_si256(_mm256_srli_epi64(cur, 1), _mm256_slli_epi64(next, 63));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), r);
+    }
+#endif
+    for (; i + 1 < n; i++) dst[i] = (src[i] >> 1) | (src[i + 1] << 63);
+    dst[n - 1] = src[n - 1] >> 1;
+}
+
+uint64_t reverseBits(uint64_t v) {
+    v = ((v >> 1) & 0x5555555555555555ULL) | ((v & 0x5555555555555555ULL) << 1);
+    v = ((v >> 2) & 0x3333333333333333ULL) | ((v & 0x3333333333333333ULL) << 2);
+    v = ((v >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((v & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    return std::byteswap(v);
+}
+
+// Fill the runs of mask bits containing a seed within one word, from the
+// lowest seed of each run upwards: adding the seeds to the mask carries
+// through the rest of the run. Seeds must be a subset of the mask.
+uint64_t fillUp(uint64_t seeds, uint64_t mask) {
+    return (((mask + seeds) ^ mask) | seeds) & mask;
+}
+
+// Expand seeds (a subset of mask) to every run of mask they touch in a
+// row. Upward and downward fills are done separately so each only needs
+// a carry bit between words; scratch holds the upward result.
+void fillRowRuns(uint64_t* seeds, const uint64_t* mask, uint64_t* scratch, size_t n) {
+    uint64_t carry = 0;
+    for (size_t w = 0; w < n; w++) {
+        uint64_t s = seeds[w] | (carry & mask[w]);
+        scratch[w] = fillUp(s, mask[w]);
+        carry = scratch[w] >> 63;
+    }
+
+    carry = 0;
+    for (size_t w = n; w-- > 0;) {
+        uint64_t rm = reverseBits(mask[w]);
+        uint64_t rs = reverseBits(seeds[w]) | (carry & rm);
+        uint64_t filled = fillUp(rs, rm);
+        carry = filled >> 63;
+        seeds[w] = reverseBits(filled) | scratch[w];
+    }
+}
+
+} // namespace
+
+Bitboard::Bitboard(int w, int h) {
+    resize(w, h);
+}
+
+void Bitboard::resize(int w, int h) {
+    width = std::max(w, 0);
+    height = std::max(h, 0);
+    words_per_row = (static_cast<size_t>(width) + 63) / 64;
+    words.assign(words_per_row * height, 0);
+}
+
+void Bitboard::fill(bool value) {
+    std::fill(words.begin(), words.end(), value ? ~uint64_t{0} : 0);
+    if (value) clearPadding();
+}
+
+void Bitboard::clearPadding() {
+    if (words_per_row == 0) return;
+    uint64_t mask = lastWordMask();
+    for (int y = 0; y < height; y++) {
+        row(y)[words_per_row - 1] &= mask;
+    }
+}
+
+size_t Bitboard::count() const {
+    size_t total = 0;
+    for (uint64_t word : words) {
+        total += std::popcount(word);
+    }
+    return total;
+}
+
+bool Bitboard::none() const {
+    return std::all_of(words.begin(), words.end(), [](uint64_t w) { return w == 0; });
+}
+
+Point Bitboard::findFirst() const {
+    for (size_t i = 0; i < words.size(); i++) {
+        if (words[i]) {
+            int y = static_cast<int>(i / words_per_row);
+            int x = static_cast<int>((i % words_per_row) * 64) + std::countr_zero(words[i]);
+            return Point(x, y);
+        }
+    }
+    return Point(-1, -1);
+}
+
+Bitboard& Bitboard::operator&=(const Bitboard& other) {
+    andWords(words.data(), other.words.data(), std::min(words.size(), other.words.size()));
+    return *this;
+}
+
+Bitboard& Bitboard::operator|=(const Bitboard& other) {
+    orWords(words.data(), other.words.data(), std::min(words.size(), other.words.size()));
+    return *this;
+}
+
+Bitboard& Bitboard::andNot(const Bitboard& other) {
+    andNotWords(words.data(), other.words.data(), std::min(words.size(), other.words.size()));
+    return *this;
+}
+
+bool Bitboard::operator==(const Bitboard& other) const {
+    return width == other.width && height == other.height && words == other.words;
+}
+
+Bitboard Bitboard::neighbor(int dx, int dy) const {
+    Bitboard result(width, height);
+    for (int y = 0; y < height; y++) {
+        int sy = y + dy;
+        if (sy < 0 || sy >= height) continue;
+
+        const uint64_t* src = row(sy);
+        uint64_t* dst = result.row(y);
+        if (dx < 0) {
+            shiftRowUp(dst, src, words_per_row);
+        } else if (dx > 0) {
+            shiftRowDown(dst, src, words_per_row);
+        } else {
+            std::copy(src, src + words_per_row, dst);
+        }
+    }
+    if (dx < 0) result.clearPadding();
+    return result;
+}
+
+Bitboard Bitboard::floodFill(const Point& seed) const {
+    Bitboard region(width, height);
+    if (!test(seed)) {
+        return region;
+    }
+    region.set(seed.x, seed.y);
+
+    std::vector<uint64_t> candidate(words_per_row);
+    std::vector<uint64_t> scratch(words_per_row);
+    const std::vector<uint64_t> empty(words_per_row, 0);
+
+    // Pull seeds into row y from a neighbouring row, then fill its runs.
+    // Rows of the region are always run-closed, so if no new seed bit
+    // arrived the row is already complete.
+    auto relax = [&](int y, int from) {
+        const uint64_t* neighbor_row = (from >= 0 && from < height) ? region.row(from) : empty.data();
+        if (!seedWords(candidate.data(), region.row(y), neighbor_row, row(y), words_per_row)) {
+            return false;
+        }
+        fillRowRuns(candidate.data(), row(y), scratch.data(), words_per_row);
+        std::copy(candidate.begin(), candidate.end(), region.row(y));
+        return true;
+    };
+
+    // The seed row has its runs filled before the sweeps start
+    std::copy(region.row(seed.y), region.row(seed.y) + words_per_row, candidate.begin());
+    fillRowRuns(candidate.data(), row(seed.y), scratch.data(), words_per_row);
+    std::copy(candidate.begin(), candidate.end(), region.row(seed.y));
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int y = 1; y < height; y++) {
+            changed |= relax(y, y - 1);
+        }
+        for (int y = height - 2; y >= 0; y--) {
+            changed |= relax(y, y + 1);
+        }
+    }
+    return region;
+}
+
+bool Bitboard::simdEnabled() {
+#if defined(__AVX2__)
+    return true;
+#else
+    return false;
+#endif
+}
@@ -152,6 +152,18 @@ bool Config::loadFromFile(const std::string& filename) {
             if (perf.contains("target_fps")) {
                 target_fps = static_cast<int>(perf.at("target_fps").as_int64());
             }
+            if (perf.contains("worker_threads")) {
+                worker_threads = static_cast<int>(perf.at("worker_threads").as_int64());
+            }
+            if (perf.contains("parallel_systems")) {
+                parallel_systems = perf.at("parallel_systems").as_bool();
+            }
+            if (perf.contains("parallel_pathfinding")) {
+                parallel_pathfinding = perf.at("parallel_pathfinding").as_bool();
+            }
+            if (perf.contains("ai_level_of_detail")) {
+                ai_level_of_detail = perf.at("ai_level_of_detail").as_bool();
+            }
         }
 
         // Database settings
@@ -266,6 +278,10 @@ bool Config::saveToFile(const std::string& filename) const {
         // Performance
         boost::json::object performance;
         performance["target_fps"] = target_fps;
+        performance["worker_threads"] = worker_threads;
+        performance["parallel_systems"] = parallel_systems;
+        performance["parallel_pathfinding"] = parallel_pathfinding;
+        performance["ai_level_of_detail"] = ai_level_of_detail;
         config["performance"] = performance;
 
         // Database
@@ -535,14 +535,14 @@ boost::json::object GameEntityRepository::serializeComponents(const ecs::Entity&
                 continue;
             }
             case ecs::ComponentType::HEALTH: {
-                if (auto* health = dynamic_cast<ecs::HealthComponent*>(component.get())) {
+                if (auto* health = dynamic_cast<ecs::HealthComponent*>(component)) {
                     comp_obj["hp"] = health->hp;
                     comp_obj["max_hp"] = health->max_hp;
                 }
                 break;
             }
             case ecs::ComponentType::RENDERABLE: {
-                if (auto* render = dynamic_cast<ecs::RenderableComponent*>(component.get())) {
+                if (auto* render = dynamic_cast<ecs::RenderableComponent*>(component)) {
                     // Only store dynamic state - static data comes from definitions tables
                     comp_obj["visible"] = render->is_visible;
                     comp_obj["always_visible"] = render->always_visible;
@@ -552,7 +552,7 @@ boost::json::object GameEntityRepository::serializeComponents(const ecs::Entity&
                 break;
             }
             case ecs::ComponentType::COMBAT: {
-                if (auto* combat = dynamic_cast<ecs::CombatComponent*>(component.get())) {
+                if (auto* combat = dynamic_cast<ecs::CombatComponent*>(component)) {
                     comp_obj["min_damage"] = combat->min_damage;
                     comp_obj["max_damage"] = combat->max_damage;
                     comp_obj["attack_bonus"] = combat->attack_bonus;
@@ -561,7 +561,7 @@ boost::json::object GameEntityRepository::serializeComponents(const ecs::Entity&
                 break;
             }
             case ecs::ComponentType::STATS: {
-                if (auto* stats = dynamic_cast<ecs::StatsComponent*>(component.get())) {
+                if (auto* stats = dynamic_cast<ecs::StatsComponent*>(component)) {
                     comp_obj["strength"] = stats->strength;
                     comp_obj["dexterity"] = stats->dexterity;
                     comp_obj["intelligence"] = stats->intelligence;
@@ -574,7 +574,7 @@ boost::json::object GameEntityRepository::serializeComponents(const ecs::Entity&
                 break;
             }
             case ecs::ComponentType::AI: {
-                if (auto* ai = dynamic_cast<ecs::AIComponent*>(component.get())) {
+                if (auto* ai = dynamic_cast<ecs::AIComponent*>(component)) {
                     comp_obj["vision_range"] = ai->vision_range;
                     comp_obj["aggro_range"] = ai->aggro_range;
                     comp_obj["target_id"] = static_cast<int64_t>(ai->target_id);
@@ -591,13 +591,16 @@ boost::json::object GameEntityRepository::serializeComponents(const ecs::Entity&
             }
             case ecs::ComponentType::CUSTOM: {
                 // Handle experience component
-                if (auto* exp = dynamic_cast<ecs::ExperienceComponent*>(component.get())) {
+                if (auto* exp = dynamic_cast<ecs::ExperienceComponent*>(component)) {
                     comp_obj["level"] = exp->level;
                     comp_obj["experience"] = exp->experience;
                     comp_obj["experience_to_next"] = exp->experience_to_next;
                     comp_obj["total_experience"] = exp->total_experience;
                     comp_obj["skill_points"] = exp->skill_points;
                     comp_obj["stat_points"] = exp->stat_points;
+                } else {
+                    // Other CUSTOM components share this key; don't clobber experience
+                    continue;
                 }
                 break;
             }
@@ -655,17 +658,17 @@ std::unique_ptr<ecs::Entity> GameEntityRepository::dataToEntity(const GameEntity
         for (const auto& [type, component] : template_entity->getComponents()) {
             if (type != ecs::ComponentType::POSITION) {
                 // Clone the component (this is a simplified approach)
-                if (auto* health = dynamic_cast<ecs::HealthComponent*>(component.get())) {
+                if (auto* health = dynamic_cast<ecs::HealthComponent*>(component)) {
                     entity->addComponent<ecs::HealthComponent>(*health);
-                } else if (auto* renderable = dynamic_cast<ecs::RenderableComponent*>(component.get())) {
+                } else if (auto* renderable = dynamic_cast<ecs::RenderableComponent*>(component)) {
                     entity->addComponent<ecs::RenderableComponent>(*renderable);
-                } else if (auto* combat = dynamic_cast<ecs::CombatComponent*>(component.get())) {
+                } else if (auto* combat = dynamic_cast<ecs::CombatComponent*>(component)) {
                     entity->addComponent<ecs::CombatComponent>(*combat);
-                } else if (auto* stats = dynamic_cast<ecs::StatsComponent*>(component.get())) {
+                } else if (auto* stats = dynamic_cast<ecs::StatsComponent*>(component)) {
                     entity->addComponent<ecs::StatsComponent>(*stats);
-                } else if (auto* ai = dynamic_cast<ecs::AIComponent*>(component.get())) {
+                } else if (auto* ai = dynamic_cast<ecs::AIComponent*>(component)) {
                     entity->addComponent<ecs::AIComponent>(*ai);
-                } else if (auto* player = dynamic_cast<ecs::PlayerComponent*>(component.get())) {
+                } else if (auto* player = dynamic_cast<ecs::PlayerComponent*>(component)) {
                     entity->addComponent<ecs::PlayerComponent>(*player);
                 }
                 // Add other component types as needed
@@ -755,6 +758,9 @@ void GameEntityRepository::deserializeComponents(ecs::Entity& entity, const boos
                         if (comp_obj.contains("render_priority") && comp_obj.at("render_priority").is_int64()) {
                             render->render_priority = comp_obj.at("render_priority").as_int64();
                         }
+                        // RenderSystem only rebuilds changed renderables; a no-op
+                        // until the entity joins a world
+                        entity.markChanged<ecs::RenderableComponent>();
                     }
                     break;
                 }
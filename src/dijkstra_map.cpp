@@ -0,0 +1,135 @@
+#include "dijkstra_map.h"
+#include "map.h"
+#include "pathfinding.h"
+#include <algorithm>
+#include <functional>
+
+bool DijkstraMap::compute(const Map& new_map, const std::vector<Point>& new_goals, bool allow_diagonals) {
+    if (isCurrent(new_map, new_goals, false, 0, allow_diagonals)) {
+        return false;
+    }
+    remember(new_map, new_goals, false, 0, allow_diagonals);
+    scan(new_map, new_goals);
+    return true;
+}
+
+bool DijkstraMap::computeFlee(const Map& new_map, const std::vector<Point>& threats,
+                              int new_scale, bool allow_diagonals) {
+    if (isCurrent(new_map, threats, true, new_scale, allow_diagonals)) {
+        return false;
+    }
+    remember(new_map, threats, true, new_scale, allow_diagonals);
+    scan(new_map, threats);
+
+    // Invert and rescale, then let values flow downhill again so tiles
+    // next to a far escape route drop below dead ends near the threat
+    for (int32_t& value : values) {
+        if (value != UNREACHABLE) {
+            value = -value * new_scale / 100;
+        }
+    }
+    relax(new_map);
+    return true;
+}
+
+Point DijkstraMap::nextStep(const Point& from) const {
+    const Point* directions = diagonals ? Pathfinding::DIRECTIONS_8 : Pathfinding::DIRECTIONS_4;
+    const int count = diagonals ? 8 : 4;
+
+    Point best = from;
+    int32_t best_value = getValue(from);
+    for (int i = 0; i < count; i++) {
+        Point next = from + directions[i];
+        int32_t value = getValue(next);
+        if (value < best_value) {
+            best = next;
+            best_value = value;
+        }
+    }
+    return best;
+}
+
+bool DijkstraMap::isCurrent(const Map& new_map, const std::vector<Point>& new_goals, bool new_flee,
+                            int new_scale, bool allow_diagonals) const {
+    return valid && map == &new_map && width == new_map.getWidth() &&
+           height == new_map.getHeight() &&
+           walkability_version == new_map.getWalkabilityVersion() &&
+           flee == new_flee && scale_percent == new_scale && diagonals == allow_diagonals &&
+           goals == new_goals;
+}
+
+void DijkstraMap::remember(const Map& new_map, const std::vector<Point>& new_goals, bool new_flee,
+                           int new_scale, bool allow_diagonals) {
+    map = &new_map;
+    width = new_map.getWidth();
+    height = new_map.getHeight();
+    walkability_version = new_map.getWalkabilityVersion();
+    goals = new_goals;
+    flee = new_flee;
+    scale_percent = new_scale;
+    diagonals = allow_diagonals;
+    valid = true;
+}
+
+void DijkstraMap::scan(const Map& new_map, const std::vector<Point>& sources) {
+    values.assign(static_cast<size_t>(width) * height, UNREACHABLE);
+    frontier.clear();
+    for (const Point& goal : sources) {
+        if (!new_map.isWalkable(goal.x, goal.y)) continue;
+        uint32_t index = static_cast<uint32_t>(goal.y * width + goal.x);
+        if (values[index] != 0) {
+            values[index] = 0;
+            frontier.push_back(index);
+        }
+    }
+
+    // Every move costs the same, so a breadth-first pass is exact
+    const Point* directions = diagonals ? Pathfinding::DIRECTIONS_8 : Pathfinding::DIRECTIONS_4;
+    const int count = diagonals ? 8 : 4;
+    for (size_t head = 0; head < frontier.size(); head++) {
+        uint32_t index = frontier[head];
+        Point pos(static_cast<int>(index % width), static_cast<int>(index / width));
+        int32_t next_value = values[index] + STEP_COST;
+        for (int i = 0; i < count; i++) {
+            Point next = pos + directions[i];
+            if (!new_map.isWalkable(next.x, next.y)) continue;
+            uint32_t next_index = static_cast<uint32_t>(next.y * width + next.x);
+            if (values[next_index] == UNREACHABLE) {
+                values[next_index] = next_value;
+                frontier.push_back(next_index);
+            }
+        }
+    }
+}
+
+void DijkstraMap::relax(const Map& new_map) {
+    // Dijkstra with every reachable tile as a source at its current value
+    heap.clear();
+    for (uint32_t index = 0; index < values.size(); index++) {
+        if (values[index] != UNREACHABLE) {
+            heap.emplace_back(values[index], index);
+        }
+    }
+    std::make_heap(heap.begin(), heap.end(), std::greater<>());
+
+    const Point* directions = diagonals ? Pathfinding::DIRECTIONS_8 : Pathfinding::DIRECTIONS_4;
+    const int count = diagonals ? 8 : 4;
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<>());
+        auto [value, index] = heap.back();
+        heap.pop_back();
+        if (value > values[index]) continue;
+
+        Point pos(static_cast<int>(index % width), static_cast<int>(index / width));
+        for (int i = 0; i < count; i++) {
+            Point next = pos + directions[i];
+            if (!new_map.isWalkable(next.x, next.y)) continue;
+            uint32_t next_index = static_cast<uint32_t>(next.y * width + next.x);
+            if (value + STEP_COST < values[next_index]) {
+                values[next_index] = value + STEP_COST;
+                heap.emplace_back(values[next_index], next_index);
+                std::push_heap(heap.begin(), heap.end(), std::greater<>());
+            }
+        }
+    }
+}
@@ -4,18 +4,20 @@
  */
 
 #include <algorithm>
-#include <queue>
+#include <atomic>
+#include <chrono>
 #include <random>
 #include <limits>
 #include <climits>
-#include <deque>
-#include <unordered_set>
 #include <cmath>
 #include "ecs/ai_system.h"
 #include "ecs/movement_system.h"
 #include "ecs/combat_system.h"
 #include "ecs/health_component.h"
 #include "ecs/renderable_component.h"
+#include "ecs/system_manager.h"
+#include "pathfinding.h"
+#include "thread_pool.h"
 
 namespace ecs {
 
@@ -31,347 +33,612 @@ AISystem::AISystem(Map* map,
 }
 
 void AISystem::update(const std::vector<std::unique_ptr<Entity>>& entities, double) {
-    // Process AI for each entity with an AI component
+    roster.clear();
     for (const auto& entity : entities) {
-        if (entity->hasComponent<AIComponent>() && entity->getID() != player_id) {
-            // Create temporary shared_ptr for processing
-            auto entity_ptr = std::shared_ptr<Entity>(entity.get(), [](Entity*){});
-            processEntityAI(entity_ptr, entities);
+        if (auto* ai = entity->getComponent<AIComponent>()) {
+            addToRoster(*entity, *ai);
         }
     }
+    runTurn(findEntity(entities, player_id));
 }
 
-void AISystem::processEntityAI(std::shared_ptr<Entity> entity,
-                               const std::vector<std::unique_ptr<Entity>>& entities) {
-    auto* ai = entity->getComponent<AIComponent>();
-    if (!ai) return;
+void AISystem::update(World& world, double) {
+    roster.clear();
+    for (Entity* entity : world.view<AIComponent>()) {
+        addToRoster(*entity, *entity->getComponent<AIComponent>());
+    }
+    runTurn(world.getEntity(player_id));
+}
+
+void AISystem::updateActors(World& world, const std::vector<EntityID>& actors) {
+    roster.clear();
+    for (EntityID id : actors) {
+        Entity* entity = world.getEntity(id);
+        if (auto* ai = entity ? entity->getComponent<AIComponent>() : nullptr) {
+            addToRoster(*entity, *ai);
+        }
+    }
+    runTurn(world.getEntity(player_id));
+}
 
-    // Find player entity
-    auto player = findEntity(entities, player_id);
-    if (!player) return;
+void AISystem::addToRoster(Entity& entity, AIComponent& ai) {
+    if (entity.getID() == player_id) return;
+    if (auto* pos = entity.getComponent<PositionComponent>()) {
+        roster.push_back({&entity, &ai, pos->position});
+    }
+}
 
-    // Update AI state based on player visibility
-    if (canSeeEntity(entity, player)) {
-        if (!ai->has_seen_player && logger) {
-            logger->logAI("Entity " + std::to_string(entity->getID()) + " spotted player");
+void AISystem::AwakeBatch::clear() {
+    entities.clear();
+    ai.clear();
+    move_slot.clear();
+    x.clear();
+    y.clear();
+    vision_range.clear();
+    aggro_range.clear();
+    hp_ratio.clear();
+    player_distance.clear();
+    adjacent.clear();
+    sees_player.clear();
+    for (auto& bucket : buckets) {
+        bucket.clear();
+    }
+}
+
+void AISystem::runTurn(const Entity* player) {
+    int max_range = 0;
+    for (const Monster& monster : roster) {
+        max_range = std::max(max_range, monster.ai->vision_range);
+    }
+    refreshPlayerSight(player, max_range);
+    path_cache.resetStats();
+    path_jobs = 0;
+    batching = path_pool != nullptr;
+    tier_stats = {};
+    awake.clear();
+    staged_moves.clear();
+
+    // Monsters have nothing to react to without a player
+    if (!player_goal.empty()) {
+        // Walking distances to the player (shared with chasers) set the tiers
+        schedule(lod_enabled ? getPlayerField(false) : nullptr);
+
+        auto start = std::chrono::steady_clock::now();
+        if (batched) {
+            perceive(0, awake.size());
+            runWandering(awake.buckets[static_cast<size_t>(AIBehavior::WANDERING)]);
+            runAggressive(awake.buckets[static_cast<size_t>(AIBehavior::AGGRESSIVE)]);
+            runDefensive(awake.buckets[static_cast<size_t>(AIBehavior::DEFENSIVE)]);
+            runPatrol(awake.buckets[static_cast<size_t>(AIBehavior::PATROL)]);
+            runFleeing(awake.buckets[static_cast<size_t>(AIBehavior::FLEEING)]);
+            runSupport(awake.buckets[static_cast<size_t>(AIBehavior::SUPPORT)]);
+        } else {
+            for (uint32_t i = 0; i < awake.size(); i++) {
+                perceive(i, i + 1);
+                runOne(i);
+            }
         }
-        ai->has_seen_player = true;
-        ai->turns_since_player_seen = 0;
-        auto* player_pos = player->getComponent<PositionComponent>();
-        if (player_pos) {
-            ai->last_player_position = Point{player_pos->position.x, player_pos->position.y};
+        if (batching) {
+            resolvePathRequests();
         }
-    } else {
-        ai->turns_since_player_seen++;
-        if (ai->turns_since_player_seen == 10 && logger) {
-            logger->logAI("Entity " + std::to_string(entity->getID()) + " lost track of player");
+
+        // The awake batch runs as one; its time is shared out by head count
+        double elapsed = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        for (AITier tier : {AITier::ACTIVE, AITier::NEARBY}) {
+            size_t t = static_cast<size_t>(tier);
+            if (!awake.entities.empty()) {
+                tier_stats.time_ms[t] += elapsed * tier_stats.updated[t] / awake.size();
+            }
         }
     }
+    batching = false;
+    noises.clear();
+    flushMoves();
+}
 
-    // Execute behavior based on AI type
-    switch (ai->behavior) {
-        case AIBehavior::PASSIVE:
-            handlePassiveBehavior(entity);
-            break;
-        case AIBehavior::WANDERING:
-            handleWanderingBehavior(entity);
-            break;
-        case AIBehavior::AGGRESSIVE:
-            if (logger) logger->logAI("Entity " + std::to_string(entity->getID()) + " acting aggressively");
-            handleAggressiveBehavior(entity, player);
-            break;
-        case AIBehavior::DEFENSIVE:
-            handleDefensiveBehavior(entity, player);
-            break;
-        case AIBehavior::PATROL:
-            handlePatrolBehavior(entity);
-            break;
-        case AIBehavior::FLEEING:
-            if (logger) logger->logAI("Entity " + std::to_string(entity->getID()) + " fleeing from threat");
-            handleFleeingBehavior(entity, player);
-            break;
-        case AIBehavior::SUPPORT:
-            handleSupportBehavior(entity, player);
-            break;
-    }
-}
-
-void AISystem::handlePassiveBehavior(std::shared_ptr<Entity>) {
-    // Passive entities don't move or attack
-    // They just exist peacefully
-}
-
-void AISystem::handleWanderingBehavior(std::shared_ptr<Entity> entity) {
-    auto* pos = entity->getComponent<PositionComponent>();
-    if (!pos) return;
-
-    // Random movement
-    Point current{pos->position.x, pos->position.y};
-    Point target = getRandomAdjacentPosition(current);
+void AISystem::schedule(const DijkstraMap* distances) {
+    for (const Monster& monster : roster) {
+        if (!distances) {
+            monster.ai->tier = AITier::ACTIVE;
+            staged_moves.push_back({monster.entity->getID()});
+            wake(monster, staged_moves.size() - 1);
+            continue;
+        }
 
-    // Try to move to random position
-    if (map && map->isWalkable(target.x, target.y)) {
-        int dx = target.x - pos->position.x;
-        int dy = target.y - pos->position.y;
-        movement_system->queueMove(entity->getID(), dx, dy);
+        auto start = std::chrono::steady_clock::now();
+        AITier tier = classify(monster.pos, *monster.ai, *distances);
+        monster.ai->tier = tier;
+        const size_t t = static_cast<size_t>(tier);
+        tier_stats.counts[t]++;
+        // Counted per monster: with mixed speeds, monsters take turns at different rates
+        if (AILevelOfDetail::isDue(tier, monster.entity->getID(), monster.ai->lod_turns++)) {
+            tier_stats.updated[t]++;
+            staged_moves.push_back({monster.entity->getID()});
+            if (tier == AITier::ACTIVE || tier == AITier::NEARBY) {
+                wake(monster, staged_moves.size() - 1);
+            } else {
+                simulateDistant(monster, staged_moves.size() - 1);
+            }
+        }
+        tier_stats.time_ms[t] += std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
     }
 }
 
-void AISystem::handleAggressiveBehavior(std::shared_ptr<Entity> entity,
-                                        std::shared_ptr<Entity> player) {
-    if (!player) return;
+void AISystem::wake(const Monster& monster, size_t move_slot) {
+    float hp_ratio = -1.0f;
+    if (auto* health = monster.entity->getComponent<HealthComponent>()) {
+        hp_ratio = health->max_hp > 0 ? static_cast<float>(health->hp) / health->max_hp : 0.0f;
+    }
 
-    auto* ai = entity->getComponent<AIComponent>();
-    auto* pos = entity->getComponent<PositionComponent>();
-    if (!ai || !pos) return;
+    awake.buckets[static_cast<size_t>(monster.ai->behavior)].push_back(static_cast<uint32_t>(awake.size()));
+    awake.entities.push_back(monster.entity);
+    awake.ai.push_back(monster.ai);
+    awake.move_slot.push_back(move_slot);
+    awake.x.push_back(monster.pos.x);
+    awake.y.push_back(monster.pos.y);
+    awake.vision_range.push_back(monster.ai->vision_range);
+    awake.aggro_range.push_back(monster.ai->aggro_range);
+    awake.hp_ratio.push_back(hp_ratio);
+}
 
-    // Check if we can see the player
-    if (canSeeEntity(entity, player)) {
-        ai->target_id = player->getID();
+void AISystem::perceive(size_t begin, size_t end) {
+    const int px = player_goal.front().x;
+    const int py = player_goal.front().y;
+    awake.player_distance.resize(awake.size());
+    awake.adjacent.resize(awake.size());
+    awake.sees_player.resize(awake.size());
+
+    // Plain arithmetic over the arrays; the compiler can vectorize these
+    const int* x = awake.x.data();
+    const int* y = awake.y.data();
+    int* distance = awake.player_distance.data();
+    uint8_t* adjacent = awake.adjacent.data();
+    for (size_t i = begin; i < end; i++) {
+        int dx = std::abs(x[i] - px);
+        int dy = std::abs(y[i] - py);
+        distance[i] = dx + dy;
+        adjacent[i] = dx <= 1 && dy <= 1 && dx + dy > 0;
+    }
 
-        // Try to attack if adjacent
-        if (tryAttack(entity, player)) {
-            return;
+    // Only monsters within range look; symmetric shadowcasting makes "lit
+    // from the player" the same answer as the monster's own view
+    for (size_t i = begin; i < end; i++) {
+        bool sees = false;
+        if (distance[i] <= awake.vision_range[i]) {
+            Point pos = awake.position(i);
+            if (!map) {
+                sees = true;
+            } else if (player_sight.isValid() && awake.vision_range[i] <= player_sight.getRadius()) {
+                sees = player_sight.canSee(pos, awake.vision_range[i]);
+            } else {
+                sees = Pathfinding::hasLineOfSight(pos, player_goal.front(), *map);
+            }
         }
+        awake.sees_player[i] = sees;
+    }
 
-        // Otherwise, move towards player
-        auto* player_pos = player->getComponent<PositionComponent>();
-        if (player_pos) {
-            Point target{player_pos->position.x, player_pos->position.y};
-            moveTowards(entity, target);
-        }
-    } else if (ai->has_seen_player && ai->turns_since_player_seen < 5) {
-        // Hunt last known position
-        if (ai->last_player_position.x >= 0) {
-            moveTowards(entity, ai->last_player_position);
+    // Update AI state based on player visibility
+    for (size_t i = begin; i < end; i++) {
+        AIComponent& ai = *awake.ai[i];
+        if (awake.sees_player[i]) {
+            if (!ai.has_seen_player && logger) {
+                logger->logAI("Entity " + std::to_string(awake.entities[i]->getID()) + " spotted player");
+            }
+            ai.has_seen_player = true;
+            ai.turns_since_player_seen = 0;
+            ai.last_player_position = player_goal.front();
+        } else {
+            ai.turns_since_player_seen++;
+            if (ai.turns_since_player_seen == 10 && logger) {
+                logger->logAI("Entity " + std::to_string(awake.entities[i]->getID()) + " lost track of player");
+            }
         }
-    } else {
-        // Wander when no target
-        handleWanderingBehavior(entity);
     }
 }
 
-void AISystem::handleDefensiveBehavior(std::shared_ptr<Entity> entity,
-                                       std::shared_ptr<Entity> player) {
-    if (!player) return;
-
-    auto* ai = entity->getComponent<AIComponent>();
-    auto* health = entity->getComponent<HealthComponent>();
-    if (!ai || !health) return;
+AITier AISystem::classify(const Point& pos, const AIComponent& ai, const DijkstraMap& distances) const {
+    // Promoted at once: in the player's view, hunting, or within earshot
+    if (player_sight.isValid() && player_sight.canSee(pos, player_sight.getRadius())) {
+        return AITier::ACTIVE;
+    }
+    if (ai.has_seen_player && ai.turns_since_player_seen < HUNT_TURNS) {
+        return AITier::ACTIVE;
+    }
+    for (const Noise& noise : noises) {
+        if (std::abs(pos.x - noise.origin.x) + std::abs(pos.y - noise.origin.y) <= noise.radius) {
+            return AITier::ACTIVE;
+        }
+    }
 
-    // Check health status
-    float health_percent = static_cast<float>(health->hp) / health->max_hp;
+    int32_t value = distances.getValue(pos);
+    return AILevelOfDetail::classify(value == DijkstraMap::UNREACHABLE ? -1 : value / DijkstraMap::STEP_COST);
+}
 
-    // Flee if health is low
-    if (health_percent < 0.3f) {
-        auto* player_pos = player->getComponent<PositionComponent>();
-        if (player_pos && canSeeEntity(entity, player)) {
-            Point threat{player_pos->position.x, player_pos->position.y};
-            moveAway(entity, threat);
+void AISystem::simulateDistant(const Monster& monster, size_t move_slot) {
+    AIComponent& ai = *monster.ai;
+    const Point& pos = monster.pos;
+    if (!map || ai.behavior == AIBehavior::PASSIVE) return;
+
+    // Carry on along the current path
+    if (!ai.path.empty()) {
+        Point next = ai.path.front();
+        if (map->isWalkable(next.x, next.y)) {
+            ai.path.pop_front();
+            queueMove(move_slot, next.x - pos.x, next.y - pos.y);
             return;
         }
+        ai.path.clear();
     }
 
-    // Attack if player is close and we're healthy enough
-    if (health_percent > 0.3f && getDistance(entity, player) <= ai->aggro_range) {
-        // Try to attack if adjacent
-        if (tryAttack(entity, player)) {
-            return;
+    // Monsters that would be wandering drift; the rest hold their ground
+    if (ai.behavior == AIBehavior::WANDERING || ai.behavior == AIBehavior::AGGRESSIVE ||
+        ai.behavior == AIBehavior::DEFENSIVE) {
+        Point target = getRandomAdjacentPosition(pos);
+        if (map->isWalkable(target.x, target.y)) {
+            queueMove(move_slot, target.x - pos.x, target.y - pos.y);
         }
+    }
+}
 
-        // Move towards player to attack
-        auto* player_pos = player->getComponent<PositionComponent>();
-        if (player_pos) {
-            Point target{player_pos->position.x, player_pos->position.y};
-            moveTowards(entity, target);
-        }
-    } else {
-        // Default to wandering
-        handleWanderingBehavior(entity);
+void AISystem::wander(size_t i) {
+    // Random movement
+    Point current = awake.position(i);
+    Point target = getRandomAdjacentPosition(current);
+
+    // Try to move to random position
+    if (map && map->isWalkable(target.x, target.y)) {
+        queueMove(awake.move_slot[i], target.x - current.x, target.y - current.y);
     }
 }
 
-bool AISystem::canSeeEntity(std::shared_ptr<Entity> entity,
-                            std::shared_ptr<Entity> target) const {
-    auto* ai = entity->getComponent<AIComponent>();
-    if (!ai) return false;
+void AISystem::runOne(uint32_t i) {
+    const std::vector<uint32_t> bucket{i};
+    switch (awake.ai[i]->behavior) {
+        case AIBehavior::WANDERING:  runWandering(bucket); break;
+        case AIBehavior::AGGRESSIVE: runAggressive(bucket); break;
+        case AIBehavior::DEFENSIVE:  runDefensive(bucket); break;
+        case AIBehavior::PATROL:     runPatrol(bucket); break;
+        case AIBehavior::FLEEING:    runFleeing(bucket); break;
+        case AIBehavior::SUPPORT:    runSupport(bucket); break;
+        case AIBehavior::PASSIVE:    break;
+    }
+}
 
-    int distance = getDistance(entity, target);
-    if (distance > ai->vision_range) return false;
+void AISystem::runWandering(const std::vector<uint32_t>& bucket) {
+    for (uint32_t i : bucket) {
+        wander(i);
+    }
+}
 
-    // Check line of sight using FOV or simple line algorithm
-    auto* entity_pos = entity->getComponent<PositionComponent>();
-    auto* target_pos = target->getComponent<PositionComponent>();
-    if (!entity_pos || !target_pos) return false;
+void AISystem::runAggressive(const std::vector<uint32_t>& bucket) {
+    for (uint32_t i : bucket) {
+        AIComponent& ai = *awake.ai[i];
 
-    // Simple line of sight check - could be improved with proper FOV
-    // For now, just check if within vision range
-    return distance <= ai->vision_range;
+        if (awake.sees_player[i]) {
+            ai.target_id = player_id;
+            // Attack if adjacent, otherwise close in
+            if (!tryAttack(i)) {
+                moveTowards(i, player_goal.front());
+            }
+        } else if (ai.has_seen_player && ai.turns_since_player_seen < HUNT_TURNS) {
+            // Hunt last known position
+            if (ai.last_player_position.x >= 0) {
+                moveTowards(i, ai.last_player_position);
+            }
+        } else {
+            // Wander when no target
+            wander(i);
+        }
+    }
 }
 
-int AISystem::getDistance(std::shared_ptr<Entity> e1,
-                          std::shared_ptr<Entity> e2) const {
-    auto* pos1 = e1->getComponent<PositionComponent>();
-    auto* pos2 = e2->getComponent<PositionComponent>();
+void AISystem::runDefensive(const std::vector<uint32_t>& bucket) {
+    for (uint32_t i : bucket) {
+        float health_percent = awake.hp_ratio[i];
+        if (health_percent < 0.0f) continue;  // needs health to judge the odds
 
-    if (!pos1 || !pos2) return INT_MAX;
+        // Flee if health is low
+        if (health_percent < 0.3f && awake.sees_player[i]) {
+            moveAway(i, player_goal.front());
+            continue;
+        }
 
-    // Manhattan distance
-    return std::abs(pos1->position.x - pos2->position.x) + std::abs(pos1->position.y - pos2->position.y);
+        // Attack if player is close and we're healthy enough
+        if (health_percent > 0.3f && awake.player_distance[i] <= awake.aggro_range[i]) {
+            if (!tryAttack(i)) {
+                moveTowards(i, player_goal.front());
+            }
+        } else {
+            // Default to wandering
+            wander(i);
+        }
+    }
 }
 
-std::deque<Point> AISystem::findPath(const Point& from, const Point& to) const {
-    std::deque<Point> path;
-    if (!map) return path;
+void AISystem::runPatrol(const std::vector<uint32_t>& bucket) {
+    for (uint32_t i : bucket) {
+        AIComponent& ai = *awake.ai[i];
+        Point current = awake.position(i);
+
+        // Initialize patrol points if not set
+        if (ai.patrol_points.empty()) {
+            // Create a simple square patrol pattern
+            ai.patrol_points.push_back({current.x + 3, current.y});
+            ai.patrol_points.push_back({current.x + 3, current.y + 3});
+            ai.patrol_points.push_back({current.x, current.y + 3});
+            ai.patrol_points.push_back(current);
+            ai.current_patrol_index = 0;
+        }
 
-    // Simple BFS pathfinding
-    std::queue<Point> frontier;
-    std::unordered_map<int, Point> came_from;
-    std::unordered_set<int> visited;
+        // Move to current patrol point
+        if (ai.current_patrol_index < ai.patrol_points.size()) {
+            // Move to next patrol point once this one is reached
+            if (current == ai.patrol_points[ai.current_patrol_index]) {
+                ai.current_patrol_index = (ai.current_patrol_index + 1) % ai.patrol_points.size();
+            }
+            moveTowards(i, ai.patrol_points[ai.current_patrol_index]);
+        }
+    }
+}
 
-    auto point_to_key = [this](const Point& p) {
-        return p.y * map->getWidth() + p.x;
-    };
+void AISystem::runFleeing(const std::vector<uint32_t>& bucket) {
+    for (uint32_t i : bucket) {
+        moveAway(i, player_goal.front());
+
+        // Far enough away: stop fleeing
+        if (awake.player_distance[i] > awake.vision_range[i] * 2) {
+            awake.ai[i]->behavior = AIBehavior::DEFENSIVE;
+        }
+    }
+}
 
-    frontier.push(from);
-    visited.insert(point_to_key(from));
+void AISystem::runSupport(const std::vector<uint32_t>& bucket) {
+    // Note: helping injured allies would need an ally search; for now
+    // supporters follow the player at a distance
+    for (uint32_t i : bucket) {
+        if (awake.player_distance[i] > 3) {
+            moveTowards(i, player_goal.front());
+        }
+    }
+}
 
-    // BFS to find path
-    bool found = false;
-    while (!frontier.empty() && !found) {
-        Point current = frontier.front();
-        frontier.pop();
+void AISystem::refreshPlayerSight(const Entity* player, int range) {
+    player_goal.clear();
+    const auto* pos = player ? player->getComponent<PositionComponent>() : nullptr;
+    if (pos) {
+        player_goal.push_back(pos->position);
+    }
+    if (!map || !pos) {
+        player_sight.invalidate();
+        return;
+    }
+    player_sight.compute(*map, pos->position, range);
+}
 
-        // Check all 4 directions
-        const int dx[] = {0, 1, 0, -1};
-        const int dy[] = {-1, 0, 1, 0};
+const DijkstraMap* AISystem::getPlayerField(bool fleeing) {
+    if (!map || player_goal.empty()) return nullptr;
 
-        for (int i = 0; i < 4; ++i) {
-            Point next{current.x + dx[i], current.y + dy[i]};
+    // Recomputed only when the player moved or a door changed
+    if (fleeing) {
+        flee_field.computeFlee(*map, player_goal);
+        return &flee_field;
+    }
+    chase_field.compute(*map, player_goal);
+    return &chase_field;
+}
 
-            if (!map->isWalkable(next.x, next.y)) continue;
+SharedPath AISystem::findPath(const Point& from, const Point& to) const {
+    SharedPath path;
+    if (!map || from == to) return path;
 
-            int next_key = point_to_key(next);
-            if (visited.find(next_key) != visited.end()) continue;
+    // Monsters with the same errand from the same area share one path
+    if (path_cache.lookup(*map, from, to, false, path)) return path;
 
-            visited.insert(next_key);
-            came_from[next_key] = current;
-            frontier.push(next);
+    // Monsters step in the four cardinal directions
+    bool found;
+    if (std::abs(to.x - from.x) + std::abs(to.y - from.y) >= LONG_PATH_DISTANCE) {
+        // Long trips go over the room graph; refining all of it once lets
+        // every monster setting out from this area reuse the result
+        route_planner.update(*map);
+        found = route_planner.findPath(from, to, path_buffer);
+    } else {
+        found = Pathfinding::findPath(from, to, *map, path_context, path_buffer, false);
+    }
+    if (found) {
+        path = path_cache.store(*map, from, to, false, path_buffer);
+    }
+    return path;
+}
 
-            if (next.x == to.x && next.y == to.y) {
-                found = true;
-                break;
+bool AISystem::moveTowards(size_t i, const Point& target) {
+    AIComponent& ai = *awake.ai[i];
+    const size_t slot = awake.move_slot[i];
+    Point current = awake.position(i);
+
+    // Chasing the player: every chaser steps along one shared field
+    if (!player_goal.empty() && target == player_goal.front()) {
+        if (const DijkstraMap* field = getPlayerField(false)) {
+            Point next = field->nextStep(current);
+            if (next != current) {
+                ai.path.clear();
+                queueMove(slot, next.x - current.x, next.y - current.y);
+                return true;
             }
         }
     }
 
-    // Reconstruct path if found
-    if (found) {
-        Point current = to;
-        while (!(current.x == from.x && current.y == from.y)) {
-            path.push_front(current);
-            int key = point_to_key(current);
-            if (came_from.find(key) == came_from.end()) break;
-            current = came_from[key];
-        }
+    // Batched: the move stays in its slot until the turn's searches are done
+    if (batching) {
+        if (target == current) return false;
+        path_requests.push_back({&ai, current, target, slot, false, {}});
+        return true;
     }
 
-    return path;
+    Point next;
+    if (!followPath(ai, current, target, nullptr, next)) return false;
+    queueMove(slot, next.x - current.x, next.y - current.y);
+    return true;
 }
 
-bool AISystem::moveTowards(std::shared_ptr<Entity> entity, const Point& target) {
-    auto* pos = entity->getComponent<PositionComponent>();
-    auto* ai = entity->getComponent<AIComponent>();
-    if (!pos || !ai) return false;
-
-    Point current{pos->position.x, pos->position.y};
+bool AISystem::followPath(AIComponent& ai, const Point& current, const Point& target,
+                          const PathRequest* solved, Point& next) {
+    // Nearby targets: repair this monster's search from last turn, which
+    // follows both its own steps and a target that moved since
+    bool searched = false;
+    if (map && std::abs(target.x - current.x) + std::abs(target.y - current.y) < LONG_PATH_DISTANCE) {
+        bool found = solved ? solved->found : ai.search.findPath(*map, current, target, path_buffer);
+        const std::vector<Point>& steps = solved ? solved->steps : path_buffer;
+        if (found && !steps.empty()) {
+            next = steps.front();
+            ai.path.assign(steps.begin() + 1, steps.end());
+            return true;
+        }
+        // Past its node limit the one-off search below takes over
+        searched = !ai.search.hitNodeLimit();
+        if (searched) ai.path.clear();
+    }
 
     // Use cached path if available and still valid
-    if (!ai->path.empty()) {
-        Point next = ai->path.front();
+    if (!searched && !ai.path.empty()) {
+        next = ai.path.front();
         if (map && map->isWalkable(next.x, next.y)) {
-            int dx = next.x - pos->position.x;
-            int dy = next.y - pos->position.y;
-            movement_system->queueMove(entity->getID(), dx, dy);
-            ai->path.pop_front();
+            ai.path.pop_front();
             return true;
         } else {
             // Path blocked, recalculate
-            ai->path.clear();
+            ai.path.clear();
         }
     }
 
     // Calculate new path if needed
-    if (ai->path.empty()) {
-        ai->path = findPath(current, target);
-        if (!ai->path.empty()) {
-            Point next = ai->path.front();
-            int dx = next.x - pos->position.x;
-            int dy = next.y - pos->position.y;
-            movement_system->queueMove(entity->getID(), dx, dy);
-            ai->path.pop_front();
+    if (!searched && ai.path.empty()) {
+        ai.path = findPath(current, target);
+        if (!ai.path.empty()) {
+            next = ai.path.front();
+            ai.path.pop_front();
             return true;
         }
     }
 
     // Fallback to simple movement towards target
-    int dx = (target.x > pos->position.x) ? 1 : (target.x < pos->position.x) ? -1 : 0;
-    int dy = (target.y > pos->position.y) ? 1 : (target.y < pos->position.y) ? -1 : 0;
+    int dx = (target.x > current.x) ? 1 : (target.x < current.x) ? -1 : 0;
+    int dy = (target.y > current.y) ? 1 : (target.y < current.y) ? -1 : 0;
+    next = current + Point(dx, dy);
+    return dx != 0 || dy != 0;
+}
 
-    if (dx != 0 || dy != 0) {
-        movement_system->queueMove(entity->getID(), dx, dy);
-        return true;
+void AISystem::queueMove(size_t move_slot, int dx, int dy) {
+    StagedMove& move = staged_moves[move_slot];
+    move.dx = dx;
+    move.dy = dy;
+    move.held = false;
+}
+
+void AISystem::flushMoves() {
+    for (const StagedMove& move : staged_moves) {
+        if (!move.held) {
+            movement_system->queueMove(move.entity_id, move.dx, move.dy);
+        }
     }
+    staged_moves.clear();
+}
 
-    return false;
+void AISystem::resolvePathRequests() {
+    // Near searches touch only the requesting monster's own search tree
+    // and read the map, which stays put until the movement phase
+    std::vector<size_t> jobs;
+    for (size_t i = 0; i < path_requests.size(); i++) {
+        const PathRequest& request = path_requests[i];
+        if (map && std::abs(request.target.x - request.from.x) +
+                   std::abs(request.target.y - request.from.y) < LONG_PATH_DISTANCE) {
+            jobs.push_back(i);
+        }
+    }
+    path_jobs = jobs.size();
+
+    if (!jobs.empty()) {
+        const Map& snapshot = *map;
+        std::atomic<size_t> next_job{0};
+        std::atomic<size_t> finished{0};
+        const size_t tasks = std::min(jobs.size(), path_pool->getThreadCount() + 1);
+        auto work = [&] {
+            for (size_t k = next_job++; k < jobs.size(); k = next_job++) {
+                PathRequest& request = path_requests[jobs[k]];
+                request.found = request.ai->search.findPath(snapshot, request.from, request.target, request.steps);
+            }
+            ++finished;
+        };
+        for (size_t t = 0; t < tasks; t++) {
+            path_pool->submit(work);
+        }
+        path_pool->helpUntil([&] { return finished == tasks; });
+    }
+
+    // Results apply in entity order, so shared state (the path cache, the
+    // route planner) sees the same sequence as an unbatched turn
+    for (PathRequest& request : path_requests) {
+        Point next;
+        if (followPath(*request.ai, request.from, request.target, &request, next)) {
+            queueMove(request.move_slot, next.x - request.from.x, next.y - request.from.y);
+        }
+    }
+    path_requests.clear();
 }
 
-bool AISystem::moveAway(std::shared_ptr<Entity> entity, const Point& threat) {
-    auto* pos = entity->getComponent<PositionComponent>();
-    if (!pos) return false;
+bool AISystem::moveAway(size_t i, const Point& threat) {
+    const size_t slot = awake.move_slot[i];
+    Point pos = awake.position(i);
+
+    // Fleeing the player: follow the shared flee field
+    if (!player_goal.empty() && threat == player_goal.front()) {
+        if (const DijkstraMap* field = getPlayerField(true)) {
+            Point next = field->nextStep(pos);
+            if (next != pos) {
+                queueMove(slot, next.x - pos.x, next.y - pos.y);
+                return true;
+            }
+        }
+    }
 
     // Move in opposite direction from threat
-    int dx = (pos->position.x > threat.x) ? 1 : (pos->position.x < threat.x) ? -1 : 0;
-    int dy = (pos->position.y > threat.y) ? 1 : (pos->position.y < threat.y) ? -1 : 0;
+    int dx = (pos.x > threat.x) ? 1 : (pos.x < threat.x) ? -1 : 0;
+    int dy = (pos.y > threat.y) ? 1 : (pos.y < threat.y) ? -1 : 0;
+    if (!map) return false;
 
     // Try to move away
-    if (map && map->isWalkable(pos->position.x + dx, pos->position.y + dy)) {
-        movement_system->queueMove(entity->getID(), dx, dy);
+    if (map->isWalkable(pos.x + dx, pos.y + dy)) {
+        queueMove(slot, dx, dy);
         return true;
     }
 
     // Try perpendicular directions if direct retreat is blocked
-    if (dx != 0 && map->isWalkable(pos->position.x, pos->position.y + 1)) {
-        movement_system->queueMove(entity->getID(), 0, 1);
+    if (dx != 0 && map->isWalkable(pos.x, pos.y + 1)) {
+        queueMove(slot, 0, 1);
         return true;
     }
-    if (dx != 0 && map->isWalkable(pos->position.x, pos->position.y - 1)) {
-        movement_system->queueMove(entity->getID(), 0, -1);
+    if (dx != 0 && map->isWalkable(pos.x, pos.y - 1)) {
+        queueMove(slot, 0, -1);
         return true;
     }
-    if (dy != 0 && map->isWalkable(pos->position.x + 1, pos->position.y)) {
-        movement_system->queueMove(entity->getID(), 1, 0);
+    if (dy != 0 && map->isWalkable(pos.x + 1, pos.y)) {
+        queueMove(slot, 1, 0);
         return true;
     }
-    if (dy != 0 && map->isWalkable(pos->position.x - 1, pos->position.y)) {
-        movement_system->queueMove(entity->getID(), -1, 0);
+    if (dy != 0 && map->isWalkable(pos.x - 1, pos.y)) {
+        queueMove(slot, -1, 0);
         return true;
     }
 
     return false;
 }
 
-bool AISystem::tryAttack(std::shared_ptr<Entity> entity,
-                        std::shared_ptr<Entity> target) {
-    if (!combat_system) return false;
-
-    // Check if entities are adjacent
-    if (combat_system->areAdjacent(entity, target)) {
-        combat_system->queueAttack(entity->getID(), target->getID());
-        return true;
-    }
+bool AISystem::tryAttack(size_t i) {
+    if (!combat_system || !awake.adjacent[i]) return false;
 
-    return false;
+    combat_system->queueAttack(awake.entities[i]->getID(), player_id);
+    return true;
 }
 
 Point AISystem::getRandomAdjacentPosition(const Point& pos) const {
@@ -384,114 +651,16 @@ Point AISystem::getRandomAdjacentPosition(const Point& pos) const {
     return Point{pos.x + dx[dir], pos.y + dy[dir]};
 }
 
-std::shared_ptr<Entity> AISystem::findEntity(
-    const std::vector<std::unique_ptr<Entity>>& entities,
-    EntityID id) const {
+Entity* AISystem::findEntity(const std::vector<std::unique_ptr<Entity>>& entities, EntityID id) const {
+    if (world) {
+        return world->getEntity(id);
+    }
 
     auto it = std::find_if(entities.begin(), entities.end(),
         [id](const std::unique_ptr<Entity>& e) {
             return e->getID() == id;
         });
-
-    // Create shared_ptr that doesn't own the entity
-    return (it != entities.end()) ? std::shared_ptr<Entity>(it->get(), [](Entity*){}) : nullptr;
-}
-
-void AISystem::handlePatrolBehavior(std::shared_ptr<Entity> entity) {
-    auto* ai = entity->getComponent<AIComponent>();
-    auto* pos = entity->getComponent<PositionComponent>();
-    if (!ai || !pos) return;
-
-    // Initialize patrol points if not set
-    if (ai->patrol_points.empty()) {
-        Point current{pos->position.x, pos->position.y};
-        // Create a simple square patrol pattern
-        ai->patrol_points.push_back({current.x + 3, current.y});
-        ai->patrol_points.push_back({current.x + 3, current.y + 3});
-        ai->patrol_points.push_back({current.x, current.y + 3});
-        ai->patrol_points.push_back(current);
-        ai->current_patrol_index = 0;
-    }
-
-    // Move to current patrol point
-    if (ai->current_patrol_index < ai->patrol_points.size()) {
-        Point target = ai->patrol_points[ai->current_patrol_index];
-        Point current{pos->position.x, pos->position.y};
-
-        // Check if we've reached the patrol point
-        if (current.x == target.x && current.y == target.y) {
-            // Move to next patrol point
-            ai->current_patrol_index = (ai->current_patrol_index + 1) % ai->patrol_points.size();
-            target = ai->patrol_points[ai->current_patrol_index];
-        }
-
-        // Move towards patrol point
-        moveTowards(entity, target);
-    }
-}
-
-void AISystem::handleFleeingBehavior(std::shared_ptr<Entity> entity,
-                                     std::shared_ptr<Entity> threat) {
-    if (!threat) return;
-
-    auto* threat_pos = threat->getComponent<PositionComponent>();
-    if (!threat_pos) return;
-
-    Point threat_point{threat_pos->position.x, threat_pos->position.y};
-    moveAway(entity, threat_point);
-
-    // Check if we're far enough away to stop fleeing
-    auto* ai = entity->getComponent<AIComponent>();
-    if (ai && getDistance(entity, threat) > ai->vision_range * 2) {
-        // Switch back to wandering or defensive
-        ai->behavior = AIBehavior::DEFENSIVE;
-    }
-}
-
-void AISystem::handleSupportBehavior(std::shared_ptr<Entity> entity,
-                                     std::shared_ptr<Entity> player) {
-    if (!player) return;
-
-    auto* ai = entity->getComponent<AIComponent>();
-    if (!ai) return;
-
-    // Find nearby allies that need help
-    auto* pos = entity->getComponent<PositionComponent>();
-    if (!pos) return;
-
-    Point current{pos->position.x, pos->position.y};
-
-    // Note: Would need access to all entities to find allies
-    // For now, just follow player
-    /*for (const auto& other : entities) {
-        if (other->getID() == entity->getID()) continue;
-
-        auto* other_ai = other->getComponent<AIComponent>();
-        if (!other_ai || other_ai->behavior == AIBehavior::AGGRESSIVE) continue;
-
-        auto* other_health = other->getComponent<HealthComponent>();
-        if (!other_health) continue;
-
-        // Check if ally is injured
-        if (other_health->hp < other_health->max_hp / 2) {
-            // Move towards injured ally
-            auto* other_pos = other->getComponent<PositionComponent>();
-            if (other_pos && getDistance(entity, other) <= ai->vision_range) {
-                Point ally_pos{other_pos->position.x, other_pos->position.y};
-                moveTowards(entity, ally_pos);
-                return;
-            }
-        }
-    }*/
-
-    // Follow the player at a distance
-    if (getDistance(entity, player) > 3) {
-        auto* player_pos = player->getComponent<PositionComponent>();
-        if (player_pos) {
-            Point player_point{player_pos->position.x, player_pos->position.y};
-            moveTowards(entity, player_point);
-        }
-    }
+    return it != entities.end() ? it->get() : nullptr;
 }
 
-} // namespace ecs
\ No newline at end of file
+} // namespace ecs
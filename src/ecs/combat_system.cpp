@@ -6,6 +6,7 @@
 #include "ecs/combat_system.h"
 #include "ecs/renderable_component.h"
 #include "ecs/event.h"
+#include "ecs/system_manager.h"
 #include <algorithm>
 #include <cmath>
 
@@ -163,6 +164,7 @@ int CombatSystem::applyDamage(std::shared_ptr<Entity> entity, int damage) {
         health->hp = 0;
         // Could set a "dead" flag here if needed
     }
+    entity->markChanged<HealthComponent>();
 
     return actual_damage;
 }
@@ -211,6 +213,11 @@ std::shared_ptr<Entity> CombatSystem::findEntity(
     const std::vector<std::unique_ptr<Entity>>& entities,
     EntityID id) const {
 
+    if (world) {
+        Entity* entity = world->getEntity(id);
+        return entity ? std::shared_ptr<Entity>(entity, [](Entity*){}) : nullptr;
+    }
+
     auto it = std::find_if(entities.begin(), entities.end(),
         [id](const std::unique_ptr<Entity>& e) {
             return e->getID() == id;
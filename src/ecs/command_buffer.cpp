@@ -0,0 +1,108 @@
+/**
+ * @file command_buffer.cpp
+ * @brief Implementation of deferred world changes
+ */
+
+#include "../../include/ecs/command_buffer.h"
+#include "../../include/ecs/system_manager.h"
+
+namespace ecs {
+
+Entity& CommandBuffer::create() {
+    auto entity = std::make_unique<Entity>();
+    Entity& staged = *entity;
+    create(std::move(entity));
+    return staged;
+}
+
+EntityID CommandBuffer::create(std::unique_ptr<Entity> entity) {
+    if (!entity) {
+        return INVALID_ENTITY_ID;
+    }
+
+    // Reserve the ID now so later commands can target the staged entity
+    bool reserved = entity->id == INVALID_ENTITY_ID;
+    if (reserved) {
+        entity->id = ids.allocate();
+    }
+    EntityID id = entity->id;
+    record({Op::CREATE, id, std::move(entity), nullptr, nullptr, reserved});
+    return id;
+}
+
+void CommandBuffer::destroy(EntityID id) {
+    record({Op::DESTROY, id, nullptr, nullptr, nullptr});
+}
+
+void CommandBuffer::addComponent(EntityID id, std::unique_ptr<IComponent> component) {
+    if (component) {
+        record({Op::ADD_COMPONENT, id, nullptr, std::move(component), nullptr});
+    }
+}
+
+void CommandBuffer::record(Command command) {
+    std::lock_guard<std::mutex> lock(mutex);
+    commands.push_back(std::move(command));
+}
+
+size_t CommandBuffer::flush(World& world) {
+    size_t applied = 0;
+
+    // Take the batch out first so commands recorded while applying (or a
+    // nested flush) never touch the vector being walked
+    std::vector<Command> batch = std::move(applying);
+    while (true) {
+        batch.clear();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (commands.empty()) {
+                break;
+            }
+            batch.swap(commands);
+        }
+
+        for (Command& command : batch) {
+            if (command.op == Op::CREATE) {
+                world.addEntity(std::move(command.entity));
+                ++applied;
+                continue;
+            }
+
+            if (command.op == Op::DESTROY) {
+                applied += world.removeEntity(command.id) ? 1 : 0;
+                continue;
+            }
+
+            Entity* entity = world.getEntity(command.id);
+            if (!entity) {
+                continue;
+            }
+            if (command.op == Op::ADD_COMPONENT) {
+                entity->addComponent(std::move(command.component));
+                ++applied;
+            } else if (command.remove(*entity)) {
+                ++applied;
+            }
+        }
+    }
+    applying = std::move(batch);
+
+    return applied;
+}
+
+void CommandBuffer::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const Command& command : commands) {
+        if (command.reserved) {
+            ids.release(command.id);
+        }
+    }
+    commands.clear();
+}
+
+size_t CommandBuffer::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return commands.size();
+}
+
+} // namespace ecs
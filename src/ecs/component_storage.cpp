@@ -0,0 +1,372 @@
+/**
+ * @file component_storage.cpp
+ * @brief Implementation of per-type component pools
+ */
+
+#include "../../include/ecs/component_storage.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+
+namespace ecs {
+
+namespace {
+
+/// Memory layout of a registered component class
+struct ComponentLayout {
+    std::size_t size;
+    std::size_t align;
+};
+
+std::vector<ComponentLayout>& layoutRegistry() {
+    static std::vector<ComponentLayout> layouts;
+    return layouts;
+}
+
+std::mutex& layoutMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+ComponentLayout getLayout(ComponentTypeId type) {
+    std::lock_guard<std::mutex> lock(layoutMutex());
+    return layoutRegistry().at(type);
+}
+
+} // anonymous namespace
+
+namespace detail {
+
+ComponentTypeId registerComponentType(std::size_t size, std::size_t align) {
+    std::lock_guard<std::mutex> lock(layoutMutex());
+    auto& layouts = layoutRegistry();
+    layouts.push_back({size, align});
+    return static_cast<ComponentTypeId>(layouts.size() - 1);
+}
+
+ViewId registerView() {
+    static std::atomic<ViewId> next_view{0};
+    return next_view++;
+}
+
+} // namespace detail
+
+// ComponentPool
+
+ComponentPool::ComponentPool(ComponentTypeId type, std::size_t size, std::size_t align,
+                             const std::atomic<std::uint32_t>* clock)
+    : type(type)
+    , stride((size + align - 1) / align * align)
+    , alignment(align)
+    , clock(clock) {
+}
+
+ComponentPool::~ComponentPool() {
+    for (IComponent* component : components) {
+        component->~IComponent();
+    }
+    for (void* page : pages) {
+        ::operator delete(page, std::align_val_t(alignment));
+    }
+}
+
+IComponent* ComponentPool::adopt(Entity* owner, std::uint32_t index, IComponent& source) {
+    std::uint32_t slot = allocateSlot();
+    IComponent* component = nullptr;
+    try {
+        component = source.relocateTo(slotAddress(slot));
+    } catch (...) {
+        free_slots.push_back(slot);
+        throw;
+    }
+    commit(owner, index, slot, component);
+    return component;
+}
+
+IComponent* ComponentPool::copy(Entity* owner, std::uint32_t index, const IComponent& source) {
+    std::uint32_t slot = allocateSlot();
+    IComponent* component = nullptr;
+    try {
+        component = source.copyTo(slotAddress(slot));
+    } catch (...) {
+        free_slots.push_back(slot);
+        throw;
+    }
+    commit(owner, index, slot, component);
+    return component;
+}
+
+bool ComponentPool::erase(std::uint32_t index) {
+    if (!contains(index)) {
+        return false;
+    }
+
+    const std::uint32_t dense = sparse[index];
+    const std::uint32_t last = static_cast<std::uint32_t>(owners.size() - 1);
+
+    components[dense]->~IComponent();
+    free_slots.push_back(dense_slots[dense]);
+
+    // Swap-remove to keep dense arrays packed
+    if (dense != last) {
+        owners[dense] = owners[last];
+        components[dense] = components[last];
+        dense_slots[dense] = dense_slots[last];
+        dense_index[dense] = dense_index[last];
+        added_ticks[dense] = added_ticks[last];
+        changed_ticks[dense] = changed_ticks[last];
+        sparse[dense_index[dense]] = dense;
+    }
+
+    owners.pop_back();
+    components.pop_back();
+    dense_slots.pop_back();
+    dense_index.pop_back();
+    added_ticks.pop_back();
+    changed_ticks.pop_back();
+    sparse[index] = NPOS;
+    last_change_tick = now();
+    return true;
+}
+
+std::uint32_t ComponentPool::allocateSlot() {
+    if (!free_slots.empty()) {
+        std::uint32_t slot = free_slots.back();
+        free_slots.pop_back();
+        return slot;
+    }
+
+    if (used_slots == pages.size() * PAGE_SIZE) {
+        pages.push_back(::operator new(stride * PAGE_SIZE, std::align_val_t(alignment)));
+    }
+    return used_slots++;
+}
+
+void* ComponentPool::slotAddress(std::uint32_t slot) const {
+    auto* page = static_cast<unsigned char*>(pages[slot / PAGE_SIZE]);
+    return page + (slot % PAGE_SIZE) * stride;
+}
+
+void ComponentPool::commit(Entity* owner, std::uint32_t index, std::uint32_t slot,
+                           IComponent* component) {
+    if (index >= sparse.size()) {
+        sparse.resize(index + 1, NPOS);
+    }
+
+    const std::uint32_t tick = now();
+    last_change_tick = tick;
+
+    if (sparse[index] != NPOS) {
+        // Replace in place: the new component is already constructed
+        const std::uint32_t dense = sparse[index];
+        components[dense]->~IComponent();
+        free_slots.push_back(dense_slots[dense]);
+        owners[dense] = owner;
+        components[dense] = component;
+        dense_slots[dense] = slot;
+        added_ticks[dense] = tick;
+        changed_ticks[dense] = tick;
+        return;
+    }
+
+    sparse[index] = static_cast<std::uint32_t>(owners.size());
+    owners.push_back(owner);
+    components.push_back(component);
+    dense_slots.push_back(slot);
+    dense_index.push_back(index);
+    added_ticks.push_back(tick);
+    changed_ticks.push_back(tick);
+}
+
+// ViewCache
+
+void ViewCache::insert(Entity* entity, std::uint32_t index) {
+    if (index >= positions.size()) {
+        positions.resize(index + 1, NPOS);
+    }
+    if (positions[index] != NPOS) {
+        return;
+    }
+
+    positions[index] = static_cast<std::uint32_t>(entities.size());
+    entities.push_back(entity);
+    indices.push_back(index);
+}
+
+void ViewCache::erase(std::uint32_t index) {
+    if (!contains(index)) {
+        return;
+    }
+
+    const std::uint32_t pos = positions[index];
+    if (passes > 0) {
+        // Leave a hole: swap-moving the last entry would shift it under the pass
+        entities[pos] = nullptr;
+        positions[index] = NPOS;
+        ++holes;
+        return;
+    }
+
+    const std::uint32_t last = static_cast<std::uint32_t>(entities.size() - 1);
+    if (pos != last) {
+        entities[pos] = entities[last];
+        indices[pos] = indices[last];
+        positions[indices[pos]] = pos;
+    }
+
+    entities.pop_back();
+    indices.pop_back();
+    positions[index] = NPOS;
+}
+
+void ViewCache::endPass() {
+    if (--passes == 0 && holes > 0) {
+        compact();
+    }
+}
+
+void ViewCache::compact() {
+    size_t kept = 0;
+    for (size_t i = 0; i < entities.size(); ++i) {
+        if (!entities[i]) {
+            continue;
+        }
+        entities[kept] = entities[i];
+        indices[kept] = indices[i];
+        positions[indices[kept]] = static_cast<std::uint32_t>(kept);
+        ++kept;
+    }
+    entities.resize(kept);
+    indices.resize(kept);
+    holes = 0;
+}
+
+// ComponentStorage
+
+ComponentPool& ComponentStorage::getPool(ComponentTypeId type) {
+    if (ComponentPool* pool = findPool(type)) {
+        return *pool;
+    }
+    std::lock_guard<std::mutex> lock(view_mutex);
+    return createPool(type);
+}
+
+ComponentPool& ComponentStorage::createPool(ComponentTypeId type) {
+    if (type >= MAX_COMPONENT_TYPES) {
+        throw std::out_of_range("Too many component types for ComponentStorage");
+    }
+    if (ComponentPool* pool = findPool(type)) {
+        return *pool;
+    }
+
+    ComponentLayout layout = getLayout(type);
+    owned_pools.push_back(
+        std::make_unique<ComponentPool>(type, layout.size, layout.align, &change_tick));
+    pools[type].store(owned_pools.back().get(), std::memory_order_release);
+    return *owned_pools.back();
+}
+
+std::uint32_t ComponentStorage::acquireIndex() {
+    if (!free_indices.empty()) {
+        std::uint32_t index = free_indices.back();
+        free_indices.pop_back();
+        return index;
+    }
+    return next_index++;
+}
+
+void ComponentStorage::releaseIndex(std::uint32_t index) {
+    free_indices.push_back(index);
+}
+
+ViewCache& ComponentStorage::getView(ViewId id, std::vector<ComponentTypeId> signature) {
+    std::lock_guard<std::mutex> lock(view_mutex);
+    if (id < views.size() && views[id]) {
+        return *views[id];
+    }
+
+    if (id >= views.size()) {
+        views.resize(id + 1);
+    }
+    views[id] = std::make_unique<ViewCache>(std::move(signature));
+    ViewCache& view = *views[id];
+
+    // Seed from the smallest pool in the signature
+    const ComponentPool* smallest = nullptr;
+    for (ComponentTypeId type : view.getSignature()) {
+        if (type >= views_by_type.size()) {
+            views_by_type.resize(type + 1);
+        }
+        views_by_type[type].push_back(&view);
+
+        const ComponentPool& pool = createPool(type);
+        if (!smallest || pool.size() < smallest->size()) {
+            smallest = &pool;
+        }
+    }
+
+    if (smallest) {
+        const auto& owners = smallest->getOwners();
+        const auto& indices = smallest->getIndices();
+        for (std::size_t i = 0; i < owners.size(); ++i) {
+            if (matches(view, indices[i])) {
+                view.insert(owners[i], indices[i]);
+            }
+        }
+    }
+
+    return view;
+}
+
+void ComponentStorage::notifyAdded(ComponentTypeId type, Entity* entity, std::uint32_t index) {
+    if (type >= views_by_type.size()) {
+        return;
+    }
+    for (ViewCache* view : views_by_type[type]) {
+        if (!view->contains(index) && matches(*view, index)) {
+            view->insert(entity, index);
+        }
+    }
+}
+
+void ComponentStorage::notifyRemoved(ComponentTypeId type, std::uint32_t index) {
+    if (type >= views_by_type.size()) {
+        return;
+    }
+    for (ViewCache* view : views_by_type[type]) {
+        view->erase(index);
+    }
+}
+
+void ComponentStorage::addListener(ComponentTypeId type, ComponentListener* listener) {
+    if (type >= listeners.size()) {
+        listeners.resize(type + 1);
+    }
+    listeners[type].push_back(listener);
+}
+
+void ComponentStorage::removeListener(ComponentTypeId type, ComponentListener* listener) {
+    if (type < listeners.size()) {
+        auto& list = listeners[type];
+        list.erase(std::remove(list.begin(), list.end(), listener), list.end());
+    }
+}
+
+bool ComponentStorage::matches(const ViewCache& view, std::uint32_t index) const {
+    for (ComponentTypeId type : view.getSignature()) {
+        const ComponentPool* pool = findPool(type);
+        if (!pool || !pool->contains(index)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::size_t ComponentStorage::getPoolCount() const {
+    return static_cast<std::size_t>(
+        std::count_if(pools.begin(), pools.end(),
+                      [](const auto& pool) { return pool.load() != nullptr; }));
+}
+
+} // namespace ecs
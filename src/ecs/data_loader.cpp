@@ -48,6 +48,7 @@ bool DataLoader::loadMonsters(const std::string& filepath) {
             }
         }
 
+        ++revision;
         std::cout << "Loaded " << monster_templates.size() << " monster templates" << std::endl;
         return true;
     }
@@ -80,6 +81,7 @@ bool DataLoader::loadItems(const std::string& filepath) {
             }
         }
 
+        ++revision;
         std::cout << "Loaded " << item_templates.size() << " item templates" << std::endl;
         return true;
     }
@@ -103,6 +105,7 @@ void DataLoader::clearData() {
     monster_templates.clear();
     item_templates.clear();
     data_loaded = false;
+    ++revision;
 }
 
 ftxui::Color DataLoader::parseColor(const std::string& color_str) const {
@@ -7,46 +7,99 @@
 
 namespace ecs {
 
-// Initialize static member
-EntityID Entity::next_id = 1;
+Entity::Entity()
+    : id(INVALID_ENTITY_ID) {
+}
 
-Entity::Entity() : id(next_id++) {}
+Entity::Entity(EntityID id)
+    : id(id) {
+}
 
-Entity::Entity(EntityID id) : id(id) {
-    // Update next_id if necessary to avoid conflicts
-    if (id >= next_id) {
-        next_id = id + 1;
+Entity::~Entity() {
+    clearComponents();
+    if (storage) {
+        storage->releaseIndex(storage_index);
     }
 }
 
 void Entity::addComponent(std::unique_ptr<IComponent> component) {
-    if (component) {
-        components[component->getType()] = std::move(component);
+    if (!component) {
+        return;
+    }
+
+    const ComponentTypeId type_id = component->getTypeId();
+    if (storage) {
+        // Move into the pool; the heap copy is released with the unique_ptr
+        setSlot(type_id, storage->getPool(type_id).adopt(this, storage_index, *component));
+    } else {
+        setSlot(type_id, component.release());
+    }
+}
+
+void Entity::copyComponent(const IComponent& component) {
+    const ComponentTypeId type_id = component.getTypeId();
+    if (storage) {
+        setSlot(type_id, storage->getPool(type_id).copy(this, storage_index, component));
+    } else {
+        setSlot(type_id, component.clone().release());
     }
 }
 
 IComponent* Entity::getComponent(ComponentType type) {
-    auto it = components.find(type);
-    return (it != components.end()) ? it->second.get() : nullptr;
+    for (IComponent* component : slots) {
+        if (component && component->getType() == type) {
+            return component;
+        }
+    }
+    return nullptr;
 }
 
 const IComponent* Entity::getComponent(ComponentType type) const {
-    auto it = components.find(type);
-    return (it != components.end()) ? it->second.get() : nullptr;
+    for (const IComponent* component : slots) {
+        if (component && component->getType() == type) {
+            return component;
+        }
+    }
+    return nullptr;
 }
 
 bool Entity::hasComponent(ComponentType type) const {
-    return components.find(type) != components.end();
+    return getComponent(type) != nullptr;
 }
 
 bool Entity::removeComponent(ComponentType type) {
-    return components.erase(type) > 0;
+    for (ComponentTypeId type_id = 0; type_id < slots.size(); ++type_id) {
+        if (slots[type_id] && slots[type_id]->getType() == type) {
+            return eraseSlot(type_id);
+        }
+    }
+    return false;
+}
+
+std::vector<std::pair<ComponentType, IComponent*>> Entity::getComponents() const {
+    std::vector<std::pair<ComponentType, IComponent*>> result;
+    result.reserve(component_count);
+    for (IComponent* component : slots) {
+        if (component) {
+            result.emplace_back(component->getType(), component);
+        }
+    }
+    return result;
+}
+
+void Entity::clearComponents() {
+    for (ComponentTypeId type_id = 0; type_id < slots.size(); ++type_id) {
+        if (slots[type_id]) {
+            eraseSlot(type_id);
+        }
+    }
+    slots.clear();
 }
 
 std::unique_ptr<Entity> Entity::clone() const {
     auto cloned = std::make_unique<Entity>();
 
-    for (const auto& [type, component] : components) {
+    for (const IComponent* component : slots) {
         if (component) {
             cloned->addComponent(component->clone());
         }
@@ -55,4 +108,79 @@ std::unique_ptr<Entity> Entity::clone() const {
     return cloned;
 }
 
-} // namespace ecs
\ No newline at end of file
+void Entity::attach(ComponentStorage& target) {
+    if (storage == &target) {
+        return;
+    }
+
+    storage = &target;
+    storage_index = target.acquireIndex();
+
+    // Migrate heap-owned components into the pools
+    for (ComponentTypeId type_id = 0; type_id < slots.size(); ++type_id) {
+        IComponent* component = slots[type_id];
+        if (component) {
+            slots[type_id] = target.getPool(type_id).adopt(this, storage_index, *component);
+            delete component;
+        }
+    }
+
+    // Register with cached views and listeners once every component is in place
+    for (ComponentTypeId type_id = 0; type_id < slots.size(); ++type_id) {
+        if (slots[type_id]) {
+            target.notifyAdded(type_id, this, storage_index);
+            target.notifySet(type_id, *this, *slots[type_id]);
+        }
+    }
+}
+
+void Entity::setSlot(ComponentTypeId type_id, IComponent* component) {
+    if (type_id >= slots.size()) {
+        slots.resize(type_id + 1, nullptr);
+    }
+
+    IComponent*& slot = slots[type_id];
+    const bool added = (slot == nullptr);
+    if (added) {
+        ++component_count;
+    } else if (!storage && slot != component) {
+        // Standalone entities own their components; pools destroy replaced ones
+        delete slot;
+    }
+    slot = component;
+
+    if (storage) {
+        if (added) {
+            storage->notifyAdded(type_id, this, storage_index);
+        }
+        storage->notifySet(type_id, *this, *component);
+    }
+}
+
+void Entity::markChanged(ComponentTypeId type_id) {
+    if (storage && type_id < slots.size() && slots[type_id]) {
+        storage->markChanged(type_id, *this, storage_index, *slots[type_id]);
+    }
+}
+
+bool Entity::eraseSlot(ComponentTypeId type_id) {
+    if (type_id >= slots.size() || !slots[type_id]) {
+        return false;
+    }
+
+    if (storage) {
+        storage->notifyRemoving(type_id, *this, *slots[type_id]);
+        storage->getPool(type_id).erase(storage_index);
+    } else {
+        delete slots[type_id];
+    }
+    slots[type_id] = nullptr;
+    --component_count;
+
+    if (storage) {
+        storage->notifyRemoved(type_id, storage_index);
+    }
+    return true;
+}
+
+} // namespace ecs
@@ -262,6 +262,10 @@ std::unique_ptr<Entity> EntityFactory::createLight(int x, int y, int radius,
     renderable.name = "Light";
     renderable.color = color;
 
+    // Light source
+    auto& light_source = light->addComponent<LightComponent>(radius);
+    light_source.color = color;
+
     // Tags
     light->addTag("light");
     light->addTag("radius:" + std::to_string(radius));
@@ -490,6 +494,7 @@ void EntityFactory::applyMonsterTemplate(Entity* entity, const std::string& mons
 
     auto& ai = entity->addComponent<AIComponent>();
     ai.behavior = template_data->aggressive ? AIBehavior::AGGRESSIVE : AIBehavior::WANDERING;
+    ai.speed = template_data->speed;
 
     // Add stats if needed
     auto& stats = entity->addComponent<StatsComponent>();
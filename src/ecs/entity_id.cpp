@@ -0,0 +1,110 @@
+/**
+ * @file entity_id.cpp
+ * @brief Implementation of generational entity ID allocation
+ */
+
+#include "../../include/ecs/entity_id.h"
+
+namespace ecs {
+
+EntityIdAllocator::EntityIdAllocator() {
+    // Slot 0 is reserved so that ID 0 stays invalid
+    generations.push_back(0);
+    alive.push_back(true);
+}
+
+EntityID EntityIdAllocator::allocate() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    while (free_slots.size() - free_head > MIN_FREE_SLOTS) {
+        uint32_t index = free_slots[free_head++];
+
+        // Drop consumed entries once they dominate the ring
+        if (free_head > MIN_FREE_SLOTS && free_head * 2 > free_slots.size()) {
+            free_slots.erase(free_slots.begin(), free_slots.begin() + free_head);
+            free_head = 0;
+        }
+
+        if (alive[index]) {
+            continue;  // Claimed explicitly since it was released
+        }
+        alive[index] = true;
+        ++alive_count;
+        return makeEntityID(index, generations[index]);
+    }
+
+    uint32_t index = static_cast<uint32_t>(generations.size());
+    generations.push_back(0);
+    alive.push_back(true);
+    ++alive_count;
+    return makeEntityID(index, 0);
+}
+
+bool EntityIdAllocator::claim(EntityID id) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    uint32_t index = entityIndex(id);
+    if (index == 0) {
+        return false;
+    }
+
+    // Slots skipped over by the claim become ordinary free slots
+    while (generations.size() <= index) {
+        uint32_t skipped = static_cast<uint32_t>(generations.size());
+        generations.push_back(0);
+        alive.push_back(false);
+        if (skipped != index) {
+            free_slots.push_back(skipped);
+        }
+    }
+
+    // Never move a generation backwards, or released IDs would match again
+    if (alive[index] || entityGeneration(id) < generations[index]) {
+        return false;
+    }
+
+    generations[index] = entityGeneration(id);
+    alive[index] = true;
+    ++alive_count;
+    return true;
+}
+
+void EntityIdAllocator::release(EntityID id) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    uint32_t index = entityIndex(id);
+    if (index == 0 || index >= generations.size() || !alive[index] ||
+        generations[index] != entityGeneration(id)) {
+        return;
+    }
+
+    alive[index] = false;
+    ++generations[index];
+    free_slots.push_back(index);
+    --alive_count;
+}
+
+bool EntityIdAllocator::isAlive(EntityID id) const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    uint32_t index = entityIndex(id);
+    return index != 0 && index < generations.size() && alive[index] &&
+           generations[index] == entityGeneration(id);
+}
+
+size_t EntityIdAllocator::getAliveCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return alive_count;
+}
+
+void EntityIdAllocator::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    generations.assign(1, 0);
+    alive.assign(1, true);
+    free_slots.clear();
+    free_head = 0;
+    alive_count = 0;
+}
+
+} // namespace ecs
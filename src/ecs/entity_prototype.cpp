@@ -0,0 +1,213 @@
+/**
+ * @file entity_prototype.cpp
+ * @brief Implementation of precompiled entity prototypes
+ */
+
+#include "ecs/entity_prototype.h"
+#include "ecs/data_loader.h"
+#include "ecs/system_manager.h"
+#include "ecs/position_component.h"
+#include "ecs/renderable_component.h"
+#include "ecs/health_component.h"
+#include "ecs/combat_component.h"
+#include "ecs/item_component.h"
+#include "ecs/ai_component.h"
+#include "ecs/loot_component.h"
+
+namespace ecs {
+
+// EntityPrototype
+
+std::unique_ptr<Entity> EntityPrototype::instantiate(int x, int y) const {
+    auto entity = std::make_unique<Entity>();
+    stamp(*entity, x, y);
+    return entity;
+}
+
+Entity& EntityPrototype::instantiate(World& world, int x, int y) const {
+    // Join the world first so components are copied straight into its pools
+    Entity& entity = world.createEntity();
+    stamp(entity, x, y);
+    return entity;
+}
+
+void EntityPrototype::stamp(Entity& entity, int x, int y) const {
+    entity.addComponent<PositionComponent>(x, y);
+    for (const auto& component : components) {
+        entity.copyComponent(*component);
+    }
+    for (const auto& tag : tags) {
+        entity.addTag(tag);
+    }
+}
+
+// PrototypeRegistry
+
+PrototypeRegistry& PrototypeRegistry::getInstance() {
+    static PrototypeRegistry instance;
+    return instance;
+}
+
+PrototypeId PrototypeRegistry::findMonster(std::string_view monster_id) {
+    ensureCompiled();
+    return find(monster_ids, monster_id);
+}
+
+PrototypeId PrototypeRegistry::findItem(std::string_view item_id) {
+    ensureCompiled();
+    return find(item_ids, item_id);
+}
+
+PrototypeId PrototypeRegistry::find(const NameMap& ids, std::string_view name) {
+    auto it = ids.find(name);
+    return it != ids.end() ? it->second : INVALID_PROTOTYPE_ID;
+}
+
+std::vector<EntityID> PrototypeRegistry::spawnBatch(World& world,
+                                                    const std::vector<SpawnRequest>& requests,
+                                                    const std::function<void(Entity&)>& customize) {
+    std::vector<EntityID> spawned;
+    spawned.reserve(requests.size());
+    world.reserveEntities(requests.size());
+
+    for (const SpawnRequest& request : requests) {
+        const EntityPrototype* prototype = get(request.prototype);
+        if (!prototype) {
+            continue;
+        }
+        Entity& entity = prototype->instantiate(world, request.x, request.y);
+        if (customize) {
+            customize(entity);
+        }
+        spawned.push_back(entity.getID());
+    }
+    return spawned;
+}
+
+void PrototypeRegistry::ensureCompiled() {
+    const DataLoader& loader = DataLoader::getInstance();
+    if (!compiled || compiled_revision != loader.getRevision()) {
+        compile(loader);
+    }
+}
+
+void PrototypeRegistry::compile(const DataLoader& loader) {
+    prototypes.clear();
+    monster_ids.clear();
+    item_ids.clear();
+
+    for (const auto& [id, data] : loader.getMonsterTemplates()) {
+        monster_ids.emplace(id, static_cast<PrototypeId>(prototypes.size()));
+        prototypes.push_back(compileMonster(data));
+    }
+    for (const auto& [id, data] : loader.getItemTemplates()) {
+        item_ids.emplace(id, static_cast<PrototypeId>(prototypes.size()));
+        prototypes.push_back(compileItem(data));
+    }
+
+    compiled_revision = loader.getRevision();
+    compiled = true;
+}
+
+std::unique_ptr<EntityPrototype> PrototypeRegistry::compileMonster(const MonsterTemplate& data) {
+    auto prototype = std::make_unique<EntityPrototype>(data.id);
+
+    // Renderable component
+    auto& renderable = prototype->addComponent<RenderableComponent>(
+        std::string(1, data.glyph), data.color);
+    renderable.name = data.name;
+
+    // Health component
+    prototype->addComponent<HealthComponent>(data.hp, data.hp);
+
+    // Combat component
+    int min_damage = 1;
+    int max_damage = 4;
+    auto& combat = prototype->addComponent<CombatComponent>(
+        (min_damage + max_damage) / 2,
+        data.attack,
+        data.defense
+    );
+    combat.setDamageRange(min_damage, max_damage);
+    combat.combat_name = data.name;
+
+    // AI component
+    auto& ai = prototype->addComponent<AIComponent>();
+    ai.behavior = data.aggressive ? AIBehavior::AGGRESSIVE : AIBehavior::WANDERING;
+    ai.vision_range = 5;  // Default values
+    ai.aggro_range = 3;
+    ai.speed = data.speed;
+
+    // Loot component
+    auto& loot = prototype->addComponent<LootComponent>();
+    loot.guaranteed_gold = 0;
+    loot.random_gold_max = data.xp_value / 2;  // Use XP as basis for gold
+    loot.experience_value = data.xp_value;
+
+    // Tags
+    prototype->addTag("monster");
+    prototype->addTag(data.id);
+
+    return prototype;
+}
+
+std::unique_ptr<EntityPrototype> PrototypeRegistry::compileItem(const ItemTemplate& data) {
+    auto prototype = std::make_unique<EntityPrototype>(data.id);
+
+    // Renderable component
+    auto& renderable = prototype->addComponent<RenderableComponent>(
+        std::string(1, data.symbol), data.color);
+    renderable.name = data.name;
+
+    // Item component
+    auto& item_comp = prototype->addComponent<ItemComponent>();
+    item_comp.name = data.name;
+    item_comp.description = data.description;
+    item_comp.value = data.value;
+    item_comp.weight = static_cast<float>(data.weight);
+    item_comp.max_stack = data.stackable ? data.max_stack : 1;
+    item_comp.stack_size = 1;
+
+    // Map item type string to enum
+    if (data.type == "weapon") {
+        item_comp.item_type = ItemType::WEAPON;
+        item_comp.equippable = true;
+        item_comp.min_damage = data.min_damage;
+        item_comp.max_damage = data.max_damage;
+        item_comp.attack_bonus = data.attack_bonus;
+    } else if (data.type == "armor") {
+        item_comp.item_type = ItemType::ARMOR;
+        item_comp.equippable = true;
+        item_comp.defense_bonus = data.defense_bonus;
+    } else if (data.type == "potion") {
+        item_comp.item_type = ItemType::POTION;
+        item_comp.consumable = true;
+        item_comp.heal_amount = data.heal_amount;
+    } else if (data.type == "scroll") {
+        item_comp.item_type = ItemType::SCROLL;
+        item_comp.consumable = true;
+        item_comp.damage_amount = data.damage_amount;
+    } else if (data.type == "food") {
+        item_comp.item_type = ItemType::FOOD;
+        item_comp.consumable = true;
+        item_comp.heal_amount = data.heal_amount;
+    } else if (data.type == "ring") {
+        item_comp.item_type = ItemType::RING;
+        item_comp.equippable = true;
+    } else if (data.type == "shield") {
+        item_comp.item_type = ItemType::SHIELD;
+        item_comp.equippable = true;
+        item_comp.defense_bonus = data.defense_bonus;
+    } else {
+        item_comp.item_type = ItemType::MISC;
+    }
+
+    // Tags
+    prototype->addTag("item");
+    prototype->addTag(data.id);
+    prototype->addTag(data.type);
+
+    return prototype;
+}
+
+} // namespace ecs
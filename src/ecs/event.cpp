@@ -4,9 +4,247 @@
  */
 
 #include "ecs/event.h"
+#include <algorithm>
 
 namespace ecs {
 
-// Event system implementation is all in the header for simplicity
+void EventRing::grow() {
+    std::vector<BaseEvent> larger(slots.empty() ? 16 : slots.size() * 2);
+    for (size_t i = 0; i < count; ++i) {
+        larger[i] = slots[(head + i) & (slots.size() - 1)];
+    }
+    slots.swap(larger);
+    head = 0;
+}
 
-} // namespace ecs
\ No newline at end of file
+std::span<const BaseEvent> EventRing::view() {
+    if (head + count > slots.size()) {
+        // Wrapped: rotate so the oldest event sits at the start
+        std::rotate(slots.begin(), slots.begin() + static_cast<std::ptrdiff_t>(head), slots.end());
+        head = 0;
+    }
+    if (count == 0) {
+        return {};
+    }
+    return std::span<const BaseEvent>(slots.data() + head, count);
+}
+
+EventMailbox::EventMailbox(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) {
+        size *= 2;
+    }
+    cells = std::make_unique<Cell[]>(size);
+    mask = size - 1;
+    for (size_t i = 0; i < size; ++i) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool EventMailbox::push(const BaseEvent& event) {
+    size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+        cell = &cells[pos & mask];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0) {
+            // Slot is free for this position; claim it
+            if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;  // Full: consumer has not freed this slot yet
+        } else {
+            pos = enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->event = event;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool EventMailbox::pop(BaseEvent& event) {
+    Cell& cell = cells[dequeue_pos & mask];
+    size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    if (sequence != dequeue_pos + 1) {
+        return false;
+    }
+
+    event = cell.event;
+    cell.sequence.store(dequeue_pos + mask + 1, std::memory_order_release);
+    ++dequeue_pos;
+    return true;
+}
+
+SubscriptionId EventSystem::subscribe(EventType type, EventHandler handler) {
+    SubscriptionId id = next_subscription++;
+    if (in_dispatch) {
+        // Appending could reallocate the vector being dispatched from
+        added_handlers.push_back({type, {id, std::move(handler)}});
+    } else {
+        handlers[static_cast<size_t>(type)].push_back({id, std::move(handler)});
+    }
+    return id;
+}
+
+SubscriptionId EventSystem::subscribeBatch(EventType type, EventBatchHandler handler) {
+    SubscriptionId id = next_subscription++;
+    if (in_dispatch) {
+        added_batch_handlers.push_back({type, {id, std::move(handler)}});
+    } else {
+        batch_handlers[static_cast<size_t>(type)].push_back({id, std::move(handler)});
+    }
+    return id;
+}
+
+void EventSystem::unsubscribe(EventType type, SubscriptionId id) {
+    // Only marked here: the handler may be the one running. endDispatch()
+    // or the next update() drops the entry.
+    for (auto& sub : handlers[static_cast<size_t>(type)]) {
+        if (sub.id == id) {
+            sub.active = false;
+        }
+    }
+    for (auto& sub : batch_handlers[static_cast<size_t>(type)]) {
+        if (sub.id == id) {
+            sub.active = false;
+        }
+    }
+    for (auto& [added_type, sub] : added_handlers) {
+        if (added_type == type && sub.id == id) {
+            sub.active = false;
+        }
+    }
+    for (auto& [added_type, sub] : added_batch_handlers) {
+        if (added_type == type && sub.id == id) {
+            sub.active = false;
+        }
+    }
+    if (!in_dispatch) {
+        endDispatch();
+    }
+}
+
+void EventSystem::endDispatch() {
+    in_dispatch = false;
+    dispatching.clear();
+    for (auto& batch : batches) {
+        batch.clear();
+    }
+
+    for (auto& type_handlers : handlers) {
+        std::erase_if(type_handlers, [](const Subscription& sub) { return !sub.active; });
+    }
+    for (auto& type_batch_handlers : batch_handlers) {
+        std::erase_if(type_batch_handlers, [](const BatchSubscription& sub) { return !sub.active; });
+    }
+    for (auto& [type, sub] : added_handlers) {
+        if (sub.active) {
+            handlers[static_cast<size_t>(type)].push_back(std::move(sub));
+        }
+    }
+    for (auto& [type, sub] : added_batch_handlers) {
+        if (sub.active) {
+            batch_handlers[static_cast<size_t>(type)].push_back(std::move(sub));
+        }
+    }
+    added_handlers.clear();
+    added_batch_handlers.clear();
+}
+
+void EventSystem::update() {
+    if (in_dispatch) {
+        return;
+    }
+
+    // Hand over events posted by other threads
+    BaseEvent posted;
+    while (mailbox.pop(posted)) {
+        emit(posted);
+    }
+
+    // Take every queued event; whatever handlers emit from here on lands
+    // in the emptied ring and waits for the next update
+    queue.swap(dispatching);
+    queued_counts.fill(0);
+    std::span<const BaseEvent> events = dispatching.view();
+    if (events.empty()) {
+        return;
+    }
+
+    // Finishes the dispatch even if a handler throws
+    struct DispatchScope {
+        EventSystem& bus;
+        ~DispatchScope() { bus.endDispatch(); }
+    };
+    in_dispatch = true;
+    DispatchScope scope{*this};
+
+    // Gather each batch-handled type's events into one span
+    for (const BaseEvent& event : events) {
+        size_t type = static_cast<size_t>(event.type);
+        if (!batch_handlers[type].empty()) {
+            batches[type].push(event);
+        }
+    }
+    for (size_t type = 0; type < EVENT_TYPE_COUNT; ++type) {
+        if (batches[type].size() == 0) {
+            continue;
+        }
+        // Handler vectors stay put while dispatching; see subscribe()
+        std::span<const BaseEvent> batch = batches[type].view();
+        for (const BatchSubscription& sub : batch_handlers[type]) {
+            if (sub.active) {
+                sub.handler(batch);
+            }
+        }
+    }
+
+    // Per-event handlers in emission order
+    for (const BaseEvent& event : events) {
+        for (const Subscription& sub : handlers[static_cast<size_t>(event.type)]) {
+            if (sub.active) {
+                sub.handler(event);
+            }
+        }
+    }
+}
+
+void EventSystem::reset() {
+    BaseEvent posted;
+    while (mailbox.pop(posted)) {
+    }
+    queue.clear();
+    queued_counts.fill(0);
+    added_handlers.clear();
+    added_batch_handlers.clear();
+    if (in_dispatch) {
+        // Silences the rest of this dispatch; endDispatch() drops them all
+        for (auto& type_handlers : handlers) {
+            for (auto& sub : type_handlers) {
+                sub.active = false;
+            }
+        }
+        for (auto& type_handlers : batch_handlers) {
+            for (auto& sub : type_handlers) {
+                sub.active = false;
+            }
+        }
+        return;
+    }
+
+    dispatching.clear();
+    for (auto& batch : batches) {
+        batch.clear();
+    }
+    for (auto& type_handlers : handlers) {
+        type_handlers.clear();
+    }
+    for (auto& type_handlers : batch_handlers) {
+        type_handlers.clear();
+    }
+}
+
+} // namespace ecs
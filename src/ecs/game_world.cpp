@@ -8,6 +8,7 @@
 #include <vector>
 #include <deque>
 #include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <string>
 #include <exception>
@@ -17,16 +18,20 @@
 #include "ecs/entity_factory.h"
 #include "ecs/movement_system.h"
 #include "ecs/render_system.h"
+#include "ecs/light_system.h"
 #include "ecs/combat_system.h"
 #include "ecs/ai_system.h"
 #include "ecs/inventory_system.h"
 #include "ecs/equipment_system.h"
+#include "ecs/status_effect_system.h"
 #include "ecs/event.h"
 #include "ecs/experience_component.h"
 #include "ecs/loot_component.h"
 #include "ecs/player_component.h"
 #include "turn_manager.h"
 #include "message_log_adapter.h"
+#include "config.h"
+#include "thread_pool.h"
 
 // Forward declare Map to avoid include issues
 class Map;
@@ -34,6 +39,19 @@ class Map;
 // Only now open the namespace
 namespace ecs {
 
+namespace {
+
+/// Run a system outside SystemManager::update() and record its time
+template<typename Work>
+void runTimed(World& world, const ISystem& system, Work&& work) {
+    auto start = std::chrono::steady_clock::now();
+    work();
+    world.getSystemManager().recordTiming(system, std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+} // namespace
+
 GameWorld::GameWorld(MessageLog* log, ::Map* map)
     : message_log(log),
       game_map(map) {
@@ -43,7 +61,12 @@ GameWorld::GameWorld(MessageLog* log, ::Map* map)
     }
 }
 
-GameWorld::~GameWorld() = default;
+GameWorld::~GameWorld() {
+    setTurnManager(nullptr);
+    if (drop_subscription != 0) {
+        EventSystem::getInstance().unsubscribe(EventType::DROP, drop_subscription);
+    }
+}
 
 void GameWorld::initialize(bool migrate_existing) {
     // Bridge objects removed - no longer needed in full ECS mode
@@ -58,23 +81,58 @@ void GameWorld::initialize(bool migrate_existing) {
 }
 
 void GameWorld::initializeSystems() {
+    // Track positioned entities by tile
+    if (game_map) {
+        spatial_index.resize(game_map->getWidth(), game_map->getHeight());
+    }
+    world.getComponentStorage().addListener(componentTypeId<PositionComponent>(), &spatial_index);
+
     // Register core systems with priorities
     auto& movement = world.registerSystem<MovementSystem>(game_map);
+    movement.setWorld(&world);
+    movement.setSpatialIndex(&spatial_index);
     world.registerSystem<RenderSystem>(game_map);
+    world.registerSystem<LightSystem>(game_map);
 
     // Register native ECS combat system
     native_combat_system = &world.registerSystem<CombatSystem>(logger.get());
+    native_combat_system->setWorld(&world);
 
     // Register AI system with dependencies
     native_ai_system = &world.registerSystem<AISystem>(game_map, &movement,
                                                         native_combat_system,
                                                         logger.get());
+    native_ai_system->setWorld(&world);
 
     // Register inventory system
     world.registerSystem<InventorySystem>(game_map, logger.get());
 
     // Register equipment system with world access
-    world.registerSystem<EquipmentSystem>(logger.get(), &world);
+    auto& equipment = world.registerSystem<EquipmentSystem>(logger.get(), &world);
+
+    // Status effects tick once per world turn
+    world.registerSystem<StatusEffectSystem>(logger.get());
+
+    // Monsters act when the TurnManager gives them a turn (processMonsterAI),
+    // and equipment bonuses are applied on equip, so neither runs again in
+    // the once-per-turn update()
+    native_ai_system->setEnabled(false);
+    equipment.setEnabled(false);
+
+    // Run systems with non-conflicting access concurrently, and monster
+    // path searches as batched jobs, if configured
+    const Config& config = Config::getInstance();
+    if ((config.getParallelSystems() || config.getParallelPathfinding()) && !thread_pool) {
+        int threads = config.getWorkerThreads();
+        thread_pool = std::make_unique<ThreadPool>(threads > 0 ? static_cast<size_t>(threads) : 0);
+    }
+    if (config.getParallelSystems()) {
+        world.getSystemManager().setThreadPool(thread_pool.get());
+    }
+    if (config.getParallelPathfinding()) {
+        native_ai_system->setThreadPool(thread_pool.get());
+    }
+    native_ai_system->setLevelOfDetail(config.getAILevelOfDetail());
 
     // Set player ID for AI targeting
     if (native_ai_system && player_id != 0) {
@@ -82,7 +140,7 @@ void GameWorld::initializeSystems() {
     }
 
     // Subscribe to drop events to restore item position when dropped
-    EventSystem::getInstance().subscribe(EventType::DROP,
+    drop_subscription = EventSystem::getInstance().subscribe(EventType::DROP,
         [this](const BaseEvent& e) {
             if (logger) {
                 logger->logSystem("Drop event received: item_id=" + std::to_string(e.target_id) +
@@ -98,6 +156,7 @@ void GameWorld::initializeSystems() {
                 auto* render = item->getComponent<RenderableComponent>();
                 if (render) {
                     render->is_visible = true;
+                    item->markChanged<RenderableComponent>();
                 }
 
                 if (logger) {
@@ -224,7 +283,7 @@ void GameWorld::migrateExistingEntities() {
 }
 
 void GameWorld::update(double delta_time) {
-    // Process all queued events from previous frame
+    // Process all queued events from the player's and monsters' actions
     EventSystem::getInstance().update();
 
     // Update all ECS systems
@@ -244,8 +303,17 @@ void GameWorld::updateRenderSystem() {
     // Update only the render system to refresh visual display
     auto* render_system = getRenderSystem();
     if (render_system) {
-        render_system->update(world.getEntities(), 0.0);
+        render_system->update(world, 0.0);
+    }
+}
+
+bool GameWorld::updateLights() {
+    auto* light_system = getLightSystem();
+    if (!light_system) {
+        return false;
     }
+    runTimed(world, *light_system, [&] { light_system->update(world, 0.0); });
+    return light_system->levelsChanged();
 }
 
 EntityID GameWorld::createPlayer(int x, int y, int user_id,
@@ -254,7 +322,6 @@ EntityID GameWorld::createPlayer(int x, int y, int user_id,
 
     // Create player using factory
     auto player_entity = PlayerFactory().create(x, y);
-    EntityID id = player_entity->getID();
 
     // Link to authentication if provided
     if (auto* player_comp = player_entity->getComponent<PlayerComponent>()) {
@@ -265,7 +332,7 @@ EntityID GameWorld::createPlayer(int x, int y, int user_id,
     }
 
     // Add to world
-    world.addEntity(std::move(player_entity));
+    EntityID id = world.addEntity(std::move(player_entity)).getID();
 
     // Legacy player creation removed - full ECS mode
 
@@ -281,29 +348,31 @@ EntityID GameWorld::createPlayer(int x, int y, int user_id,
 }
 
 EntityID GameWorld::createMonster(const std::string& type, int x, int y) {
-    // Create monster using factory
-    auto monster_entity = MonsterFactoryECS().create(type, x, y);
-    EntityID id = monster_entity->getID();
-
-    // Add to world
-    world.addEntity(std::move(monster_entity));
-
-    // Legacy monster creation removed - full ECS mode
+    // Stamp known monsters straight into the world's pools
+    auto& prototypes = PrototypeRegistry::getInstance();
+    if (const auto* prototype = prototypes.get(prototypes.findMonster(type))) {
+        return prototype->instantiate(world, x, y).getID();
+    }
 
-    return id;
+    // Unknown type: the factory builds a generic monster
+    auto monster_entity = MonsterFactoryECS().create(type, x, y);
+    return world.addEntity(std::move(monster_entity)).getID();
 }
 
 EntityID GameWorld::createItem(const std::string& type, int x, int y) {
-    // Create item using factory
-    auto item_entity = ItemFactoryECS().create(type, x, y);
-    EntityID id = item_entity->getID();
-
-    // Add to world
-    world.addEntity(std::move(item_entity));
+    // Stamp known items straight into the world's pools
+    auto& prototypes = PrototypeRegistry::getInstance();
+    if (const auto* prototype = prototypes.get(prototypes.findItem(type))) {
+        return prototype->instantiate(world, x, y).getID();
+    }
 
-    // Legacy item creation removed
+    // Unknown type: the factory builds a generic item
+    auto item_entity = ItemFactoryECS().create(type, x, y);
+    return world.addEntity(std::move(item_entity)).getID();
+}
 
-    return id;
+std::vector<EntityID> GameWorld::spawnBatch(const std::vector<SpawnRequest>& requests) {
+    return PrototypeRegistry::getInstance().spawnBatch(world, requests);
 }
 
 Entity* GameWorld::getEntity(EntityID id) {
@@ -321,17 +390,17 @@ bool GameWorld::removeEntity(EntityID id) {
     return world.removeEntity(id);
 }
 
-std::vector<Entity*> GameWorld::getEntitiesAt(int x, int y) {
-    std::vector<Entity*> result;
-
-    for (const auto& entity : world.getEntities()) {
-        auto* pos = entity->getComponent<PositionComponent>();
-        if (pos && pos->isAt(x, y)) {
-            result.push_back(entity.get());
-        }
+void GameWorld::clearEntities() {
+    // Entities are dropped wholesale, without removal observers
+    if (turn_manager) {
+        turn_manager->clearActors();
     }
+    world.clearEntities();
+    player_id = 0; // Reset player ID when clearing entities
+}
 
-    return result;
+std::vector<Entity*> GameWorld::getEntitiesAt(int x, int y) {
+    return spatial_index.queryPoint(x, y);
 }
 
 ActionSpeed GameWorld::processPlayerAction(int action, int dx, int dy) {
@@ -366,6 +435,10 @@ ActionSpeed GameWorld::processPlayerAction(int action, int dx, int dy) {
                         if (native_combat_system) {
                             native_combat_system->queueAttack(player_id, target->getID());
                         }
+                        // Monsters in earshot wake up
+                        if (native_ai_system) {
+                            native_ai_system->makeNoise(Point(new_x, new_y), AISystem::COMBAT_NOISE_RADIUS);
+                        }
                         return ActionSpeed::NORMAL;
                     }
                 }
@@ -375,7 +448,7 @@ ActionSpeed GameWorld::processPlayerAction(int action, int dx, int dy) {
                 if (movement) {
                     movement->queueMove(player_id, dx, dy);
                     // Process the queued movement immediately for player
-                    movement->update(world.getEntities(), 0.0);
+                    runTimed(world, *movement, [&] { movement->update(world.getEntities(), 0.0); });
                     speed = ActionSpeed::NORMAL;
                 }
             }
@@ -419,7 +492,8 @@ ActionSpeed GameWorld::processPlayerAction(int action, int dx, int dy) {
 
     // Process any queued combat actions from player action
     if (native_combat_system) {
-        native_combat_system->update(world.getEntities(), 0.0);
+        runTimed(world, *native_combat_system,
+                 [&] { native_combat_system->update(world.getEntities(), 0.0); });
         // Remove dead entities immediately after combat
         removeDeadEntities();
     }
@@ -427,22 +501,24 @@ ActionSpeed GameWorld::processPlayerAction(int action, int dx, int dy) {
     return speed;
 }
 
-void GameWorld::processMonsterAI() {
-    // Update AI system for one turn
+void GameWorld::processMonsterAI(const std::vector<EntityID>& actors) {
+    // Update AI system for the monsters whose turn it is
     if (native_ai_system && player_id != 0) {
         native_ai_system->setPlayerId(player_id);
         // Run the AI system update manually for turn-based behavior
-        native_ai_system->update(world.getEntities(), 0.0);
+        runTimed(world, *native_ai_system, [&] { native_ai_system->updateActors(world, actors); });
 
         // Process any queued movements from AI decisions
         auto* movement_system = getMovementSystem();
         if (movement_system) {
-            movement_system->update(world.getEntities(), 0.0);
+            runTimed(world, *movement_system,
+                     [&] { movement_system->update(world.getEntities(), 0.0); });
         }
 
         // Process any queued combat actions
         if (native_combat_system) {
-            native_combat_system->update(world.getEntities(), 0.0);
+            runTimed(world, *native_combat_system,
+                     [&] { native_combat_system->update(world.getEntities(), 0.0); });
         }
 
         // Remove dead entities immediately after combat to prevent ghost actions
@@ -450,6 +526,31 @@ void GameWorld::processMonsterAI() {
     }
 }
 
+void GameWorld::setTurnManager(::TurnManager* turns) {
+    if (actor_added) {
+        world.removeObserver(actor_added);
+        actor_added = nullptr;
+    }
+    if (actor_removed) {
+        world.removeObserver(actor_removed);
+        actor_removed = nullptr;
+    }
+    turn_manager = turns;
+    if (!turn_manager) {
+        return;
+    }
+
+    actor_added = world.onAdd<AIComponent>([this](Entity& entity, AIComponent& ai) {
+        turn_manager->addActor(entity.getID(), ai.speed);
+    });
+    actor_removed = world.onRemove<AIComponent>([this](Entity& entity, AIComponent&) {
+        turn_manager->removeActor(entity.getID());
+    });
+    for (Entity* entity : world.view<AIComponent>()) {
+        turn_manager->addActor(entity->getID(), entity->getComponent<AIComponent>()->speed);
+    }
+}
+
 void GameWorld::updateFOV(const std::vector<std::vector<bool>>& fov) {
     // Update visibility for all entities based on FOV
     for (const auto& entity : world.getEntities()) {
@@ -459,7 +560,11 @@ void GameWorld::updateFOV(const std::vector<std::vector<bool>>& fov) {
         if (pos && renderable) {
             if (pos->position.x >= 0 && pos->position.x < (int)fov.size() &&
                 pos->position.y >= 0 && pos->position.y < (int)fov[0].size()) {
-                renderable->is_visible = fov[pos->position.x][pos->position.y];
+                bool visible = fov[pos->position.x][pos->position.y];
+                if (renderable->is_visible != visible) {
+                    renderable->is_visible = visible;
+                    entity->markChanged<RenderableComponent>();
+                }
             }
         }
     }
@@ -487,6 +592,10 @@ RenderSystem* GameWorld::getRenderSystem() {
     return world.getSystem<RenderSystem>();
 }
 
+LightSystem* GameWorld::getLightSystem() {
+    return world.getSystem<LightSystem>();
+}
+
 InventorySystem* GameWorld::getInventorySystem() {
     return world.getSystem<InventorySystem>();
 }
@@ -497,26 +606,18 @@ bool GameWorld::isPositionBlocked(int x, int y) const {
         return true;
     }
 
-    // Check entities
-    for (const auto& entity : world.getEntities()) {
-        auto* pos = entity->getComponent<PositionComponent>();
-        auto* combat = entity->getComponent<CombatComponent>();
-
-        // Blocking entities have position and combat components
-        if (pos && combat && pos->isAt(x, y)) {
-            return true;
-        }
-    }
-
-    return false;
+    // Blocking entities have position and combat components
+    return spatial_index.findAt(x, y, [](Entity* entity) {
+        return entity->hasComponent<CombatComponent>();
+    }) != nullptr;
 }
 
 void GameWorld::removeDeadEntities() {
-    std::vector<EntityID> to_remove;
+    CommandBuffer& commands = world.getCommandBuffer();
 
-    for (const auto& entity : world.getEntities()) {
+    for (Entity* entity : world.view<HealthComponent>()) {
         auto* health = entity->getComponent<HealthComponent>();
-        if (health && health->hp <= 0) {
+        if (health->hp <= 0) {
             // Special handling for player death
             if (entity->getID() == player_id) {
                 // Player died - log it
@@ -527,22 +628,18 @@ void GameWorld::removeDeadEntities() {
                 player_died = true;
                 continue;  // Don't remove the player entity
             }
-            to_remove.push_back(entity->getID());
-
             // Drop items on death
             auto* inventory = entity->getComponent<InventoryComponent>();
             auto* pos = entity->getComponent<PositionComponent>();
             if (inventory && pos) {
                 for (EntityID item_id : inventory->items) {
-                    Entity* item = getEntity(item_id);
-                    if (item) {
-                        // Add position back to item
-                        item->addComponent<PositionComponent>(
-                            pos->position.x, pos->position.y
-                        );
-                    }
+                    // Add position back to item
+                    commands.addComponent<PositionComponent>(
+                        item_id, pos->position.x, pos->position.y
+                    );
                 }
             }
+            commands.destroy(entity->getID());
 
             // Log death message
             if (logger) {
@@ -553,10 +650,8 @@ void GameWorld::removeDeadEntities() {
         }
     }
 
-    // Remove dead entities
-    for (EntityID id : to_remove) {
-        removeEntity(id);
-    }
+    // Drop items and remove corpses in one batch
+    world.flushCommands();
 }
 
 Entity& GameWorld::addEntityWithTracking(std::unique_ptr<Entity> entity) {
@@ -31,17 +31,21 @@ InventorySystem::InventorySystem(Map* map, ILogger* logger)
     // Subscribe to inventory-related events
     auto& event_system = EventSystem::getInstance();
 
-    event_system.subscribe(EventType::PICKUP,
-        [this](const BaseEvent& e) { handlePickupEvent(e); });
+    subscriptions.emplace_back(EventType::PICKUP, event_system.subscribe(EventType::PICKUP,
+        [this](const BaseEvent& e) { handlePickupEvent(e); }));
 
-    event_system.subscribe(EventType::DROP,
-        [this](const BaseEvent& e) { handleDropEvent(e); });
+    subscriptions.emplace_back(EventType::DROP, event_system.subscribe(EventType::DROP,
+        [this](const BaseEvent& e) { handleDropEvent(e); }));
 
-    event_system.subscribe(EventType::USE_ITEM,
-        [this](const BaseEvent& e) { handleUseItemEvent(e); });
+    subscriptions.emplace_back(EventType::USE_ITEM, event_system.subscribe(EventType::USE_ITEM,
+        [this](const BaseEvent& e) { handleUseItemEvent(e); }));
 }
 
-InventorySystem::~InventorySystem() = default;
+InventorySystem::~InventorySystem() {
+    for (const auto& [type, id] : subscriptions) {
+        EventSystem::getInstance().unsubscribe(type, id);
+    }
+}
 
 void InventorySystem::update(const std::vector<std::unique_ptr<Entity>>& entities, double) {
     // Process any pending inventory actions
@@ -273,6 +277,7 @@ void InventorySystem::applyItemEffects(Entity* user, const ItemComponent& item,
             int old_hp = health->hp;
             health->hp = std::min(health->hp + item.heal_amount, health->max_hp);
             int healed = health->hp - old_hp;
+            target->markChanged<HealthComponent>();
 
             if (logger && healed > 0) {
                 std::stringstream msg;
@@ -292,6 +297,7 @@ void InventorySystem::applyItemEffects(Entity* user, const ItemComponent& item,
         auto* health = target->getComponent<HealthComponent>();
         if (health) {
             health->hp -= item.damage_amount;
+            target->markChanged<HealthComponent>();
 
             if (logger) {
                 std::stringstream msg;
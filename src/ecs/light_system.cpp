@@ -0,0 +1,57 @@
+/**
+ * @file light_system.cpp
+ * @brief Implementation of light system
+ */
+
+#include "../../include/ecs/light_system.h"
+#include "../../include/ecs/system_manager.h"
+#include "../../include/map.h"
+
+namespace ecs {
+
+void LightSystem::update(const std::vector<std::unique_ptr<Entity>>& entities,
+                         [[maybe_unused]] double delta_time) {
+    live.clear();
+    for (const auto& entity : entities) {
+        if (!shouldProcess(*entity)) continue;
+        registerLight(*entity, *entity->getComponent<PositionComponent>(),
+                      *entity->getComponent<LightComponent>());
+    }
+    finishUpdate();
+}
+
+void LightSystem::update(World& world, [[maybe_unused]] double delta_time) {
+    uint32_t since = sync_tick;
+    sync_tick = world.captureChangeTick();
+
+    // setLight() ignores lights that did not move or change, so walking
+    // every light only costs a lookup; recasting is what is avoided
+    if (!synced || world.anyChanged<PositionComponent>(since) ||
+        world.anyChanged<LightComponent>(since)) {
+        live.clear();
+        world.view<PositionComponent, LightComponent>().each(
+            [this](Entity& entity, PositionComponent& pos, LightComponent& light) {
+                registerLight(entity, pos, light);
+            });
+        finishUpdate();
+    } else if (game_map) {
+        // Doors and walls may still have changed under static lights
+        levels_changed = light_map.update(*game_map);
+    }
+}
+
+void LightSystem::registerLight(Entity& entity, const PositionComponent& pos,
+                                const LightComponent& light) {
+    if (!light.is_lit) return;
+    light_map.setLight(entity.getID(), pos.getPosition(), light.radius, light.intensity);
+    live.push_back(entity.getID());
+}
+
+void LightSystem::finishUpdate() {
+    // Drop lights whose entity or component went away or were switched off
+    light_map.retain(live);
+    synced = true;
+    levels_changed = game_map ? light_map.update(*game_map) : false;
+}
+
+} // namespace ecs
@@ -137,6 +137,7 @@ std::vector<std::unique_ptr<Entity>> LootSystem::openChest(Entity* chest) {
         renderable->glyph = '[';
         renderable->name = "Empty Chest";
         renderable->color = {128, 128, 128};  // Gray
+        chest->markChanged<RenderableComponent>();
     }
 
     return drops;
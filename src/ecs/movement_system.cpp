@@ -6,6 +6,7 @@
 #include "../../include/ecs/movement_system.h"
 #include "../../include/ecs/renderable_component.h"
 #include "../../include/ecs/combat_component.h"
+#include "../../include/ecs/system_manager.h"
 #include <iostream>
 
 namespace ecs {
@@ -68,6 +69,10 @@ bool MovementSystem::moveEntityTo(Entity& entity, int x, int y, bool forced) {
 
     // Update position
     pos->moveTo(x, y);
+    entity.markChanged<PositionComponent>();
+    if (spatial_index) {
+        spatial_index->move(entity.getID(), pos->position);
+    }
     return true;
 }
 
@@ -87,6 +92,12 @@ bool MovementSystem::isValidPosition(int x, int y,
 Entity* MovementSystem::getBlockingEntity(int x, int y,
                                          const std::vector<std::unique_ptr<Entity>>& entities,
                                          const Entity* ignore) const {
+    if (spatial_index) {
+        return spatial_index->findAt(x, y, [ignore](Entity* entity) {
+            return entity != ignore && entity->hasComponent<CombatComponent>();
+        });
+    }
+
     for (const auto& entity : entities) {
         if (entity.get() == ignore) continue;
 
@@ -108,6 +119,10 @@ Entity* MovementSystem::getBlockingEntity(int x, int y,
 
 Entity* MovementSystem::findEntity(const std::vector<std::unique_ptr<Entity>>& entities,
                                   EntityID id) const {
+    if (world) {
+        return world->getEntity(id);
+    }
+
     for (const auto& entity : entities) {
         if (entity->getID() == id) {
             return entity.get();
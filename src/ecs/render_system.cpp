@@ -4,6 +4,7 @@
  */
 
 #include "../../include/ecs/render_system.h"
+#include "../../include/ecs/system_manager.h"
 #include "../../include/log.h"
 #include <algorithm>
 
@@ -13,27 +14,47 @@ void RenderSystem::update(const std::vector<std::unique_ptr<Entity>>& entities,
                           [[maybe_unused]] double delta_time) {
     // Clear and rebuild render cache
     render_cache.clear();
+    cache_valid = false;
 
     for (const auto& entity : entities) {
         if (!shouldProcess(*entity)) continue;
 
-        auto* pos = entity->getComponent<PositionComponent>();
-        auto* render = entity->getComponent<RenderableComponent>();
-
-        if (!render->isVisible()) continue;
+        cacheEntity(*entity->getComponent<PositionComponent>(),
+                    *entity->getComponent<RenderableComponent>());
+    }
 
-        RenderData data;
-        data.position = pos->getPosition();
-        data.glyph = render->glyph;
-        data.color = render->color;
-        data.priority = render->render_priority;
-        data.always_visible = render->always_visible;
+    // Sort by position for efficient lookup
+    sortRenderCache();
+}
 
-        render_cache.push_back(data);
+void RenderSystem::update(World& world, [[maybe_unused]] double delta_time) {
+    uint32_t since = cache_tick;
+    cache_tick = world.captureChangeTick();
+    if (cache_valid && !world.anyChanged<PositionComponent>(since) &&
+        !world.anyChanged<RenderableComponent>(since)) {
+        return;
     }
 
-    // Sort by position for efficient lookup
+    render_cache.clear();
+    world.view<PositionComponent, RenderableComponent>().each(
+        [this](Entity&, PositionComponent& pos, RenderableComponent& render) {
+            cacheEntity(pos, render);
+        });
     sortRenderCache();
+    cache_valid = true;
+}
+
+void RenderSystem::cacheEntity(const PositionComponent& pos, const RenderableComponent& render) {
+    if (!render.isVisible()) return;
+
+    RenderData data;
+    data.position = pos.getPosition();
+    data.glyph = render.glyph;
+    data.color = render.color;
+    data.priority = render.render_priority;
+    data.always_visible = render.always_visible;
+
+    render_cache.push_back(data);
 }
 
 void RenderSystem::sortRenderCache() {
@@ -0,0 +1,202 @@
+/**
+ * @file spatial_index.cpp
+ * @brief Implementation of tile occupancy index
+ */
+
+#include "../../include/ecs/spatial_index.h"
+#include "../../include/ecs/position_component.h"
+
+namespace ecs {
+
+SpatialIndex::SpatialIndex(int width, int height) {
+    resize(width, height);
+}
+
+void SpatialIndex::resize(int new_width, int new_height) {
+    // Collect current entries, rebuild the grids, then relink
+    std::vector<uint32_t> live;
+    live.reserve(count);
+    for (uint32_t node = 0; node < nodes.size(); ++node) {
+        if (nodes[node].entity) {
+            live.push_back(node);
+        }
+    }
+
+    width = std::max(0, new_width);
+    height = std::max(0, new_height);
+    buckets_x = (width + BUCKET_SIZE - 1) / BUCKET_SIZE;
+    buckets_y = (height + BUCKET_SIZE - 1) / BUCKET_SIZE;
+
+    tile_heads.assign(static_cast<size_t>(width) * height, NONE);
+    buckets.assign(static_cast<size_t>(buckets_x) * buckets_y, {});
+    overflow.clear();
+
+    for (uint32_t node : live) {
+        link(node);
+    }
+}
+
+void SpatialIndex::insert(Entity& entity, const Point& pos) {
+    uint32_t node = entityIndex(entity.getID());
+    if (node < nodes.size() && nodes[node].entity) {
+        nodes[node].entity = &entity;
+        move(entity.getID(), pos);
+        return;
+    }
+
+    if (node >= nodes.size()) {
+        nodes.resize(node + 1);
+    }
+    growToFit(pos);
+
+    nodes[node].entity = &entity;
+    nodes[node].pos = pos;
+    link(node);
+    ++count;
+}
+
+void SpatialIndex::remove(EntityID id) {
+    if (!contains(id)) {
+        return;
+    }
+
+    uint32_t node = entityIndex(id);
+    unlink(node);
+    nodes[node] = Node{};
+    --count;
+}
+
+void SpatialIndex::move(EntityID id, const Point& pos) {
+    if (!contains(id)) {
+        return;
+    }
+
+    uint32_t node = entityIndex(id);
+    if (nodes[node].pos == pos) {
+        return;
+    }
+
+    unlink(node);
+    nodes[node].pos = pos;
+    if (!growToFit(pos)) {
+        link(node);  // A resize relinks every entry itself
+    }
+}
+
+bool SpatialIndex::contains(EntityID id) const {
+    uint32_t node = entityIndex(id);
+    return node < nodes.size() && nodes[node].entity &&
+           nodes[node].entity->getID() == id;
+}
+
+void SpatialIndex::clear() {
+    nodes.clear();
+    tile_heads.assign(tile_heads.size(), NONE);
+    for (auto& bucket : buckets) {
+        bucket.clear();
+    }
+    overflow.clear();
+    count = 0;
+}
+
+std::vector<Entity*> SpatialIndex::queryPoint(int x, int y) const {
+    std::vector<Entity*> result;
+    findAt(x, y, [&result](Entity* entity) {
+        result.push_back(entity);
+        return false;
+    });
+    return result;
+}
+
+std::vector<Entity*> SpatialIndex::queryRect(int x0, int y0, int x1, int y1) const {
+    std::vector<Entity*> result;
+    forEachInRect(x0, y0, x1, y1, [&result](Entity* entity, const Point&) {
+        result.push_back(entity);
+    });
+    return result;
+}
+
+std::vector<Entity*> SpatialIndex::queryRadius(const Point& center, int radius) const {
+    std::vector<Entity*> result;
+    forEachInRadius(center, radius, [&result](Entity* entity, const Point&) {
+        result.push_back(entity);
+    });
+    return result;
+}
+
+void SpatialIndex::onComponentSet(Entity& entity, IComponent& component) {
+    insert(entity, static_cast<PositionComponent&>(component).position);
+}
+
+void SpatialIndex::onComponentRemoved(Entity& entity, IComponent&) {
+    remove(entity.getID());
+}
+
+std::vector<uint32_t>& SpatialIndex::listFor(const Point& pos) {
+    if (!inGrid(pos.x, pos.y)) {
+        return overflow;
+    }
+    return buckets[(pos.y / BUCKET_SIZE) * buckets_x + pos.x / BUCKET_SIZE];
+}
+
+void SpatialIndex::link(uint32_t node) {
+    Node& entry = nodes[node];
+
+    auto& list = listFor(entry.pos);
+    entry.bucket_slot = static_cast<uint32_t>(list.size());
+    list.push_back(node);
+
+    entry.tile_prev = NONE;
+    entry.tile_next = NONE;
+    if (inGrid(entry.pos.x, entry.pos.y)) {
+        uint32_t& head = tile_heads[tileIndex(entry.pos.x, entry.pos.y)];
+        entry.tile_next = head;
+        if (head != NONE) {
+            nodes[head].tile_prev = node;
+        }
+        head = node;
+    }
+}
+
+void SpatialIndex::unlink(uint32_t node) {
+    Node& entry = nodes[node];
+
+    // Swap-remove from the bucket list
+    auto& list = listFor(entry.pos);
+    uint32_t last = list.back();
+    list[entry.bucket_slot] = last;
+    nodes[last].bucket_slot = entry.bucket_slot;
+    list.pop_back();
+
+    if (inGrid(entry.pos.x, entry.pos.y)) {
+        if (entry.tile_prev != NONE) {
+            nodes[entry.tile_prev].tile_next = entry.tile_next;
+        } else {
+            tile_heads[tileIndex(entry.pos.x, entry.pos.y)] = entry.tile_next;
+        }
+        if (entry.tile_next != NONE) {
+            nodes[entry.tile_next].tile_prev = entry.tile_prev;
+        }
+    }
+    entry.tile_prev = NONE;
+    entry.tile_next = NONE;
+}
+
+bool SpatialIndex::growToFit(const Point& pos) {
+    if (pos.x < width && pos.y < height) {
+        return false;
+    }
+    if (pos.x < 0 || pos.y < 0) {
+        return false;  // Negative coordinates live in the overflow list
+    }
+
+    // Grow geometrically so a stream of far-out inserts stays amortised O(1)
+    int new_width = std::max(width, 1);
+    int new_height = std::max(height, 1);
+    while (new_width <= pos.x) new_width *= 2;
+    while (new_height <= pos.y) new_height *= 2;
+    resize(new_width, new_height);
+    return true;
+}
+
+} // namespace ecs
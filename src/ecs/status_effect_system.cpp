@@ -6,6 +6,7 @@
 #include <sstream>
 #include "ecs/status_effect_system.h"
 #include "ecs/renderable_component.h"
+#include "ecs/system_manager.h"
 
 namespace ecs {
 
@@ -20,20 +21,30 @@ void StatusEffectSystem::update(const std::vector<std::unique_ptr<Entity>>& enti
         auto* effects = entity->getComponent<EffectsComponent>();
         if (!effects) continue;
 
-        // Process damage over time
-        processDamageOverTime(entity.get(), effects);
+        processEntity(entity.get(), effects);
+    }
+}
 
-        // Apply stat modifiers
-        applyStatModifiers(entity.get(), effects);
+void StatusEffectSystem::update(World& world, double) {
+    world.view<EffectsComponent>().each([this](Entity& entity, EffectsComponent& effects) {
+        processEntity(&entity, &effects);
+    });
+}
 
-        // Process special effects
-        for (const auto& effect : effects->active_effects) {
-            processSpecialEffect(entity.get(), effect);
-        }
+void StatusEffectSystem::processEntity(Entity* entity, EffectsComponent* effects) {
+    // Process damage over time
+    processDamageOverTime(entity, effects);
 
-        // Update effect durations
-        effects->updateEffects();
+    // Apply stat modifiers
+    applyStatModifiers(entity, effects);
+
+    // Process special effects
+    for (const auto& effect : effects->active_effects) {
+        processSpecialEffect(entity, effect);
     }
+
+    // Update effect durations
+    effects->updateEffects();
 }
 
 bool StatusEffectSystem::applyEffect(Entity* entity, const StatusEffect& effect) {
@@ -133,6 +144,7 @@ void StatusEffectSystem::processDamageOverTime(Entity* entity, EffectsComponent*
     }
 
     if (total_tick_damage != 0) {
+        entity->markChanged<HealthComponent>();
         if (total_tick_damage > 0) {
             // Damage
             health->takeDamage(total_tick_damage);
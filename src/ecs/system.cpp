@@ -0,0 +1,15 @@
+/**
+ * @file system.cpp
+ * @brief Implementation of base system interface
+ */
+
+#include "../../include/ecs/system.h"
+#include "../../include/ecs/system_manager.h"
+
+namespace ecs {
+
+void ISystem::update(World& world, double delta_time) {
+    update(world.getEntities(), delta_time);
+}
+
+} // namespace ecs
@@ -0,0 +1,165 @@
+/**
+ * @file system_manager.cpp
+ * @brief System scheduling and timing for SystemManager
+ */
+
+#include "../../include/ecs/system_manager.h"
+#include "../../include/thread_pool.h"
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <mutex>
+
+namespace ecs {
+
+/// Shared state of one parallel update, kept alive by its pending tasks
+struct SystemManager::ScheduleRun {
+    std::unique_ptr<std::atomic<uint32_t>[]> waiting;  ///< Unfinished dependencies per system
+    std::atomic<size_t> remaining{0};                  ///< Systems not yet finished
+    std::atomic<bool> failed{false};                   ///< A system threw
+    std::mutex error_mutex;                            ///< Guards error
+    std::exception_ptr error;                          ///< First exception thrown
+};
+
+void SystemManager::update(World& world, double delta_time) {
+    if (schedule_dirty) {
+        rebuildSchedule();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    if (!thread_pool || systems.size() < 2) {
+        for (size_t i = 0; i < systems.size(); ++i) {
+            runSystem(i, world, delta_time);
+        }
+    } else {
+        auto run = std::make_shared<ScheduleRun>();
+        run->waiting = std::make_unique<std::atomic<uint32_t>[]>(systems.size());
+        run->remaining = systems.size();
+        for (size_t i = 0; i < systems.size(); ++i) {
+            run->waiting[i] = dependency_counts[i];
+        }
+
+        for (size_t i = 0; i < systems.size(); ++i) {
+            if (dependency_counts[i] == 0) {
+                thread_pool->submit([this, run, i, &world, delta_time] {
+                    runScheduled(run, i, world, delta_time);
+                });
+            }
+        }
+        thread_pool->helpUntil([&run] {
+            return run->remaining.load(std::memory_order_acquire) == 0;
+        });
+
+        if (run->error) {
+            last_update_ms = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start).count();
+            std::rethrow_exception(run->error);
+        }
+    }
+
+    last_update_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+void SystemManager::recordTiming(const ISystem& system, double ms) {
+    if (schedule_dirty) {
+        rebuildSchedule();
+    }
+    for (size_t i = 0; i < systems.size(); ++i) {
+        if (systems[i].get() == &system) {
+            SystemTiming& timing = timings[i];
+            timing.last_ms = ms;
+            timing.total_ms += ms;
+            ++timing.calls;
+            return;
+        }
+    }
+}
+
+double SystemManager::getParallelSpeedup() const {
+    if (last_update_ms <= 0.0) {
+        return 1.0;
+    }
+    double busy = 0.0;
+    for (const auto& timing : timings) {
+        busy += timing.last_ms;
+    }
+    return busy / last_update_ms;
+}
+
+void SystemManager::rebuildSchedule() {
+    std::vector<SystemAccess> access;
+    access.reserve(systems.size());
+    for (const auto& system : systems) {
+        access.push_back(system->getAccess());
+    }
+
+    dependents.assign(systems.size(), {});
+    dependency_counts.assign(systems.size(), 0);
+    for (size_t later = 0; later < systems.size(); ++later) {
+        for (size_t earlier = 0; earlier < later; ++earlier) {
+            if (access[earlier].conflictsWith(access[later])) {
+                dependents[earlier].push_back(later);
+                ++dependency_counts[later];
+            }
+        }
+    }
+
+    timings.assign(systems.size(), {});
+    for (size_t i = 0; i < systems.size(); ++i) {
+        timings[i].name = systems[i]->getName();
+    }
+
+    schedule_dirty = false;
+}
+
+void SystemManager::runSystem(size_t index, World& world, double delta_time) {
+    SystemTiming& timing = timings[index];
+    ISystem& system = *systems[index];
+    if (!system.isEnabled()) {
+        timing.last_ms = 0.0;
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    try {
+        system.update(world, delta_time);
+    } catch (...) {
+        timing.last_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        throw;
+    }
+    timing.last_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    timing.total_ms += timing.last_ms;
+    ++timing.calls;
+}
+
+void SystemManager::runScheduled(const std::shared_ptr<ScheduleRun>& run, size_t index,
+                                 World& world, double delta_time) {
+    // After a failure, remaining systems are skipped but still released so
+    // the waiting thread sees every system finish
+    if (!run->failed.load(std::memory_order_acquire)) {
+        try {
+            runSystem(index, world, delta_time);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(run->error_mutex);
+            if (!run->error) {
+                run->error = std::current_exception();
+            }
+            run->failed.store(true, std::memory_order_release);
+        }
+    }
+
+    for (size_t next : dependents[index]) {
+        if (run->waiting[next].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            thread_pool->submit([this, run, next, &world, delta_time] {
+                runScheduled(run, next, world, delta_time);
+            });
+        }
+    }
+    run->remaining.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+} // namespace ecs
@@ -2,7 +2,29 @@
 #include "map.h"
 #include "log.h"
 #include <algorithm>
-#include <cmath>
+
+namespace {
+
+// Octant transforms: each column maps (dx, dy) of the canonical octant
+// onto one of the eight octants around the origin
+constexpr int OCTANTS[4][FOV::OCTANT_COUNT] = {
+    {1,  0,  0, -1, -1,  0,  0,  1},
+    {0,  1, -1,  0,  0, -1,  1,  0},
+    {0,  1,  1,  0,  0, -1, -1,  0},
+    {1,  0,  0,  1, -1,  0,  0, -1}
+};
+
+/// Integer division rounding down (b > 0)
+constexpr int floorDiv(int a, int b) {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+/// Integer division rounding up (b > 0)
+constexpr int ceilDiv(int a, int b) {
+    return -floorDiv(-a, b);
+}
+
+} // namespace
 
 void FOV::calculate(const Map& map, const Point& origin, int radius,
                    std::vector<std::vector<bool>>& visible) {
@@ -10,89 +32,114 @@ void FOV::calculate(const Map& map, const Point& origin, int radius,
              std::to_string(origin.y) + ") with radius " + std::to_string(radius));
 
     // Initialize visible array if needed
-    if (visible.size() != static_cast<size_t>(map.getHeight()) ||
-        (visible.size() > 0 && visible[0].size() != static_cast<size_t>(map.getWidth()))) {
-        visible.resize(map.getHeight(), std::vector<bool>(map.getWidth(), false));
+    const size_t height = static_cast<size_t>(map.getHeight());
+    const size_t width = static_cast<size_t>(map.getWidth());
+    if (visible.size() != height || (height > 0 && visible[0].size() != width)) {
+        visible.assign(height, std::vector<bool>(width, false));
+    } else {
+        // Clear visibility
+        for (auto& row : visible) {
+            std::fill(row.begin(), row.end(), false);
+        }
     }
 
-    // Clear visibility
-    for (auto& row : visible) {
-        std::fill(row.begin(), row.end(), false);
+    if (!map.inBounds(origin.x, origin.y)) {
+        return;
     }
 
     // Origin is always visible
-    if (map.inBounds(origin.x, origin.y)) {
-        visible[origin.y][origin.x] = true;
+    visible[origin.y][origin.x] = true;
+
+    auto light = [&visible](int x, int y) { visible[y][x] = true; };
+    for (int octant = 0; octant < OCTANT_COUNT; octant++) {
+        castLight(map, origin, radius, 1, Slope{0, 1}, Slope{1, 1},
+                  OCTANTS[0][octant], OCTANTS[1][octant],
+                  OCTANTS[2][octant], OCTANTS[3][octant], light);
     }
-    
-    // Use simple raycasting for now to fix tests
-    // We'll optimize with proper shadowcasting later
-    for (int y = origin.y - radius; y <= origin.y + radius; y++) {
-        for (int x = origin.x - radius; x <= origin.x + radius; x++) {
-            if (!map.inBounds(x, y)) continue;
-            
-            int dx = x - origin.x;
-            int dy = y - origin.y;
-            int distSq = dx * dx + dy * dy;
-            
-            if (distSq > radius * radius) continue;
-            
-            // Cast a ray from origin to this point
-            bool blocked = false;
-            int steps = std::max(std::abs(dx), std::abs(dy));
-            
-            for (int i = 1; i < steps; i++) {
-                int checkX = origin.x + (dx * i) / steps;
-                int checkY = origin.y + (dy * i) / steps;
-                
-                if (!map.inBounds(checkX, checkY)) {
-                    blocked = true;
-                    break;
-                }
-                
-                if (isOpaque(map, checkX, checkY)) {
-                    blocked = true;
-                    break;
-                }
-            }
-            
-            if (!blocked) {
-                visible[y][x] = true;
-            }
-        }
+}
+
+void FOV::calculateOctant(const Map& map, const Point& origin, int radius, int octant,
+                          std::vector<Point>& lit) {
+    if (octant < 0 || octant >= OCTANT_COUNT || !map.inBounds(origin.x, origin.y)) {
+        return;
     }
 
-    // Count visible tiles for logging
-    int visibleCount = 0;
-    for (const auto& row : visible) {
-        visibleCount += static_cast<int>(std::count(row.begin(), row.end(), true));
+    auto light = [&lit](int x, int y) { lit.emplace_back(x, y); };
+    castLight(map, origin, radius, 1, Slope{0, 1}, Slope{1, 1},
+              OCTANTS[0][octant], OCTANTS[1][octant],
+              OCTANTS[2][octant], OCTANTS[3][octant], light);
+}
+
+unsigned FOV::octantsContaining(const Point& origin, const Point& tile) {
+    const int ax = tile.x - origin.x;
+    const int ay = tile.y - origin.y;
+    unsigned mask = 0;
+    for (int octant = 0; octant < OCTANT_COUNT; octant++) {
+        // The transforms are signed permutations, so the transpose undoes them
+        const int dx = ax * OCTANTS[0][octant] + ay * OCTANTS[2][octant];
+        const int dy = ax * OCTANTS[1][octant] + ay * OCTANTS[3][octant];
+        if (dy < 0 && dx <= 0 && dx >= dy) {
+            mask |= 1u << octant;
+        }
     }
-    Log::fov("FOV calculation complete: " + std::to_string(visibleCount) + " tiles visible");
+    return mask;
 }
 
-void FOV::castLight([[maybe_unused]] const Map& map, 
-                   [[maybe_unused]] const Point& origin, 
-                   [[maybe_unused]] int radius,
-                   [[maybe_unused]] int row, 
-                   [[maybe_unused]] float start, 
-                   [[maybe_unused]] float end,
-                   [[maybe_unused]] int xx, 
-                   [[maybe_unused]] int xy, 
-                   [[maybe_unused]] int yx, 
-                   [[maybe_unused]] int yy,
-                   [[maybe_unused]] std::vector<std::vector<bool>>& visible) {
-    // This method is temporarily not used - using simple raycasting instead
-    // Will be reimplemented with proper shadowcasting later
+template<typename LightFn>
+void FOV::castLight(const Map& map, const Point& origin, int radius,
+                   int depth, Slope start, Slope end,
+                   int xx, int xy, int yx, int yy,
+                   LightFn& light) {
+    if (depth > radius) {
+        return;
+    }
+
+    // Columns count from the axis (0) to the diagonal (depth). A tile
+    // belongs to the row's light if the range covers any of it, rounding
+    // half-covered edge tiles outwards at the start and inwards at the end
+    const int minCol = floorDiv(2 * depth * start.num + start.den, 2 * start.den);
+    const int maxCol = std::min(depth, ceilDiv(2 * depth * end.num - end.den, 2 * end.den));
+    const int radiusSq = radius * radius;
+
+    bool prevOpaque = false;
+    bool first = true;
+    for (int col = std::max(minCol, 0); col <= maxCol; col++) {
+        const int dx = -col;
+        const int dy = -depth;
+        const int x = origin.x + dx * xx + dy * xy;
+        const int y = origin.y + dx * yx + dy * yy;
+        const bool opaque = isOpaque(map, x, y);
+
+        // Walls are lit so the player sees what blocks the view; open tiles
+        // only when their centre is in the light, which keeps sight symmetric
+        const bool centreLit = col * start.den >= depth * start.num &&
+                               col * end.den <= depth * end.num;
+        if ((opaque || centreLit) && col * col + depth * depth <= radiusSq && map.inBounds(x, y)) {
+            light(x, y);
+        }
+
+        if (!first) {
+            if (prevOpaque && !opaque) {
+                // Leaving a shadow: the light resumes at this tile's near edge
+                start = Slope{2 * col - 1, 2 * depth};
+            } else if (!prevOpaque && opaque) {
+                // Entering a shadow: carry the light so far on to the next row
+                castLight(map, origin, radius, depth + 1, start, Slope{2 * col - 1, 2 * depth},
+                          xx, xy, yx, yy, light);
+            }
+        }
+        prevOpaque = opaque;
+        first = false;
+    }
+
+    if (!first && !prevOpaque) {
+        castLight(map, origin, radius, depth + 1, start, end, xx, xy, yx, yy, light);
+    }
 }
 
 bool FOV::isOpaque(const Map& map, int x, int y) {
-    if (!map.inBounds(x, y)) {
-        return true;  // Out of bounds blocks vision
-    }
-    
-    TileType tile = map.getTile(x, y);
-    auto props = map.getTileProperties(tile);
-    return !props.transparent;  // Opaque is the opposite of transparent
+    // Out of bounds blocks vision; opaque is the opposite of transparent
+    return !map.isTransparent(x, y);
 }
 
 bool FOV::isVisible(const Map& map, const Point& origin,
@@ -110,12 +157,25 @@ bool FOV::isVisible(const Map& map, const Point& origin,
         return false;
     }
 
-    // Use shadowcasting to check visibility
-    std::vector<std::vector<bool>> visible(map.getHeight(),
-                                          std::vector<bool>(map.getWidth(), false));
-    calculate(map, origin, maxDistance, visible);
+    if (!map.inBounds(origin.x, origin.y) || !map.inBounds(target.x, target.y)) {
+        return false;
+    }
+    if (target == origin) {
+        return true;
+    }
+
+    // Only the octants containing the target can light it, so cast those
+    // instead of a whole map-sized grid
+    std::vector<Point> lit;
+    bool result = false;
+    unsigned octants = octantsContaining(origin, target);
+    for (int octant = 0; octant < OCTANT_COUNT && !result; octant++) {
+        if (!(octants & (1u << octant))) continue;
+        lit.clear();
+        calculateOctant(map, origin, maxDistance, octant, lit);
+        result = std::find(lit.begin(), lit.end(), target) != lit.end();
+    }
 
-    bool result = visible[target.y][target.x];
     Log::fov("Visibility check result: " + std::string(result ? "visible" : "blocked"));
     return result;
 }
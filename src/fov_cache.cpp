@@ -0,0 +1,117 @@
+#include "fov_cache.h"
+#include "fov.h"
+#include "map.h"
+#include <cstdlib>
+
+namespace {
+constexpr unsigned ALL_OCTANTS = (1u << FOV::OCTANT_COUNT) - 1;
+}
+
+FOVCache::Result FOVCache::update(const Map& new_map, const Point& new_origin, int new_radius) {
+    entered.clear();
+    left.clear();
+    recomputed_octants = 0;
+
+    if (!valid || map != &new_map || width != new_map.getWidth() ||
+        static_cast<int>(visible.size()) != new_map.getHeight()) {
+        reset(new_map);
+        origin = new_origin;
+        radius = new_radius;
+        recompute(new_map, ALL_OCTANTS);
+        return Result::UPDATED;
+    }
+
+    unsigned octant_mask = 0;
+    if (new_origin != origin || new_radius != radius) {
+        origin = new_origin;
+        radius = new_radius;
+        octant_mask = ALL_OCTANTS;
+    } else if (new_map.getTransparencyVersion() != transparency_version) {
+        changes.clear();
+        if (!new_map.getTransparencyChanges(transparency_version, changes)) {
+            octant_mask = ALL_OCTANTS;
+        } else {
+            for (const Point& tile : changes) {
+                // Tiles beyond the scanned square can't cast a shadow inside it
+                if (std::abs(tile.x - origin.x) <= radius && std::abs(tile.y - origin.y) <= radius) {
+                    octant_mask |= FOV::octantsContaining(origin, tile);
+                }
+            }
+        }
+    }
+    transparency_version = new_map.getTransparencyVersion();
+
+    if (octant_mask == 0) {
+        return Result::UNCHANGED;
+    }
+
+    recompute(new_map, octant_mask);
+    return Result::UPDATED;
+}
+
+void FOVCache::invalidate() {
+    valid = false;
+}
+
+void FOVCache::reset(const Map& new_map) {
+    map = &new_map;
+    width = new_map.getWidth();
+    visible.assign(new_map.getHeight(), std::vector<bool>(width, false));
+    light_count.assign(static_cast<size_t>(width) * new_map.getHeight(), 0);
+    for (auto& list : lit) {
+        list.clear();
+    }
+    transparency_version = new_map.getTransparencyVersion();
+    valid = true;
+}
+
+void FOVCache::recompute(const Map& current_map, unsigned octant_mask) {
+    touched.clear();
+
+    for (int octant = 0; octant < FOV::OCTANT_COUNT; octant++) {
+        if (octant_mask & (1u << octant)) {
+            recomputeList(current_map, octant);
+            recomputed_octants++;
+        }
+    }
+    if (octant_mask == ALL_OCTANTS) {
+        recomputeList(current_map, ORIGIN_LIST);
+    }
+
+    publishDelta();
+}
+
+void FOVCache::recomputeList(const Map& current_map, int list) {
+    std::vector<Point>& tiles = lit[list];
+    for (const Point& tile : tiles) {
+        light_count[static_cast<size_t>(tile.y) * width + tile.x]--;
+        touched.push_back(tile);
+    }
+    tiles.clear();
+
+    if (list == ORIGIN_LIST) {
+        // Origin is always visible
+        if (current_map.inBounds(origin.x, origin.y)) {
+            tiles.push_back(origin);
+        }
+    } else {
+        FOV::calculateOctant(current_map, origin, radius, list, tiles);
+    }
+
+    for (const Point& tile : tiles) {
+        light_count[static_cast<size_t>(tile.y) * width + tile.x]++;
+        touched.push_back(tile);
+    }
+}
+
+void FOVCache::publishDelta() {
+    // A tile may be touched several times; once its grid entry matches the
+    // new count later visits see no difference, so each appears at most once
+    for (const Point& tile : touched) {
+        bool now_visible = light_count[static_cast<size_t>(tile.y) * width + tile.x] > 0;
+        if (visible[tile.y][tile.x] != now_visible) {
+            visible[tile.y][tile.x] = now_visible;
+            (now_visible ? entered : left).push_back(tile);
+        }
+    }
+}
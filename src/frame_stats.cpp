@@ -38,6 +38,17 @@ void FrameStats::update(double fps, double frameTime, double updateTime, double
     }
 }
 
+void FrameStats::recordPathQueries(int hits, int misses) {
+    pathHits = hits;
+    pathMisses = misses;
+}
+
+void FrameStats::recordAITier(size_t tier, int count, double time) {
+    if (tier >= AI_TIERS) return;
+    aiTierCounts[tier] = count;
+    aiTierTimes[tier] = time;
+}
+
 double FrameStats::getAverageFPS() const {
     if (fpsHistory.empty()) return 0.0;
     
@@ -57,6 +68,9 @@ std::string FrameStats::format() const {
     oss << std::fixed << std::setprecision(1);
     oss << "FPS: " << currentFPS;
     oss << " | Frame: " << currentFrameTime << "ms";
+    if (pathHits + pathMisses > 0) {
+        oss << " | Paths: " << pathHits << "/" << pathHits + pathMisses;
+    }
     return oss.str();
 }
 
@@ -68,6 +82,10 @@ std::string FrameStats::formatDetailed() const {
     oss << " | Update: " << currentUpdateTime << "ms";
     oss << " | Render: " << currentRenderTime << "ms";
     oss << " | Min/Max FPS: " << minFPS << "/" << maxFPS;
+    oss << " | Paths: " << pathHits << " hit/" << pathMisses << " miss";
+    oss << " | AI tiers: " << aiTierCounts[0] << "/" << aiTierCounts[1] << "/" << aiTierCounts[2]
+        << "/" << aiTierCounts[3] << " (" << std::setprecision(2) << aiTierTimes[0] << "/"
+        << aiTierTimes[1] << "/" << aiTierTimes[2] << "/" << aiTierTimes[3] << "ms)";
     return oss.str();
 }
 
@@ -78,6 +96,10 @@ void FrameStats::reset() {
     currentRenderTime = 0.0;
     minFPS = 999999.0;
     maxFPS = 0.0;
+    pathHits = 0;
+    pathMisses = 0;
+    aiTierCounts.fill(0);
+    aiTierTimes.fill(0.0);
     fpsHistory.clear();
     frameTimeHistory.clear();
 }
\ No newline at end of file
@@ -14,9 +14,12 @@
 #include "log.h"
 #include "ecs/position_component.h"
 #include "ecs/data_loader.h"
+#include "ecs/entity_prototype.h"
 #include "ecs/health_component.h"
 #include "ecs/renderable_component.h"
 #include "ecs/game_world.h"
+#include "ecs/light_system.h"
+#include "ecs/ai_system.h"
 #include "db/database_manager.h"
 #include "db/save_game_repository.h"
 #include "db/game_entity_repository.h"
@@ -77,6 +80,12 @@ void GameManager::initializeMap(MapType type) {
     // Update stairs based on current depth
     MapGenerator::updateStairsForDepth(*map, current_depth);
 
+    // Cached FOV belongs to the previous level
+    fov_cache.invalidate();
+    light_sight.invalidate();
+    light_revealed.clear();
+    fov_full_sync = true;
+
     // Validate the map
     auto validation = MapValidator::validate(*map);
     if (!validation.valid) {
@@ -95,6 +104,11 @@ void GameManager::initializeMap(MapType type) {
     if (ecs_world) {
         ecs_world->clearEntities();
         LOG_INFO("Cleared all entities for level transition");
+
+        // Monster route graph over this level's rooms and corridors
+        if (auto* ai_system = ecs_world->getAISystem()) {
+            ai_system->buildRouteGraph();
+        }
     }
 
     // Set player spawn point
@@ -170,8 +184,18 @@ void GameManager::returnToPreviousState() {
 }
 
 void GameManager::processPlayerAction(ActionSpeed speed) {
+    // Monster stats cover the ticks of this action only
+    frame_stats->recordPathQueries(0, 0);
+    for (size_t tier = 0; tier < ecs::AI_TIER_COUNT; tier++) {
+        frame_stats->recordAITier(tier, 0, 0.0);
+    }
     turn_manager->executePlayerAction(speed);
-    
+
+    // Effects, lights and rendering advance once per world turn
+    if (ecs_world) {
+        ecs_world->update(1.0);
+    }
+
     // After player acts, check for dynamic spawning
     // ECS handles spawning
 }
@@ -191,8 +215,7 @@ void GameManager::update([[maybe_unused]] double deltaTime) {
 
     // Update ECS systems
     if (ecs_world) {
-        // Don't update AI every frame - only when updateMonsters() is called
-        // ecs_world->update(deltaTime);  // DISABLED - AI should be turn-based
+        // The world turn runs in processPlayerAction(), not every frame
 
         // Update only render system for visual display
         ecs_world->updateRenderSystem();
@@ -253,11 +276,81 @@ void GameManager::updateFOV() {
         return;  // ECS is required
     }
 
-    // Calculate FOV from player position
-    FOV::calculate(*map, playerPos, Config::getInstance().getFOVRadius(), current_fov);
-    
-    // Check if player entered a new room
+    // Bring the cached FOV up to date; only what changed is recast
+    auto result = fov_cache.update(*map, playerPos, Config::getInstance().getFOVRadius());
     const Room* new_room = map->getRoomAt(playerPos);
+    bool lights_changed = ecs_world->updateLights();
+    // Long-range sight is only read for tiles lit by a light source
+    bool sight_changed = false;
+    const auto* light_system = ecs_world->getLightSystem();
+    if (light_system && light_system->getLightMap().getLightCount() > 0) {
+        sight_changed = light_sight.compute(*map, playerPos, LIGHT_SIGHT_RADIUS);
+    } else if (light_sight.isValid()) {
+        // The last light went out: drop the stale sight once
+        light_sight.invalidate();
+        sight_changed = true;
+    }
+
+    if (result == FOVCache::Result::UNCHANGED && new_room == current_room && !fov_full_sync &&
+        !lights_changed && !sight_changed) {
+        // Nothing in view changed, but monsters may have moved in or out of it
+        ecs_world->updateFOV(current_fov);
+        return;
+    }
+
+    // Tiles beyond the view radius that a light source makes visible
+    std::vector<Point> lit_now;
+    collectLightRevealed(lit_now);
+
+    // Lit rooms add tiles on top of the cast view, so deltas only hold
+    // when neither the old nor the new view involves one
+    bool was_lit = current_room && current_room->isLit();
+    bool is_lit = new_room && new_room->isLit();
+    if (!fov_full_sync && !was_lit && !is_lit) {
+        current_room = new_room;
+
+        Bitboard lit_view(map->getWidth(), map->getHeight());
+        for (const auto& tile : lit_now) {
+            lit_view.set(tile.x, tile.y);
+        }
+
+        std::vector<Point> entered;
+        std::vector<Point> left;
+        auto apply = [&](const Point& tile, bool now) {
+            if (current_fov[tile.y][tile.x] == now) return;
+            current_fov[tile.y][tile.x] = now;
+            map->setVisible(tile.x, tile.y, now);
+            (now ? entered : left).push_back(tile);
+        };
+        for (const auto& tile : fov_cache.getEntered()) {
+            apply(tile, true);
+        }
+        for (const auto& tile : fov_cache.getLeft()) {
+            apply(tile, lit_view.test(tile));
+        }
+        for (const auto& tile : light_revealed) {
+            apply(tile, fov_cache.isVisible(tile.x, tile.y) || lit_view.test(tile));
+        }
+        for (const auto& tile : lit_now) {
+            apply(tile, true);
+        }
+        light_revealed = std::move(lit_now);
+
+        if (map_memory) {
+            map_memory->updateVisibility(*map, entered, left);
+        }
+        ecs_world->updateFOV(current_fov);
+        return;
+    }
+
+    current_fov = fov_cache.getVisible();
+    fov_full_sync = false;
+    for (const auto& tile : lit_now) {
+        current_fov[tile.y][tile.x] = true;
+    }
+    light_revealed = std::move(lit_now);
+
+    // Check if player entered a new room
     if (new_room != current_room) {
         // Player entered a different room (or left a room)
         const Room* old_room = current_room;
@@ -324,16 +417,39 @@ void GameManager::updateFOV() {
     }
 
     // Update ECS FOV
-    if (ecs_world) {
-        ecs_world->updateFOV(current_fov);
-    }
+    ecs_world->updateFOV(current_fov);
 }
 
-void GameManager::updateMonsters() {
-    // Update ECS AI system for one turn
+void GameManager::collectLightRevealed(std::vector<Point>& tiles) const {
+    tiles.clear();
+    const auto* light_system = ecs_world->getLightSystem();
+    if (!light_system || light_system->getLightMap().getLightCount() == 0) return;
+
+    // Lit tiles the player has a line of sight to; the view radius
+    // itself is already covered by the FOV cache
+    light_system->getLightMap().getLitTiles().forEach([&](int x, int y) {
+        if (light_sight.canSee(x, y) && !fov_cache.isVisible(x, y)) {
+            tiles.emplace_back(x, y);
+        }
+    });
+}
+
+void GameManager::updateMonsters(const std::vector<ecs::EntityID>& actors) {
+    // Update ECS AI system for the monsters whose turn it is
     if (ecs_world) {
         // Only update the AI system, not the entire world
-        ecs_world->processMonsterAI();
+        ecs_world->processMonsterAI(actors);
+        if (auto* ai_system = ecs_world->getAISystem()) {
+            // Added up over every monster tick of the player's action
+            const PathCache& paths = ai_system->getPathCache();
+            frame_stats->recordPathQueries(frame_stats->getPathHits() + paths.getHits(),
+                                           frame_stats->getPathMisses() + paths.getMisses());
+            const ecs::AITierStats& tiers = ai_system->getTierStats();
+            for (size_t tier = 0; tier < ecs::AI_TIER_COUNT; tier++) {
+                frame_stats->recordAITier(tier, frame_stats->getAITierCount(tier) + tiers.counts[tier],
+                                          frame_stats->getAITierTime(tier) + tiers.time_ms[tier]);
+            }
+        }
     }
 }
 
@@ -465,6 +581,7 @@ void GameManager::initializeECS(bool migrate_existing) {
 
     // Initialize the ECS world
     ecs_world->initialize(migrate_existing);
+    ecs_world->setTurnManager(turn_manager.get());
 
     // Update FOV in ECS
     if (!current_fov.empty()) {
@@ -544,6 +661,20 @@ void GameManager::spawnEntities() {
         total_item_weight += weight;
     }
 
+    // Resolve spawn tables to compiled prototypes once
+    auto& prototypes = ecs::PrototypeRegistry::getInstance();
+    std::vector<std::pair<ecs::PrototypeId, int>> monster_prototypes;
+    for (const auto& [type, weight] : monster_table) {
+        monster_prototypes.emplace_back(prototypes.findMonster(type), weight);
+    }
+    std::vector<std::pair<ecs::PrototypeId, int>> item_prototypes;
+    for (const auto& [type, weight] : common_items) {
+        item_prototypes.emplace_back(prototypes.findItem(type), weight);
+    }
+
+    // Collect spawns and create them in one batch
+    std::vector<ecs::SpawnRequest> spawns;
+
     // Spawn monsters in rooms (skip first room where player spawns)
     LOG_SPAWN("Starting spawn loop for " + std::to_string(rooms.size() - 1) + " rooms");
     for (size_t i = 1; i < rooms.size(); ++i) {
@@ -562,9 +693,9 @@ void GameManager::spawnEntities() {
             std::uniform_int_distribution<> weight_dist(0, total_monster_weight - 1);
             int roll = weight_dist(rng);
 
-            std::string monster_type;
+            ecs::PrototypeId monster_type = ecs::INVALID_PROTOTYPE_ID;
             int cumulative = 0;
-            for (const auto& [type, weight] : monster_table) {
+            for (const auto& [type, weight] : monster_prototypes) {
                 cumulative += weight;
                 if (roll < cumulative) {
                     monster_type = type;
@@ -583,7 +714,7 @@ void GameManager::spawnEntities() {
 
                 // Check if position is walkable and not occupied
                 if (map->isWalkable(x, y)) {
-                    ecs_world->createMonster(monster_type, x, y);
+                    spawns.push_back({monster_type, x, y});
                     break;
                 }
             }
@@ -596,9 +727,9 @@ void GameManager::spawnEntities() {
             std::uniform_int_distribution<> item_weight_dist(0, total_item_weight - 1);
             int roll = item_weight_dist(rng);
 
-            std::string item_type;
+            ecs::PrototypeId item_type = ecs::INVALID_PROTOTYPE_ID;
             int cumulative = 0;
-            for (const auto& [type, weight] : common_items) {
+            for (const auto& [type, weight] : item_prototypes) {
                 cumulative += weight;
                 if (roll < cumulative) {
                     item_type = type;
@@ -616,13 +747,15 @@ void GameManager::spawnEntities() {
                 int y = y_dist(rng);
 
                 if (map->isWalkable(x, y)) {
-                    ecs_world->createItem(item_type, x, y);
+                    spawns.push_back({item_type, x, y});
                     break;
                 }
             }
         }
     }
 
+    ecs_world->spawnBatch(spawns);
+
     // Log spawn summary
     std::string spawn_msg = "Spawned monsters and items in " + std::to_string(rooms.size() - 1) + " rooms";
     message_log->addSystemMessage(spawn_msg);
@@ -17,6 +17,7 @@
 #include "ecs/inventory_system.h"
 #include "ecs/game_world.h"
 #include "ecs/combat_system.h"
+#include "ecs/movement_system.h"
 #include "ecs/position_component.h"
 #include "ecs/event.h"
 #include "controllers/game_controller.h"
@@ -128,7 +129,6 @@ bool GameScreen::handleDirectionalDoorInteraction(int dx, int dy) {
 
         // Opening doors takes a turn
         game_manager->processPlayerAction(ActionSpeed::NORMAL);
-        game_manager->updateMonsters();
 
         return true;
     } else if (tile == TileType::DOOR_OPEN) {
@@ -140,7 +140,6 @@ bool GameScreen::handleDirectionalDoorInteraction(int dx, int dy) {
 
         // Closing doors takes a turn
         game_manager->processPlayerAction(ActionSpeed::NORMAL);
-        game_manager->updateMonsters();
 
         return true;
     } else {
@@ -234,9 +233,10 @@ bool GameScreen::handleStairInteraction(bool going_down) {
         if (ecs_world) {
             auto* player_entity = ecs_world->getPlayerEntity();
             if (player_entity) {
-                auto* pos_comp = player_entity->getComponent<ecs::PositionComponent>();
-                if (pos_comp) {
-                    pos_comp->moveTo(game_manager->player_x, game_manager->player_y);
+                // Forced move through the movement system keeps the spatial index in sync
+                if (auto* movement = ecs_world->getMovementSystem()) {
+                    movement->moveEntityTo(*player_entity, game_manager->player_x,
+                                           game_manager->player_y, true);
                 }
             }
         }
@@ -247,7 +247,6 @@ bool GameScreen::handleStairInteraction(bool going_down) {
 
     // Using stairs takes a turn
     game_manager->processPlayerAction(ActionSpeed::NORMAL);
-    game_manager->updateMonsters();
 
     std::string depth_msg = "Welcome to dungeon level " + std::to_string(new_depth) + "!";
     msg_log->addMessage(depth_msg);
@@ -290,7 +289,6 @@ bool GameScreen::handlePlayerMovement(int dx, int dy, const std::string& directi
         }
     }
     game_manager->updateFOV();
-    game_manager->updateMonsters();
 
     // Auto-save after successful movement to preserve current position
     game_manager->autoSave();
@@ -526,7 +524,6 @@ Component GameScreen::Create() {
                 LOG_PLAYER("Waiting for one turn");
                 game_manager->processPlayerAction(ActionSpeed::NORMAL);
                 game_manager->getMessageLog()->addMessage("You wait.");
-                game_manager->updateMonsters();  // Let monsters act
                 return true;
 
             case InputAction::OPEN_DOOR:
@@ -0,0 +1,517 @@
+#include "hierarchical_pathfinder.h"
+#include "map.h"
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <tuple>
+
+namespace {
+
+constexpr uint32_t NO_PARENT = UINT32_MAX;
+
+uint32_t manhattan(const Point& a, const Point& b) {
+    return static_cast<uint32_t>(std::abs(a.x - b.x) + std::abs(a.y - b.y));
+}
+
+} // namespace
+
+void HierarchicalPathfinder::build(const Map& new_map) {
+    map = &new_map;
+    width = new_map.getWidth();
+    height = new_map.getHeight();
+    walkability_version = new_map.getWalkabilityVersion();
+
+    const size_t tile_count = static_cast<size_t>(width) * height;
+    assignClusters();
+    region_of.assign(tile_count, -1);
+    node_of.assign(tile_count, -1);
+    cluster_regions.assign(clusters.size(), {});
+    regions.clear();
+    free_regions.clear();
+    nodes.clear();
+    free_nodes.clear();
+    tile_stamp.assign(tile_count, 0);
+    tile_dist.assign(tile_count, 0);
+    tile_generation = 0;
+    built = true;
+
+    std::vector<int32_t> all(clusters.size());
+    std::iota(all.begin(), all.end(), 0);
+    rebuildClusters(all);
+}
+
+bool HierarchicalPathfinder::update(const Map& new_map) {
+    if (!built || map != &new_map || width != new_map.getWidth() ||
+        height != new_map.getHeight()) {
+        build(new_map);
+        return true;
+    }
+
+    uint32_t version = new_map.getWalkabilityVersion();
+    if (version == walkability_version) {
+        rebuilt_clusters = 0;
+        return false;
+    }
+
+    changes.clear();
+    if (!new_map.getWalkabilityChanges(walkability_version, changes)) {
+        // A regenerated level (fill() drops the history) may also have new rooms
+        build(new_map);
+        return true;
+    }
+    walkability_version = version;
+
+    std::vector<int32_t> dirty;
+    for (const Point& p : changes) {
+        dirty.push_back(cluster_of[index(p)]);
+    }
+    std::sort(dirty.begin(), dirty.end());
+    dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+    rebuildClusters(dirty);
+    return true;
+}
+
+int HierarchicalPathfinder::getRegionCount() const {
+    return static_cast<int>(regions.size() - free_regions.size());
+}
+
+int HierarchicalPathfinder::getNodeCount() const {
+    return static_cast<int>(nodes.size() - free_nodes.size());
+}
+
+void HierarchicalPathfinder::assignClusters() {
+    clusters.clear();
+    cluster_of.assign(static_cast<size_t>(width) * height, -1);
+
+    // Room interiors first; their walls, doorways and corridors fall to sectors
+    for (const Room& room : map->getRooms()) {
+        Cluster cluster{std::max(room.left() + 1, 0), std::max(room.top() + 1, 0),
+                        std::min(room.right() - 1, width - 1), std::min(room.bottom() - 1, height - 1)};
+        int32_t id = static_cast<int32_t>(clusters.size());
+        clusters.push_back(cluster);
+        for (int y = cluster.y0; y <= cluster.y1; y++) {
+            for (int x = cluster.x0; x <= cluster.x1; x++) {
+                int32_t& owner = cluster_of[index(x, y)];
+                if (owner < 0) owner = id;
+            }
+        }
+    }
+
+    const int32_t first_sector = static_cast<int32_t>(clusters.size());
+    const int sectors_x = (width + SECTOR_SIZE - 1) / SECTOR_SIZE;
+    const int sectors_y = (height + SECTOR_SIZE - 1) / SECTOR_SIZE;
+    for (int sy = 0; sy < sectors_y; sy++) {
+        for (int sx = 0; sx < sectors_x; sx++) {
+            clusters.push_back({sx * SECTOR_SIZE, sy * SECTOR_SIZE,
+                                std::min((sx + 1) * SECTOR_SIZE, width) - 1,
+                                std::min((sy + 1) * SECTOR_SIZE, height) - 1});
+        }
+    }
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int32_t& owner = cluster_of[index(x, y)];
+            if (owner < 0) {
+                owner = first_sector + (y / SECTOR_SIZE) * sectors_x + x / SECTOR_SIZE;
+            }
+        }
+    }
+}
+
+void HierarchicalPathfinder::rebuildClusters(const std::vector<int32_t>& dirty) {
+    dirty_mark.assign(clusters.size(), 0);
+    for (int32_t cluster : dirty) {
+        dirty_mark[cluster] = 1;
+    }
+    rebuilt_clusters = static_cast<int>(dirty.size());
+
+    // Regions outside the dirty clusters whose entrances change
+    std::vector<int32_t> touched;
+
+    // Drop the dirty clusters' regions and nodes, unhooking their neighbours
+    for (int32_t cluster : dirty) {
+        for (int32_t region : cluster_regions[cluster]) {
+            for (uint32_t node : regions[region].nodes) {
+                for (const Edge& edge : nodes[node].edges) {
+                    uint32_t partner = edge.to;
+                    int32_t partner_region = nodes[partner].region;
+                    if (partner_region == region || partner_region < 0 ||
+                        dirty_mark[regions[partner_region].cluster]) {
+                        continue;
+                    }
+                    removeEdge(partner, node);
+                    touched.push_back(partner_region);
+
+                    bool still_entrance = std::any_of(
+                        nodes[partner].edges.begin(), nodes[partner].edges.end(),
+                        [&](const Edge& e) { return nodes[e.to].region != partner_region; });
+                    if (!still_entrance) {
+                        auto& siblings = regions[partner_region].nodes;
+                        siblings.erase(std::find(siblings.begin(), siblings.end(), partner));
+                        for (uint32_t sibling : siblings) {
+                            removeEdge(sibling, partner);
+                        }
+                        freeNode(partner);
+                    }
+                }
+                freeNode(node);
+            }
+            regions[region].nodes.clear();
+            regions[region].cluster = -1;
+            free_regions.push_back(region);
+        }
+        cluster_regions[cluster].clear();
+    }
+
+    for (int32_t cluster : dirty) {
+        fillRegions(cluster);
+    }
+
+    transitions.clear();
+    for (int32_t cluster : dirty) {
+        collectTransitions(cluster);
+    }
+    addEntrances(touched);
+
+    for (int32_t cluster : dirty) {
+        touched.insert(touched.end(), cluster_regions[cluster].begin(), cluster_regions[cluster].end());
+    }
+    std::sort(touched.begin(), touched.end());
+    touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+    for (int32_t region : touched) {
+        connectRegion(region);
+    }
+}
+
+void HierarchicalPathfinder::fillRegions(int32_t cluster) {
+    const Cluster& box = clusters[cluster];
+    for (int y = box.y0; y <= box.y1; y++) {
+        for (int x = box.x0; x <= box.x1; x++) {
+            if (cluster_of[index(x, y)] == cluster) region_of[index(x, y)] = -1;
+        }
+    }
+
+    for (int y = box.y0; y <= box.y1; y++) {
+        for (int x = box.x0; x <= box.x1; x++) {
+            size_t seed = index(x, y);
+            if (cluster_of[seed] != cluster || region_of[seed] >= 0 || !map->isWalkable(x, y)) {
+                continue;
+            }
+
+            int32_t region = allocateRegion(cluster);
+            region_of[seed] = region;
+            frontier.assign(1, static_cast<uint32_t>(seed));
+            for (size_t head = 0; head < frontier.size(); head++) {
+                Point pos(static_cast<int>(frontier[head] % width), static_cast<int>(frontier[head] / width));
+                for (const Point& dir : Pathfinding::DIRECTIONS_4) {
+                    Point next = pos + dir;
+                    if (!map->isWalkable(next.x, next.y)) continue;
+                    size_t next_index = index(next);
+                    if (cluster_of[next_index] != cluster || region_of[next_index] >= 0) continue;
+                    region_of[next_index] = region;
+                    frontier.push_back(static_cast<uint32_t>(next_index));
+                }
+            }
+        }
+    }
+}
+
+void HierarchicalPathfinder::collectTransitions(int32_t cluster) {
+    const Cluster& box = clusters[cluster];
+    for (int y = box.y0; y <= box.y1; y++) {
+        for (int x = box.x0; x <= box.x1; x++) {
+            size_t i = index(x, y);
+            if (cluster_of[i] != cluster || region_of[i] < 0) continue;
+
+            for (int d = 0; d < 4; d++) {
+                Point next = Point(x, y) + Pathfinding::DIRECTIONS_4[d];
+                if (!map->inBounds(next.x, next.y)) continue;
+                size_t next_index = index(next);
+                int32_t other = cluster_of[next_index];
+                if (other == cluster || region_of[next_index] < 0) continue;
+                // Borders between two dirty clusters are collected once
+                if (dirty_mark[other] && other < cluster) continue;
+                transitions.push_back({region_of[i], region_of[next_index], d, Point(x, y)});
+            }
+        }
+    }
+}
+
+void HierarchicalPathfinder::addEntrances(std::vector<int32_t>& touched) {
+    // Runs are straight: north/south crossings share a row, east/west a column
+    auto line = [](const Transition& t) {
+        return Pathfinding::DIRECTIONS_4[t.direction].y != 0 ? t.from.y : t.from.x;
+    };
+    auto along = [](const Transition& t) {
+        return Pathfinding::DIRECTIONS_4[t.direction].y != 0 ? t.from.x : t.from.y;
+    };
+    std::sort(transitions.begin(), transitions.end(), [&](const Transition& a, const Transition& b) {
+        return std::make_tuple(a.from_region, a.to_region, a.direction, line(a), along(a)) <
+               std::make_tuple(b.from_region, b.to_region, b.direction, line(b), along(b));
+    });
+
+    auto link = [&](const Transition& t) {
+        uint32_t a = nodeAt(t.from, t.from_region);
+        uint32_t b = nodeAt(t.from + Pathfinding::DIRECTIONS_4[t.direction], t.to_region);
+        addEdge(a, b, 1);
+        addEdge(b, a, 1);
+        if (!dirty_mark[regions[t.to_region].cluster]) touched.push_back(t.to_region);
+    };
+
+    size_t start = 0;
+    while (start < transitions.size()) {
+        const Transition& first = transitions[start];
+        size_t end = start + 1;
+        while (end < transitions.size()) {
+            const Transition& t = transitions[end];
+            if (t.from_region != first.from_region || t.to_region != first.to_region ||
+                t.direction != first.direction || line(t) != line(first) ||
+                along(t) != along(transitions[end - 1]) + 1) {
+                break;
+            }
+            end++;
+        }
+
+        size_t length = end - start;
+        if (length > static_cast<size_t>(MAX_ENTRANCE_WIDTH)) {
+            link(transitions[start]);
+            link(transitions[end - 1]);
+        } else {
+            link(transitions[start + length / 2]);
+        }
+        start = end;
+    }
+}
+
+void HierarchicalPathfinder::connectRegion(int32_t region) {
+    const auto& members = regions[region].nodes;
+    for (uint32_t node : members) {
+        auto& edges = nodes[node].edges;
+        edges.erase(std::remove_if(edges.begin(), edges.end(),
+                                   [&](const Edge& e) { return nodes[e.to].region == region; }),
+                    edges.end());
+    }
+
+    // Distances are symmetric, so each pair needs one search
+    for (size_t i = 0; i + 1 < members.size(); i++) {
+        searchRegion(nodes[members[i]].pos);
+        for (size_t j = i + 1; j < members.size(); j++) {
+            size_t target = index(nodes[members[j]].pos);
+            if (tile_stamp[target] != tile_generation) continue;
+            addEdge(members[i], members[j], tile_dist[target]);
+            addEdge(members[j], members[i], tile_dist[target]);
+        }
+    }
+}
+
+void HierarchicalPathfinder::searchRegion(const Point& from) {
+    if (++tile_generation == 0) {
+        std::fill(tile_stamp.begin(), tile_stamp.end(), 0);
+        tile_generation = 1;
+    }
+
+    const size_t origin = index(from);
+    const int32_t region = region_of[origin];
+    tile_stamp[origin] = tile_generation;
+    tile_dist[origin] = 0;
+    frontier.assign(1, static_cast<uint32_t>(origin));
+    for (size_t head = 0; head < frontier.size(); head++) {
+        uint32_t current = frontier[head];
+        Point pos(static_cast<int>(current % width), static_cast<int>(current / width));
+        for (const Point& dir : Pathfinding::DIRECTIONS_4) {
+            Point next = pos + dir;
+            if (!map->inBounds(next.x, next.y)) continue;
+            size_t next_index = index(next);
+            if (region_of[next_index] != region || tile_stamp[next_index] == tile_generation) continue;
+            tile_stamp[next_index] = tile_generation;
+            tile_dist[next_index] = tile_dist[current] + 1;
+            frontier.push_back(static_cast<uint32_t>(next_index));
+        }
+    }
+}
+
+int32_t HierarchicalPathfinder::allocateRegion(int32_t cluster) {
+    int32_t region;
+    if (!free_regions.empty()) {
+        region = free_regions.back();
+        free_regions.pop_back();
+    } else {
+        region = static_cast<int32_t>(regions.size());
+        regions.emplace_back();
+    }
+    regions[region].cluster = cluster;
+    regions[region].nodes.clear();
+    cluster_regions[cluster].push_back(region);
+    return region;
+}
+
+uint32_t HierarchicalPathfinder::nodeAt(const Point& pos, int32_t region) {
+    int32_t& existing = node_of[index(pos)];
+    if (existing >= 0) return static_cast<uint32_t>(existing);
+
+    uint32_t node;
+    if (!free_nodes.empty()) {
+        node = free_nodes.back();
+        free_nodes.pop_back();
+    } else {
+        node = static_cast<uint32_t>(nodes.size());
+        nodes.emplace_back();
+    }
+    nodes[node].pos = pos;
+    nodes[node].region = region;
+    nodes[node].edges.clear();
+    existing = static_cast<int32_t>(node);
+    regions[region].nodes.push_back(node);
+    return node;
+}
+
+void HierarchicalPathfinder::freeNode(uint32_t node) {
+    node_of[index(nodes[node].pos)] = -1;
+    nodes[node].region = -1;
+    nodes[node].edges.clear();
+    free_nodes.push_back(node);
+}
+
+void HierarchicalPathfinder::addEdge(uint32_t from, uint32_t to, uint32_t cost) {
+    auto& edges = nodes[from].edges;
+    for (const Edge& edge : edges) {
+        if (edge.to == to) return;
+    }
+    edges.push_back({to, cost});
+}
+
+void HierarchicalPathfinder::removeEdge(uint32_t from, uint32_t to) {
+    auto& edges = nodes[from].edges;
+    edges.erase(std::remove_if(edges.begin(), edges.end(), [to](const Edge& e) { return e.to == to; }),
+                edges.end());
+}
+
+bool HierarchicalPathfinder::findRoute(const Point& start, const Point& goal, std::vector<Point>& route) {
+    route.clear();
+    expanded = 0;
+    if (!built || !map->inBounds(start.x, start.y) || !map->inBounds(goal.x, goal.y)) {
+        return false;
+    }
+    const int32_t start_region = region_of[index(start)];
+    const int32_t goal_region = region_of[index(goal)];
+    if (start_region < 0 || goal_region < 0) return false;
+    if (start_region == goal_region) {
+        route.push_back(goal);
+        return true;
+    }
+
+    if (node_stamp.size() < nodes.size()) {
+        node_stamp.resize(nodes.size(), 0);
+        node_g.resize(nodes.size());
+        node_parent.resize(nodes.size());
+        goal_cost.resize(nodes.size());
+        goal_stamp.resize(nodes.size(), 0);
+    }
+    if (++node_generation == 0) {
+        std::fill(node_stamp.begin(), node_stamp.end(), 0);
+        std::fill(goal_stamp.begin(), goal_stamp.end(), 0);
+        node_generation = 1;
+    }
+
+    // Only the start and goal regions are searched tile by tile
+    searchRegion(goal);
+    for (uint32_t node : regions[goal_region].nodes) {
+        size_t i = index(nodes[node].pos);
+        if (tile_stamp[i] != tile_generation) continue;
+        goal_stamp[node] = node_generation;
+        goal_cost[node] = tile_dist[i];
+    }
+
+    open.clear();
+    searchRegion(start);
+    for (uint32_t node : regions[start_region].nodes) {
+        size_t i = index(nodes[node].pos);
+        if (tile_stamp[i] != tile_generation) continue;
+        node_stamp[node] = node_generation;
+        node_g[node] = tile_dist[i];
+        node_parent[node] = NO_PARENT;
+        open.push_back({tile_dist[i] + manhattan(nodes[node].pos, goal), tile_dist[i], node});
+    }
+    std::make_heap(open.begin(), open.end(), std::greater<>());
+
+    uint32_t best = UINT32_MAX;
+    uint32_t best_parent = NO_PARENT;
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), std::greater<>());
+        HeapEntry current = open.back();
+        open.pop_back();
+        if (current.node == GOAL_NODE) break;
+        if (current.g > node_g[current.node]) continue;
+        expanded++;
+
+        if (goal_stamp[current.node] == node_generation) {
+            uint32_t total = current.g + goal_cost[current.node];
+            if (total < best) {
+                best = total;
+                best_parent = current.node;
+                open.push_back({total, total, GOAL_NODE});
+                std::push_heap(open.begin(), open.end(), std::greater<>());
+            }
+        }
+
+        for (const Edge& edge : nodes[current.node].edges) {
+            uint32_t g = current.g + edge.cost;
+            if (node_stamp[edge.to] == node_generation && g >= node_g[edge.to]) continue;
+            node_stamp[edge.to] = node_generation;
+            node_g[edge.to] = g;
+            node_parent[edge.to] = current.node;
+            open.push_back({g + manhattan(nodes[edge.to].pos, goal), g, edge.to});
+            std::push_heap(open.begin(), open.end(), std::greater<>());
+        }
+    }
+    if (best_parent == NO_PARENT) return false;
+
+    route_nodes.clear();
+    for (uint32_t node = best_parent; node != NO_PARENT; node = node_parent[node]) {
+        route_nodes.push_back(node);
+    }
+    for (auto it = route_nodes.rbegin(); it != route_nodes.rend(); ++it) {
+        if (nodes[*it].pos != start) route.push_back(nodes[*it].pos);
+    }
+    if (route.empty() || route.back() != goal) route.push_back(goal);
+    return true;
+}
+
+bool HierarchicalPathfinder::findPath(const Point& start, const Point& goal, std::vector<Point>& path) {
+    path.clear();
+    if (!findRoute(start, goal, waypoints)) return false;
+
+    Point from = start;
+    for (const Point& waypoint : waypoints) {
+        if (!refineTo(from, waypoint, path)) {
+            path.clear();
+            return false;
+        }
+        from = waypoint;
+    }
+    return true;
+}
+
+bool HierarchicalPathfinder::findNextSegment(const Point& start, const Point& goal, std::vector<Point>& path) {
+    path.clear();
+    if (!findRoute(start, goal, waypoints)) return false;
+
+    const int32_t start_region = region_of[index(start)];
+    Point from = start;
+    for (const Point& waypoint : waypoints) {
+        if (!refineTo(from, waypoint, path)) {
+            path.clear();
+            return false;
+        }
+        if (region_of[index(waypoint)] != start_region) break;
+        from = waypoint;
+    }
+    return true;
+}
+
+bool HierarchicalPathfinder::refineTo(const Point& from, const Point& to, std::vector<Point>& path) {
+    if (from == to) return true;
+    // Waypoints are close together, so these searches stay small
+    if (!Pathfinding::findPath(from, to, *map, context, segment, false)) return false;
+    path.insert(path.end(), segment.begin(), segment.end());
+    return true;
+}
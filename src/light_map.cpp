@@ -0,0 +1,153 @@
+#include "light_map.h"
+#include "fov.h"
+#include "map.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+void LightMap::setLight(LightId id, const Point& position, int radius, int intensity) {
+    intensity = std::clamp(intensity, 0, MAX_LEVEL);
+    radius = std::max(radius, 0);
+
+    auto [it, inserted] = lights.try_emplace(id);
+    Light& light = it->second;
+    if (!inserted && light.position == position && light.radius == radius &&
+        light.intensity == intensity) {
+        return;
+    }
+    light.position = position;
+    light.radius = radius;
+    light.intensity = intensity;
+    light.dirty = true;
+}
+
+void LightMap::removeLight(LightId id) {
+    auto it = lights.find(id);
+    if (it == lights.end()) return;
+    subtract(it->second);
+    lights.erase(it);
+}
+
+void LightMap::retain(const std::vector<LightId>& ids) {
+    for (auto it = lights.begin(); it != lights.end();) {
+        if (std::find(ids.begin(), ids.end(), it->first) == ids.end()) {
+            subtract(it->second);
+            it = lights.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void LightMap::clear() {
+    lights.clear();
+    std::fill(levels.begin(), levels.end(), 0);
+    lit.fill(false);
+    levels_changed = true;
+}
+
+bool LightMap::update(const Map& new_map) {
+    recast_count = 0;
+
+    if (map != &new_map || width != new_map.getWidth() || height != new_map.getHeight()) {
+        // Different tiles entirely: drop every cached contribution
+        map = &new_map;
+        width = new_map.getWidth();
+        height = new_map.getHeight();
+        levels.assign(static_cast<size_t>(width) * height, 0);
+        lit.resize(width, height);
+        for (auto& [id, light] : lights) {
+            light.tiles.clear();
+            light.amounts.clear();
+            light.dirty = true;
+        }
+        transparency_version = new_map.getTransparencyVersion();
+        levels_changed = true;
+    } else if (transparency_version != new_map.getTransparencyVersion()) {
+        // Walls or doors changed: recast only the lights that reach them
+        changes.clear();
+        if (new_map.getTransparencyChanges(transparency_version, changes)) {
+            for (const Point& tile : changes) {
+                markDirtyNear(tile);
+            }
+        } else {
+            for (auto& [id, light] : lights) {
+                light.dirty = true;
+            }
+        }
+        transparency_version = new_map.getTransparencyVersion();
+    }
+
+    for (auto& [id, light] : lights) {
+        if (!light.dirty) continue;
+        subtract(light);
+        cast(light);
+        light.dirty = false;
+        recast_count++;
+    }
+
+    bool changed = levels_changed;
+    levels_changed = false;
+    return changed;
+}
+
+void LightMap::markDirtyNear(const Point& tile) {
+    for (auto& [id, light] : lights) {
+        if (std::abs(tile.x - light.position.x) <= light.radius &&
+            std::abs(tile.y - light.position.y) <= light.radius) {
+            light.dirty = true;
+        }
+    }
+}
+
+void LightMap::subtract(Light& light) {
+    for (size_t i = 0; i < light.tiles.size(); i++) {
+        uint32_t index = light.tiles[i];
+        if (index >= levels.size()) continue;
+        levels[index] -= light.amounts[i];
+        if (levels[index] == 0) {
+            lit.set(static_cast<int>(index % width), static_cast<int>(index / width), false);
+        }
+    }
+    if (!light.tiles.empty()) {
+        levels_changed = true;
+    }
+    light.tiles.clear();
+    light.amounts.clear();
+}
+
+void LightMap::cast(Light& light) {
+    if (!map || light.intensity == 0 || !map->inBounds(light.position.x, light.position.y)) {
+        return;
+    }
+
+    // Shadowcast the light's reach; axis and diagonal tiles come back twice
+    scratch.clear();
+    scratch.push_back(light.position);
+    for (int octant = 0; octant < FOV::OCTANT_COUNT; octant++) {
+        FOV::calculateOctant(*map, light.position, light.radius, octant, scratch);
+    }
+
+    for (const Point& tile : scratch) {
+        light.tiles.push_back(static_cast<uint32_t>(tile.y) * width + tile.x);
+    }
+    std::sort(light.tiles.begin(), light.tiles.end());
+    light.tiles.erase(std::unique(light.tiles.begin(), light.tiles.end()), light.tiles.end());
+
+    // Linear falloff, never below 1 inside the reach
+    double reach = light.radius + 1.0;
+    light.amounts.reserve(light.tiles.size());
+    for (uint32_t index : light.tiles) {
+        int dx = static_cast<int>(index % width) - light.position.x;
+        int dy = static_cast<int>(index / width) - light.position.y;
+        double falloff = 1.0 - std::sqrt(static_cast<double>(dx * dx + dy * dy)) / reach;
+        auto amount = static_cast<uint16_t>(std::max(1, static_cast<int>(light.intensity * falloff)));
+        light.amounts.push_back(amount);
+
+        levels[index] += amount;
+        lit.set(static_cast<int>(index % width), static_cast<int>(index / width));
+    }
+    if (!light.tiles.empty()) {
+        levels_changed = true;
+    }
+}
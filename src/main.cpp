@@ -33,6 +33,7 @@
 #include "ecs/player_component.h"
 #include "frame_stats.h"
 #include "map_generator.h"
+#include "simulation.h"
 #include "config.h"
 
 // Database and authentication
@@ -608,6 +609,36 @@ void runFrameDumpMode(TestInput* test_input, MapType initial_map = MapType::TEST
     std::cout << "\n=== FRAME DUMP MODE END (Input Exhausted) ===\n";
 }
 
+/**
+ * Run a headless simulation and print its report
+ */
+int runSimulationMode(const std::string& turns_arg, unsigned int seed, MapType map_type) {
+    int turns = 0;
+    try {
+        turns = std::stoi(turns_arg);
+    } catch (const std::exception&) {
+        turns = 0;
+    }
+    if (turns <= 0) {
+        std::cerr << "Error: --simulate needs a positive number of turns, got: " << turns_arg << "\n";
+        return 1;
+    }
+
+    // Per-turn debug logging would dominate the run
+    Log::init("logs/veyrm_debug.log", Log::WARN);
+
+    std::cout << "Simulating " << turns << " turns (seed " << seed << ")...\n";
+    SimulationOptions options;
+    options.turns = turns;
+    options.seed = seed;
+    options.map_type = map_type;
+    Simulation simulation(options);
+    SimulationReport report = simulation.run();
+
+    std::cout << "\n=== SIMULATION REPORT ===\n" << report.format();
+    return 0;
+}
+
 /**
  * Run FTXUI interface
  */
@@ -1002,8 +1033,16 @@ int main(int argc, char* argv[]) {
     Config& config = Config::getInstance();
     config.loadFromFile("config.yml");
 
+    // Headless simulation runs without a database
+    bool simulate = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]) == "--simulate") {
+            simulate = true;
+        }
+    }
+
     // Initialize database (REQUIRED)
-    {
+    if (!simulate) {
         LOG_INFO("Initializing database connection...");
         db::DatabaseConfig db_config;
 
@@ -1051,6 +1090,10 @@ int main(int argc, char* argv[]) {
     std::string cmdline_username;
     std::string cmdline_password;
 
+    // Headless simulation, run once every option is parsed
+    std::string simulate_turns;
+    unsigned int cmdline_seed = 1;
+
     // Parse command-line arguments for config options (CLI overrides config file)
     for (int i = 1; i < argc; i++) {
         std::string arg = argv[i];
@@ -1099,6 +1142,29 @@ int main(int argc, char* argv[]) {
             continue;
         }
 
+        // Headless simulation
+        if (arg == "--simulate") {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: --simulate needs a number of turns\n";
+                std::cerr << "Use --help for usage information\n";
+                return 1;
+            }
+            simulate_turns = argv[++i];
+            continue;
+        }
+
+        // Simulation seed
+        if (arg == "--seed" && i + 1 < argc) {
+            std::string seed_arg = argv[++i];
+            try {
+                cmdline_seed = static_cast<unsigned int>(std::stoul(seed_arg));
+            } catch (const std::exception&) {
+                std::cerr << "Invalid seed: " << seed_arg << "\n";
+                return 1;
+            }
+            continue;
+        }
+
         // Authentication arguments for testing
         if (arg == "--username" && i + 1 < argc) {
             cmdline_username = argv[++i];
@@ -1130,6 +1196,8 @@ int main(int argc, char* argv[]) {
             std::cout << "  --no-ui             Run without UI (test mode)\n";
             std::cout << "  --keys <keystrokes> Run with automated keystrokes\n";
             std::cout << "  --dump <keystrokes> Run in frame dump mode (slideshow)\n";
+            std::cout << "  --simulate <turns>  Play turns headless and report performance\n";
+            std::cout << "  --seed <n>          Map seed for --simulate (default: 1)\n";
             std::cout << "  --config <file>     Load configuration from file (default: config.yml)\n";
             std::cout << "  --data-dir <path>   Set path to data directory (default: ./data)\n";
             std::cout << "  --map <type>        Start with specific map type\n";
@@ -1150,6 +1218,7 @@ int main(int argc, char* argv[]) {
             std::cout << "    \\b - Backspace\n";
             std::cout << "    \\\\ - Literal backslash\n";
             std::cout << "\nExample: --keys \"\\n\\u\\u\\n\" (Enter, Up, Up, Enter)\n";
+            std::cout << "Example: --simulate 10000 --seed 42 --map procedural\n";
             return 0;
         } else if (arg == "--test") {
             bool passed = runSystemChecks();
@@ -1181,7 +1250,8 @@ int main(int argc, char* argv[]) {
             runFrameDumpMode(&test_input, map_type);
             return 0;
         } else if (arg != "--map" && arg != "--username" && arg != "--password" &&
-                   arg != "--config" && arg != "--data-dir") {
+                   arg != "--config" && arg != "--data-dir" && arg != "--seed" &&
+                   arg != "--simulate") {
             // Options already handled above, only show error for truly unknown options
             std::cerr << "Unknown option: " << arg << "\n";
             std::cerr << "Use --help for usage information\n";
@@ -1189,6 +1259,11 @@ int main(int argc, char* argv[]) {
         }
     }
     
+    if (simulate) {
+        // Headless fast-forward with a scripted player
+        return runSimulationMode(simulate_turns, cmdline_seed, map_type);
+    }
+
     // Run the interface normally with selected map type
     runInterface(nullptr, map_type, cmdline_username, cmdline_password);
     
@@ -2,38 +2,26 @@
 #include "color_scheme.h"
 #include <algorithm>
 
-// Define tile properties for each tile type
-const std::map<TileType, TileProperties> Map::tileProperties = {
-    {TileType::FLOOR,       {"·", Color::White,     Color::Black, true,  true,  false, "Stone Floor"}},
-    {TileType::WALL,        {"█", Color::Yellow,    Color::Black, false, false, true,  "Stone Wall"}},
-    {TileType::STAIRS_DOWN, {"▼", Color::Yellow,    Color::Black, true,  true,  false, "Stairs Down"}},
-    {TileType::STAIRS_UP,   {"▲", Color::Yellow,    Color::Black, true,  true,  false, "Stairs Up"}},
-    {TileType::DOOR_CLOSED, {"▦", Color::Yellow,    Color::Black, false, false, true,  "Closed Door"}},
-    {TileType::DOOR_OPEN,   {"▢", Color::Yellow,    Color::Black, true,  true,  false, "Open Door"}},
-    {TileType::WATER,       {"≈", Color::Cyan,      Color::Black, false, true,  false, "Water"}},
-    {TileType::LAVA,        {"≈", Color::Red,       Color::Black, false, true,  false, "Lava"}},
-    {TileType::VOID,        {" ", Color::Black,     Color::Black, false, false, false, "Void"}},
-    {TileType::UNKNOWN,     {"?", Color::GrayDark,  Color::Black, false, false, false, "Unknown"}},
-};
-
-Map::Map(int w, int h) : width(w), height(h) {
-    // Initialize tile grid
-    tiles.resize(height);
-    visible.resize(height);
-    explored.resize(height);
-    
-    for (int y = 0; y < height; y++) {
-        tiles[y].resize(width, TileType::VOID);
-        visible[y].resize(width, false);
-        explored[y].resize(width, false);
-    }
+Map::Map(int w, int h)
+    : width(w)
+    , height(h)
+    , tiles(static_cast<size_t>(w) * h, TileType::VOID)
+    , flags(tiles.size(), flagsFor(TileType::VOID))
+    , visible((tiles.size() + 63) / 64, 0)
+    , explored(visible.size(), 0)
+    , walkable_bits(w, h)
+    , transparent_bits(w, h)
+    , wall_bits(w, h)
+    , chunks_wide((w + CHUNK_SIZE - 1) / CHUNK_SIZE)
+    , chunk_versions(static_cast<size_t>(chunks_wide) * ((h + CHUNK_SIZE - 1) / CHUNK_SIZE), 0) {
+    fill(TileType::VOID);
 }
 
 TileType Map::getTile(int x, int y) const {
     if (!inBounds(x, y)) {
         return TileType::VOID;
     }
-    return tiles[y][x];
+    return tiles[index(x, y)];
 }
 
 TileType Map::getTile(const Point& pos) const {
@@ -42,7 +30,20 @@ TileType Map::getTile(const Point& pos) const {
 
 void Map::setTile(int x, int y, TileType type) {
     if (inBounds(x, y)) {
-        tiles[y][x] = type;
+        size_t i = index(x, y);
+        uint8_t new_flags = flagsFor(type);
+        if ((flags[i] ^ new_flags) & FLAG_TRANSPARENT) {
+            transparency.record(x, y);
+        }
+        if ((flags[i] ^ new_flags) & FLAG_WALKABLE) {
+            walkability.record(x, y);
+            ++chunk_versions[static_cast<size_t>(getChunkIndex(x, y))];
+        }
+        tiles[i] = type;
+        flags[i] = new_flags;
+        walkable_bits.set(x, y, new_flags & FLAG_WALKABLE);
+        transparent_bits.set(x, y, new_flags & FLAG_TRANSPARENT);
+        wall_bits.set(x, y, isWallLike(type));
     }
 }
 
@@ -50,95 +51,71 @@ void Map::setTile(const Point& pos, TileType type) {
     setTile(pos.x, pos.y, type);
 }
 
-bool Map::isWalkable(int x, int y) const {
-    if (!inBounds(x, y)) {
-        return false;
-    }
-    TileType tile = getTile(x, y);
-    auto it = tileProperties.find(tile);
-    if (it != tileProperties.end()) {
-        return it->second.walkable;
-    }
-    return false;
+bool Map::getTransparencyChanges(uint32_t since, std::vector<Point>& changes) const {
+    return transparency.changesSince(since, changes);
 }
 
-bool Map::isWalkable(const Point& pos) const {
-    return isWalkable(pos.x, pos.y);
-}
-
-bool Map::isTransparent(int x, int y) const {
-    if (!inBounds(x, y)) {
+bool Map::TileChangeLog::changesSince(uint32_t since, std::vector<Point>& changes) const {
+    if (since < log_start || since > version) {
         return false;
     }
-    TileType tile = getTile(x, y);
-    auto it = tileProperties.find(tile);
-    if (it != tileProperties.end()) {
-        return it->second.transparent;
-    }
-    return false;
+    changes.insert(changes.end(), log.begin() + (since - log_start), log.end());
+    return true;
 }
 
-bool Map::isTransparent(const Point& pos) const {
-    return isTransparent(pos.x, pos.y);
-}
-
-bool Map::inBounds(int x, int y) const {
-    return x >= 0 && x < width && y >= 0 && y < height;
-}
-
-bool Map::inBounds(const Point& pos) const {
-    return inBounds(pos.x, pos.y);
+void Map::TileChangeLog::record(int x, int y) {
+    if (log.size() >= MAX_LOG) {
+        // Map generation churns through thousands of tiles; past this
+        // point consumers are better off recomputing everything
+        reset();
+        return;
+    }
+    ++version;
+    log.emplace_back(x, y);
 }
 
-bool Map::isVisible(int x, int y) const {
-    if (!inBounds(x, y)) {
-        return false;
-    }
-    return visible[y][x];
+void Map::TileChangeLog::reset() {
+    ++version;
+    log.clear();
+    log_start = version;
 }
 
 void Map::setVisible(int x, int y, bool vis) {
     if (inBounds(x, y)) {
-        visible[y][x] = vis;
-        // If setting visible, also mark as explored
+        size_t i = index(x, y);
+        uint64_t bit = uint64_t{1} << (i & 63);
         if (vis) {
-            explored[y][x] = true;
+            visible[i >> 6] |= bit;
+            // If setting visible, also mark as explored
+            explored[i >> 6] |= bit;
+        } else {
+            visible[i >> 6] &= ~bit;
         }
     }
 }
 
-bool Map::isExplored(int x, int y) const {
-    if (!inBounds(x, y)) {
-        return false;
-    }
-    return explored[y][x];
-}
-
 void Map::setExplored(int x, int y, bool exp) {
     if (inBounds(x, y)) {
-        explored[y][x] = exp;
+        size_t i = index(x, y);
+        uint64_t bit = uint64_t{1} << (i & 63);
+        if (exp) {
+            explored[i >> 6] |= bit;
+        } else {
+            explored[i >> 6] &= ~bit;
+        }
     }
 }
 
 void Map::clearVisibility() {
-    for (auto& row : visible) {
-        std::fill(row.begin(), row.end(), false);
-    }
+    std::fill(visible.begin(), visible.end(), 0);
 }
 
 void Map::clearExploration() {
-    for (auto& row : explored) {
-        std::fill(row.begin(), row.end(), false);
-    }
+    std::fill(explored.begin(), explored.end(), 0);
 }
 
 std::string Map::getGlyph(int x, int y) const {
-    TileType tile = getTile(x, y);
-    auto it = tileProperties.find(tile);
-    if (it != tileProperties.end()) {
-        return it->second.glyph;
-    }
-    return "?";
+    return std::string(getTileProperties(getTile(x, y)).glyph);
 }
 
 Color Map::getForeground(int x, int y) const {
@@ -165,19 +142,19 @@ Color Map::getForeground(int x, int y) const {
 }
 
 Color Map::getBackground(int x, int y) const {
-    TileType tile = getTile(x, y);
-    auto it = tileProperties.find(tile);
-    if (it != tileProperties.end()) {
-        return it->second.background;
-    }
-    return Color::Black;
+    return getTileProperties(getTile(x, y)).background;
 }
 
 void Map::fill(TileType type) {
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            tiles[y][x] = type;
-        }
+    std::fill(tiles.begin(), tiles.end(), type);
+    std::fill(flags.begin(), flags.end(), flagsFor(type));
+    walkable_bits.fill(flagsFor(type) & FLAG_WALKABLE);
+    transparent_bits.fill(flagsFor(type) & FLAG_TRANSPARENT);
+    wall_bits.fill(isWallLike(type));
+    transparency.reset();
+    walkability.reset();
+    for (uint32_t& version : chunk_versions) {
+        ++version;
     }
 }
 
@@ -199,15 +176,6 @@ void Map::createRoom(int x, int y, int w, int h) {
     }
 }
 
-TileProperties Map::getTileProperties(TileType type) {
-    auto it = tileProperties.find(type);
-    if (it != tileProperties.end()) {
-        return it->second;
-    }
-    // Return default properties for unknown tile
-    return {" ", Color::White, Color::Black, false, false, false, "Unknown"};
-}
-
 void Map::createCorridor(const Point& start, const Point& end) {
     // Simple L-shaped corridor
     Point current = start;
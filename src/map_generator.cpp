@@ -392,7 +392,7 @@ Point MapGenerator::getDefaultSpawnPoint(const Map& map, MapType type) {
     // For fixed maps, verify the default point is walkable, otherwise find safe one
     Point defaultPoint = getDefaultSpawnPoint(type);
     if (map.inBounds(defaultPoint)) {
-        auto props = Map::getTileProperties(map.getTile(defaultPoint.x, defaultPoint.y));
+        const auto& props = Map::getTileProperties(map.getTile(defaultPoint.x, defaultPoint.y));
         if (props.walkable) {
             return defaultPoint;
         }
@@ -965,25 +965,56 @@ std::vector<std::pair<int, int>> MapGenerator::getSequentialConnections(const st
 
 void MapGenerator::placeDoorsAtRoomEntrances(Map& map, const std::vector<Room>& rooms) {
     LOG_MAP("Placing doors at room entrances for " + std::to_string(rooms.size()) + " rooms");
+
+    // Placing a door only ever rules out neighbouring doorways, so the
+    // candidates found up front stay a valid filter for the whole scan
+    const Bitboard candidates = findDoorwayCandidates(map);
+    auto tryDoor = [&](int x, int y) {
+        if (candidates.test(x, y)) {
+            checkAndPlaceDoor(map, x, y);
+        }
+    };
+
     // Scan the perimeter of each room for doorway positions
     for (const auto& room : rooms) {
         // Check each edge of the room (walls are at the room boundary)
         for (int x = room.x; x < room.x + room.width; x++) {
             // Top wall
-            checkAndPlaceDoor(map, x, room.y);
+            tryDoor(x, room.y);
             // Bottom wall
-            checkAndPlaceDoor(map, x, room.y + room.height - 1);
+            tryDoor(x, room.y + room.height - 1);
         }
 
         for (int y = room.y; y < room.y + room.height; y++) {
             // Left wall
-            checkAndPlaceDoor(map, room.x, y);
+            tryDoor(room.x, y);
             // Right wall
-            checkAndPlaceDoor(map, room.x + room.width - 1, y);
+            tryDoor(room.x + room.width - 1, y);
         }
     }
 }
 
+Bitboard MapGenerator::findDoorwayCandidates(const Map& map) {
+    const Bitboard& walls = map.getWallBits();
+    const Bitboard& walkable = map.getWalkableBits();
+
+    // Walkable above and below, walls left and right
+    Bitboard horizontal = walkable.neighbor(0, -1);
+    horizontal &= walkable.neighbor(0, 1);
+    horizontal &= walls.neighbor(-1, 0);
+    horizontal &= walls.neighbor(1, 0);
+
+    // Walkable left and right, walls above and below
+    Bitboard vertical = walkable.neighbor(-1, 0);
+    vertical &= walkable.neighbor(1, 0);
+    vertical &= walls.neighbor(0, -1);
+    vertical &= walls.neighbor(0, 1);
+
+    horizontal |= vertical;
+    horizontal &= walls;
+    return horizontal;
+}
+
 void MapGenerator::checkAndPlaceDoor(Map& map, int x, int y) {
     // Check if this position is a valid doorway
     if (!map.inBounds(x, y)) return;
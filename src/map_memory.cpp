@@ -22,6 +22,23 @@ void MapMemory::updateVisibility(const Map& map, const std::vector<std::vector<b
     }
 }
 
+void MapMemory::updateVisibility(const Map& map, const std::vector<Point>& entered,
+                                 const std::vector<Point>& left) {
+    for (const auto& p : entered) {
+        if (!inBounds(p.x, p.y)) continue;
+        currentlyVisible[p.y][p.x] = true;
+        explored[p.y][p.x] = true;
+        remembered[p.y][p.x] = map.getTile(p.x, p.y);
+    }
+
+    // Remember tiles as they were when last in view
+    for (const auto& p : left) {
+        if (!inBounds(p.x, p.y)) continue;
+        currentlyVisible[p.y][p.x] = false;
+        remembered[p.y][p.x] = map.getTile(p.x, p.y);
+    }
+}
+
 bool MapMemory::isExplored(int x, int y) const {
     if (!inBounds(x, y)) return false;
     return explored[y][x];
@@ -74,26 +74,14 @@ MapValidator::ValidationResult MapValidator::validate(const Map& map) {
 
 bool MapValidator::checkConnectivity(const Map& map) {
     // Find first walkable tile
-    Point start = findWalkableTile(map);
+    const Bitboard& walkable = map.getWalkableBits();
+    Point start = walkable.findFirst();
     if (start.x == -1 || start.y == -1) {
         return false;  // No walkable tiles
     }
-    
-    // Flood fill from that tile
-    std::vector<std::vector<bool>> visited(map.getHeight(), 
-                                          std::vector<bool>(map.getWidth(), false));
-    floodFill(map, start.x, start.y, visited);
-    
-    // Check if all walkable tiles were visited
-    for (int y = 0; y < map.getHeight(); y++) {
-        for (int x = 0; x < map.getWidth(); x++) {
-            if (isWalkable(map, x, y) && !visited[y][x]) {
-                return false;  // Found unreachable walkable tile
-            }
-        }
-    }
-    
-    return true;
+
+    // Connected if the region around that tile covers every walkable tile
+    return walkable.floodFill(start).count() == walkable.count();
 }
 
 bool MapValidator::hasWalkableTiles(const Map& map) {
@@ -101,46 +89,24 @@ bool MapValidator::hasWalkableTiles(const Map& map) {
 }
 
 int MapValidator::countWalkableTiles(const Map& map) {
-    int count = 0;
-    for (int y = 0; y < map.getHeight(); y++) {
-        for (int x = 0; x < map.getWidth(); x++) {
-            if (isWalkable(map, x, y)) {
-                count++;
-            }
-        }
-    }
-    return count;
+    return static_cast<int>(map.getWalkableBits().count());
 }
 
 int MapValidator::countWallTiles(const Map& map) {
-    int count = 0;
-    for (int y = 0; y < map.getHeight(); y++) {
-        for (int x = 0; x < map.getWidth(); x++) {
-            TileType tile = map.getTile(x, y);
-            if (tile == TileType::WALL || tile == TileType::DOOR_CLOSED) {
-                count++;
-            }
-        }
-    }
-    return count;
+    // Walls and closed doors
+    return static_cast<int>(map.getWallBits().count());
 }
 
 int MapValidator::countRooms(const Map& map) {
-    // Simple room counting using flood fill
-    std::vector<std::vector<bool>> visited(map.getHeight(), 
-                                          std::vector<bool>(map.getWidth(), false));
+    // Peel connected regions off the walkable layer one flood fill at a time
+    Bitboard remaining = map.getWalkableBits();
     int room_count = 0;
-    
-    for (int y = 0; y < map.getHeight(); y++) {
-        for (int x = 0; x < map.getWidth(); x++) {
-            if (isWalkable(map, x, y) && !visited[y][x]) {
-                // Found new room/area
-                floodFill(map, x, y, visited);
-                room_count++;
-            }
-        }
+
+    for (Point seed = remaining.findFirst(); seed.x != -1; seed = remaining.findFirst()) {
+        remaining.andNot(remaining.floodFill(seed));
+        room_count++;
     }
-    
+
     return room_count;
 }
 
@@ -158,46 +124,7 @@ bool MapValidator::hasStairs(const Map& map) {
 
 Point MapValidator::findWalkableTile(const Map& map) {
     // Find first walkable tile
-    for (int y = 0; y < map.getHeight(); y++) {
-        for (int x = 0; x < map.getWidth(); x++) {
-            if (isWalkable(map, x, y)) {
-                return Point(x, y);
-            }
-        }
-    }
-    return Point(-1, -1);
-}
-
-void MapValidator::floodFill(const Map& map, int start_x, int start_y,
-                            std::vector<std::vector<bool>>& visited) {
-    // BFS flood fill
-    std::queue<Point> queue;
-    queue.push(Point(start_x, start_y));
-    visited[start_y][start_x] = true;
-    
-    const int dx[] = {0, 1, 0, -1};
-    const int dy[] = {-1, 0, 1, 0};
-    
-    while (!queue.empty()) {
-        Point current = queue.front();
-        queue.pop();
-        
-        // Check all 4 neighbors
-        for (int i = 0; i < 4; i++) {
-            int nx = current.x + dx[i];
-            int ny = current.y + dy[i];
-            
-            // Check bounds
-            if (nx >= 0 && nx < map.getWidth() && 
-                ny >= 0 && ny < map.getHeight()) {
-                // Check if walkable and not visited
-                if (isWalkable(map, nx, ny) && !visited[ny][nx]) {
-                    visited[ny][nx] = true;
-                    queue.push(Point(nx, ny));
-                }
-            }
-        }
-    }
+    return map.getWalkableBits().findFirst();
 }
 
 bool MapValidator::isWalkable(const Map& map, int x, int y) {
@@ -207,7 +134,7 @@ bool MapValidator::isWalkable(const Map& map, int x, int y) {
     
     TileType tile = map.getTile(x, y);
     // Get walkability from tile properties
-    auto props = map.getTileProperties(tile);
+    const auto& props = map.getTileProperties(tile);
     return props.walkable;
 }
 
@@ -346,8 +273,7 @@ bool MapValidator::isReachable(const Map& map, const Point& from, const Point& t
         return false;
     }
     
-    std::set<Point> reachable = bfsFloodFill(map, from);
-    return reachable.find(to) != reachable.end();
+    return map.getWalkableBits().floodFill(from).test(to);
 }
 
 std::set<Point> MapValidator::getReachableTiles(const Map& map, const Point& start) {
@@ -0,0 +1,235 @@
+#include "moving_target_search.h"
+#include "map.h"
+#include "pathfinding.h"
+#include <algorithm>
+#include <functional>
+
+namespace {
+
+uint32_t manhattan(const Point& a, const Point& b) {
+    return static_cast<uint32_t>(std::abs(a.x - b.x) + std::abs(a.y - b.y));
+}
+
+} // namespace
+
+bool MovingTargetSearch::findPath(const Map& new_map, const Point& start, const Point& goal,
+                                  std::vector<Point>& path) {
+    path.clear();
+    expanded = 0;
+    limit_hit = false;
+    if (!new_map.inBounds(start.x, start.y) || !new_map.isWalkable(goal.x, goal.y)) {
+        return false;
+    }
+
+    if (!valid || map != &new_map || width != new_map.getWidth() || height != new_map.getHeight() ||
+        !applyMapChanges(new_map)) {
+        restart(new_map, start);
+    }
+    if (index(start) != root && !reroot(index(start))) {
+        restart(new_map, start);
+    }
+    if (start == goal) return true;
+
+    rebuildOpen(goal);
+    if (!search(goal)) {
+        if (limit_hit) reset();
+        return false;
+    }
+
+    chain.clear();
+    for (uint32_t i = index(goal); i != root; i = records.find(i)->second.parent) {
+        chain.push_back(i);
+    }
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+        path.push_back(position(*it));
+    }
+    return true;
+}
+
+void MovingTargetSearch::reset() {
+    records.clear();
+    open.clear();
+    valid = false;
+}
+
+void MovingTargetSearch::restart(const Map& new_map, const Point& start) {
+    map = &new_map;
+    width = new_map.getWidth();
+    height = new_map.getHeight();
+    walkability_version = new_map.getWalkabilityVersion();
+    records.clear();
+    open.clear();
+    root = index(start);
+    g_offset = 0;
+    records.emplace(root, Record{0, NONE});
+    open.push_back({0, 0, root});
+    valid = true;
+}
+
+bool MovingTargetSearch::applyMapChanges(const Map& new_map) {
+    uint32_t version = new_map.getWalkabilityVersion();
+    if (version == walkability_version) return true;
+
+    changes.clear();
+    if (!new_map.getWalkabilityChanges(walkability_version, changes)) return false;
+    walkability_version = version;
+
+    removed.clear();
+    for (const Point& p : changes) {
+        uint32_t i = index(p);
+        if (new_map.isWalkable(p.x, p.y)) {
+            // An opening next to the tree may shorten any route through it
+            if (records.count(i)) continue;
+            for (const Point& dir : Pathfinding::DIRECTIONS_4) {
+                Point next = p + dir;
+                if (new_map.inBounds(next.x, next.y) && records.count(index(next))) return false;
+            }
+        } else if (records.count(i)) {
+            // Routes that avoided the closed tile are still shortest
+            if (i == root) return false;
+            detach(i);
+        }
+    }
+    return refillFringe();
+}
+
+bool MovingTargetSearch::reroot(uint32_t new_root) {
+    auto it = records.find(new_root);
+    if (it == records.end() || it->second.state != CLOSED) return false;
+
+    // The subtree under an expanded tile holds exact distances from it;
+    // everything else hangs off the old root and is dropped
+    unlink(new_root);
+    removed.clear();
+    detach(root);
+    root = new_root;
+    g_offset = it->second.g;
+    return refillFringe();
+}
+
+void MovingTargetSearch::detach(uint32_t subtree) {
+    unlink(subtree);
+    chain.assign(1, subtree);
+    while (!chain.empty()) {
+        uint32_t i = chain.back();
+        chain.pop_back();
+        removed.push_back(i);
+        for (uint32_t child = records.find(i)->second.first_child; child != NONE;
+             child = records.find(child)->second.next_sibling) {
+            chain.push_back(child);
+        }
+    }
+    for (uint32_t i : removed) {
+        records.erase(i);
+    }
+}
+
+bool MovingTargetSearch::refillFringe() {
+    // Dropped tiles next to a kept expanded tile become open again
+    for (uint32_t i : removed) {
+        Point pos = position(i);
+        if (!map->isWalkable(pos.x, pos.y) || records.count(i)) continue;
+
+        uint32_t best_parent = NONE;
+        uint32_t best_g = UINT32_MAX;
+        for (const Point& dir : Pathfinding::DIRECTIONS_4) {
+            Point next = pos + dir;
+            if (!map->inBounds(next.x, next.y)) continue;
+            auto it = records.find(index(next));
+            if (it != records.end() && it->second.state == CLOSED && it->second.g < best_g) {
+                best_g = it->second.g;
+                best_parent = it->first;
+            }
+        }
+        if (best_parent == NONE) continue;
+
+        records.emplace(i, Record{best_g + 1, NONE});
+        link(i, best_parent);
+        open.push_back({0, best_g + 1, i});
+        if (records.size() > node_limit) return false;
+    }
+    removed.clear();
+    return true;
+}
+
+void MovingTargetSearch::link(uint32_t child, uint32_t parent) {
+    Record& record = records.find(child)->second;
+    Record& parent_record = records.find(parent)->second;
+    record.parent = parent;
+    record.next_sibling = parent_record.first_child;
+    parent_record.first_child = child;
+}
+
+void MovingTargetSearch::unlink(uint32_t child) {
+    Record& record = records.find(child)->second;
+    if (record.parent == NONE) return;
+
+    Record& parent_record = records.find(record.parent)->second;
+    if (parent_record.first_child == child) {
+        parent_record.first_child = record.next_sibling;
+    } else {
+        Record* sibling = &records.find(parent_record.first_child)->second;
+        while (sibling->next_sibling != child) {
+            sibling = &records.find(sibling->next_sibling)->second;
+        }
+        sibling->next_sibling = record.next_sibling;
+    }
+    record.parent = NONE;
+    record.next_sibling = NONE;
+}
+
+void MovingTargetSearch::rebuildOpen(const Point& goal) {
+    // Distances from the root do not depend on the goal; only the keys do
+    size_t kept = 0;
+    for (const HeapEntry& entry : open) {
+        auto it = records.find(entry.index);
+        if (it == records.end() || it->second.state != OPEN || it->second.g != entry.g) continue;
+        open[kept++] = {entry.g - g_offset + manhattan(position(entry.index), goal), entry.g, entry.index};
+    }
+    open.resize(kept);
+    std::make_heap(open.begin(), open.end(), std::greater<>());
+}
+
+bool MovingTargetSearch::search(const Point& goal) {
+    const uint32_t target = index(goal);
+    auto found = records.find(target);
+    if (found != records.end() && found->second.state == CLOSED) return true;
+
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), std::greater<>());
+        HeapEntry current = open.back();
+        open.pop_back();
+
+        Record& record = records.find(current.index)->second;
+        if (record.state == CLOSED || current.g != record.g) continue;
+        record.state = CLOSED;
+        expanded++;
+
+        const uint32_t g = current.g + 1;
+        Point pos = position(current.index);
+        for (const Point& dir : Pathfinding::DIRECTIONS_4) {
+            Point next = pos + dir;
+            if (!map->isWalkable(next.x, next.y)) continue;
+            uint32_t next_index = index(next);
+            auto [it, inserted] = records.try_emplace(next_index, Record{g, NONE});
+            if (inserted) {
+                if (records.size() > node_limit) {
+                    limit_hit = true;
+                    return false;
+                }
+            } else if (it->second.state == OPEN && g < it->second.g) {
+                unlink(next_index);
+                it->second.g = g;
+            } else {
+                continue;
+            }
+            link(next_index, current.index);
+            open.push_back({g - g_offset + manhattan(next, goal), g, next_index});
+            std::push_heap(open.begin(), open.end(), std::greater<>());
+        }
+        // Checked after relaxing so every expanded tile keeps its neighbours
+        // in the tree, which the next query's repairs rely on
+        if (current.index == target) return true;
+    }
+    return false;
+}
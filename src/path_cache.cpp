@@ -0,0 +1,202 @@
+#include "path_cache.h"
+#include "map.h"
+#include "pathfinding.h"
+#include <algorithm>
+#include <climits>
+
+const Point& SharedPath::operator[](size_t i) const {
+    size_t leading = lead.size() - lead_offset;
+    return i < leading ? lead[lead_offset + i] : (*steps)[offset + i - leading];
+}
+
+void SharedPath::pop_front() {
+    if (lead_offset < lead.size()) {
+        lead_offset++;
+    } else {
+        offset++;
+    }
+}
+
+void SharedPath::clear() {
+    lead.clear();
+    lead_offset = 0;
+    steps.reset();
+    offset = 0;
+}
+
+std::span<const Point> SharedPath::span() const {
+    if (!steps) return {};
+    return std::span<const Point>(*steps).subspan(offset);
+}
+
+bool PathCache::lookup(const Map& new_map, const Point& start, const Point& goal, bool allow_diagonals,
+                       SharedPath& path) {
+    path.clear();
+    if (start == goal) return true;
+    bind(new_map);
+
+    auto it = entries.find(key(start, goal, allow_diagonals));
+    if (it == entries.end()) {
+        misses++;
+        return false;
+    }
+    Entry& entry = it->second;
+    if (!isCurrent(new_map, entry)) {
+        entries.erase(it);
+        misses++;
+        return false;
+    }
+
+    // On the path already: the rest of it is the answer
+    const std::vector<Point>& steps = *entry.steps;
+    if (start == entry.start) {
+        path = SharedPath(entry.steps);
+    } else if (auto on = std::find(steps.begin(), steps.end(), start); on != steps.end()) {
+        path = SharedPath(entry.steps, static_cast<size_t>(on - steps.begin()) + 1);
+    } else if (!join(new_map, start, entry, path)) {
+        misses++;
+        return false;
+    }
+    entry.last_used = ++tick;
+    hits++;
+    return true;
+}
+
+SharedPath PathCache::store(const Map& new_map, const Point& start, const Point& goal, bool allow_diagonals,
+                            std::vector<Point> steps) {
+    auto shared = std::make_shared<const std::vector<Point>>(std::move(steps));
+    if (shared->empty() || capacity == 0) return SharedPath(shared);
+    bind(new_map);
+
+    Entry entry;
+    entry.start = start;
+    entry.steps = shared;
+    entry.last_used = ++tick;
+    std::vector<int> crossed;
+    crossed.push_back(new_map.getChunkIndex(start));
+    for (const Point& p : *shared) {
+        int chunk = new_map.getChunkIndex(p);
+        if (chunk != crossed.back()) crossed.push_back(chunk);
+    }
+    std::sort(crossed.begin(), crossed.end());
+    crossed.erase(std::unique(crossed.begin(), crossed.end()), crossed.end());
+    entry.chunks.reserve(crossed.size());
+    for (int chunk : crossed) {
+        entry.chunks.emplace_back(chunk, new_map.getChunkVersion(chunk));
+    }
+
+    uint64_t k = key(start, goal, allow_diagonals);
+    if (entries.size() >= capacity && !entries.count(k)) {
+        auto oldest = std::min_element(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+            return a.second.last_used < b.second.last_used;
+        });
+        entries.erase(oldest);
+    }
+    entries[k] = std::move(entry);
+    return SharedPath(shared);
+}
+
+void PathCache::clear() {
+    entries.clear();
+}
+
+void PathCache::bind(const Map& new_map) {
+    if (map == &new_map && width == new_map.getWidth() && height == new_map.getHeight()) return;
+    map = &new_map;
+    width = new_map.getWidth();
+    height = new_map.getHeight();
+    entries.clear();
+}
+
+uint64_t PathCache::key(const Point& start, const Point& goal, bool allow_diagonals) const {
+    uint64_t goal_index = static_cast<uint64_t>(goal.y) * static_cast<uint64_t>(width) + static_cast<uint64_t>(goal.x);
+    uint64_t region = static_cast<uint64_t>(map->getChunkIndex(start));
+    return goal_index << 32 | region << 1 | (allow_diagonals ? 1 : 0);
+}
+
+bool PathCache::isCurrent(const Map& new_map, const Entry& entry) const {
+    return std::all_of(entry.chunks.begin(), entry.chunks.end(), [&new_map](const auto& chunk) {
+        return new_map.getChunkVersion(chunk.first) == chunk.second;
+    });
+}
+
+bool PathCache::join(const Map& new_map, const Point& start, const Entry& entry, SharedPath& path) {
+    // Breadth-first over the start chunk, joining the path wherever that
+    // leaves the fewest steps; cardinal steps are valid in either mode
+    constexpr int SIZE = Map::CHUNK_SIZE;
+    const Point origin((start.x / SIZE) * SIZE, (start.y / SIZE) * SIZE);
+    auto local = [&origin](const Point& p) {
+        int x = p.x - origin.x;
+        int y = p.y - origin.y;
+        return x >= 0 && x < SIZE && y >= 0 && y < SIZE ? y * SIZE + x : -1;
+    };
+
+    // Remaining steps after stepping onto each path tile in the chunk
+    const std::vector<Point>& steps = *entry.steps;
+    join_remaining.assign(SIZE * SIZE, NONE);
+    if (int i = local(entry.start); i >= 0) join_remaining[i] = static_cast<int>(steps.size());
+    size_t exit = steps.size();
+    for (size_t s = 0; s < steps.size(); s++) {
+        int i = local(steps[s]);
+        if (i >= 0) {
+            join_remaining[i] = static_cast<int>(steps.size() - s - 1);
+        } else if (exit == steps.size()) {
+            exit = s;
+        }
+    }
+
+    join_parent.assign(SIZE * SIZE, NONE);
+    join_queue.clear();
+    const int root = local(start);
+    join_parent[root] = root;
+    join_queue.push_back(root);
+    int best = NONE;
+    int best_cost = INT_MAX;
+    bool best_is_exit = false;
+    join_depth.assign(SIZE * SIZE, 0);
+    for (size_t head = 0; head < join_queue.size(); head++) {
+        int i = join_queue[head];
+        if (join_depth[i] >= best_cost) break;
+        if (join_remaining[i] != NONE && join_depth[i] + join_remaining[i] < best_cost) {
+            best = i;
+            best_cost = join_depth[i] + join_remaining[i];
+            best_is_exit = false;
+        }
+        Point pos(origin.x + i % SIZE, origin.y + i / SIZE);
+        for (const Point& dir : Pathfinding::DIRECTIONS_4) {
+            Point next = pos + dir;
+            int n = local(next);
+            if (n < 0) {
+                // Stepping straight onto the path where it leaves the chunk
+                if (exit < steps.size() && next == steps[exit] &&
+                    join_depth[i] + 1 + static_cast<int>(steps.size() - exit - 1) < best_cost) {
+                    best = i;
+                    best_cost = join_depth[i] + 1 + static_cast<int>(steps.size() - exit - 1);
+                    best_is_exit = true;
+                }
+                continue;
+            }
+            if (join_parent[n] != NONE || !new_map.isWalkable(next.x, next.y)) continue;
+            join_parent[n] = i;
+            join_depth[n] = join_depth[i] + 1;
+            join_queue.push_back(n);
+        }
+    }
+    if (best == NONE) return false;
+
+    std::vector<Point> lead;
+    if (best_is_exit) lead.push_back(steps[exit]);
+    for (int i = best; i != root; i = join_parent[i]) {
+        lead.emplace_back(origin.x + i % SIZE, origin.y + i / SIZE);
+    }
+    std::reverse(lead.begin(), lead.end());
+
+    size_t offset;
+    if (best_is_exit) {
+        offset = exit + 1;
+    } else {
+        offset = steps.size() - static_cast<size_t>(join_remaining[best]);
+    }
+    path = SharedPath(entry.steps, offset, std::move(lead));
+    return true;
+}
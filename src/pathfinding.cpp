@@ -21,45 +21,110 @@ const Point Pathfinding::DIRECTIONS_4[4] = {
     {-1, 0}    // W
 };
 
+void PathfindingContext::begin(int map_width, int map_height) {
+    size_t tiles = static_cast<size_t>(map_width) * map_height;
+    if (map_width != width || map_height != height || stamps.size() != tiles) {
+        width = map_width;
+        height = map_height;
+        stamps.assign(tiles, 0);
+        g_scores.resize(tiles);
+        parents.resize(tiles);
+        generation = 0;
+    }
+
+    // Stamps from an earlier pass through the counter would look current
+    if (++generation == 0) {
+        std::fill(stamps.begin(), stamps.end(), 0);
+        generation = 1;
+    }
+    open.clear();
+    expanded = 0;
+}
+
 std::vector<Point> Pathfinding::findPath(const Point& start, const Point& goal, const Map& map, bool allow_diagonals) {
+    thread_local PathfindingContext context;
+    std::vector<Point> path;
+    findPath(start, goal, map, context, path, allow_diagonals);
+    return path;
+}
+
+bool Pathfinding::findPath(const Point& start, const Point& goal, const Map& map,
+                           PathfindingContext& context, std::vector<Point>& path,
+                           bool allow_diagonals) {
+    path.clear();
     if (start == goal) {
-        return {goal};
+        path.push_back(goal);
+        return true;
+    }
+    if (!map.inBounds(start.x, start.y) || !map.isWalkable(goal.x, goal.y)) {
+        return false;
     }
 
-    std::priority_queue<Node, std::vector<Node>, std::greater<Node>> open_set;
-    std::map<Point, float> g_scores;
-    std::map<Point, Point> came_from;
-
-    open_set.push({start, 0, heuristic(start, goal)});
-    g_scores[start] = 0;
+    const int width = map.getWidth();
+    context.begin(width, map.getHeight());
+    auto& stamps = context.stamps;
+    auto& g_scores = context.g_scores;
+    auto& parents = context.parents;
+    auto& open = context.open;
+    const uint32_t generation = context.generation;
+
+    // Pop lowest f first; among equal f prefer the node closest to the goal
+    auto worse = [](const PathfindingContext::HeapEntry& a, const PathfindingContext::HeapEntry& b) {
+        return a.f > b.f || (a.f == b.f && a.g < b.g);
+    };
+
+    const uint32_t start_index = static_cast<uint32_t>(start.y * width + start.x);
+    const uint32_t goal_index = static_cast<uint32_t>(goal.y * width + goal.x);
+    stamps[start_index] = generation;
+    g_scores[start_index] = 0;
+    parents[start_index] = start_index;
+    open.push_back({heuristic(start, goal, allow_diagonals), 0, start_index});
 
-    while (!open_set.empty()) {
-        Node current = open_set.top();
-        open_set.pop();
+    const Point* directions = allow_diagonals ? DIRECTIONS_8 : DIRECTIONS_4;
+    const int num_dirs = allow_diagonals ? 8 : 4;
 
-        if (current.pos == goal) {
-            return reconstructPath(came_from, goal);
-        }
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), worse);
+        PathfindingContext::HeapEntry current = open.back();
+        open.pop_back();
 
-        if (g_scores.count(current.pos) && current.g_cost > g_scores[current.pos]) {
+        // Stale entry superseded by a cheaper one
+        if (current.g > g_scores[current.index]) {
             continue;
         }
+        context.expanded++;
 
-        for (const Point& neighbor : getNeighbors(current.pos, map, allow_diagonals)) {
-            float tentative_g = current.g_cost;
+        if (current.index == goal_index) {
+            for (uint32_t i = goal_index; i != start_index; i = parents[i]) {
+                path.emplace_back(static_cast<int>(i % width), static_cast<int>(i / width));
+            }
+            std::reverse(path.begin(), path.end());
+            return true;
+        }
 
-            bool is_diagonal = (neighbor.x != current.pos.x) && (neighbor.y != current.pos.y);
-            tentative_g += is_diagonal ? 1.41f : 1.0f;
+        Point pos(static_cast<int>(current.index % width), static_cast<int>(current.index / width));
+        for (int i = 0; i < num_dirs; ++i) {
+            Point next = pos + directions[i];
+            if (!map.isWalkable(next.x, next.y)) {
+                continue;
+            }
 
-            if (!g_scores.count(neighbor) || tentative_g < g_scores[neighbor]) {
-                g_scores[neighbor] = tentative_g;
-                came_from[neighbor] = current.pos;
-                open_set.push({neighbor, tentative_g, tentative_g + heuristic(neighbor, goal)});
+            bool is_diagonal = directions[i].x != 0 && directions[i].y != 0;
+            uint32_t tentative_g = current.g + (is_diagonal ? DIAGONAL_COST : STRAIGHT_COST);
+            uint32_t index = static_cast<uint32_t>(next.y * width + next.x);
+            if (stamps[index] == generation && tentative_g >= g_scores[index]) {
+                continue;
             }
+
+            stamps[index] = generation;
+            g_scores[index] = tentative_g;
+            parents[index] = current.index;
+            open.push_back({tentative_g + heuristic(next, goal, allow_diagonals), tentative_g, index});
+            std::push_heap(open.begin(), open.end(), worse);
         }
     }
 
-    return {};
+    return false;
 }
 
 bool Pathfinding::hasLineOfSight(const Point& from, const Point& to, const Map& map) {
@@ -76,8 +141,7 @@ bool Pathfinding::hasLineOfSight(const Point& from, const Point& to, const Map&
             return false;
         }
 
-        auto props = Map::getTileProperties(map.getTile(x, y));
-        if (!props.transparent) {
+        if (!map.isTransparent(x, y)) {
             return false;
         }
 
@@ -101,41 +165,12 @@ float Pathfinding::getDistance(const Point& a, const Point& b) {
     return static_cast<float>(std::sqrt(dx * dx + dy * dy));
 }
 
-float Pathfinding::heuristic(const Point& a, const Point& b) {
-    return getDistance(a, b);
-}
-
-std::vector<Point> Pathfinding::getNeighbors(const Point& pos, const Map& map, bool allow_diagonals) {
-    std::vector<Point> neighbors;
-
-    const Point* directions = allow_diagonals ? DIRECTIONS_8 : DIRECTIONS_4;
-    int num_dirs = allow_diagonals ? 8 : 4;
-
-    for (int i = 0; i < num_dirs; ++i) {
-        Point new_pos = pos + directions[i];
-
-        if (!map.inBounds(new_pos.x, new_pos.y)) {
-            continue;
-        }
-
-        auto props = Map::getTileProperties(map.getTile(new_pos.x, new_pos.y));
-        if (props.walkable) {
-            neighbors.push_back(new_pos);
-        }
+uint32_t Pathfinding::heuristic(const Point& a, const Point& b, bool allow_diagonals) {
+    uint32_t dx = static_cast<uint32_t>(std::abs(a.x - b.x));
+    uint32_t dy = static_cast<uint32_t>(std::abs(a.y - b.y));
+    if (!allow_diagonals) {
+        return (dx + dy) * STRAIGHT_COST;
     }
-
-    return neighbors;
+    // Diagonal steps for the shorter axis, straight steps for the rest
+    return STRAIGHT_COST * std::max(dx, dy) + (DIAGONAL_COST - STRAIGHT_COST) * std::min(dx, dy);
 }
-
-std::vector<Point> Pathfinding::reconstructPath(const std::map<Point, Point>& came_from, const Point& current) {
-    std::vector<Point> path;
-    Point cur = current;
-
-    while (came_from.count(cur)) {
-        path.push_back(cur);
-        cur = came_from.at(cur);
-    }
-
-    std::reverse(path.begin(), path.end());
-    return path;
-}
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "color_scheme.h"
 #include "ecs/game_world.h"
 #include "ecs/render_system.h"
+#include "ecs/light_system.h"
 #include <ftxui/dom/elements.hpp>
 #include <algorithm>
 
@@ -81,6 +82,7 @@ Element MapRenderer::renderTerrainWithPlayer(const Map& map, const GameManager&
     
     // Get entities from ECS RenderSystem
     std::vector<std::vector<std::string>> ecs_entity_grid;
+    const LightMap* light_map = nullptr;
     auto* ecs_world = const_cast<ecs::GameWorld*>(game.getECSWorld());
     if (ecs_world) {
         ecs::RenderSystem* render_system = ecs_world->getRenderSystem();
@@ -88,6 +90,9 @@ Element MapRenderer::renderTerrainWithPlayer(const Map& map, const GameManager&
             ecs_entity_grid = render_system->renderToGrid(viewport_width, viewport_height,
                                                          viewport_offset.x, viewport_offset.y);
         }
+        if (ecs::LightSystem* light_system = ecs_world->getLightSystem()) {
+            light_map = &light_system->getLightMap();
+        }
     }
 
     // Items rendered through ECS
@@ -175,10 +180,14 @@ Element MapRenderer::renderTerrainWithPlayer(const Map& map, const GameManager&
                 Element tile = text(glyph) | color(fg);
                 
                 // Add highlight if this tile is selected
+                uint8_t light = light_map ? light_map->getLevel(map_pos.x, map_pos.y) : 0;
                 if (highlight_pos == map_pos) {
                     tile = tile | bgcolor(Color::Yellow) | bold;
                 } else if (bg != Color::Black) {
                     tile = tile | bgcolor(bg);
+                } else if (light > 0) {
+                    // Warm glow scaled by the light level
+                    tile = tile | bgcolor(Color::RGB(light / 4, light / 6, light / 16));
                 }
                 
                 row_elements.push_back(tile);
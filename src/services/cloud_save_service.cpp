@@ -14,6 +14,7 @@
 #include "ecs/position_component.h"
 #include "ecs/health_component.h"
 #include "ecs/stats_component.h"
+#include "ecs/event.h"
 #include "message_log.h"
 #include "log.h"
 
@@ -701,8 +702,18 @@ void CloudSaveService::syncThreadLoop() {
         if (!sync_thread_running) break;
 
         if (isAuthenticated() && isOnline()) {
-            std::lock_guard<std::mutex> lock(sync_mutex);
-            syncAllSaves();
+            SyncResult result;
+            {
+                std::lock_guard<std::mutex> lock(sync_mutex);
+                result = syncAllSaves();
+            }
+
+            // Report to the game thread; handled on its next event update
+            ecs::BaseEvent event(ecs::EventType::STATE_CHANGE);
+            event.text = "cloud_sync";
+            event.value1 = result.saves_uploaded;
+            event.value2 = result.saves_downloaded;
+            ecs::EventSystem::getInstance().post(event);
         }
     }
 }
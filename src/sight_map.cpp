@@ -0,0 +1,38 @@
+#include "sight_map.h"
+#include "fov.h"
+#include "map.h"
+#include <algorithm>
+
+bool SightMap::compute(const Map& new_map, const Point& new_focus, int new_radius) {
+    if (valid && map == &new_map && focus == new_focus && radius == new_radius &&
+        transparency_version == new_map.getTransparencyVersion() &&
+        width == new_map.getWidth() && height == new_map.getHeight()) {
+        return false;
+    }
+
+    map = &new_map;
+    focus = new_focus;
+    radius = new_radius;
+    transparency_version = new_map.getTransparencyVersion();
+    width = new_map.getWidth();
+    height = new_map.getHeight();
+    valid = true;
+
+    bits.assign((static_cast<size_t>(width) * height + 63) / 64, 0);
+    if (!new_map.inBounds(focus.x, focus.y)) {
+        return true;
+    }
+
+    auto set = [this](const Point& p) {
+        size_t i = static_cast<size_t>(p.y) * width + p.x;
+        bits[i >> 6] |= uint64_t{1} << (i & 63);
+    };
+
+    set(focus);
+    for (int octant = 0; octant < FOV::OCTANT_COUNT; octant++) {
+        lit.clear();
+        FOV::calculateOctant(new_map, focus, radius, octant, lit);
+        std::for_each(lit.begin(), lit.end(), set);
+    }
+    return true;
+}
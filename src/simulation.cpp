@@ -0,0 +1,245 @@
+/**
+ * @file simulation.cpp
+ * @brief Headless game simulation implementation
+ */
+
+#include "simulation.h"
+#include "game_state.h"
+#include "turn_manager.h"
+#include "frame_stats.h"
+#include "map.h"
+#include "pathfinding.h"
+#include "ecs/game_world.h"
+#include "ecs/ai_system.h"
+#include "ecs/combat_component.h"
+#include "ecs/health_component.h"
+#include "ecs/position_component.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+
+#ifdef PLATFORM_WINDOWS
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+    #include <psapi.h>
+#else
+    #include <sys/resource.h>
+#endif
+
+namespace {
+
+/// Turns without moving before the player gives up on its goal for a step
+constexpr int STUCK_LIMIT = 3;
+
+double millisecondsBetween(std::chrono::steady_clock::time_point start,
+                           std::chrono::steady_clock::time_point end) {
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+} // namespace
+
+Simulation::Simulation(const SimulationOptions& opts)
+    : options(opts),
+      game_manager(std::make_unique<GameManager>(opts.map_type)),
+      rng(opts.seed) {
+    game_manager->setState(GameState::PLAYING);
+    startLevel(options.seed);
+    watchDeaths();
+}
+
+Simulation::~Simulation() {
+    if (death_observer && game_manager->getECSWorld()) {
+        game_manager->getECSWorld()->getWorld().removeObserver(death_observer);
+    }
+}
+
+SimulationReport Simulation::run() {
+    using Clock = std::chrono::steady_clock;
+    ecs::GameWorld* ecs_world = game_manager->getECSWorld();
+    FrameStats* stats = game_manager->getFrameStats();
+
+    // Level setup runs systems too; report only what the run adds
+    ecs::SystemManager& system_manager = ecs_world->getWorld().getSystemManager();
+    const std::vector<ecs::SystemTiming> timings_before = system_manager.getTimings();
+
+    const auto run_start = Clock::now();
+    for (int turn = 0; turn < options.turns; turn++) {
+        auto start = Clock::now();
+        Point from(game_manager->player_x, game_manager->player_y);
+        Point step = choosePlayerStep(from);
+        auto now = Clock::now();
+        report.policy_ms += millisecondsBetween(start, now);
+
+        start = now;
+        ActionSpeed speed = ecs_world->processPlayerAction(0, step.x, step.y);
+        if (auto* player = ecs_world->getPlayerEntity()) {
+            if (auto* pos = player->getComponent<ecs::PositionComponent>()) {
+                game_manager->player_x = pos->position.x;
+                game_manager->player_y = pos->position.y;
+            }
+        }
+        now = Clock::now();
+        report.player_ms += millisecondsBetween(start, now);
+
+        start = now;
+        game_manager->processPlayerAction(speed);
+        ecs_world->removeDeadEntities();
+        now = Clock::now();
+        report.world_ms += millisecondsBetween(start, now);
+        for (size_t tier = 0; tier < report.ai_tier_ms.size(); tier++) {
+            report.ai_tier_ms[tier] += stats->getAITierTime(tier);
+        }
+        report.turns++;
+
+        if (ecs_world->isPlayerDead()) {
+            report.deaths++;
+            startLevel(options.seed == 0 ? 0 : options.seed + static_cast<unsigned int>(report.levels));
+            continue;
+        }
+
+        Point moved_to(game_manager->player_x, game_manager->player_y);
+        stuck_turns = (moved_to == last_position) ? stuck_turns + 1 : 0;
+        last_position = moved_to;
+
+        start = Clock::now();
+        game_manager->updateFOV();
+        report.fov_ms += millisecondsBetween(start, Clock::now());
+    }
+    report.seconds = millisecondsBetween(run_start, Clock::now()) / 1000.0;
+
+    report.world_time = game_manager->getTurnManager()->getWorldTime();
+    report.monsters_left = 0;
+    for ([[maybe_unused]] ecs::Entity* monster : ecs_world->getWorld().view<ecs::AIComponent>()) {
+        report.monsters_left++;
+    }
+    report.systems = system_manager.getTimings();
+    for (size_t i = 0; i < report.systems.size() && i < timings_before.size(); i++) {
+        report.systems[i].total_ms -= timings_before[i].total_ms;
+        report.systems[i].calls -= timings_before[i].calls;
+    }
+    report.peak_memory_kb = getPeakMemoryKB();
+    return report;
+}
+
+void Simulation::startLevel(unsigned int seed) {
+    game_manager->setCurrentMapSeed(seed);
+    game_manager->initializeMap(options.map_type);
+    report.levels++;
+    guide.invalidate();
+    last_position = Point(game_manager->player_x, game_manager->player_y);
+    stuck_turns = 0;
+}
+
+Point Simulation::choosePlayerStep(const Point& from) {
+    const Map& map = *game_manager->getMap();
+    ecs::World& world = game_manager->getECSWorld()->getWorld();
+
+    // Fight whatever is next to us; chase whatever is in view
+    goals.clear();
+    for (ecs::Entity* monster : world.view<ecs::AIComponent, ecs::PositionComponent>()) {
+        if (!monster->hasComponent<ecs::CombatComponent>()) continue;
+        const auto* health = monster->getComponent<ecs::HealthComponent>();
+        if (health && health->isDead()) continue;
+
+        const Point& pos = monster->getComponent<ecs::PositionComponent>()->position;
+        if (std::abs(pos.x - from.x) <= 1 && std::abs(pos.y - from.y) <= 1) {
+            return pos - from;
+        }
+        if (map.isVisible(pos.x, pos.y)) {
+            goals.push_back(pos);
+        }
+    }
+
+    // Nothing in view: head for the nearest unexplored ground
+    if (goals.empty()) {
+        for (int y = 0; y < map.getHeight(); y++) {
+            for (int x = 0; x < map.getWidth(); x++) {
+                if (map.isWalkable(x, y) && !map.isExplored(x, y)) {
+                    goals.emplace_back(x, y);
+                }
+            }
+        }
+    }
+
+    if (!goals.empty() && stuck_turns < STUCK_LIMIT) {
+        guide.compute(map, goals, true);
+        Point next = guide.nextStep(from);
+        if (next != from) {
+            return next - from;
+        }
+    }
+
+    // Blocked, or nothing left to do: wander
+    stuck_turns = 0;
+    return Pathfinding::DIRECTIONS_8[rng() % 8];
+}
+
+void Simulation::watchDeaths() {
+    // Monsters only lose their AI when they are destroyed, which in play
+    // means killed; level changes clear entities without observers
+    death_observer = game_manager->getECSWorld()->getWorld().onRemove<ecs::AIComponent>(
+        [this](ecs::Entity&, ecs::AIComponent&) { report.kills++; });
+}
+
+size_t Simulation::getPeakMemoryKB() {
+#ifdef PLATFORM_WINDOWS
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize / 1024;
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef PLATFORM_MACOS
+    return static_cast<size_t>(usage.ru_maxrss) / 1024;  // bytes on macOS
+#else
+    return static_cast<size_t>(usage.ru_maxrss);         // kilobytes on Linux
+#endif
+#endif
+}
+
+std::string SimulationReport::format() const {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+    out << "Turns: " << turns << " (world time " << world_time << ") in "
+        << std::setprecision(2) << seconds << " s, " << std::setprecision(0)
+        << getTurnsPerSecond() << " turns/s\n";
+    out << "Levels: " << levels << ", deaths: " << deaths << ", monsters killed: " << kills
+        << ", monsters left: " << monsters_left << "\n";
+    out << std::setprecision(1);
+    if (peak_memory_kb > 0) {
+        out << "Peak memory: " << static_cast<double>(peak_memory_kb) / 1024.0 << " MB\n";
+    } else {
+        out << "Peak memory: unknown\n";
+    }
+
+    const double per_turn = turns > 0 ? 1.0 / turns : 0.0;
+    auto line = [&](const char* name, double ms) {
+        out << "  " << std::left << std::setw(14) << name << std::right << std::setprecision(1)
+            << std::setw(10) << ms << " ms " << std::setprecision(3) << std::setw(9)
+            << ms * per_turn << " ms/turn\n";
+    };
+    out << "Time per system:\n";
+    line("Player policy", policy_ms);
+    line("Player action", player_ms);
+    line("World turn", world_ms);
+    const char* tier_names[] = {"  AI active", "  AI nearby", "  AI distant", "  AI dormant"};
+    for (size_t tier = 0; tier < ai_tier_ms.size(); tier++) {
+        line(tier_names[tier], ai_tier_ms[tier]);
+    }
+    line("FOV", fov_ms);
+
+    out << "Time per ECS system:\n";
+    for (const ecs::SystemTiming& timing : systems) {
+        if (timing.calls > 0) {
+            line(timing.name.c_str(), timing.total_ms);
+        }
+    }
+    return out.str();
+}
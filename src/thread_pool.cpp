@@ -0,0 +1,124 @@
+#include "thread_pool.h"
+
+namespace {
+
+// Identifies the pool and queue of the current worker thread
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local size_t current_index = 0;
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t thread_count) {
+    if (thread_count == 0) {
+        thread_count = defaultThreadCount();
+    }
+
+    queues.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    workers.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i) {
+        workers.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+size_t ThreadPool::defaultThreadCount() {
+    unsigned int hardware = std::thread::hardware_concurrency();
+    return hardware > 1 ? hardware - 1 : 1;
+}
+
+void ThreadPool::submit(Task task) {
+    size_t index = (current_pool == this)
+        ? current_index
+        : next_queue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+
+    {
+        // Counted before the task is visible, so a pop or steal can never
+        // decrement first and wrap the count
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        pending.fetch_add(1, std::memory_order_release);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+
+    {
+        // Taking the lock orders the increment against a worker's
+        // check-then-sleep, so the wakeup cannot be missed
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+    }
+    wake.notify_one();
+}
+
+bool ThreadPool::runPendingTask() {
+    if (pending.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    Task task;
+    size_t start = (current_pool == this) ? current_index : 0;
+    if ((current_pool == this && popTask(start, task)) || stealTask(start, task)) {
+        task();
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    current_pool = this;
+    current_index = index;
+
+    while (true) {
+        Task task;
+        if (popTask(index, task) || stealTask(index, task)) {
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        wake.wait(lock, [this] {
+            return stopping || pending.load(std::memory_order_acquire) > 0;
+        });
+        if (stopping && pending.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::popTask(size_t index, Task& task) {
+    WorkerQueue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    pending.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+bool ThreadPool::stealTask(size_t thief, Task& task) {
+    for (size_t offset = 1; offset <= queues.size(); ++offset) {
+        WorkerQueue& queue = *queues[(thief + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            pending.fetch_sub(1, std::memory_order_acq_rel);
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file timing_wheel.cpp
+ * @brief Hierarchical timing wheel implementation
+ */
+
+#include "timing_wheel.h"
+#include <algorithm>
+#include <bit>
+
+void TimingWheel::schedule(TimerNode& node, int64_t when) {
+    if (node.linked) {
+        unlink(node);
+    }
+    node.when = when;
+    file(node);
+}
+
+void TimingWheel::cancel(TimerNode& node) {
+    if (node.linked) {
+        unlink(node);
+    }
+}
+
+TimerNode* TimingWheel::peek(int64_t until) {
+    while (count > 0) {
+        // Level 0: one slot per time unit, from now to the end of the window
+        const int now_slot = static_cast<int>(current & (SLOTS - 1));
+        if (uint64_t mask = occupied[0] & (~0ull << now_slot)) {
+            const int64_t time = (current & ~int64_t{SLOTS - 1}) | std::countr_zero(mask);
+            if (time > until) return nullptr;
+            current = time;
+            return lists[time & (SLOTS - 1)].head;
+        }
+
+        // Jump to the next busy slot above and spread it out below
+        bool cascaded = false;
+        for (int level = 1; level < LEVELS && !cascaded; level++) {
+            const int shift = SLOT_BITS * level;
+            const int level_slot = static_cast<int>((current >> shift) & (SLOTS - 1));
+            if (level_slot == SLOTS - 1) continue;
+            uint64_t mask = occupied[level] & (~0ull << (level_slot + 1));
+            if (!mask) continue;
+
+            const int slot = std::countr_zero(mask);
+            const int window = shift + SLOT_BITS;
+            const int64_t time = ((current >> window) << window) | (int64_t{slot} << shift);
+            if (time > until) return nullptr;
+            current = time;
+            cascade(static_cast<uint16_t>(level * SLOTS + slot));
+            cascaded = true;
+        }
+        if (cascaded) continue;
+
+        // Only far-future nodes left: start over from the earliest
+        const TimerNode* first = lists[OVERFLOW_BUCKET].head;
+        if (!first) return nullptr;
+        int64_t earliest = first->when;
+        for (const TimerNode* node = first->next; node; node = node->next) {
+            earliest = std::min(earliest, node->when);
+        }
+        if (earliest > until) return nullptr;
+        current = std::max(current, earliest);
+        cascade(OVERFLOW_BUCKET);
+    }
+    return nullptr;
+}
+
+TimerNode* TimingWheel::pop(int64_t until) {
+    TimerNode* node = peek(until);
+    if (node) {
+        unlink(*node);
+    }
+    return node;
+}
+
+void TimingWheel::clear(int64_t time) {
+    for (List& list : lists) {
+        for (TimerNode* node = list.head; node;) {
+            TimerNode* next = node->next;
+            node->prev = node->next = nullptr;
+            node->linked = false;
+            node = next;
+        }
+        list = {};
+    }
+    occupied = {};
+    current = time;
+    count = 0;
+}
+
+void TimingWheel::file(TimerNode& node) {
+    // Overdue nodes are filed as due now
+    const int64_t when = std::max(node.when, current);
+    for (int level = 0; level < LEVELS; level++) {
+        const int shift = SLOT_BITS * level;
+        const int window = shift + SLOT_BITS;
+        if ((when >> window) == (current >> window)) {
+            const auto slot = static_cast<uint16_t>((when >> shift) & (SLOTS - 1));
+            link(node, static_cast<uint16_t>(level * SLOTS + slot));
+            return;
+        }
+    }
+    link(node, OVERFLOW_BUCKET);
+}
+
+void TimingWheel::link(TimerNode& node, uint16_t bucket) {
+    List& list = lists[bucket];
+    node.prev = list.tail;
+    node.next = nullptr;
+    if (list.tail) {
+        list.tail->next = &node;
+    } else {
+        list.head = &node;
+    }
+    list.tail = &node;
+    node.bucket = bucket;
+    node.linked = true;
+    if (bucket != OVERFLOW_BUCKET) {
+        occupied[bucket / SLOTS] |= 1ull << (bucket % SLOTS);
+    }
+    count++;
+}
+
+void TimingWheel::unlink(TimerNode& node) {
+    List& list = lists[node.bucket];
+    (node.prev ? node.prev->next : list.head) = node.next;
+    (node.next ? node.next->prev : list.tail) = node.prev;
+    node.prev = node.next = nullptr;
+    node.linked = false;
+    if (!list.head && node.bucket != OVERFLOW_BUCKET) {
+        occupied[node.bucket / SLOTS] &= ~(1ull << (node.bucket % SLOTS));
+    }
+    count--;
+}
+
+void TimingWheel::cascade(uint16_t bucket) {
+    List& list = lists[bucket];
+    TimerNode* node = list.head;
+    list = {};
+    if (bucket != OVERFLOW_BUCKET) {
+        occupied[bucket / SLOTS] &= ~(1ull << (bucket % SLOTS));
+    }
+
+    // Refiled in list order, so equal times keep their FIFO order
+    while (node) {
+        TimerNode* next = node->next;
+        count--;
+        node->linked = false;
+        file(*node);
+        node = next;
+    }
+}
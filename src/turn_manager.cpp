@@ -1,6 +1,7 @@
 #include "turn_manager.h"
 #include "game_state.h"
 #include "log.h"
+#include <algorithm>
 #include <iostream>
 
 TurnManager::TurnManager(GameManager* gm) 
@@ -41,23 +42,35 @@ void TurnManager::executePlayerAction(ActionSpeed speed) {
 
 void TurnManager::processWorldTurn() {
     current_phase = TurnPhase::WORLD_UPDATE;
+    const int start_time = world_time;
+
+    // Everything due before the player's next action runs in time order
+    const int64_t last = static_cast<int64_t>(player_next_action_time) - 1;
+    while (true) {
+        TimerNode* actor = actor_wheel.peek(last);
+        TimerNode* action = action_wheel.peek(actor ? actor->when : last);
+        if (!action && !actor) break;
+
+        // Actions due by an actor's turn run first
+        const int64_t due = action ? action->when : actor->when;
+        world_time = std::max(world_time, static_cast<int>(due));
+        processScheduledActions();
+        runActors();
+    }
 
     // Advance time to next player action
     int time_to_advance = player_next_action_time - world_time;
     if (time_to_advance > 0) {
         advanceTime(time_to_advance);
-        Log::turn("Advanced world time by " + std::to_string(time_to_advance) +
+    }
+    if (world_time > start_time) {
+        Log::turn("Advanced world time by " + std::to_string(world_time - start_time) +
                   " to " + std::to_string(world_time));
     }
 
     // Process any scheduled actions that are due
     processScheduledActions();
 
-    // Update monsters
-    if (game_manager) {
-        game_manager->updateMonsters();
-    }
-
     endTurn();
 }
 
@@ -73,16 +86,108 @@ void TurnManager::endTurn() {
     }
 }
 
-void TurnManager::scheduleAction(int delay, std::function<void()> action) {
-    action_queue.push({world_time + delay, action});
+void TurnManager::scheduleAction(int delay, ActionCallback callback, void* context) {
+    ScheduledAction* action;
+    if (free_actions.empty()) {
+        action = &action_pool.emplace_back();
+    } else {
+        action = free_actions.back();
+        free_actions.pop_back();
+    }
+    action->callback = callback;
+    action->context = context;
+    action_wheel.schedule(*action, world_time + delay);
 }
 
 void TurnManager::processScheduledActions() {
-    while (!action_queue.empty() && 
-           action_queue.top().executionTime <= world_time) {
-        auto scheduled = action_queue.top();
-        action_queue.pop();
-        scheduled.action();
+    while (TimerNode* node = action_wheel.pop(world_time)) {
+        auto* scheduled = static_cast<ScheduledAction*>(node);
+        ActionCallback callback = scheduled->callback;
+        void* context = scheduled->context;
+        // Recycled before running, so the callback may schedule again
+        free_actions.push_back(scheduled);
+        if (callback) {
+            callback(context);
+        }
+    }
+}
+
+void TurnManager::addActor(ecs::EntityID id, int speed) {
+    if (ScheduledActor* actor = findActor(id)) {
+        actor->speed = std::clamp(speed, MIN_SPEED, MAX_SPEED);
+        return;
+    }
+
+    const uint32_t index = ecs::entityIndex(id);
+    if (index >= actors.size()) {
+        actors.resize(index + 1);  // grows at the back: existing actors stay put
+    }
+    ScheduledActor& actor = actors[index];
+    if (actor.id != ecs::INVALID_ENTITY_ID) {
+        // A stale occupant of the slot (its entity is gone)
+        actor_wheel.cancel(actor);
+        actor_count--;
+    }
+    actor.id = id;
+    actor.speed = std::clamp(speed, MIN_SPEED, MAX_SPEED);
+    actor.carry = 0;
+    actor_wheel.schedule(actor, world_time);
+    actor_count++;
+}
+
+void TurnManager::removeActor(ecs::EntityID id) {
+    if (ScheduledActor* actor = findActor(id)) {
+        actor_wheel.cancel(*actor);
+        actor->id = ecs::INVALID_ENTITY_ID;
+        actor_count--;
+    }
+}
+
+void TurnManager::clearActors() {
+    actor_wheel.clear(world_time);
+    actors.clear();
+    actor_count = 0;
+}
+
+void TurnManager::setActorSpeed(ecs::EntityID id, int speed) {
+    if (ScheduledActor* actor = findActor(id)) {
+        actor->speed = std::clamp(speed, MIN_SPEED, MAX_SPEED);
+    }
+}
+
+ScheduledActor* TurnManager::findActor(ecs::EntityID id) {
+    const uint32_t index = ecs::entityIndex(id);
+    if (id == ecs::INVALID_ENTITY_ID || index >= actors.size() || actors[index].id != id) {
+        return nullptr;
+    }
+    return &actors[index];
+}
+
+const ScheduledActor* TurnManager::findActor(ecs::EntityID id) const {
+    return const_cast<TurnManager*>(this)->findActor(id);
+}
+
+void TurnManager::runActors() {
+    ready_actors.clear();
+    while (TimerNode* node = actor_wheel.pop(world_time)) {
+        ready_actors.push_back(static_cast<ScheduledActor*>(node)->id);
+    }
+    if (ready_actors.empty()) return;
+
+    if (actor_handler) {
+        actor_handler(actor_context, ready_actors);
+    } else if (game_manager) {
+        game_manager->updateMonsters(ready_actors);
+    }
+
+    // Monster actions cost a normal action, stretched or shrunk by speed
+    const int energy = getActionCost(ActionSpeed::NORMAL) * NORMAL_SPEED;
+    for (ecs::EntityID id : ready_actors) {
+        ScheduledActor* actor = findActor(id);
+        if (!actor || actor->linked) continue;  // removed or re-added while acting
+        const int total = energy + actor->carry;
+        actor->carry = total % actor->speed;
+        actor_wheel.schedule(*actor, world_time + std::max(1, total / actor->speed));
     }
 }
 
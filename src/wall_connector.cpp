@@ -12,23 +12,39 @@ void WallConnector::setUnicodeEnabled(bool enabled) {
 }
 
 bool WallConnector::hasWallNorth(const Map& map, int x, int y) {
-    return map.getTile(x, y - 1) == TileType::WALL || 
-           map.getTile(x, y - 1) == TileType::DOOR_CLOSED;
+    return map.getWallBits().test(x, y - 1);
 }
 
 bool WallConnector::hasWallSouth(const Map& map, int x, int y) {
-    return map.getTile(x, y + 1) == TileType::WALL || 
-           map.getTile(x, y + 1) == TileType::DOOR_CLOSED;
+    return map.getWallBits().test(x, y + 1);
 }
 
 bool WallConnector::hasWallEast(const Map& map, int x, int y) {
-    return map.getTile(x + 1, y) == TileType::WALL || 
-           map.getTile(x + 1, y) == TileType::DOOR_CLOSED;
+    return map.getWallBits().test(x + 1, y);
 }
 
 bool WallConnector::hasWallWest(const Map& map, int x, int y) {
-    return map.getTile(x - 1, y) == TileType::WALL || 
-           map.getTile(x - 1, y) == TileType::DOOR_CLOSED;
+    return map.getWallBits().test(x - 1, y);
+}
+
+void WallConnector::computeConnectionMasks(const Map& map, std::vector<uint8_t>& masks) {
+    const Bitboard& walls = map.getWallBits();
+    const size_t width = static_cast<size_t>(map.getWidth());
+    masks.assign(width * map.getHeight(), 0);
+
+    // One shifted layer per direction, ANDed with the walls a word at a
+    // time; only the surviving bits are visited
+    auto addConnections = [&](int dx, int dy, uint8_t bit) {
+        Bitboard connected = walls.neighbor(dx, dy);
+        connected &= walls;
+        connected.forEach([&](int x, int y) {
+            masks[static_cast<size_t>(y) * width + x] |= bit;
+        });
+    };
+    addConnections(0, -1, CONNECT_NORTH);
+    addConnections(0, 1, CONNECT_SOUTH);
+    addConnections(1, 0, CONNECT_EAST);
+    addConnections(-1, 0, CONNECT_WEST);
 }
 
 char WallConnector::getASCIIWall(bool /*n*/, bool /*s*/, bool /*e*/, bool /*w*/) {
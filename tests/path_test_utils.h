@@ -0,0 +1,52 @@
+/**
+ * @file path_test_utils.h
+ * @brief Helpers shared by the pathfinding tests
+ * @author Veyrm Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include <catch2/catch_test_macros.hpp>
+#include "map.h"
+#include "point.h"
+#include <cstdlib>
+#include <vector>
+
+/**
+ * @brief Collect every walkable tile of a map
+ * @param map Map to scan
+ * @return Walkable tiles in row-major order
+ */
+inline std::vector<Point> walkableTiles(const Map& map) {
+    std::vector<Point> tiles;
+    for (int y = 0; y < map.getHeight(); y++) {
+        for (int x = 0; x < map.getWidth(); x++) {
+            if (map.isWalkable(x, y)) tiles.emplace_back(x, y);
+        }
+    }
+    return tiles;
+}
+
+/**
+ * @brief Check that a path is cardinal moves onto walkable tiles ending at goal
+ * @tparam Path Step sequence with size() and operator[] (e.g. SharedPath)
+ * @param start Tile the path leaves from (not part of the path)
+ * @param goal Tile the path must end on
+ * @param path Steps to check
+ * @param map Map the path runs through
+ */
+template<typename Path>
+void requireValidPath(const Point& start, const Point& goal, const Path& path, const Map& map) {
+    Point prev = start;
+    for (size_t i = 0; i < path.size(); i++) {
+        const Point& p = path[i];
+        REQUIRE(map.isWalkable(p.x, p.y));
+        REQUIRE(std::abs(p.x - prev.x) + std::abs(p.y - prev.y) == 1);
+        prev = p;
+    }
+    REQUIRE(prev == goal);
+    if (!path.empty()) {
+        REQUIRE(path.back() == goal);
+    }
+}
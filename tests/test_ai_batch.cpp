@@ -0,0 +1,217 @@
+#include <catch2/catch_test_macros.hpp>
+#include "map.h"
+#include "map_generator.h"
+#include "path_test_utils.h"
+#include "../include/ecs/ai_system.h"
+#include "../include/ecs/combat_component.h"
+#include "../include/ecs/combat_system.h"
+#include "../include/ecs/health_component.h"
+#include "../include/ecs/movement_system.h"
+#include "../include/ecs/spatial_index.h"
+#include "../include/ecs/system_manager.h"
+#include <chrono>
+#include <random>
+
+using namespace ecs;
+
+namespace {
+
+// An open room with the player in the middle
+struct Arena {
+    Map map{30, 15};
+    World world;
+    MovementSystem& movement;
+    CombatSystem combat{nullptr};
+    AISystem ai_system;
+    Entity* player;
+
+    Arena()
+        : movement(world.registerSystem<MovementSystem>(&map))
+        , ai_system(&map, &movement, &combat, nullptr) {
+        map.fill(TileType::WALL);
+        for (int y = 1; y < map.getHeight() - 1; y++) {
+            for (int x = 1; x < map.getWidth() - 1; x++) {
+                map.setTile(x, y, TileType::FLOOR);
+            }
+        }
+        movement.setWorld(&world);
+        ai_system.setWorld(&world);
+        player = &world.createEntity();
+        player->addComponent<PositionComponent>(15, 7);
+        ai_system.setPlayerId(player->getID());
+    }
+
+    Entity& addMonster(int x, int y, AIBehavior behavior) {
+        Entity& monster = world.createEntity();
+        monster.addComponent<PositionComponent>(x, y);
+        monster.addComponent<AIComponent>().behavior = behavior;
+        return monster;
+    }
+
+    void turn() {
+        ai_system.update(world, 0.0);
+        movement.update(world.getEntities(), 0.0);
+    }
+
+    static Point at(Entity& entity) { return entity.getComponent<PositionComponent>()->position; }
+};
+
+} // namespace
+
+TEST_CASE("AISystem: Behaviour passes", "[ai][batch]") {
+    Arena arena;
+
+    SECTION("Aggressive monsters close in, then attack") {
+        Entity& orc = arena.addMonster(11, 7, AIBehavior::AGGRESSIVE);
+        arena.turn();
+        REQUIRE(Arena::at(orc) == Point(12, 7));
+        REQUIRE(orc.getComponent<AIComponent>()->has_seen_player);
+        REQUIRE(orc.getComponent<AIComponent>()->target_id == arena.player->getID());
+
+        arena.turn();
+        arena.turn();
+        REQUIRE(Arena::at(orc) == Point(14, 7));
+        arena.turn();  // adjacent: attacks instead of stepping
+        REQUIRE(Arena::at(orc) == Point(14, 7));
+    }
+
+    SECTION("Wounded defenders back off, healthy ones close in") {
+        Entity& wounded = arena.addMonster(17, 7, AIBehavior::DEFENSIVE);
+        wounded.addComponent<HealthComponent>(10, 2);
+        Entity& healthy = arena.addMonster(15, 11, AIBehavior::DEFENSIVE);
+        healthy.addComponent<HealthComponent>(10);
+        healthy.getComponent<AIComponent>()->aggro_range = 4;
+
+        arena.turn();
+        Point retreat = Arena::at(wounded);
+        REQUIRE(std::abs(retreat.x - 15) + std::abs(retreat.y - 7) == 3);
+        REQUIRE(Arena::at(healthy) == Point(15, 10));
+    }
+
+    SECTION("Defenders without health do nothing") {
+        Entity& statue = arena.addMonster(16, 8, AIBehavior::DEFENSIVE);
+        arena.turn();
+        REQUIRE(Arena::at(statue) == Point(16, 8));
+    }
+
+    SECTION("Fleeing monsters calm down once far away") {
+        Entity& coward = arena.addMonster(28, 13, AIBehavior::FLEEING);
+        coward.getComponent<AIComponent>()->vision_range = 4;
+        arena.turn();
+        REQUIRE(coward.getComponent<AIComponent>()->behavior == AIBehavior::DEFENSIVE);
+    }
+
+    SECTION("Passive monsters are gathered but stay put") {
+        Entity& mushroom = arena.addMonster(14, 7, AIBehavior::PASSIVE);
+        arena.turn();
+        REQUIRE(arena.ai_system.getAwakeCount() == 1);
+        REQUIRE(Arena::at(mushroom) == Point(14, 7));
+    }
+}
+
+TEST_CASE("AISystem: Moves keep entity order across behaviours", "[ai][batch]") {
+    // A patrolling guard (created first) and a chaser want the same tile;
+    // the chaser's bucket runs first but the guard still moves first
+    Arena arena;
+    Entity& guard = arena.addMonster(10, 6, AIBehavior::PATROL);
+    guard.addComponent<CombatComponent>();
+    auto& patrol = *guard.getComponent<AIComponent>();
+    patrol.patrol_points = {Point(10, 7), Point(10, 6)};
+    Entity& chaser = arena.addMonster(9, 7, AIBehavior::AGGRESSIVE);
+    chaser.addComponent<CombatComponent>();
+    chaser.getComponent<AIComponent>()->vision_range = 10;
+
+    arena.turn();
+    REQUIRE(Arena::at(guard) == Point(10, 7));
+    REQUIRE(Arena::at(chaser) == Point(9, 7));
+}
+
+TEST_CASE("AISystem: Per-monster dispatch matches the passes", "[ai][batch]") {
+    auto run = [](bool batched) {
+        Arena arena;
+        arena.ai_system.setBatched(batched);
+        Entity& guard = arena.addMonster(10, 6, AIBehavior::PATROL);
+        guard.addComponent<CombatComponent>();
+        guard.getComponent<AIComponent>()->patrol_points = {Point(10, 7), Point(10, 6)};
+        Entity& chaser = arena.addMonster(9, 7, AIBehavior::AGGRESSIVE);
+        chaser.addComponent<CombatComponent>();
+        chaser.getComponent<AIComponent>()->vision_range = 10;
+        Entity& healthy = arena.addMonster(15, 11, AIBehavior::DEFENSIVE);
+        healthy.addComponent<HealthComponent>(10);
+        healthy.getComponent<AIComponent>()->aggro_range = 4;
+
+        std::vector<Point> trail;
+        for (int t = 0; t < 4; t++) {
+            arena.turn();
+            for (Entity* entity : {&guard, &chaser, &healthy}) {
+                trail.push_back(Arena::at(*entity));
+            }
+        }
+        return trail;
+    };
+
+    REQUIRE(run(false) == run(true));
+}
+
+TEST_CASE("AISystem: Nothing acts without a player", "[ai][batch]") {
+    Arena arena;
+    Entity& orc = arena.addMonster(11, 7, AIBehavior::WANDERING);
+    arena.ai_system.setPlayerId(0);
+    for (int t = 0; t < 5; t++) {
+        arena.turn();
+    }
+    REQUIRE(Arena::at(orc) == Point(11, 7));
+    REQUIRE(arena.ai_system.getAwakeCount() == 0);
+}
+
+TEST_CASE("AISystem: Batched update benchmark", "[ai][batch][!benchmark][.]") {
+    using Clock = std::chrono::steady_clock;
+    constexpr int TURNS = 50;
+
+    Map map(198, 66);
+    MapGenerator::generate(map, MapType::PROCEDURAL, 4242);
+    std::vector<Point> tiles = walkableTiles(map);
+
+    // Per-monster dispatch is the pre-batching loop, run at the same sizes
+    for (bool batched : {false, true})
+    for (int monsters : {500, 2000, 8000}) {
+        // Blocking checks go through the tile index, as in GameWorld
+        SpatialIndex spatial(map.getWidth(), map.getHeight());
+        World world;
+        world.getComponentStorage().addListener(componentTypeId<PositionComponent>(), &spatial);
+        auto& movement = world.registerSystem<MovementSystem>(&map);
+        movement.setWorld(&world);
+        movement.setSpatialIndex(&spatial);
+        AISystem ai_system(&map, &movement, nullptr, nullptr);
+        ai_system.setWorld(&world);
+        ai_system.setLevelOfDetail(false);  // everyone awake
+        ai_system.setBatched(batched);
+
+        std::mt19937 rng(7);
+        Entity& player = world.createEntity();
+        player.addComponent<PositionComponent>(tiles[0].x, tiles[0].y);
+        ai_system.setPlayerId(player.getID());
+        const AIBehavior behaviors[] = {AIBehavior::WANDERING, AIBehavior::AGGRESSIVE,
+                                        AIBehavior::DEFENSIVE, AIBehavior::PATROL};
+        for (int i = 0; i < monsters; i++) {
+            Entity& monster = world.createEntity();
+            Point p = tiles[rng() % tiles.size()];
+            monster.addComponent<PositionComponent>(p.x, p.y);
+            monster.addComponent<HealthComponent>(10);
+            monster.addComponent<AIComponent>().behavior = behaviors[i % 4];
+        }
+
+        // Only the AI update is timed; moves are applied between turns
+        Clock::duration elapsed{};
+        for (int t = 0; t < TURNS; t++) {
+            auto start = Clock::now();
+            ai_system.update(world, 0.0);
+            elapsed += Clock::now() - start;
+            movement.update(world.getEntities(), 0.0);
+        }
+        double ms = std::chrono::duration<double, std::milli>(elapsed).count() / TURNS;
+        WARN((batched ? "batched, " : "per-monster, ") << monsters << " awake monsters: "
+             << ms << " ms/turn, " << ms * 1000.0 / monsters << " us/monster");
+        REQUIRE(ai_system.getAwakeCount() == static_cast<size_t>(monsters));
+    }
+}
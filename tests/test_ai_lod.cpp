@@ -0,0 +1,215 @@
+#include <catch2/catch_test_macros.hpp>
+#include "map.h"
+#include "map_generator.h"
+#include "frame_stats.h"
+#include "path_test_utils.h"
+#include "../include/ecs/ai_system.h"
+#include "../include/ecs/movement_system.h"
+#include "../include/ecs/system_manager.h"
+#include <chrono>
+#include <random>
+
+using namespace ecs;
+
+namespace {
+
+// A long east-west hall; a closed door at x = 5 seals off the far west end
+void buildHall(Map& map) {
+    map.fill(TileType::WALL);
+    for (int x = 1; x < map.getWidth() - 1; x++) {
+        map.setTile(x, 2, TileType::FLOOR);
+    }
+    map.setTile(5, 2, TileType::DOOR_CLOSED);
+}
+
+struct Hall {
+    Map map{200, 5};
+    World world;
+    MovementSystem& movement;
+    AISystem ai_system;
+
+    Hall()
+        : movement(world.registerSystem<MovementSystem>(&map))
+        , ai_system(&map, &movement, nullptr, nullptr) {
+        buildHall(map);
+        movement.setWorld(&world);
+        ai_system.setWorld(&world);
+        Entity& player = world.createEntity();
+        player.addComponent<PositionComponent>(10, 2);
+        ai_system.setPlayerId(player.getID());
+    }
+
+    AIComponent& addMonster(int x, AIBehavior behavior = AIBehavior::WANDERING) {
+        Entity& monster = world.createEntity();
+        monster.addComponent<PositionComponent>(x, 2);
+        auto& ai = monster.addComponent<AIComponent>();
+        ai.behavior = behavior;
+        ai.vision_range = 4;
+        return ai;
+    }
+};
+
+} // namespace
+
+TEST_CASE("AILevelOfDetail: Tiers and schedules", "[ai][lod]") {
+    REQUIRE(AILevelOfDetail::classify(0) == AITier::ACTIVE);
+    REQUIRE(AILevelOfDetail::classify(AILevelOfDetail::ACTIVE_STEPS) == AITier::ACTIVE);
+    REQUIRE(AILevelOfDetail::classify(AILevelOfDetail::ACTIVE_STEPS + 1) == AITier::NEARBY);
+    REQUIRE(AILevelOfDetail::classify(AILevelOfDetail::NEARBY_STEPS + 1) == AITier::DISTANT);
+    REQUIRE(AILevelOfDetail::classify(AILevelOfDetail::DISTANT_STEPS + 1) == AITier::DORMANT);
+    REQUIRE(AILevelOfDetail::classify(-1) == AITier::DORMANT);
+
+    // Every monster of a tier acts exactly once per period, staggered by ID
+    for (AITier tier : {AITier::ACTIVE, AITier::NEARBY, AITier::DISTANT, AITier::DORMANT}) {
+        const int period = AILevelOfDetail::getPeriod(tier);
+        for (EntityID id = 1; id < 40; id++) {
+            int due = 0;
+            for (uint64_t turn = 0; turn < static_cast<uint64_t>(period); turn++) {
+                due += AILevelOfDetail::isDue(tier, id, turn);
+            }
+            REQUIRE(due == 1);
+        }
+    }
+}
+
+TEST_CASE("AISystem: Monsters are tiered by walking distance", "[ai][lod]") {
+    Hall hall;
+    AIComponent& near = hall.addMonster(20);
+    AIComponent& nearby = hall.addMonster(40);
+    AIComponent& distant = hall.addMonster(80);
+    AIComponent& dormant = hall.addMonster(150);
+    AIComponent& sealed = hall.addMonster(2);  // four tiles away, behind the door
+
+    hall.ai_system.update(hall.world, 0.0);
+    REQUIRE(near.tier == AITier::ACTIVE);
+    REQUIRE(nearby.tier == AITier::NEARBY);
+    REQUIRE(distant.tier == AITier::DISTANT);
+    REQUIRE(dormant.tier == AITier::DORMANT);
+    REQUIRE(sealed.tier == AITier::DORMANT);
+
+    const AITierStats& stats = hall.ai_system.getTierStats();
+    REQUIRE(stats.count(AITier::ACTIVE) == 1);
+    REQUIRE(stats.count(AITier::NEARBY) == 1);
+    REQUIRE(stats.count(AITier::DISTANT) == 1);
+    REQUIRE(stats.count(AITier::DORMANT) == 2);
+
+    SECTION("Without level of detail everything is active") {
+        hall.ai_system.setLevelOfDetail(false);
+        hall.ai_system.update(hall.world, 0.0);
+        REQUIRE(dormant.tier == AITier::ACTIVE);
+        REQUIRE(sealed.tier == AITier::ACTIVE);
+    }
+
+    SECTION("Opening the door brings the sealed monster close") {
+        hall.map.setTile(5, 2, TileType::DOOR_OPEN);
+        hall.ai_system.update(hall.world, 0.0);
+        REQUIRE(sealed.tier == AITier::ACTIVE);
+    }
+
+    SECTION("Stats reach the frame stats") {
+        FrameStats frame;
+        for (size_t tier = 0; tier < AI_TIER_COUNT; tier++) {
+            frame.recordAITier(tier, stats.counts[tier], stats.time_ms[tier]);
+        }
+        REQUIRE(frame.getAITierCount(3) == 2);
+        REQUIRE(frame.formatDetailed().find("AI tiers: 1/1/1/2") != std::string::npos);
+    }
+}
+
+TEST_CASE("AISystem: Distant monsters promote at once", "[ai][lod]") {
+    Hall hall;
+    AIComponent& hunter = hall.addMonster(150, AIBehavior::AGGRESSIVE);
+    AIComponent& listener = hall.addMonster(120);
+
+    hall.ai_system.update(hall.world, 0.0);
+    REQUIRE(hunter.tier == AITier::DORMANT);
+    REQUIRE(listener.tier == AITier::DORMANT);
+
+    SECTION("Hunting a remembered position") {
+        hunter.has_seen_player = true;
+        hunter.last_player_position = Point(140, 2);
+        hall.ai_system.update(hall.world, 0.0);
+        REQUIRE(hunter.tier == AITier::ACTIVE);
+    }
+
+    SECTION("Hearing a noise") {
+        hall.ai_system.makeNoise(Point(115, 2), 6);
+        hall.ai_system.update(hall.world, 0.0);
+        REQUIRE(listener.tier == AITier::ACTIVE);
+        REQUIRE(hunter.tier == AITier::DORMANT);
+
+        // Noises are heard once
+        hall.ai_system.update(hall.world, 0.0);
+        REQUIRE(listener.tier == AITier::DORMANT);
+    }
+}
+
+TEST_CASE("AISystem: Lower tiers act every few turns", "[ai][lod]") {
+    Hall hall;
+    hall.addMonster(35);
+    hall.addMonster(36);
+    hall.addMonster(70);
+    hall.addMonster(71);
+
+    int nearby_updates = 0;
+    int distant_updates = 0;
+    const int turns = 2 * AILevelOfDetail::DISTANT_PERIOD;
+    for (int turn = 0; turn < turns; turn++) {
+        hall.ai_system.update(hall.world, 0.0);
+        hall.movement.update(hall.world.getEntities(), 0.0);
+        const AITierStats& stats = hall.ai_system.getTierStats();
+        nearby_updates += stats.updated[static_cast<size_t>(AITier::NEARBY)];
+        distant_updates += stats.updated[static_cast<size_t>(AITier::DISTANT)];
+    }
+    // Drifting a few steps never changes their tier here
+    REQUIRE(nearby_updates == 2 * turns / AILevelOfDetail::NEARBY_PERIOD);
+    REQUIRE(distant_updates == 2 * turns / AILevelOfDetail::DISTANT_PERIOD);
+}
+
+TEST_CASE("AISystem: Level of detail benchmark", "[ai][lod][!benchmark][.]") {
+    using Clock = std::chrono::steady_clock;
+    constexpr int MONSTERS = 1000;
+    constexpr int TURNS = 50;
+
+    Map map(198, 66);
+    MapGenerator::generate(map, MapType::PROCEDURAL, 4242);
+    std::vector<Point> tiles = walkableTiles(map);
+
+    auto run = [&](bool lod, AITierStats& last) {
+        World world;
+        auto& movement = world.registerSystem<MovementSystem>(&map);
+        movement.setWorld(&world);
+        AISystem ai_system(&map, &movement, nullptr, nullptr);
+        ai_system.setWorld(&world);
+        ai_system.setLevelOfDetail(lod);
+
+        std::mt19937 rng(7);
+        Entity& player = world.createEntity();
+        player.addComponent<PositionComponent>(tiles[0].x, tiles[0].y);
+        ai_system.setPlayerId(player.getID());
+        for (int i = 0; i < MONSTERS; i++) {
+            Entity& monster = world.createEntity();
+            Point p = tiles[rng() % tiles.size()];
+            monster.addComponent<PositionComponent>(p.x, p.y);
+            auto& ai = monster.addComponent<AIComponent>();
+            ai.behavior = i % 2 ? AIBehavior::WANDERING : AIBehavior::PATROL;
+        }
+
+        auto start = Clock::now();
+        for (int t = 0; t < TURNS; t++) {
+            ai_system.update(world, 0.0);
+            movement.update(world.getEntities(), 0.0);
+        }
+        last = ai_system.getTierStats();
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count() / TURNS;
+    };
+
+    AITierStats full_stats;
+    AITierStats lod_stats;
+    double full = run(false, full_stats);
+    double lod = run(true, lod_stats);
+    WARN(MONSTERS << " monsters: full AI " << full << " ms/turn, level of detail " << lod << " ms/turn ("
+         << lod_stats.counts[0] << " active, " << lod_stats.counts[1] << " nearby, " << lod_stats.counts[2]
+         << " distant, " << lod_stats.counts[3] << " dormant)");
+    REQUIRE(lod_stats.count(AITier::DORMANT) > 0);
+}
@@ -0,0 +1,327 @@
+#include <catch2/catch_test_macros.hpp>
+#include "bitboard.h"
+#include "map.h"
+#include "map_generator.h"
+#include "map_validator.h"
+#include "wall_connector.h"
+#include <algorithm>
+#include <chrono>
+#include <queue>
+
+namespace {
+
+// Reference 4-connected flood fill over the walkable tiles
+std::vector<bool> bfsRegion(const Map& map, const Point& seed) {
+    std::vector<bool> seen(static_cast<size_t>(map.getWidth()) * map.getHeight(), false);
+    if (!map.isWalkable(seed.x, seed.y)) return seen;
+
+    std::queue<Point> open;
+    open.push(seed);
+    seen[static_cast<size_t>(seed.y) * map.getWidth() + seed.x] = true;
+    const int dx[] = {1, -1, 0, 0};
+    const int dy[] = {0, 0, 1, -1};
+    while (!open.empty()) {
+        Point p = open.front();
+        open.pop();
+        for (int i = 0; i < 4; i++) {
+            int nx = p.x + dx[i];
+            int ny = p.y + dy[i];
+            if (!map.isWalkable(nx, ny)) continue;
+            size_t idx = static_cast<size_t>(ny) * map.getWidth() + nx;
+            if (!seen[idx]) {
+                seen[idx] = true;
+                open.push(Point(nx, ny));
+            }
+        }
+    }
+    return seen;
+}
+
+void requireSameRegion(const Map& map, const Point& seed) {
+    Bitboard region = map.getWalkableBits().floodFill(seed);
+    std::vector<bool> expected = bfsRegion(map, seed);
+    size_t expected_count = 0;
+    for (int y = 0; y < map.getHeight(); y++) {
+        for (int x = 0; x < map.getWidth(); x++) {
+            bool want = expected[static_cast<size_t>(y) * map.getWidth() + x];
+            expected_count += want;
+            REQUIRE(region.test(x, y) == want);
+        }
+    }
+    REQUIRE(region.count() == expected_count);
+}
+
+bool isWallTile(const Map& map, int x, int y) {
+    return map.inBounds(x, y) && Map::isWallLike(map.getTile(x, y));
+}
+
+// Grid of rooms joined by corridors, for maps larger than the generators make
+void buildRoomGrid(Map& map, int spacing) {
+    map.fill(TileType::WALL);
+    for (int y = 1; y + spacing < map.getHeight(); y += spacing) {
+        for (int x = 1; x + spacing < map.getWidth(); x += spacing) {
+            Room room(x, y, spacing - 4, spacing - 4);
+            MapGenerator::carveRoom(map, room);
+            if (x + 2 * spacing < map.getWidth()) {
+                MapGenerator::carveCorridorL(map, room.center(), Point(room.center().x + spacing, room.center().y));
+            }
+            if (y + 2 * spacing < map.getHeight()) {
+                MapGenerator::carveCorridorL(map, room.center(), Point(room.center().x, room.center().y + spacing));
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("Bitboard: Basic bit operations", "[bitboard]") {
+    Bitboard bits(130, 3);
+    REQUIRE(bits.getWordsPerRow() == 3);
+    REQUIRE(bits.none());
+    REQUIRE(bits.findFirst() == Point(-1, -1));
+
+    bits.set(129, 2);
+    bits.set(64, 1);
+    bits.set(0, 0);
+    bits.set(130, 0);  // out of bounds, ignored
+    REQUIRE(bits.count() == 3);
+    REQUIRE(bits.test(129, 2));
+    REQUIRE(bits.test(64, 1));
+    REQUIRE_FALSE(bits.test(63, 1));
+    REQUIRE_FALSE(bits.test(-1, 0));
+    REQUIRE(bits.findFirst() == Point(0, 0));
+
+    bits.set(0, 0, false);
+    REQUIRE(bits.findFirst() == Point(64, 1));
+
+    SECTION("Fill leaves padding clear") {
+        bits.fill(true);
+        REQUIRE(bits.count() == 130u * 3u);
+        REQUIRE((bits.row(0)[2] >> 2) == 0);
+        bits.fill(false);
+        REQUIRE(bits.none());
+    }
+
+    SECTION("Set operations") {
+        Bitboard other(130, 3);
+        other.set(64, 1);
+        other.set(5, 0);
+
+        Bitboard both = bits;
+        both &= other;
+        REQUIRE(both.count() == 1);
+        REQUIRE(both.test(64, 1));
+
+        Bitboard either = bits;
+        either |= other;
+        REQUIRE(either.count() == 3);
+
+        Bitboard only = bits;
+        only.andNot(other);
+        REQUIRE(only.count() == 1);
+        REQUIRE(only.test(129, 2));
+        REQUIRE_FALSE(only == bits);
+    }
+}
+
+TEST_CASE("Bitboard: Neighbour layers shift across words", "[bitboard]") {
+    Bitboard bits(130, 3);
+    for (int x : {0, 63, 64, 127, 128, 129}) {
+        bits.set(x, 1);
+    }
+
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            Bitboard shifted = bits.neighbor(dx, dy);
+            for (int y = 0; y < 3; y++) {
+                for (int x = 0; x < 130; x++) {
+                    REQUIRE(shifted.test(x, y) == bits.test(x + dx, y + dy));
+                }
+            }
+            // Nothing may leak into the row padding
+            for (int y = 0; y < 3; y++) {
+                REQUIRE((shifted.row(y)[2] >> 2) == 0);
+            }
+        }
+    }
+}
+
+TEST_CASE("Bitboard: Flood fill matches BFS", "[bitboard]") {
+    SECTION("Generated maps") {
+        for (MapType type : {MapType::PROCEDURAL, MapType::TEST_DUNGEON, MapType::STRESS_TEST}) {
+            Map map(198, 66);
+            MapGenerator::generate(map, type, 4242);
+            requireSameRegion(map, MapGenerator::getDefaultSpawnPoint(map, type));
+        }
+    }
+
+    SECTION("Serpentine spanning several words per row") {
+        // Vertical walls with alternating gaps force many row sweeps
+        Map map(200, 40);
+        map.fill(TileType::FLOOR);
+        for (int x = 3; x < 200; x += 4) {
+            int gap = (x / 4) % 2 ? 0 : 39;
+            for (int y = 0; y < 40; y++) {
+                if (y != gap) map.setTile(x, y, TileType::WALL);
+            }
+        }
+        requireSameRegion(map, Point(0, 20));
+        requireSameRegion(map, Point(199, 5));
+    }
+
+    SECTION("Seed on a wall gives an empty region") {
+        Map map(10, 10);
+        map.fill(TileType::WALL);
+        REQUIRE(map.getWalkableBits().floodFill(Point(5, 5)).none());
+    }
+}
+
+TEST_CASE("Bitboard: Map layers track tile changes", "[bitboard][map]") {
+    Map map(70, 5);
+    REQUIRE(map.getWalkableBits().none());
+
+    map.fill(TileType::FLOOR);
+    REQUIRE(map.getWalkableBits().count() == 350);
+    REQUIRE(map.getTransparentBits().count() == 350);
+    REQUIRE(map.getWallBits().none());
+
+    map.setTile(65, 2, TileType::DOOR_CLOSED);
+    REQUIRE_FALSE(map.getWalkableBits().test(65, 2));
+    REQUIRE_FALSE(map.getTransparentBits().test(65, 2));
+    REQUIRE(map.getWallBits().test(65, 2));
+
+    map.setTile(65, 2, TileType::DOOR_OPEN);
+    REQUIRE(map.getWalkableBits().test(65, 2));
+    REQUIRE(map.getTransparentBits().test(65, 2));
+    REQUIRE_FALSE(map.getWallBits().test(65, 2));
+}
+
+TEST_CASE("Bitboard: Wall connection masks match per-tile checks", "[bitboard][wall]") {
+    Map map(198, 66);
+    MapGenerator::generate(map, MapType::PROCEDURAL, 99);
+
+    std::vector<uint8_t> masks;
+    WallConnector::computeConnectionMasks(map, masks);
+    REQUIRE(masks.size() == static_cast<size_t>(map.getWidth()) * map.getHeight());
+
+    for (int y = 0; y < map.getHeight(); y++) {
+        for (int x = 0; x < map.getWidth(); x++) {
+            uint8_t expected = 0;
+            if (isWallTile(map, x, y)) {
+                if (isWallTile(map, x, y - 1)) expected |= WallConnector::CONNECT_NORTH;
+                if (isWallTile(map, x, y + 1)) expected |= WallConnector::CONNECT_SOUTH;
+                if (isWallTile(map, x + 1, y)) expected |= WallConnector::CONNECT_EAST;
+                if (isWallTile(map, x - 1, y)) expected |= WallConnector::CONNECT_WEST;
+            }
+            REQUIRE(masks[static_cast<size_t>(y) * map.getWidth() + x] == expected);
+        }
+    }
+}
+
+TEST_CASE("Bitboard: Doorway candidates cover every door position", "[bitboard][generator]") {
+    Map map(198, 66);
+    MapGenerator::generate(map, MapType::PROCEDURAL, 31337);
+    Bitboard candidates = MapGenerator::findDoorwayCandidates(map);
+
+    Map probe = map;
+    for (int y = 0; y < map.getHeight(); y++) {
+        for (int x = 0; x < map.getWidth(); x++) {
+            if (map.getTile(x, y) != TileType::WALL) continue;
+            MapGenerator::checkAndPlaceDoor(probe, x, y);
+            if (probe.getTile(x, y) == TileType::DOOR_CLOSED) {
+                REQUIRE(candidates.test(x, y));
+                probe.setTile(x, y, TileType::WALL);
+            }
+        }
+    }
+}
+
+TEST_CASE("Bitboard: Validator queries", "[bitboard][validator]") {
+    Map map(140, 20);
+    map.fill(TileType::WALL);
+    MapGenerator::carveRoom(map, Room(1, 1, 10, 10));
+    MapGenerator::carveRoom(map, Room(120, 5, 10, 10));
+    REQUIRE(MapValidator::countRooms(map) == 2);
+    REQUIRE_FALSE(MapValidator::checkConnectivity(map));
+    REQUIRE_FALSE(MapValidator::isReachable(map, Point(5, 5), Point(125, 10)));
+
+    MapGenerator::carveCorridorL(map, Point(5, 5), Point(125, 10));
+    REQUIRE(MapValidator::countRooms(map) == 1);
+    REQUIRE(MapValidator::checkConnectivity(map));
+    REQUIRE(MapValidator::isReachable(map, Point(5, 5), Point(125, 10)));
+}
+
+TEST_CASE("Bitboard: Map query benchmark", "[bitboard][!benchmark][.]") {
+    constexpr int REPEATS = 20;
+    using Clock = std::chrono::steady_clock;
+    auto micros = [](Clock::time_point start) {
+        return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / REPEATS;
+    };
+
+    auto run = [&](const char* name, Map& map) {
+        Point seed = map.getWalkableBits().findFirst();
+        double tiles = static_cast<double>(map.getWidth()) * map.getHeight();
+
+        size_t bfs_count = 0;
+        auto start = Clock::now();
+        for (int i = 0; i < REPEATS; i++) {
+            std::vector<bool> region = bfsRegion(map, seed);
+            bfs_count = static_cast<size_t>(std::count(region.begin(), region.end(), true));
+        }
+        double bfs_time = micros(start);
+
+        size_t bits_count = 0;
+        start = Clock::now();
+        for (int i = 0; i < REPEATS; i++) {
+            bits_count = map.getWalkableBits().floodFill(seed).count();
+        }
+        double fill_time = micros(start);
+        REQUIRE(bits_count == bfs_count);
+
+        std::vector<uint8_t> masks;
+        start = Clock::now();
+        for (int i = 0; i < REPEATS; i++) {
+            masks.assign(static_cast<size_t>(tiles), 0);
+            for (int y = 0; y < map.getHeight(); y++) {
+                for (int x = 0; x < map.getWidth(); x++) {
+                    if (!isWallTile(map, x, y)) continue;
+                    uint8_t m = 0;
+                    if (isWallTile(map, x, y - 1)) m |= WallConnector::CONNECT_NORTH;
+                    if (isWallTile(map, x, y + 1)) m |= WallConnector::CONNECT_SOUTH;
+                    if (isWallTile(map, x + 1, y)) m |= WallConnector::CONNECT_EAST;
+                    if (isWallTile(map, x - 1, y)) m |= WallConnector::CONNECT_WEST;
+                    masks[static_cast<size_t>(y) * map.getWidth() + x] = m;
+                }
+            }
+        }
+        double scalar_mask_time = micros(start);
+
+        start = Clock::now();
+        for (int i = 0; i < REPEATS; i++) {
+            WallConnector::computeConnectionMasks(map, masks);
+        }
+        double mask_time = micros(start);
+
+        size_t doorways = 0;
+        start = Clock::now();
+        for (int i = 0; i < REPEATS; i++) {
+            doorways = MapGenerator::findDoorwayCandidates(map).count();
+        }
+        double door_time = micros(start);
+
+        WARN(name << " (SIMD " << (Bitboard::simdEnabled() ? "on" : "off") << "): "
+             << "flood fill BFS " << tiles / bfs_time << " tiles/us, bitboard "
+             << tiles / fill_time << " tiles/us; wall masks per-tile "
+             << tiles / scalar_mask_time << " tiles/us, bitboard " << tiles / mask_time
+             << " tiles/us; doorway scan " << tiles / door_time << " tiles/us ("
+             << doorways << " candidates)");
+    };
+
+    Map small(198, 66);
+    MapGenerator::generate(small, MapType::PROCEDURAL, 12345);
+    run("198x66", small);
+
+    Map large(2048, 2048);
+    buildRoomGrid(large, 32);
+    run("2048x2048", large);
+}
@@ -0,0 +1,146 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../include/ecs/system_manager.h"
+#include "../include/ecs/render_system.h"
+#include "../include/ecs/position_component.h"
+#include "../include/ecs/health_component.h"
+#include "../include/ecs/renderable_component.h"
+#include <vector>
+
+using namespace ecs;
+
+TEST_CASE("Component change ticks", "[ecs][changes]") {
+    World world;
+
+    SECTION("Changed components are visited once per capture") {
+        std::vector<EntityID> ids;
+        for (int i = 0; i < 5; ++i) {
+            Entity& entity = world.createEntity();
+            entity.addComponent<HealthComponent>(10);
+            ids.push_back(entity.getID());
+        }
+
+        uint32_t since = world.captureChangeTick();
+        int visited = 0;
+        world.eachChanged<HealthComponent>(since, [&visited](Entity&, HealthComponent&) { ++visited; });
+        REQUIRE(visited == 0);
+
+        Entity* hurt = world.getEntity(ids[2]);
+        hurt->getComponent<HealthComponent>()->hp = 4;
+        hurt->markChanged<HealthComponent>();
+
+        std::vector<EntityID> changed;
+        world.eachChanged<HealthComponent>(since, [&changed](Entity& entity, HealthComponent& health) {
+            REQUIRE(health.hp == 4);
+            changed.push_back(entity.getID());
+        });
+        REQUIRE(changed == std::vector<EntityID>{ids[2]});
+        REQUIRE(hurt->getChangedTick<HealthComponent>() > since);
+
+        since = world.captureChangeTick();
+        visited = 0;
+        world.eachChanged<HealthComponent>(since, [&visited](Entity&, HealthComponent&) { ++visited; });
+        REQUIRE(visited == 0);
+    }
+
+    SECTION("Added components count as changed but not the other way round") {
+        Entity& old_entity = world.createEntity();
+        old_entity.addComponent<PositionComponent>(1, 1);
+        uint32_t since = world.captureChangeTick();
+
+        Entity& new_entity = world.createEntity();
+        new_entity.addComponent<PositionComponent>(2, 2);
+        old_entity.markChanged<PositionComponent>();
+
+        int added = 0;
+        int changed = 0;
+        world.eachAdded<PositionComponent>(since, [&added](Entity&, PositionComponent&) { ++added; });
+        world.eachChanged<PositionComponent>(since, [&changed](Entity&, PositionComponent&) { ++changed; });
+        REQUIRE(added == 1);
+        REQUIRE(changed == 2);
+    }
+
+    SECTION("Removal marks the pool changed") {
+        Entity& entity = world.createEntity();
+        entity.addComponent<HealthComponent>(10);
+        uint32_t since = world.captureChangeTick();
+        REQUIRE_FALSE(world.anyChanged<HealthComponent>(since));
+
+        entity.removeComponent<HealthComponent>();
+        REQUIRE(world.anyChanged<HealthComponent>(since));
+    }
+
+    SECTION("Marking an absent component is a no-op") {
+        Entity& entity = world.createEntity();
+        uint32_t since = world.captureChangeTick();
+        entity.markChanged<HealthComponent>();
+        REQUIRE_FALSE(world.anyChanged<HealthComponent>(since));
+        REQUIRE(entity.getChangedTick<HealthComponent>() == 0);
+    }
+}
+
+TEST_CASE("Component observers", "[ecs][changes]") {
+    World world;
+    std::vector<std::string> seen;
+
+    world.onAdd<HealthComponent>([&seen](Entity&, HealthComponent& health) {
+        seen.push_back("add " + std::to_string(health.max_hp));
+    });
+    ComponentObserver* on_change = world.onChange<HealthComponent>([&seen](Entity&, HealthComponent& health) {
+        seen.push_back("change " + std::to_string(health.hp));
+    });
+    world.onRemove<HealthComponent>([&seen](Entity&, HealthComponent&) {
+        seen.push_back("remove");
+    });
+
+    Entity& entity = world.createEntity();
+    entity.addComponent<HealthComponent>(10);
+    entity.getComponent<HealthComponent>()->hp = 3;
+    entity.markChanged<HealthComponent>();
+    entity.addComponent<PositionComponent>(0, 0);
+    entity.markChanged<PositionComponent>();
+    entity.removeComponent<HealthComponent>();
+    REQUIRE(seen == std::vector<std::string>{"add 10", "change 3", "remove"});
+
+    SECTION("Removed observers are not called") {
+        seen.clear();
+        world.removeObserver(on_change);
+        entity.addComponent<HealthComponent>(5);
+        entity.markChanged<HealthComponent>();
+        REQUIRE(seen == std::vector<std::string>{"add 5"});
+    }
+}
+
+TEST_CASE("RenderSystem rebuilds only after changes", "[ecs][changes][render]") {
+    World world;
+    RenderSystem render;
+
+    Entity& goblin = world.createEntity();
+    goblin.addComponent<PositionComponent>(3, 4);
+    goblin.addComponent<RenderableComponent>("g", ftxui::Color::Green);
+
+    render.update(world, 0.0);
+    REQUIRE(render.getRenderData().size() == 1);
+    REQUIRE(render.getEntityAt(3, 4) != nullptr);
+
+    // Unmarked in-place writes are not picked up
+    goblin.getComponent<PositionComponent>()->moveTo(5, 4);
+    render.update(world, 0.0);
+    REQUIRE(render.getEntityAt(3, 4) != nullptr);
+
+    goblin.markChanged<PositionComponent>();
+    render.update(world, 0.0);
+    REQUIRE(render.getEntityAt(3, 4) == nullptr);
+    REQUIRE(render.getEntityAt(5, 4) != nullptr);
+
+    goblin.getComponent<RenderableComponent>()->is_visible = false;
+    goblin.markChanged<RenderableComponent>();
+    render.update(world, 0.0);
+    REQUIRE(render.getRenderData().empty());
+
+    world.removeEntity(goblin.getID());
+    Entity& orc = world.createEntity();
+    orc.addComponent<PositionComponent>(1, 1);
+    orc.addComponent<RenderableComponent>("o", ftxui::Color::Red);
+    render.update(world, 0.0);
+    REQUIRE(render.getEntityAt(1, 1) != nullptr);
+}
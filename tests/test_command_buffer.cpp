@@ -0,0 +1,125 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../include/ecs/command_buffer.h"
+#include "../include/ecs/system_manager.h"
+#include "../include/ecs/position_component.h"
+#include "../include/ecs/health_component.h"
+#include "../include/thread_pool.h"
+#include <atomic>
+
+using namespace ecs;
+
+namespace {
+
+/// Records the death of every entity at 0 hp while iterating
+class ReaperSystem : public System<ReaperSystem> {
+public:
+    void update(const std::vector<std::unique_ptr<Entity>>&, double) override {}
+
+    void update(World& world, double) override {
+        auto& commands = world.getCommandBuffer();
+        world.view<HealthComponent>().each([&commands](Entity& entity, HealthComponent& health) {
+            if (health.hp <= 0) {
+                commands.destroy(entity.getID());
+            }
+        });
+    }
+
+    bool shouldProcess(const Entity& entity) const override {
+        return entity.hasComponent<HealthComponent>();
+    }
+
+    SystemAccess getAccess() const override {
+        return SystemAccess().read<HealthComponent>();
+    }
+};
+
+} // namespace
+
+TEST_CASE("CommandBuffer defers structural changes", "[ecs][commands]") {
+    World world;
+    CommandBuffer& commands = world.getCommandBuffer();
+
+    SECTION("Nothing changes until flush") {
+        Entity& entity = world.createEntity();
+        EntityID id = entity.getID();
+
+        commands.addComponent<PositionComponent>(id, 3, 4);
+        commands.create().addComponent<HealthComponent>(5);
+        REQUIRE(commands.size() == 2);
+        REQUIRE_FALSE(entity.hasComponent<PositionComponent>());
+        REQUIRE(world.getEntityCount() == 1);
+
+        REQUIRE(world.flushCommands() == 2);
+        REQUIRE(commands.empty());
+        REQUIRE(entity.getComponent<PositionComponent>()->position.x == 3);
+        REQUIRE(world.getEntityCount() == 2);
+        REQUIRE(world.view<HealthComponent>().size() == 1);
+    }
+
+    SECTION("Staged entities can be targeted in the same batch") {
+        auto staged = std::make_unique<Entity>();
+        staged->addComponent<HealthComponent>(10);
+        EntityID id = commands.create(std::move(staged));
+
+        commands.addComponent<PositionComponent>(id, 1, 1);
+        commands.removeComponent<HealthComponent>(id);
+        world.flushCommands();
+
+        Entity* entity = world.getEntity(id);
+        REQUIRE(entity != nullptr);
+        REQUIRE(entity->hasComponent<PositionComponent>());
+        REQUIRE_FALSE(entity->hasComponent<HealthComponent>());
+    }
+
+    SECTION("Commands on destroyed entities are dropped") {
+        EntityID id = world.createEntity().getID();
+
+        commands.destroy(id);
+        commands.addComponent<PositionComponent>(id, 0, 0);
+        commands.destroy(id);
+        REQUIRE(world.flushCommands() == 1);
+        REQUIRE_FALSE(world.hasEntity(id));
+    }
+
+    SECTION("Clear discards commands") {
+        EntityID id = world.createEntity().getID();
+        commands.destroy(id);
+        commands.clear();
+        REQUIRE(world.flushCommands() == 0);
+        REQUIRE(world.hasEntity(id));
+    }
+
+    SECTION("Destroying during iteration leaves the view intact") {
+        for (int i = 0; i < 20; ++i) {
+            world.createEntity().addComponent<HealthComponent>(10, i % 2 ? 5 : 0);
+        }
+        world.registerSystem<ReaperSystem>();
+
+        world.update(0.0);
+        REQUIRE(world.getEntityCount() == 10);
+        REQUIRE(world.view<HealthComponent>().size() == 10);
+    }
+}
+
+TEST_CASE("CommandBuffer records from many threads", "[ecs][commands][threads]") {
+    World world;
+    std::vector<EntityID> ids;
+    for (int i = 0; i < 400; ++i) {
+        ids.push_back(world.createEntity().getID());
+    }
+
+    ThreadPool pool(3);
+    std::atomic<int> done{0};
+    for (int chunk = 0; chunk < 4; ++chunk) {
+        pool.submit([&world, &ids, &done, chunk] {
+            for (int i = chunk; i < 400; i += 4) {
+                world.getCommandBuffer().addComponent<PositionComponent>(ids[i], i, 0);
+            }
+            ++done;
+        });
+    }
+    pool.helpUntil([&done] { return done.load() == 4; });
+
+    REQUIRE(world.flushCommands() == 400);
+    REQUIRE(world.view<PositionComponent>().size() == 400);
+}
@@ -0,0 +1,273 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../include/ecs/entity.h"
+#include "../include/ecs/system_manager.h"
+#include "../include/ecs/component_storage.h"
+#include "../include/ecs/position_component.h"
+#include "../include/ecs/health_component.h"
+#include "../include/ecs/experience_component.h"
+#include "../include/ecs/loot_component.h"
+#include <algorithm>
+#include <vector>
+
+using namespace ecs;
+
+TEST_CASE("Component type IDs", "[ecs][storage]") {
+    SECTION("IDs are stable per class and distinct across classes") {
+        REQUIRE(componentTypeId<PositionComponent>() == componentTypeId<PositionComponent>());
+        REQUIRE(componentTypeId<PositionComponent>() != componentTypeId<HealthComponent>());
+        REQUIRE(componentTypeId<const HealthComponent>() == componentTypeId<HealthComponent>());
+    }
+
+    SECTION("Instances report their class ID") {
+        HealthComponent health(10);
+        REQUIRE(health.getTypeId() == componentTypeId<HealthComponent>());
+    }
+}
+
+TEST_CASE("Entity component slots", "[ecs][storage]") {
+    SECTION("CUSTOM components coexist") {
+        Entity entity;
+        entity.addComponent<ExperienceComponent>();
+        entity.addComponent<LootComponent>();
+
+        REQUIRE(entity.hasComponent<ExperienceComponent>());
+        REQUIRE(entity.hasComponent<LootComponent>());
+        REQUIRE(entity.getComponentCount() == 2);
+        REQUIRE(entity.getComponents().size() == 2);
+    }
+
+    SECTION("Adding same type replaces component") {
+        Entity entity;
+        entity.addComponent<HealthComponent>(10);
+        entity.addComponent<HealthComponent>(25);
+
+        REQUIRE(entity.getComponentCount() == 1);
+        REQUIRE(entity.getComponent<HealthComponent>()->max_hp == 25);
+    }
+
+    SECTION("Clone copies every component") {
+        Entity entity;
+        entity.addComponent<PositionComponent>(3, 4);
+        entity.addComponent<ExperienceComponent>();
+
+        auto copy = entity.clone();
+        REQUIRE(copy->getComponentCount() == 2);
+        REQUIRE(copy->getComponent<PositionComponent>()->position.x == 3);
+        REQUIRE(copy->getComponent<PositionComponent>() != entity.getComponent<PositionComponent>());
+    }
+}
+
+TEST_CASE("World component pools", "[ecs][storage]") {
+    World world;
+
+    SECTION("Attaching entity preserves component values") {
+        auto entity = std::make_unique<Entity>();
+        entity->addComponent<PositionComponent>(7, 9);
+        entity->addComponent<HealthComponent>(30, 12);
+
+        Entity& added = world.addEntity(std::move(entity));
+        auto* pos = added.getComponent<PositionComponent>();
+        auto* health = added.getComponent<HealthComponent>();
+
+        REQUIRE(pos != nullptr);
+        REQUIRE(pos->position.x == 7);
+        REQUIRE(pos->position.y == 9);
+        REQUIRE(health->hp == 12);
+        REQUIRE(health->max_hp == 30);
+
+        auto& pool = world.getComponentStorage().getPool<PositionComponent>();
+        REQUIRE(pool.size() == 1);
+        REQUIRE(pool.getOwners()[0] == &added);
+        REQUIRE(pool.getComponents()[0] == pos);
+    }
+
+    SECTION("Component pointers stay valid as pools grow") {
+        Entity& first = world.createEntity();
+        auto* pos = &first.addComponent<PositionComponent>(1, 2);
+
+        for (int i = 0; i < 500; ++i) {
+            world.createEntity().addComponent<PositionComponent>(i, i);
+        }
+
+        REQUIRE(first.getComponent<PositionComponent>() == pos);
+        REQUIRE(pos->position.x == 1);
+        REQUIRE(pos->position.y == 2);
+    }
+
+    SECTION("Removing entities keeps pools packed") {
+        Entity& a = world.createEntity();
+        Entity& b = world.createEntity();
+        Entity& c = world.createEntity();
+        a.addComponent<HealthComponent>(1);
+        b.addComponent<HealthComponent>(2);
+        c.addComponent<HealthComponent>(3);
+        EntityID b_id = b.getID();
+
+        auto& pool = world.getComponentStorage().getPool<HealthComponent>();
+        REQUIRE(pool.size() == 3);
+
+        REQUIRE(world.removeEntity(b_id));
+        REQUIRE(pool.size() == 2);
+        REQUIRE(a.getComponent<HealthComponent>()->max_hp == 1);
+        REQUIRE(c.getComponent<HealthComponent>()->max_hp == 3);
+
+        c.removeComponent<HealthComponent>();
+        REQUIRE(pool.size() == 1);
+        REQUIRE(pool.getOwners()[0] == &a);
+    }
+
+    SECTION("Freed slots are reused") {
+        auto& pool = world.getComponentStorage().getPool<PositionComponent>();
+
+        for (int i = 0; i < 100; ++i) {
+            Entity& entity = world.createEntity();
+            entity.addComponent<PositionComponent>(i, i);
+            world.removeEntity(entity.getID());
+        }
+
+        REQUIRE(pool.size() == 0);
+        REQUIRE(pool.capacity() == ComponentPool::PAGE_SIZE);
+    }
+}
+
+TEST_CASE("World views", "[ecs][storage][view]") {
+    World world;
+
+    SECTION("View only contains matching entities") {
+        Entity& a = world.createEntity();
+        a.addComponent<PositionComponent>(0, 0);
+        a.addComponent<HealthComponent>(10);
+        Entity& b = world.createEntity();
+        b.addComponent<PositionComponent>(1, 1);
+        world.createEntity().addComponent<HealthComponent>(5);
+
+        auto view = world.view<PositionComponent, HealthComponent>();
+        REQUIRE(view.size() == 1);
+        REQUIRE(*view.begin() == &a);
+        REQUIRE(world.view<PositionComponent>().size() == 2);
+    }
+
+    SECTION("Cached view follows component changes") {
+        auto view = world.view<PositionComponent, HealthComponent>();
+        REQUIRE(view.empty());
+
+        Entity& entity = world.createEntity();
+        entity.addComponent<PositionComponent>(2, 3);
+        REQUIRE(view.empty());
+
+        entity.addComponent<HealthComponent>(7);
+        REQUIRE(view.size() == 1);
+
+        entity.removeComponent<PositionComponent>();
+        REQUIRE(view.empty());
+
+        entity.addComponent<PositionComponent>(4, 4);
+        REQUIRE(view.size() == 1);
+
+        world.removeEntity(entity.getID());
+        REQUIRE(view.empty());
+    }
+
+    SECTION("Entities added with components join existing views") {
+        auto view = world.view<ExperienceComponent>();
+
+        auto entity = std::make_unique<Entity>();
+        entity->addComponent<ExperienceComponent>();
+        world.addEntity(std::move(entity));
+
+        REQUIRE(view.size() == 1);
+    }
+
+    SECTION("each() passes components and tolerates removal") {
+        for (int i = 0; i < 10; ++i) {
+            Entity& entity = world.createEntity();
+            entity.addComponent<PositionComponent>(i, 0);
+            entity.addComponent<HealthComponent>(i + 1);
+        }
+
+        int visited = 0;
+        world.view<PositionComponent, HealthComponent>().each(
+            [&visited](Entity& entity, PositionComponent& pos, HealthComponent& health) {
+                REQUIRE(health.max_hp == pos.position.x + 1);
+                if (pos.position.x % 2 == 0) {
+                    entity.removeComponent<HealthComponent>();
+                }
+                ++visited;
+            });
+
+        REQUIRE(visited == 10);
+        REQUIRE(world.view<PositionComponent, HealthComponent>().size() == 5);
+    }
+
+    SECTION("each() visits once while other entities lose components") {
+        std::vector<EntityID> ids;
+        for (int i = 0; i < 10; ++i) {
+            Entity& entity = world.createEntity();
+            entity.addComponent<PositionComponent>(i, 0);
+            entity.addComponent<HealthComponent>(i + 1);
+            ids.push_back(entity.getID());
+        }
+
+        // Each visit strips the next two entities in cache order, whether
+        // or not they were visited, and destroys one more
+        std::vector<EntityID> cache_order;
+        for (Entity* entity : world.view<HealthComponent>()) {
+            cache_order.push_back(entity->getID());
+        }
+        std::vector<EntityID> seen;
+        world.view<HealthComponent>().each([&](Entity& entity, HealthComponent&) {
+            seen.push_back(entity.getID());
+            size_t at = std::find(cache_order.begin(), cache_order.end(), entity.getID()) - cache_order.begin();
+            for (size_t next = at + 1; next <= at + 2 && next < cache_order.size(); ++next) {
+                if (Entity* other = world.getEntity(cache_order[next])) {
+                    other->removeComponent<HealthComponent>();
+                }
+            }
+            if (at + 3 < cache_order.size()) {
+                world.removeEntity(cache_order[at + 3]);
+            }
+        });
+
+        REQUIRE(seen == std::vector<EntityID>{cache_order[0], cache_order[4], cache_order[8]});
+        // Components added mid-pass wait for the next call
+        int late = 0;
+        world.view<HealthComponent>().each([&](Entity&, HealthComponent&) {
+            if (Entity* entity = world.getEntity(cache_order[1])) {
+                entity->addComponent<HealthComponent>(1);
+            }
+            ++late;
+        });
+        REQUIRE(late == 3);
+        REQUIRE(world.view<HealthComponent>().size() == 4);
+    }
+
+    SECTION("each() skips entities created in a freed slot mid-pass") {
+        std::vector<EntityID> ids;
+        for (int i = 0; i < 4; ++i) {
+            Entity& entity = world.createEntity();
+            entity.addComponent<HealthComponent>(i + 1);
+            ids.push_back(entity.getID());
+        }
+
+        std::vector<int> seen;
+        bool replaced = false;
+        world.view<HealthComponent>().each([&](Entity&, HealthComponent& health) {
+            seen.push_back(health.max_hp);
+            if (!replaced) {
+                // The replacement may reuse the destroyed entity's slot
+                replaced = true;
+                world.removeEntity(ids[3]);
+                world.createEntity().addComponent<HealthComponent>(99);
+            }
+        });
+
+        REQUIRE(seen == std::vector<int>{1, 2, 3});
+        REQUIRE(world.view<HealthComponent>().size() == 4);
+
+        seen.clear();
+        world.view<HealthComponent>().each([&](Entity&, HealthComponent& health) {
+            seen.push_back(health.max_hp);
+        });
+        REQUIRE(seen == std::vector<int>{1, 2, 3, 99});
+    }
+}
@@ -0,0 +1,221 @@
+#include <catch2/catch_test_macros.hpp>
+#include "dijkstra_map.h"
+#include "map.h"
+#include "map_generator.h"
+#include "pathfinding.h"
+#include "path_test_utils.h"
+#include "../include/ecs/ai_system.h"
+#include "../include/ecs/movement_system.h"
+#include "../include/ecs/system_manager.h"
+#include <chrono>
+#include <random>
+
+using namespace ecs;
+
+TEST_CASE("DijkstraMap: Distances match shortest paths", "[dijkstra]") {
+    Map map(198, 66);
+    MapGenerator::generate(map, MapType::PROCEDURAL, 606);
+    std::vector<Point> tiles = walkableTiles(map);
+    Point goal = tiles[tiles.size() / 2];
+
+    DijkstraMap field;
+    REQUIRE(field.compute(map, {goal}));
+    REQUIRE(field.getValue(goal) == 0);
+
+    std::mt19937 rng(21);
+    for (int i = 0; i < 30; i++) {
+        Point start = tiles[rng() % tiles.size()];
+        auto path = Pathfinding::findPath(start, goal, map, false);
+        if (path.empty()) {
+            REQUIRE(field.getValue(start) == DijkstraMap::UNREACHABLE);
+            continue;
+        }
+        size_t steps = start == goal ? 0 : path.size();
+        REQUIRE(field.getValue(start) == static_cast<int32_t>(steps) * DijkstraMap::STEP_COST);
+
+        // Walking downhill reaches the goal in exactly that many steps
+        Point pos = start;
+        for (size_t s = 0; s < steps; s++) {
+            pos = field.nextStep(pos);
+        }
+        REQUIRE(pos == goal);
+        REQUIRE(field.nextStep(goal) == goal);
+    }
+}
+
+TEST_CASE("DijkstraMap: Multiple goals", "[dijkstra]") {
+    Map map(30, 5);
+    map.fill(TileType::FLOOR);
+
+    DijkstraMap field;
+    field.compute(map, {Point(0, 2), Point(29, 2)});
+    REQUIRE(field.getValue(5, 2) == 5 * DijkstraMap::STEP_COST);
+    REQUIRE(field.getValue(25, 2) == 4 * DijkstraMap::STEP_COST);
+    REQUIRE(field.nextStep(Point(20, 2)) == Point(21, 2));
+    REQUIRE(field.nextStep(Point(10, 2)) == Point(9, 2));
+
+    SECTION("Diagonal moves") {
+        field.compute(map, {Point(0, 0)}, true);
+        REQUIRE(field.getValue(4, 4) == 4 * DijkstraMap::STEP_COST);
+        REQUIRE(field.nextStep(Point(4, 4)) == Point(3, 3));
+    }
+}
+
+TEST_CASE("DijkstraMap: Recomputes only when inputs change", "[dijkstra]") {
+    Map map(20, 20);
+    map.fill(TileType::FLOOR);
+    for (int y = 0; y < 20; y++) {
+        map.setTile(10, y, TileType::WALL);
+    }
+    map.setTile(10, 10, TileType::DOOR_OPEN);
+
+    DijkstraMap field;
+    REQUIRE(field.compute(map, {Point(2, 10)}));
+    REQUIRE_FALSE(field.compute(map, {Point(2, 10)}));
+    REQUIRE(field.getValue(15, 10) == 13 * DijkstraMap::STEP_COST);
+
+    map.setTile(10, 10, TileType::DOOR_CLOSED);
+    REQUIRE(field.compute(map, {Point(2, 10)}));
+    REQUIRE(field.getValue(15, 10) == DijkstraMap::UNREACHABLE);
+    REQUIRE(field.nextStep(Point(15, 10)) == Point(15, 10));
+
+    REQUIRE(field.compute(map, {Point(3, 10)}));
+    REQUIRE(field.computeFlee(map, {Point(3, 10)}));
+    REQUIRE(field.isFlee());
+
+    // Water blocks movement without blocking sight
+    map.setTile(10, 10, TileType::DOOR_OPEN);
+    REQUIRE(field.compute(map, {Point(2, 10)}));
+    const uint32_t transparency = map.getTransparencyVersion();
+    map.setTile(10, 10, TileType::WATER);
+    REQUIRE(map.getTransparencyVersion() == transparency);
+    REQUIRE(field.compute(map, {Point(2, 10)}));
+    REQUIRE(field.getValue(15, 10) == DijkstraMap::UNREACHABLE);
+
+    map.setTile(10, 10, TileType::FLOOR);
+    REQUIRE(field.compute(map, {Point(2, 10)}));
+    REQUIRE(field.getValue(15, 10) == 13 * DijkstraMap::STEP_COST);
+}
+
+TEST_CASE("DijkstraMap: Flee field leads away", "[dijkstra]") {
+    // A room with a dead-end alcove next to the threat and a long
+    // corridor out the far side
+    Map map(40, 11);
+    map.fill(TileType::WALL);
+    for (int y = 1; y < 10; y++) {
+        for (int x = 1; x < 12; x++) {
+            map.setTile(x, y, TileType::FLOOR);
+        }
+    }
+    for (int x = 12; x < 39; x++) {
+        map.setTile(x, 5, TileType::FLOOR);
+    }
+
+    Point threat(3, 5);
+    DijkstraMap flee;
+    flee.computeFlee(map, {threat});
+
+    // Following the field from beside the threat ends far down the corridor
+    Point pos(5, 5);
+    for (int i = 0; i < 60; i++) {
+        Point next = flee.nextStep(pos);
+        REQUIRE(flee.getValue(next) <= flee.getValue(pos));
+        pos = next;
+    }
+    REQUIRE(pos.x == 38);
+    REQUIRE(flee.getValue(threat) > flee.getValue(38, 5));
+}
+
+TEST_CASE("AISystem: Pack shares one chase field", "[dijkstra][ai]") {
+    Map map(60, 30);
+    map.fill(TileType::FLOOR);
+    for (int y = 0; y < 25; y++) {
+        map.setTile(30, y, TileType::WALL);
+    }
+
+    World world;
+    auto& movement = world.registerSystem<MovementSystem>(&map);
+    movement.setWorld(&world);
+    AISystem ai_system(&map, &movement, nullptr, nullptr);
+    ai_system.setWorld(&world);
+
+    Entity& player = world.createEntity();
+    player.addComponent<PositionComponent>(45, 5);
+    ai_system.setPlayerId(player.getID());
+
+    std::vector<Entity*> pack;
+    for (int i = 0; i < 50; i++) {
+        Entity& monster = world.createEntity();
+        monster.addComponent<PositionComponent>(20 + i % 10, 2 + i / 10);
+        auto& ai = monster.addComponent<AIComponent>();
+        ai.behavior = AIBehavior::AGGRESSIVE;
+        ai.vision_range = 60;
+        ai.has_seen_player = true;
+        ai.last_player_position = Point(45, 5);
+        pack.push_back(&monster);
+    }
+
+    ai_system.update(world, 0.0);
+    const DijkstraMap& field = ai_system.getChaseField();
+    REQUIRE(field.isValid());
+    REQUIRE(field.getGoals() == std::vector<Point>{Point(45, 5)});
+
+    // Still current: nothing moved that the field depends on
+    DijkstraMap copy = field;
+    REQUIRE_FALSE(copy.compute(map, {Point(45, 5)}));
+
+    int32_t before = 0;
+    for (Entity* monster : pack) {
+        before += field.getValue(monster->getComponent<PositionComponent>()->position);
+    }
+    movement.update(world.getEntities(), 0.0);
+    int32_t after = 0;
+    for (Entity* monster : pack) {
+        after += field.getValue(monster->getComponent<PositionComponent>()->position);
+    }
+    REQUIRE(after < before);
+}
+
+TEST_CASE("DijkstraMap: Pack pursuit benchmark", "[dijkstra][!benchmark][.]") {
+    constexpr int MONSTERS = 50;
+    constexpr int TURNS = 20;
+
+    Map map(198, 66);
+    MapGenerator::generate(map, MapType::PROCEDURAL, 4242);
+    std::vector<Point> tiles = walkableTiles(map);
+    Point player = tiles[tiles.size() / 2];
+
+    std::mt19937 rng(1);
+    std::vector<Point> monsters;
+    for (int i = 0; i < MONSTERS; i++) {
+        monsters.push_back(tiles[rng() % tiles.size()]);
+    }
+
+    PathfindingContext context;
+    std::vector<Point> path;
+    auto start = std::chrono::steady_clock::now();
+    for (int turn = 0; turn < TURNS; turn++) {
+        for (const Point& m : monsters) {
+            Pathfinding::findPath(m, player, map, context, path, false);
+        }
+    }
+    double searches = std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - start).count() / TURNS;
+
+    DijkstraMap field;
+    int moved = 0;
+    start = std::chrono::steady_clock::now();
+    for (int turn = 0; turn < TURNS; turn++) {
+        field.invalidate();  // player moved
+        field.compute(map, {player});
+        for (const Point& m : monsters) {
+            moved += field.nextStep(m) != m;
+        }
+    }
+    double shared = std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - start).count() / TURNS;
+
+    WARN(MONSTERS << " chasers: per-monster A* " << searches << " us/turn, shared field "
+         << shared << " us/turn (" << moved / TURNS << " stepping)");
+    REQUIRE(shared > 0.0);
+}
@@ -1,5 +1,6 @@
 #include <catch2/catch_test_macros.hpp>
 #include "../include/ecs/entity.h"
+#include "../include/ecs/system_manager.h"
 #include "../include/ecs/position_component.h"
 #include "../include/ecs/renderable_component.h"
 #include "../include/ecs/health_component.h"
@@ -9,8 +10,9 @@ using namespace ecs;
 
 TEST_CASE("ECS Entity basic operations", "[ecs][entity]") {
     SECTION("Entity has unique ID") {
-        Entity e1;
-        Entity e2;
+        World world;
+        Entity& e1 = world.createEntity();
+        Entity& e2 = world.createEntity();
         REQUIRE(e1.getID() != e2.getID());
         REQUIRE(e1.getID() < e2.getID());
     }
@@ -67,7 +69,7 @@ TEST_CASE("ECS Entity basic operations", "[ecs][entity]") {
         original.addComponent<HealthComponent>(100);
 
         auto cloned = original.clone();
-        REQUIRE(cloned->getID() != original.getID());
+        REQUIRE(cloned->getID() == INVALID_ENTITY_ID);
         REQUIRE(cloned->hasComponent<PositionComponent>());
         REQUIRE(cloned->hasComponent<HealthComponent>());
 
@@ -138,7 +140,7 @@ TEST_CASE("RenderableComponent functionality", "[ecs][renderable]") {
         RenderableComponent render;
         REQUIRE(render.isVisible());
 
-        render.setVisible(false);
+        render.is_visible = false;
         REQUIRE(!render.isVisible());
     }
 
@@ -58,7 +58,7 @@ TEST_CASE("EntityBuilder functionality", "[ecs][factory]") {
             .withHealth(100)
             .build();
 
-        REQUIRE(entity1->getID() != entity2->getID());
+        REQUIRE(entity1.get() != entity2.get());
         REQUIRE(entity1->getComponent<HealthComponent>()->getHealth() == 50);
         REQUIRE(entity2->getComponent<HealthComponent>()->getHealth() == 100);
     }
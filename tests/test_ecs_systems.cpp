@@ -299,9 +299,7 @@ TEST_CASE("World entity and system management", "[ecs][world]") {
         World world;
 
         auto player = PlayerFactory().create(10, 10);
-        EntityID player_id = player->getID();
-
-        world.addEntity(std::move(player));
+        EntityID player_id = world.addEntity(std::move(player)).getID();
         REQUIRE(world.getEntityCount() == 1);
 
         Entity* found = world.getEntity(player_id);
@@ -0,0 +1,176 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../include/ecs/entity_id.h"
+#include "../include/ecs/entity.h"
+#include "../include/ecs/system_manager.h"
+#include "../include/ecs/position_component.h"
+#include <stdexcept>
+
+using namespace ecs;
+
+TEST_CASE("Entity ID encoding", "[ecs][entity_id]") {
+    EntityID id = makeEntityID(42, 7);
+    REQUIRE(entityIndex(id) == 42);
+    REQUIRE(entityGeneration(id) == 7);
+    REQUIRE(makeEntityID(5, 0) == 5);
+}
+
+TEST_CASE("EntityIdAllocator", "[ecs][entity_id]") {
+    EntityIdAllocator allocator;
+
+    SECTION("Allocated IDs are live until released") {
+        EntityID id = allocator.allocate();
+        REQUIRE(id != INVALID_ENTITY_ID);
+        REQUIRE(allocator.isAlive(id));
+
+        allocator.release(id);
+        REQUIRE_FALSE(allocator.isAlive(id));
+
+        // Releasing a stale ID is harmless
+        allocator.release(id);
+        REQUIRE_FALSE(allocator.isAlive(id));
+    }
+
+    SECTION("Released slots are recycled with a new generation") {
+        std::vector<EntityID> released;
+        for (size_t i = 0; i < EntityIdAllocator::MIN_FREE_SLOTS + 1; ++i) {
+            released.push_back(allocator.allocate());
+        }
+        for (EntityID id : released) {
+            allocator.release(id);
+        }
+
+        // Slots are reused oldest-first, so drain until one of ours comes back
+        std::vector<EntityID> allocated;
+        bool reused_slot = false;
+        while (!reused_slot && allocated.size() < 100000) {
+            EntityID recycled = allocator.allocate();
+            allocated.push_back(recycled);
+            for (EntityID id : released) {
+                if (entityIndex(id) == entityIndex(recycled)) {
+                    reused_slot = true;
+                    REQUIRE(entityGeneration(recycled) > entityGeneration(id));
+                    REQUIRE_FALSE(allocator.isAlive(id));
+                }
+            }
+        }
+        REQUIRE(reused_slot);
+
+        for (EntityID id : allocated) {
+            allocator.release(id);
+        }
+    }
+
+    SECTION("Claimed IDs cannot be claimed twice") {
+        EntityID id = allocator.allocate();
+        REQUIRE_FALSE(allocator.claim(id));
+        allocator.release(id);
+        REQUIRE_FALSE(allocator.claim(id));
+
+        EntityID next = makeEntityID(entityIndex(id), entityGeneration(id) + 1);
+        REQUIRE(allocator.claim(next));
+        REQUIRE_FALSE(allocator.claim(next));
+    }
+
+    SECTION("Claims never move a generation backwards") {
+        EntityID id = makeEntityID(7, 3);
+        REQUIRE(allocator.claim(id));
+        allocator.release(id);
+
+        // An older generation of the slot stays dead
+        REQUIRE_FALSE(allocator.claim(makeEntityID(7, 2)));
+        REQUIRE_FALSE(allocator.isAlive(makeEntityID(7, 2)));
+        REQUIRE(allocator.claim(makeEntityID(7, 5)));
+    }
+
+    SECTION("Reset starts numbering afresh") {
+        EntityID id = allocator.allocate();
+        allocator.release(id);
+        allocator.reset();
+
+        REQUIRE(allocator.getAliveCount() == 0);
+        REQUIRE(allocator.claim(id));
+    }
+}
+
+TEST_CASE("World entity handles", "[ecs][entity_id]") {
+    World world;
+
+    SECTION("Lookup survives swap-removal") {
+        std::vector<EntityID> ids;
+        for (int i = 0; i < 10; ++i) {
+            Entity& entity = world.createEntity();
+            entity.addComponent<PositionComponent>(i, i);
+            ids.push_back(entity.getID());
+        }
+
+        REQUIRE(world.removeEntity(ids[2]));
+        REQUIRE(world.removeEntity(ids[0]));
+        REQUIRE_FALSE(world.removeEntity(ids[0]));
+        REQUIRE(world.getEntityCount() == 8);
+
+        for (size_t i = 1; i < ids.size(); ++i) {
+            if (i == 2) continue;
+            Entity* entity = world.getEntity(ids[i]);
+            REQUIRE(entity != nullptr);
+            REQUIRE(entity->getID() == ids[i]);
+            REQUIRE(entity->getComponent<PositionComponent>()->position.x == static_cast<int>(i));
+        }
+    }
+
+    SECTION("Stale IDs do not resolve") {
+        EntityID id = world.createEntity().getID();
+        world.removeEntity(id);
+
+        REQUIRE(world.getEntity(id) == nullptr);
+        REQUIRE_FALSE(world.hasEntity(id));
+        REQUIRE(world.getEntity(makeEntityID(entityIndex(id), entityGeneration(id) + 1)) == nullptr);
+    }
+
+    SECTION("Adding a duplicate ID fails") {
+        Entity& original = world.createEntity();
+        EntityID id = original.getID();
+
+        REQUIRE_THROWS_AS(world.addEntity(std::make_unique<Entity>(id)), std::invalid_argument);
+        REQUIRE(world.getEntity(id) == &original);
+        REQUIRE(world.getEntityCount() == 1);
+
+        // Another generation of the same slot collides too
+        EntityID stale = makeEntityID(entityIndex(id), entityGeneration(id) + 1);
+        REQUIRE_THROWS_AS(world.addEntity(std::make_unique<Entity>(stale)), std::invalid_argument);
+        REQUIRE(world.getEntity(id) == &original);
+    }
+
+    SECTION("Adding a released ID fails") {
+        EntityID id = world.createEntity().getID();
+        world.removeEntity(id);
+
+        REQUIRE_THROWS_AS(world.addEntity(std::make_unique<Entity>(id)), std::invalid_argument);
+        REQUIRE(world.getEntityCount() == 0);
+    }
+
+    SECTION("Saved IDs can be restored after clearing") {
+        EntityID id = world.createEntity().getID();
+        world.removeEntity(id);
+        world.clearEntities();
+
+        REQUIRE(world.addEntity(std::make_unique<Entity>(id)).getID() == id);
+    }
+
+    SECTION("Entities get their IDs from the world they join") {
+        auto entity = std::make_unique<Entity>();
+        REQUIRE(entity->getID() == INVALID_ENTITY_ID);
+
+        EntityID id = world.addEntity(std::move(entity)).getID();
+        REQUIRE(id != INVALID_ENTITY_ID);
+        REQUIRE(world.getEntity(id) != nullptr);
+    }
+
+    SECTION("Worlds number their entities independently") {
+        World other;
+        EntityID here = world.createEntity().getID();
+        EntityID there = other.createEntity().getID();
+
+        REQUIRE(here == there);
+        REQUIRE(world.getEntity(here) != other.getEntity(there));
+    }
+}
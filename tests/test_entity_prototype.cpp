@@ -0,0 +1,123 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../include/ecs/entity_prototype.h"
+#include "../include/ecs/entity_factory.h"
+#include "../include/ecs/system_manager.h"
+#include <chrono>
+
+using namespace ecs;
+
+TEST_CASE("EntityPrototype stamps copies", "[ecs][prototype]") {
+    EntityPrototype prototype("test_goblin");
+    auto& renderable = prototype.addComponent<RenderableComponent>("g", ftxui::Color::Green);
+    renderable.name = "Goblin";
+    prototype.addComponent<HealthComponent>(12);
+    prototype.addTag("monster");
+
+    SECTION("Standalone instances own independent components") {
+        auto first = prototype.instantiate(1, 2);
+        auto second = prototype.instantiate(3, 4);
+        first->getComponent<HealthComponent>()->hp = 1;
+
+        REQUIRE(second->getComponent<HealthComponent>()->hp == 12);
+        REQUIRE(second->getComponent<PositionComponent>()->position.x == 3);
+        REQUIRE(second->getComponent<RenderableComponent>()->name == "Goblin");
+        REQUIRE(second->hasTag("monster"));
+    }
+
+    SECTION("World instances live in the world's pools") {
+        World world;
+        Entity& goblin = prototype.instantiate(world, 5, 6);
+
+        REQUIRE(world.hasEntity(goblin.getID()));
+        REQUIRE(world.view<PositionComponent, HealthComponent>().size() == 1);
+        REQUIRE(goblin.getComponent<PositionComponent>()->position.y == 6);
+        REQUIRE(goblin.getComponent<HealthComponent>()->max_hp == 12);
+    }
+}
+
+TEST_CASE("PrototypeRegistry compiles data templates", "[ecs][prototype][data]") {
+    auto& loader = DataLoader::getInstance();
+    if (!loader.loadAllData("data")) {
+        WARN("data directory not found; skipping");
+        return;
+    }
+
+    auto& registry = PrototypeRegistry::getInstance();
+    PrototypeId goblin = registry.findMonster("goblin");
+    PrototypeId potion = registry.findItem("potion_minor");
+    REQUIRE(goblin != INVALID_PROTOTYPE_ID);
+    REQUIRE(potion != INVALID_PROTOTYPE_ID);
+    REQUIRE(registry.findMonster("no_such_monster") == INVALID_PROTOTYPE_ID);
+    REQUIRE(registry.size() == loader.getMonsterTemplates().size() + loader.getItemTemplates().size());
+
+    SECTION("Prototype instances match the factory") {
+        auto from_factory = MonsterFactoryECS().create("goblin", 2, 2);
+        auto from_prototype = registry.get(goblin)->instantiate(2, 2);
+
+        const auto* template_data = loader.getMonsterTemplate("goblin");
+        REQUIRE(from_prototype->getComponent<HealthComponent>()->max_hp == template_data->hp);
+        REQUIRE(from_prototype->getComponent<CombatComponent>()->combat_name ==
+                from_factory->getComponent<CombatComponent>()->combat_name);
+        REQUIRE(from_prototype->hasTag("goblin"));
+    }
+
+    SECTION("Batch spawn creates every known request in order") {
+        World world;
+        std::vector<SpawnRequest> requests = {
+            {goblin, 1, 1},
+            {INVALID_PROTOTYPE_ID, 2, 2},
+            {potion, 3, 3}
+        };
+
+        int customized = 0;
+        auto ids = registry.spawnBatch(world, requests, [&customized](Entity&) { ++customized; });
+        REQUIRE(ids.size() == 2);
+        REQUIRE(customized == 2);
+        REQUIRE(world.getEntity(ids[0])->hasTag("monster"));
+        REQUIRE(world.getEntity(ids[1])->getComponent<ItemComponent>()->item_type == ItemType::POTION);
+    }
+
+    SECTION("Reloading data recompiles prototypes") {
+        loader.loadMonsters("data/monsters.json");
+        REQUIRE(registry.findMonster("goblin") != INVALID_PROTOTYPE_ID);
+    }
+}
+
+TEST_CASE("Level spawn benchmark", "[ecs][prototype][!benchmark][.]") {
+    auto& loader = DataLoader::getInstance();
+    if (!loader.loadAllData("data")) {
+        WARN("data directory not found; skipping");
+        return;
+    }
+
+    constexpr int SPAWNS = 500;
+    constexpr int LEVELS = 20;
+    auto& registry = PrototypeRegistry::getInstance();
+    PrototypeId goblin = registry.findMonster("goblin");
+
+    auto start = std::chrono::steady_clock::now();
+    for (int level = 0; level < LEVELS; ++level) {
+        World world;
+        for (int i = 0; i < SPAWNS; ++i) {
+            world.addEntity(MonsterFactoryECS().create("goblin", i % 80, i / 80));
+        }
+    }
+    auto factory_time = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+
+    std::vector<SpawnRequest> requests;
+    for (int i = 0; i < SPAWNS; ++i) {
+        requests.push_back({goblin, i % 80, i / 80});
+    }
+    start = std::chrono::steady_clock::now();
+    for (int level = 0; level < LEVELS; ++level) {
+        World world;
+        registry.spawnBatch(world, requests);
+    }
+    auto batch_time = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+
+    WARN("standalone + addEntity: " << factory_time / LEVELS << " ms/level, batch: "
+         << batch_time / LEVELS << " ms/level");
+    REQUIRE(batch_time > 0.0);
+}
@@ -0,0 +1,324 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../include/ecs/event.h"
+#include <chrono>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ecs;
+
+TEST_CASE("EventText", "[ecs][events]") {
+    static_assert(EventText("melee").view().size() == 5);
+
+    EventText literal = "melee";
+    std::string runtime = std::string("mel") + "ee";
+
+    REQUIRE(literal == "melee");
+    REQUIRE(literal == runtime);
+    REQUIRE(literal.str() == runtime);
+    REQUIRE_FALSE(literal.empty());
+    REQUIRE(EventText().empty());
+}
+
+TEST_CASE("EventSystem dispatch", "[ecs][events]") {
+    auto& events = EventSystem::getInstance();
+    events.reset();
+
+    SECTION("Events are dispatched in emission order across types") {
+        std::vector<std::string> seen;
+        events.subscribe(EventType::DAMAGE, [&seen](const BaseEvent& e) {
+            seen.push_back("damage " + std::to_string(e.value1));
+        });
+        events.subscribe(EventType::DEATH, [&seen](const BaseEvent& e) {
+            seen.push_back("death " + e.text.str());
+        });
+
+        events.emit(DeathEvent(1, 2, "combat"));
+        events.emit(DamageEvent(2, 1, 5));
+        events.emit(DamageEvent(2, 1, 7));
+        REQUIRE(events.getQueuedCount(EventType::DAMAGE) == 2);
+
+        events.update();
+        REQUIRE(seen == std::vector<std::string>{"death combat", "damage 5", "damage 7"});
+        REQUIRE(events.getQueuedCount(EventType::DAMAGE) == 0);
+    }
+
+    SECTION("A drop emitted before a pickup is delivered first") {
+        std::vector<EntityID> seen;
+        events.subscribe(EventType::PICKUP, [&seen](const BaseEvent& e) { seen.push_back(e.target_id); });
+        events.subscribe(EventType::DROP, [&seen](const BaseEvent& e) { seen.push_back(e.target_id); });
+
+        events.emit(DropEvent(1, 10, 0, 0));
+        events.emit(PickupEvent(11, 1));
+        events.emit(DropEvent(1, 12, 0, 0));
+        events.update();
+        REQUIRE(seen == std::vector<EntityID>{10, 11, 12});
+    }
+
+    SECTION("Events emitted by handlers wait for the next update") {
+        int damage_events = 0;
+        events.subscribe(EventType::DAMAGE, [&](const BaseEvent& e) {
+            ++damage_events;
+            if (e.value1 > 0) {
+                events.emit(DamageEvent(0, 0, e.value1 - 1));
+            }
+        });
+
+        events.emit(DamageEvent(0, 0, 2));
+        events.update();
+        REQUIRE(damage_events == 1);
+        events.update();
+        events.update();
+        REQUIRE(damage_events == 3);
+
+        // Also across types, even ones dispatched later in the same update
+        int deaths = 0;
+        events.subscribe(EventType::DEATH, [&deaths](const BaseEvent&) { ++deaths; });
+        events.subscribe(EventType::DAMAGE, [&events](const BaseEvent& e) {
+            if (e.value1 == 9) {
+                events.emit(DeathEvent(0, 0, "bled out"));
+            }
+        });
+        events.emit(DamageEvent(0, 0, 9));
+        events.update();
+        REQUIRE(deaths == 0);
+        REQUIRE(events.getQueuedCount(EventType::DEATH) == 1);
+        events.update();
+        REQUIRE(deaths == 1);
+    }
+
+    SECTION("Batch handlers get a type's events as one span") {
+        std::vector<std::vector<int>> batches;
+        std::vector<std::string> order;
+        events.subscribe(EventType::DAMAGE, [&order](const BaseEvent&) { order.push_back("event"); });
+        SubscriptionId id = events.subscribeBatch(EventType::DAMAGE,
+            [&](std::span<const BaseEvent> damage) {
+                order.push_back("batch");
+                std::vector<int> values;
+                for (const BaseEvent& e : damage) {
+                    values.push_back(e.value1);
+                }
+                batches.push_back(values);
+            });
+
+        events.emit(DamageEvent(0, 0, 1));
+        events.emit(DamageEvent(0, 0, 2));
+        events.emit(DamageEvent(0, 0, 3));
+        events.update();
+        REQUIRE(batches == std::vector<std::vector<int>>{{1, 2, 3}});
+        REQUIRE(order == std::vector<std::string>{"batch", "event", "event", "event"});
+
+        // No events, no call
+        events.update();
+        REQUIRE(batches.size() == 1);
+
+        events.unsubscribe(EventType::DAMAGE, id);
+        events.emit(DamageEvent(0, 0, 4));
+        events.update();
+        REQUIRE(batches.size() == 1);
+    }
+
+    SECTION("Unsubscribed handlers are not called") {
+        int calls = 0;
+        SubscriptionId id = events.subscribe(EventType::PICKUP, [&calls](const BaseEvent&) { ++calls; });
+        events.emit(PickupEvent(1, 2));
+        events.update();
+        events.unsubscribe(EventType::PICKUP, id);
+        events.emit(PickupEvent(1, 2));
+        events.update();
+        REQUIRE(calls == 1);
+    }
+
+    SECTION("A handler can unsubscribe itself while being dispatched") {
+        int once_calls = 0;
+        int other_calls = 0;
+        SubscriptionId once = 0;
+        once = events.subscribe(EventType::DAMAGE, [&](const BaseEvent&) {
+            ++once_calls;
+            events.unsubscribe(EventType::DAMAGE, once);
+        });
+        events.subscribe(EventType::DAMAGE, [&other_calls](const BaseEvent&) { ++other_calls; });
+
+        events.emit(DamageEvent(0, 0, 1));
+        events.emit(DamageEvent(0, 0, 2));
+        events.update();
+        REQUIRE(once_calls == 1);
+        REQUIRE(other_calls == 2);
+
+        events.emit(DamageEvent(0, 0, 3));
+        events.update();
+        REQUIRE(once_calls == 1);
+        REQUIRE(other_calls == 3);
+    }
+
+    SECTION("Handlers subscribed while dispatching join from the next update") {
+        int added_calls = 0;
+        int subscribing_calls = 0;
+        events.subscribe(EventType::DAMAGE, [&](const BaseEvent&) {
+            // Enough subscriptions to force the handler vector to grow
+            if (++subscribing_calls == 1) {
+                for (int i = 0; i < 64; ++i) {
+                    events.subscribe(EventType::DAMAGE, [&added_calls](const BaseEvent&) { ++added_calls; });
+                }
+            }
+        });
+
+        events.emit(DamageEvent(0, 0, 1));
+        events.emit(DamageEvent(0, 0, 2));
+        events.update();
+        REQUIRE(subscribing_calls == 2);
+        REQUIRE(added_calls == 0);
+
+        events.emit(DamageEvent(0, 0, 3));
+        events.update();
+        REQUIRE(added_calls == 64);
+    }
+
+    SECTION("Reset from a handler stops the rest of the dispatch") {
+        int calls = 0;
+        events.subscribe(EventType::DAMAGE, [&](const BaseEvent&) {
+            ++calls;
+            events.reset();
+        });
+        events.subscribe(EventType::DAMAGE, [&calls](const BaseEvent&) { ++calls; });
+
+        events.emit(DamageEvent(0, 0, 1));
+        events.emit(DamageEvent(0, 0, 2));
+        events.update();
+        REQUIRE(calls == 1);
+
+        events.emit(DamageEvent(0, 0, 3));
+        events.update();
+        REQUIRE(calls == 1);
+    }
+
+    SECTION("Events posted from other threads arrive on update") {
+        int received = 0;
+        events.subscribe(EventType::STATE_CHANGE, [&received](const BaseEvent&) { ++received; });
+
+        std::vector<std::thread> producers;
+        for (int t = 0; t < 4; ++t) {
+            producers.emplace_back([&events] {
+                for (int i = 0; i < 200; ++i) {
+                    BaseEvent event(EventType::STATE_CHANGE);
+                    event.value1 = i;
+                    while (!events.post(event)) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+
+        events.update();
+        REQUIRE(received == 800);
+    }
+
+    events.reset();
+}
+
+TEST_CASE("Event queues reuse storage", "[ecs][events]") {
+    SECTION("Ring keeps capacity across drains") {
+        EventRing ring;
+        for (int i = 0; i < 40; ++i) {
+            ring.push(DamageEvent(0, 0, i));
+        }
+        size_t capacity = ring.capacity();
+        for (int i = 0; i < 40; ++i) {
+            REQUIRE(ring.front().value1 == i);
+            ring.pop();
+        }
+        for (int i = 0; i < 40; ++i) {
+            ring.push(DamageEvent(0, 0, i));
+        }
+        REQUIRE(ring.capacity() == capacity);
+        REQUIRE(ring.size() == 40);
+    }
+
+    SECTION("Ring view is contiguous after wrapping") {
+        EventRing ring;
+        for (int i = 0; i < 10; ++i) {
+            ring.push(DamageEvent(0, 0, i));
+        }
+        for (int i = 0; i < 6; ++i) {
+            ring.pop();
+        }
+        for (int i = 10; i < 18; ++i) {
+            ring.push(DamageEvent(0, 0, i));
+        }
+        size_t capacity = ring.capacity();
+
+        std::span<const BaseEvent> view = ring.view();
+        REQUIRE(view.size() == 12);
+        for (size_t i = 0; i < view.size(); ++i) {
+            REQUIRE(view[i].value1 == static_cast<int>(i) + 6);
+        }
+        REQUIRE(ring.capacity() == capacity);
+        REQUIRE(ring.front().value1 == 6);
+        REQUIRE(EventRing().view().empty());
+    }
+
+    SECTION("Mailbox rejects posts when full") {
+        EventMailbox mailbox(4);
+        for (int i = 0; i < 4; ++i) {
+            REQUIRE(mailbox.push(DamageEvent(0, 0, i)));
+        }
+        REQUIRE_FALSE(mailbox.push(DamageEvent(0, 0, 4)));
+
+        BaseEvent event;
+        REQUIRE(mailbox.pop(event));
+        REQUIRE(event.value1 == 0);
+        REQUIRE(mailbox.push(DamageEvent(0, 0, 4)));
+    }
+}
+
+TEST_CASE("Event bus benchmark", "[ecs][events][!benchmark][.]") {
+    // A combat-heavy turn: attack, damage and death text for 20 fighters
+    constexpr int TURNS = 20000;
+    constexpr int EVENTS_PER_TURN = 60;
+
+    auto& events = EventSystem::getInstance();
+    events.reset();
+    long total = 0;
+    events.subscribe(EventType::DAMAGE, [&total](const BaseEvent& e) { total += e.value1; });
+
+    auto start = std::chrono::steady_clock::now();
+    for (int turn = 0; turn < TURNS; ++turn) {
+        for (int i = 0; i < EVENTS_PER_TURN; ++i) {
+            events.emit(DamageEvent(1, 2, i, "melee"));
+        }
+        events.update();
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - start).count();
+
+    WARN("ring bus: " << elapsed / (TURNS * EVENTS_PER_TURN) << " ns/event");
+    const long expected = static_cast<long>(TURNS) * (EVENTS_PER_TURN * (EVENTS_PER_TURN - 1) / 2);
+    REQUIRE(total == expected);
+
+    // The same load taken as one span per turn
+    events.reset();
+    total = 0;
+    events.subscribeBatch(EventType::DAMAGE, [&total](std::span<const BaseEvent> damage) {
+        for (const BaseEvent& e : damage) {
+            total += e.value1;
+        }
+    });
+
+    start = std::chrono::steady_clock::now();
+    for (int turn = 0; turn < TURNS; ++turn) {
+        for (int i = 0; i < EVENTS_PER_TURN; ++i) {
+            events.emit(DamageEvent(1, 2, i, "melee"));
+        }
+        events.update();
+    }
+    elapsed = std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - start).count();
+
+    WARN("ring bus, span handler: " << elapsed / (TURNS * EVENTS_PER_TURN) << " ns/event");
+    REQUIRE(total == expected);
+    events.reset();
+}
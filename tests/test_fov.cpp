@@ -3,7 +3,10 @@
 #include "map.h"
 #include "map_memory.h"
 #include "map_generator.h"
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
+#include <cstdlib>
 
 TEST_CASE("FOV: Basic visibility calculation", "[fov]") {
     Map map(30, 30);
@@ -304,4 +307,223 @@ TEST_CASE("FOV: Performance", "[fov][!benchmark]") {
         auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
         REQUIRE(duration.count() < 10);  // Should take less than 10ms
     }
-}
\ No newline at end of file
+}
+namespace {
+
+// The brute-force raycaster FOV::calculate used before shadowcasting,
+// kept as a reference for behaviour and speed comparisons
+void raycastFOV(const Map& map, const Point& origin, int radius,
+                std::vector<std::vector<bool>>& visible) {
+    visible.assign(map.getHeight(), std::vector<bool>(map.getWidth(), false));
+    if (map.inBounds(origin.x, origin.y)) {
+        visible[origin.y][origin.x] = true;
+    }
+
+    for (int y = origin.y - radius; y <= origin.y + radius; y++) {
+        for (int x = origin.x - radius; x <= origin.x + radius; x++) {
+            if (!map.inBounds(x, y)) continue;
+
+            int dx = x - origin.x;
+            int dy = y - origin.y;
+            if (dx * dx + dy * dy > radius * radius) continue;
+
+            bool blocked = false;
+            int steps = std::max(std::abs(dx), std::abs(dy));
+            for (int i = 1; i < steps; i++) {
+                int checkX = origin.x + (dx * i) / steps;
+                int checkY = origin.y + (dy * i) / steps;
+                if (!map.isTransparent(checkX, checkY)) {
+                    blocked = true;
+                    break;
+                }
+            }
+
+            if (!blocked) {
+                visible[y][x] = true;
+            }
+        }
+    }
+}
+
+struct FOVDiff {
+    int common = 0;     ///< Tiles both algorithms see
+    int onlyRay = 0;    ///< Tiles only the raycaster sees
+    int onlyShadow = 0; ///< Tiles only shadowcasting sees
+    int outside = 0;    ///< Shadowcast tiles beyond the radius
+};
+
+FOVDiff compareFOV(const Map& map, const Point& origin, int radius) {
+    std::vector<std::vector<bool>> ray;
+    std::vector<std::vector<bool>> shadow;
+    raycastFOV(map, origin, radius, ray);
+    FOV::calculate(map, origin, radius, shadow);
+
+    FOVDiff diff;
+    for (int y = 0; y < map.getHeight(); y++) {
+        for (int x = 0; x < map.getWidth(); x++) {
+            if (shadow[y][x]) {
+                int dx = x - origin.x;
+                int dy = y - origin.y;
+                if (dx * dx + dy * dy > radius * radius) diff.outside++;
+            }
+            if (ray[y][x] && shadow[y][x]) diff.common++;
+            else if (ray[y][x]) diff.onlyRay++;
+            else if (shadow[y][x]) diff.onlyShadow++;
+        }
+    }
+    return diff;
+}
+
+} // namespace
+
+TEST_CASE("FOV: Shadowcasting matches raycasting", "[fov]") {
+    SECTION("Open floor is identical") {
+        Map map(60, 60);
+        map.fill(TileType::FLOOR);
+        for (int radius : {0, 1, 5, 10, 20}) {
+            FOVDiff diff = compareFOV(map, Point(30, 30), radius);
+            REQUIRE(diff.onlyRay == 0);
+            REQUIRE(diff.onlyShadow == 0);
+        }
+    }
+
+    SECTION("Generated maps stay close to the raycaster") {
+        for (MapType type : {MapType::COMBAT_ARENA, MapType::STRESS_TEST, MapType::TEST_DUNGEON}) {
+            Map map(198, 66);
+            MapGenerator::generate(map, type, 12345);
+            Point origin = MapGenerator::getDefaultSpawnPoint(map, type);
+
+            for (int radius : {5, 10, 20}) {
+                FOVDiff diff = compareFOV(map, origin, radius);
+                REQUIRE(diff.outside == 0);
+                REQUIRE(diff.common > 0);
+                // Integer rays clip some corners and slip past others, and the
+                // symmetric rules give up floor tiles seen only past a corner;
+                // the two should only disagree about a handful of edge tiles
+                REQUIRE(diff.onlyRay * 10 <= diff.common);
+                REQUIRE(diff.onlyShadow * 5 <= diff.common);
+            }
+        }
+    }
+}
+
+namespace {
+
+// Pairs of transparent tiles within the radius where only one sees the
+// other; a monster must never see a player who cannot see it back
+struct SymmetryCheck {
+    int pairs = 0;
+    int asymmetric = 0;
+};
+
+SymmetryCheck checkSymmetry(const Map& map, int radius) {
+    const int side = 2 * radius + 1;
+    const size_t window = static_cast<size_t>(side) * side;
+    const int width = map.getWidth();
+    const int height = map.getHeight();
+
+    // Visibility of each tile's surrounding window, from that tile
+    std::vector<uint8_t> seen(static_cast<size_t>(width) * height * window, 0);
+    auto at = [&](int x, int y, int dx, int dy) -> uint8_t& {
+        return seen[(static_cast<size_t>(y) * width + x) * window +
+                    static_cast<size_t>(dy + radius) * side + (dx + radius)];
+    };
+
+    std::vector<std::vector<bool>> visible;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            if (!map.isTransparent(x, y)) continue;
+            FOV::calculate(map, Point(x, y), radius, visible);
+            for (int dy = -radius; dy <= radius; dy++) {
+                for (int dx = -radius; dx <= radius; dx++) {
+                    if (map.inBounds(x + dx, y + dy)) {
+                        at(x, y, dx, dy) = visible[y + dy][x + dx];
+                    }
+                }
+            }
+        }
+    }
+
+    SymmetryCheck check;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            if (!map.isTransparent(x, y)) continue;
+            for (int dy = -radius; dy <= radius; dy++) {
+                for (int dx = -radius; dx <= radius; dx++) {
+                    if (!map.isTransparent(x + dx, y + dy)) continue;
+                    check.pairs++;
+                    if (at(x, y, dx, dy) != at(x + dx, y + dy, -dx, -dy)) {
+                        check.asymmetric++;
+                    }
+                }
+            }
+        }
+    }
+    return check;
+}
+
+} // namespace
+
+TEST_CASE("FOV: Shadowcasting is symmetric", "[fov]") {
+    SECTION("Around pillars") {
+        Map map(40, 40);
+        map.fill(TileType::FLOOR);
+        for (int y = 4; y < 36; y += 4) {
+            for (int x = 4; x < 36; x += 4) {
+                map.setTile(x, y, TileType::WALL);
+            }
+        }
+        SymmetryCheck check = checkSymmetry(map, 15);
+        REQUIRE(check.pairs > 0);
+        REQUIRE(check.asymmetric == 0);
+    }
+
+    SECTION("Generated maps") {
+        for (MapType type : {MapType::PROCEDURAL, MapType::TEST_DUNGEON, MapType::STRESS_TEST}) {
+            Map map(198, 66);
+            MapGenerator::generate(map, type, 42);
+            SymmetryCheck check = checkSymmetry(map, 10);
+            REQUIRE(check.pairs > 0);
+            REQUIRE(check.asymmetric == 0);
+        }
+    }
+
+    SECTION("Single line-of-sight checks agree both ways") {
+        Map map(198, 66);
+        MapGenerator::generate(map, MapType::PROCEDURAL, 42);
+        REQUIRE(FOV::isVisible(map, Point(85, 27), Point(79, 28), 10) ==
+                FOV::isVisible(map, Point(79, 28), Point(85, 27), 10));
+    }
+}
+
+TEST_CASE("FOV: Shadowcasting benchmark", "[fov][!benchmark][.]") {
+    constexpr int ITERATIONS = 200;
+
+    for (MapType type : {MapType::STRESS_TEST, MapType::COMBAT_ARENA}) {
+        Map map(198, 66);
+        MapGenerator::generate(map, type, 12345);
+        Point origin = MapGenerator::getDefaultSpawnPoint(map, type);
+        std::vector<std::vector<bool>> visible;
+
+        for (int radius : {10, 20, 40}) {
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < ITERATIONS; i++) {
+                raycastFOV(map, origin, radius, visible);
+            }
+            auto ray_time = std::chrono::duration<double, std::micro>(
+                std::chrono::steady_clock::now() - start).count() / ITERATIONS;
+
+            start = std::chrono::steady_clock::now();
+            for (int i = 0; i < ITERATIONS; i++) {
+                FOV::calculate(map, origin, radius, visible);
+            }
+            auto shadow_time = std::chrono::duration<double, std::micro>(
+                std::chrono::steady_clock::now() - start).count() / ITERATIONS;
+
+            WARN((type == MapType::STRESS_TEST ? "STRESS_TEST" : "COMBAT_ARENA")
+                 << " radius " << radius << ": raycast " << ray_time << " us, shadowcast "
+                 << shadow_time << " us (" << ray_time / shadow_time << "x)");
+            REQUIRE(shadow_time > 0.0);
+        }
+    }
+}
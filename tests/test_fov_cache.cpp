@@ -0,0 +1,189 @@
+#include <catch2/catch_test_macros.hpp>
+#include "fov.h"
+#include "fov_cache.h"
+#include "map.h"
+#include "map_memory.h"
+#include "map_generator.h"
+#include <chrono>
+#include <random>
+
+namespace {
+
+// Incremental results must always equal a from-scratch calculation
+void requireMatchesFullFOV(const FOVCache& cache, const Map& map, const Point& origin, int radius) {
+    std::vector<std::vector<bool>> expected;
+    FOV::calculate(map, origin, radius, expected);
+    REQUIRE(cache.getVisible() == expected);
+}
+
+// Room split by a wall with a door, viewer west of the door
+Map makeDoorMap() {
+    Map map(40, 20);
+    map.fill(TileType::FLOOR);
+    for (int y = 0; y < 20; y++) {
+        map.setTile(20, y, TileType::WALL);
+    }
+    map.setTile(20, 10, TileType::DOOR_CLOSED);
+    return map;
+}
+
+} // namespace
+
+TEST_CASE("FOVCache: Results are cached", "[fov][fov_cache]") {
+    Map map = makeDoorMap();
+    FOVCache cache;
+    Point origin(15, 10);
+
+    REQUIRE(cache.update(map, origin, 8) == FOVCache::Result::UPDATED);
+    requireMatchesFullFOV(cache, map, origin, 8);
+    REQUIRE(cache.getLeft().empty());
+    REQUIRE(cache.getEntered().size() > 50);
+
+    SECTION("Waiting recomputes nothing") {
+        REQUIRE(cache.update(map, origin, 8) == FOVCache::Result::UNCHANGED);
+        REQUIRE(cache.getEntered().empty());
+        REQUIRE(cache.getLeft().empty());
+        REQUIRE(cache.getRecomputedOctants() == 0);
+    }
+
+    SECTION("Changes out of range recompute nothing") {
+        map.setTile(2, 2, TileType::WALL);
+        REQUIRE(cache.update(map, origin, 8) == FOVCache::Result::UNCHANGED);
+    }
+
+    SECTION("Moving reports the delta") {
+        auto before = cache.getVisible();
+        REQUIRE(cache.update(map, Point(16, 10), 8) == FOVCache::Result::UPDATED);
+        requireMatchesFullFOV(cache, map, Point(16, 10), 8);
+
+        for (const auto& tile : cache.getEntered()) {
+            REQUIRE_FALSE(before[tile.y][tile.x]);
+            REQUIRE(cache.isVisible(tile.x, tile.y));
+        }
+        for (const auto& tile : cache.getLeft()) {
+            REQUIRE(before[tile.y][tile.x]);
+            REQUIRE_FALSE(cache.isVisible(tile.x, tile.y));
+        }
+        REQUIRE_FALSE(cache.getEntered().empty());
+        REQUIRE_FALSE(cache.getLeft().empty());
+    }
+
+    SECTION("Radius change recomputes") {
+        REQUIRE(cache.update(map, origin, 4) == FOVCache::Result::UPDATED);
+        requireMatchesFullFOV(cache, map, origin, 4);
+        REQUIRE(cache.getEntered().empty());
+        REQUIRE_FALSE(cache.getLeft().empty());
+    }
+}
+
+TEST_CASE("FOVCache: Doors recompute affected octants", "[fov][fov_cache]") {
+    Map map = makeDoorMap();
+    FOVCache cache;
+    Point origin(15, 10);
+    cache.update(map, origin, 12);
+    REQUIRE_FALSE(cache.isVisible(25, 10));
+
+    map.setTile(20, 10, TileType::DOOR_OPEN);
+    REQUIRE(cache.update(map, origin, 12) == FOVCache::Result::UPDATED);
+    requireMatchesFullFOV(cache, map, origin, 12);
+    REQUIRE(cache.isVisible(25, 10));
+    REQUIRE(cache.getLeft().empty());
+    // The door sits on the east axis, shared by two octants
+    REQUIRE(cache.getRecomputedOctants() == 2);
+
+    map.setTile(20, 10, TileType::DOOR_CLOSED);
+    REQUIRE(cache.update(map, origin, 12) == FOVCache::Result::UPDATED);
+    requireMatchesFullFOV(cache, map, origin, 12);
+    REQUIRE_FALSE(cache.isVisible(25, 10));
+    REQUIRE(cache.getEntered().empty());
+
+    SECTION("Replacing a tile with one of equal transparency is not a change") {
+        uint32_t version = map.getTransparencyVersion();
+        map.setTile(20, 3, TileType::DOOR_CLOSED);
+        REQUIRE(map.getTransparencyVersion() == version);
+        REQUIRE(cache.update(map, origin, 12) == FOVCache::Result::UNCHANGED);
+    }
+
+    SECTION("Regenerating the map falls back to a full recompute") {
+        map.fill(TileType::FLOOR);
+        REQUIRE(cache.update(map, origin, 12) == FOVCache::Result::UPDATED);
+        REQUIRE(cache.getRecomputedOctants() == FOV::OCTANT_COUNT);
+        requireMatchesFullFOV(cache, map, origin, 12);
+    }
+
+    SECTION("Invalidate starts from nothing visible") {
+        cache.invalidate();
+        REQUIRE(cache.update(map, origin, 12) == FOVCache::Result::UPDATED);
+        REQUIRE(cache.getLeft().empty());
+        int visible_count = 0;
+        for (const auto& row : cache.getVisible()) {
+            for (bool v : row) visible_count += v;
+        }
+        REQUIRE(static_cast<int>(cache.getEntered().size()) == visible_count);
+    }
+}
+
+TEST_CASE("FOVCache: Walking a generated dungeon", "[fov][fov_cache]") {
+    Map map(198, 66);
+    MapGenerator::generate(map, MapType::PROCEDURAL, 4242);
+    Point origin = MapGenerator::findSafeSpawnPoint(map);
+
+    FOVCache cache;
+    MapMemory memory(map.getWidth(), map.getHeight());
+    cache.update(map, origin, 10);
+    memory.updateVisibility(map, cache.getEntered(), cache.getLeft());
+
+    // Random walk toggling doors on the way; the delta-fed memory must
+    // track the cached view exactly
+    const Point steps[] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}, {1, 1}, {-1, -1}};
+    std::mt19937 rng(7);
+    for (int i = 0; i < 200; i++) {
+        Point next = origin + steps[rng() % 6];
+        if (map.isWalkable(next)) {
+            origin = next;
+        }
+        if (i % 25 == 0) {
+            Point door = origin + Point(2, 0);
+            if (map.inBounds(door)) {
+                map.setTile(door, map.isTransparent(door) ? TileType::DOOR_CLOSED : TileType::DOOR_OPEN);
+            }
+        }
+
+        cache.update(map, origin, 10);
+        memory.updateVisibility(map, cache.getEntered(), cache.getLeft());
+    }
+
+    requireMatchesFullFOV(cache, map, origin, 10);
+    for (int y = 0; y < map.getHeight(); y++) {
+        for (int x = 0; x < map.getWidth(); x++) {
+            REQUIRE(memory.isVisible(x, y) == cache.isVisible(x, y));
+        }
+    }
+}
+
+TEST_CASE("FOVCache: Update benchmark", "[fov][fov_cache][!benchmark][.]") {
+    constexpr int ITERATIONS = 1000;
+    Map map(198, 66);
+    MapGenerator::generate(map, MapType::STRESS_TEST);
+    Point origin = MapGenerator::getDefaultSpawnPoint(map, MapType::STRESS_TEST);
+    std::vector<std::vector<bool>> visible;
+    FOVCache cache;
+    cache.update(map, origin, 20);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        FOV::calculate(map, origin, 20, visible);
+    }
+    auto full_time = std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - start).count() / ITERATIONS;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        cache.update(map, origin, 20);
+    }
+    auto cached_time = std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - start).count() / ITERATIONS;
+
+    WARN("radius 20 full: " << full_time << " us, unchanged cache hit: " << cached_time << " us");
+    REQUIRE(cached_time < full_time);
+}
@@ -0,0 +1,268 @@
+#include <catch2/catch_test_macros.hpp>
+#include "hierarchical_pathfinder.h"
+#include "map.h"
+#include "map_generator.h"
+#include "pathfinding.h"
+#include "path_test_utils.h"
+#include <chrono>
+#include <random>
+
+namespace {
+
+// A lattice of rooms joined by corridors, like a procedural level but larger
+void buildRoomLattice(Map& map, int cells, unsigned seed) {
+    map.fill(TileType::VOID);
+    map.clearRooms();
+    std::mt19937 rng(seed);
+    std::vector<Room> rooms;
+    const int cell = map.getWidth() / cells;
+    for (int gy = 0; gy < cells; gy++) {
+        for (int gx = 0; gx < cells; gx++) {
+            Room room(gx * cell + 2 + static_cast<int>(rng() % 5), gy * cell + 2 + static_cast<int>(rng() % 5),
+                      8 + static_cast<int>(rng() % (cell - 14)), 6 + static_cast<int>(rng() % (cell - 14)));
+            map.addRoom(room);
+            MapGenerator::carveRoom(map, room);
+            rooms.push_back(room);
+        }
+    }
+    CorridorOptions options;
+    options.placeDoors = false;
+    MapGenerator::connectRooms(map, rooms, options);
+}
+
+} // namespace
+
+TEST_CASE("HierarchicalPathfinder: Rooms and sectors become clusters", "[pathfinding][hpa]") {
+    Map map(198, 66);
+    MapGenerator::generate(map, MapType::PROCEDURAL, 31);
+
+    HierarchicalPathfinder planner;
+    REQUIRE_FALSE(planner.isBuilt());
+    planner.build(map);
+    REQUIRE(planner.isBuilt());
+
+    const int sectors = ((198 + HierarchicalPathfinder::SECTOR_SIZE - 1) / HierarchicalPathfinder::SECTOR_SIZE) *
+                        ((66 + HierarchicalPathfinder::SECTOR_SIZE - 1) / HierarchicalPathfinder::SECTOR_SIZE);
+    REQUIRE(planner.getClusterCount() == static_cast<int>(map.getRooms().size()) + sectors);
+    REQUIRE(planner.getRebuiltClusterCount() == planner.getClusterCount());
+    REQUIRE(planner.getNodeCount() > 0);
+    REQUIRE_FALSE(planner.update(map));
+}
+
+TEST_CASE("HierarchicalPathfinder: Agrees with flat search", "[pathfinding][hpa]") {
+    Map map(198, 66);
+    MapGenerator::generate(map, MapType::PROCEDURAL, 8080);
+    // Open every door so most of the level is one connected space
+    for (int y = 0; y < map.getHeight(); y++) {
+        for (int x = 0; x < map.getWidth(); x++) {
+            if (map.getTile(x, y) == TileType::DOOR_CLOSED) map.setTile(x, y, TileType::DOOR_OPEN);
+        }
+    }
+    std::vector<Point> tiles = walkableTiles(map);
+
+    HierarchicalPathfinder planner;
+    planner.build(map);
+
+    PathfindingContext context;
+    std::vector<Point> exact;
+    std::vector<Point> path;
+    std::mt19937 rng(5);
+    size_t exact_steps = 0;
+    size_t planned_steps = 0;
+    for (int i = 0; i < 200; i++) {
+        Point start = tiles[rng() % tiles.size()];
+        Point goal = tiles[rng() % tiles.size()];
+        bool reachable = Pathfinding::findPath(start, goal, map, context, exact, false);
+        REQUIRE(planner.findPath(start, goal, path) == reachable);
+        if (!reachable || start == goal) continue;
+
+        requireValidPath(start, goal, path, map);
+        REQUIRE(path.size() >= exact.size());
+        exact_steps += exact.size();
+        planned_steps += path.size();
+    }
+    // Near-optimal overall
+    REQUIRE(planned_steps * 100 <= exact_steps * 115);
+}
+
+TEST_CASE("HierarchicalPathfinder: Next segment leaves the start region", "[pathfinding][hpa]") {
+    // Two rooms joined by a corridor
+    Map map(60, 20);
+    map.fill(TileType::VOID);
+    Room left(2, 2, 12, 10);
+    Room right(40, 5, 12, 10);
+    map.addRoom(left);
+    map.addRoom(right);
+    MapGenerator::carveRoom(map, left);
+    MapGenerator::carveRoom(map, right);
+    MapGenerator::carveCorridorL(map, left.center(), right.center());
+
+    HierarchicalPathfinder planner;
+    planner.build(map);
+
+    std::vector<Point> route;
+    REQUIRE(planner.findRoute(Point(4, 4), Point(48, 12), route));
+    REQUIRE(route.size() > 2);
+    REQUIRE(route.back() == Point(48, 12));
+
+    std::vector<Point> segment;
+    REQUIRE(planner.findNextSegment(Point(4, 4), Point(48, 12), segment));
+    REQUIRE_FALSE(segment.empty());
+    // Ends one step outside the left room's interior, no further
+    auto inside = [&left](const Point& p) {
+        return p.x > left.left() && p.x < left.right() && p.y > left.top() && p.y < left.bottom();
+    };
+    REQUIRE(inside(segment[segment.size() - 2]));
+    REQUIRE_FALSE(inside(segment.back()));
+
+    std::vector<Point> full;
+    REQUIRE(planner.findPath(Point(4, 4), Point(48, 12), full));
+    REQUIRE(full.size() > segment.size());
+    requireValidPath(Point(4, 4), Point(48, 12), full, map);
+
+    SECTION("Same region needs no abstract search") {
+        REQUIRE(planner.findNextSegment(Point(4, 4), Point(10, 9), segment));
+        requireValidPath(Point(4, 4), Point(10, 9), segment, map);
+        REQUIRE(planner.getExpandedCount() == 0);
+    }
+
+    SECTION("Unreachable goals") {
+        REQUIRE_FALSE(planner.findPath(Point(4, 4), Point(0, 0), full));
+        REQUIRE(full.empty());
+    }
+}
+
+TEST_CASE("HierarchicalPathfinder: Doors repair only their cluster", "[pathfinding][hpa]") {
+    Map map(64, 32);
+    map.fill(TileType::FLOOR);
+    for (int y = 0; y < 32; y++) {
+        map.setTile(40, y, TileType::WALL);
+    }
+    map.setTile(40, 20, TileType::DOOR_OPEN);
+
+    HierarchicalPathfinder planner;
+    planner.build(map);
+    const int nodes = planner.getNodeCount();
+    std::vector<Point> path;
+    REQUIRE(planner.findPath(Point(2, 2), Point(60, 2), path));
+
+    map.setTile(40, 20, TileType::DOOR_CLOSED);
+    REQUIRE(planner.update(map));
+    REQUIRE(planner.getRebuiltClusterCount() == 1);
+    REQUIRE_FALSE(planner.findPath(Point(2, 2), Point(60, 2), path));
+
+    map.setTile(40, 20, TileType::DOOR_OPEN);
+    REQUIRE(planner.update(map));
+    REQUIRE(planner.getNodeCount() == nodes);
+    REQUIRE(planner.findPath(Point(2, 2), Point(60, 2), path));
+    requireValidPath(Point(2, 2), Point(60, 2), path, map);
+
+    SECTION("Water in the doorway blocks it without changing sight") {
+        map.setTile(40, 20, TileType::WATER);
+        REQUIRE(planner.update(map));
+        REQUIRE(planner.getRebuiltClusterCount() == 1);
+        REQUIRE_FALSE(planner.findPath(Point(2, 2), Point(60, 2), path));
+
+        map.setTile(40, 20, TileType::FLOOR);
+        REQUIRE(planner.update(map));
+        REQUIRE(planner.findPath(Point(2, 2), Point(60, 2), path));
+    }
+
+    SECTION("A regenerated level rebuilds everything") {
+        MapGenerator::generate(map, MapType::TEST_ROOM);
+        REQUIRE(planner.update(map));
+        REQUIRE(planner.getRebuiltClusterCount() == planner.getClusterCount());
+    }
+}
+
+TEST_CASE("HierarchicalPathfinder: Incremental repair matches a fresh build", "[pathfinding][hpa]") {
+    Map map(128, 96);
+    buildRoomLattice(map, 4, 12);
+    std::vector<Point> tiles = walkableTiles(map);
+
+    HierarchicalPathfinder planner;
+    planner.build(map);
+
+    std::mt19937 rng(77);
+    std::vector<Point> repaired;
+    std::vector<Point> fresh_path;
+    for (int step = 0; step < 40; step++) {
+        // Wall off or reopen a handful of tiles
+        for (int k = 0; k < 3; k++) {
+            Point p = tiles[rng() % tiles.size()];
+            map.setTile(p.x, p.y, map.isWalkable(p.x, p.y) ? TileType::WALL : TileType::FLOOR);
+        }
+        planner.update(map);
+        // Only the changed clusters, unless the map's change log wrapped
+        int rebuilt = planner.getRebuiltClusterCount();
+        REQUIRE((rebuilt <= 3 || rebuilt == planner.getClusterCount()));
+
+        HierarchicalPathfinder fresh;
+        fresh.build(map);
+        REQUIRE(planner.getNodeCount() == fresh.getNodeCount());
+        REQUIRE(planner.getRegionCount() == fresh.getRegionCount());
+
+        for (int q = 0; q < 5; q++) {
+            Point start = tiles[rng() % tiles.size()];
+            Point goal = tiles[rng() % tiles.size()];
+            bool found = planner.findPath(start, goal, repaired);
+            REQUIRE(found == fresh.findPath(start, goal, fresh_path));
+            REQUIRE(repaired.size() == fresh_path.size());
+        }
+    }
+}
+
+TEST_CASE("HierarchicalPathfinder: Long route benchmark", "[pathfinding][hpa][!benchmark][.]") {
+    using Clock = std::chrono::steady_clock;
+    constexpr int QUERIES = 200;
+
+    auto run = [](const char* name, const Map& map) {
+        std::vector<Point> tiles = walkableTiles(map);
+        std::mt19937 rng(3);
+        std::vector<std::pair<Point, Point>> queries;
+        while (queries.size() < QUERIES) {
+            Point a = tiles[rng() % tiles.size()];
+            Point b = tiles[rng() % tiles.size()];
+            if (std::abs(a.x - b.x) + std::abs(a.y - b.y) > map.getWidth() / 2) queries.emplace_back(a, b);
+        }
+
+        auto t0 = Clock::now();
+        HierarchicalPathfinder planner;
+        planner.build(map);
+        double build = std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+
+        PathfindingContext context;
+        std::vector<Point> path;
+        t0 = Clock::now();
+        for (const auto& [a, b] : queries) {
+            Pathfinding::findPath(a, b, map, context, path, false);
+        }
+        double flat = std::chrono::duration<double, std::micro>(Clock::now() - t0).count() / QUERIES;
+
+        std::vector<Point> route;
+        t0 = Clock::now();
+        for (const auto& [a, b] : queries) {
+            planner.findNextSegment(a, b, route);
+        }
+        double segment = std::chrono::duration<double, std::micro>(Clock::now() - t0).count() / QUERIES;
+
+        t0 = Clock::now();
+        for (const auto& [a, b] : queries) {
+            planner.findPath(a, b, route);
+        }
+        double full = std::chrono::duration<double, std::micro>(Clock::now() - t0).count() / QUERIES;
+
+        WARN(name << ": " << planner.getClusterCount() << " clusters, " << planner.getNodeCount()
+             << " nodes, build " << build << " us; flat A* " << flat << " us, next segment "
+             << segment << " us, full refined path " << full << " us");
+        REQUIRE(segment > 0.0);
+    };
+
+    Map dungeon(198, 66);
+    MapGenerator::generate(dungeon, MapType::PROCEDURAL, 4242);
+    run("198x66 dungeon", dungeon);
+
+    Map lattice(1024, 1024);
+    buildRoomLattice(lattice, 32, 9);
+    run("1024x1024 room lattice", lattice);
+}
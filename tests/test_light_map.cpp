@@ -0,0 +1,238 @@
+#include <catch2/catch_test_macros.hpp>
+#include "light_map.h"
+#include "map.h"
+#include "map_generator.h"
+#include "../include/ecs/light_system.h"
+#include "../include/ecs/system_manager.h"
+#include <chrono>
+#include <random>
+
+using namespace ecs;
+
+namespace {
+
+struct TestLight {
+    Point position;
+    int radius;
+    int intensity;
+};
+
+void requireSameLevels(const LightMap& a, const LightMap& b, const Map& map) {
+    for (int y = 0; y < map.getHeight(); y++) {
+        for (int x = 0; x < map.getWidth(); x++) {
+            REQUIRE(a.getLevel(x, y) == b.getLevel(x, y));
+            REQUIRE(a.isLit(x, y) == b.isLit(x, y));
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("LightMap: Single light", "[light]") {
+    Map map(30, 15);
+    map.fill(TileType::FLOOR);
+    for (int y = 0; y < 15; y++) {
+        map.setTile(20, y, TileType::WALL);
+    }
+
+    LightMap lights;
+    lights.setLight(1, Point(15, 7), 4);
+    REQUIRE(lights.update(map));
+    REQUIRE(lights.getRecastCount() == 1);
+
+    SECTION("Brightest at the source and fading with distance") {
+        REQUIRE(lights.getLevel(15, 7) == LightMap::MAX_LEVEL);
+        REQUIRE(lights.getLevel(16, 7) < lights.getLevel(15, 7));
+        REQUIRE(lights.getLevel(18, 7) < lights.getLevel(16, 7));
+        REQUIRE(lights.getLevel(19, 7) > 0);
+        REQUIRE(lights.getLevel(20, 7) == 0);  // beyond the radius
+        REQUIRE_FALSE(lights.isLit(15, 12));
+    }
+
+    SECTION("Walls block light") {
+        lights.setLight(1, Point(18, 7), 6);
+        lights.update(map);
+        REQUIRE(lights.isLit(20, 7));   // the wall itself is lit
+        REQUIRE_FALSE(lights.isLit(21, 7));
+    }
+
+    SECTION("Unchanged lights are not recast") {
+        REQUIRE_FALSE(lights.update(map));
+        REQUIRE(lights.getRecastCount() == 0);
+        lights.setLight(1, Point(15, 7), 4);
+        REQUIRE_FALSE(lights.update(map));
+    }
+
+    SECTION("Removing a light clears its contribution") {
+        lights.removeLight(1);
+        REQUIRE(lights.update(map));
+        REQUIRE(lights.getLitTiles().none());
+        REQUIRE(lights.getLevel(15, 7) == 0);
+    }
+
+    SECTION("Overlapping lights add up") {
+        lights.setLight(2, Point(17, 7), 4, 100);
+        lights.update(map);
+        REQUIRE(lights.getLevel(16, 7) > 100);
+        REQUIRE(lights.getLevel(15, 7) == LightMap::MAX_LEVEL);  // saturated
+    }
+}
+
+TEST_CASE("LightMap: Door changes recast only nearby lights", "[light]") {
+    Map map(60, 11);
+    map.fill(TileType::FLOOR);
+    for (int y = 0; y < 11; y++) {
+        map.setTile(10, y, TileType::WALL);
+    }
+    map.setTile(10, 5, TileType::DOOR_OPEN);
+
+    LightMap lights;
+    lights.setLight(1, Point(7, 5), 5);
+    lights.setLight(2, Point(50, 5), 5);
+    lights.update(map);
+    REQUIRE(lights.isLit(12, 5));
+
+    map.setTile(10, 5, TileType::DOOR_CLOSED);
+    REQUIRE(lights.update(map));
+    REQUIRE(lights.getRecastCount() == 1);
+    REQUIRE_FALSE(lights.isLit(12, 5));
+    REQUIRE(lights.isLit(50, 5));
+
+    map.setTile(10, 5, TileType::DOOR_OPEN);
+    lights.update(map);
+    REQUIRE(lights.isLit(12, 5));
+}
+
+TEST_CASE("LightMap: Incremental updates match a fresh build", "[light]") {
+    Map map(198, 66);
+    MapGenerator::generate(map, MapType::PROCEDURAL, 2024);
+
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> x_dist(1, map.getWidth() - 2);
+    std::uniform_int_distribution<int> y_dist(1, map.getHeight() - 2);
+
+    std::vector<TestLight> placed(24);
+    LightMap lights;
+    for (size_t i = 0; i < placed.size(); i++) {
+        placed[i] = {Point(x_dist(rng), y_dist(rng)), 3 + static_cast<int>(i % 6), 120 + static_cast<int>(i)};
+        lights.setLight(i, placed[i].position, placed[i].radius, placed[i].intensity);
+    }
+    lights.update(map);
+
+    for (int step = 0; step < 60; step++) {
+        size_t i = rng() % placed.size();
+        switch (rng() % 3) {
+        case 0:
+            placed[i].position = Point(x_dist(rng), y_dist(rng));
+            lights.setLight(i, placed[i].position, placed[i].radius, placed[i].intensity);
+            break;
+        case 1: {
+            // Toggle a tile near a light between wall and floor
+            Point p(placed[i].position.x + 2, placed[i].position.y);
+            if (map.inBounds(p.x, p.y)) {
+                map.setTile(p.x, p.y, map.isTransparent(p.x, p.y) ? TileType::WALL : TileType::FLOOR);
+            }
+            break;
+        }
+        default:
+            placed[i].radius = 2 + static_cast<int>(rng() % 8);
+            lights.setLight(i, placed[i].position, placed[i].radius, placed[i].intensity);
+            break;
+        }
+        lights.update(map);
+
+        LightMap fresh;
+        for (size_t j = 0; j < placed.size(); j++) {
+            fresh.setLight(j, placed[j].position, placed[j].radius, placed[j].intensity);
+        }
+        fresh.update(map);
+        requireSameLevels(lights, fresh, map);
+    }
+}
+
+TEST_CASE("LightSystem: Follows light entities", "[light][ecs]") {
+    Map map(40, 20);
+    map.fill(TileType::FLOOR);
+
+    World world;
+    auto& system = world.registerSystem<LightSystem>(&map);
+
+    Entity& torch = world.createEntity();
+    torch.addComponent<PositionComponent>(5, 5);
+    torch.addComponent<LightComponent>(3);
+    system.update(world, 0.0);
+    REQUIRE(system.levelsChanged());
+    REQUIRE(system.getLightMap().isLit(7, 5));
+
+    SECTION("Nothing changed") {
+        system.update(world, 0.0);
+        REQUIRE_FALSE(system.levelsChanged());
+    }
+
+    SECTION("Moving the entity moves the light") {
+        torch.getComponent<PositionComponent>()->moveTo(30, 10);
+        torch.markChanged<PositionComponent>();
+        system.update(world, 0.0);
+        REQUIRE(system.levelsChanged());
+        REQUIRE_FALSE(system.getLightMap().isLit(7, 5));
+        REQUIRE(system.getLightMap().isLit(32, 10));
+    }
+
+    SECTION("Switching off or removing the light clears it") {
+        torch.getComponent<LightComponent>()->is_lit = false;
+        torch.markChanged<LightComponent>();
+        system.update(world, 0.0);
+        REQUIRE(system.getLightMap().getLitTiles().none());
+
+        torch.getComponent<LightComponent>()->is_lit = true;
+        torch.markChanged<LightComponent>();
+        system.update(world, 0.0);
+        REQUIRE(system.getLightMap().isLit(5, 5));
+
+        torch.removeComponent<LightComponent>();
+        system.update(world, 0.0);
+        REQUIRE(system.getLightMap().getLightCount() == 0);
+        REQUIRE(system.getLightMap().getLitTiles().none());
+    }
+}
+
+TEST_CASE("LightMap: Many torches benchmark", "[light][!benchmark][.]") {
+    constexpr int TORCHES = 48;
+    constexpr int TURNS = 200;
+
+    Map map(198, 66);
+    MapGenerator::generate(map, MapType::PROCEDURAL, 99);
+
+    std::vector<Point> torches;
+    std::mt19937 rng(3);
+    while (torches.size() < TORCHES) {
+        Point p(static_cast<int>(rng() % map.getWidth()), static_cast<int>(rng() % map.getHeight()));
+        if (map.isWalkable(p)) torches.push_back(p);
+    }
+    Point door = torches[0];
+
+    auto run = [&](bool incremental) {
+        LightMap lights;
+        auto start = std::chrono::steady_clock::now();
+        for (int turn = 0; turn < TURNS; turn++) {
+            if (!incremental) {
+                lights.clear();
+            }
+            for (size_t i = 0; i < torches.size(); i++) {
+                lights.setLight(i, torches[i], 6);
+            }
+            // One carried light moves and a door near a torch toggles
+            lights.setLight(TORCHES, Point(torches[1].x + turn % 2, torches[1].y), 4);
+            map.setTile(door.x + 1, door.y, turn % 2 ? TileType::DOOR_CLOSED : TileType::DOOR_OPEN);
+            lights.update(map);
+        }
+        return std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - start).count() / TURNS;
+    };
+
+    double full = run(false);
+    double incremental = run(true);
+    WARN(TORCHES << " torches: full recompute " << full << " us/turn, incremental "
+         << incremental << " us/turn");
+    REQUIRE(incremental > 0.0);
+}
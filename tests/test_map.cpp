@@ -192,4 +192,56 @@ TEST_CASE("Map: Custom size initialization", "[map]") {
         REQUIRE(tiny_map.inBounds(9, 9) == true);
         REQUIRE(tiny_map.inBounds(10, 10) == false);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Map: Packed storage", "[map]") {
+    SECTION("Cached flags follow tile changes") {
+        Map map(20, 20);
+        REQUIRE(map.isWalkable(3, 3) == false);
+
+        map.fill(TileType::FLOOR);
+        REQUIRE(map.isWalkable(3, 3) == true);
+        REQUIRE(map.isTransparent(3, 3) == true);
+
+        map.setTile(3, 3, TileType::WATER);
+        REQUIRE(map.isWalkable(3, 3) == false);
+        REQUIRE(map.isTransparent(3, 3) == true);
+
+        map.setTile(3, 3, TileType::DOOR_CLOSED);
+        REQUIRE(map.isTransparent(3, 3) == false);
+    }
+
+    SECTION("Visibility bits are independent across word boundaries") {
+        // 198 columns: row ends and word ends fall at different tiles
+        Map map;
+        map.setVisible(63, 0, true);
+        map.setVisible(64, 0, true);
+        map.setVisible(197, 0, true);
+        map.setVisible(0, 1, true);
+
+        REQUIRE(map.isVisible(63, 0));
+        REQUIRE(map.isVisible(64, 0));
+        REQUIRE_FALSE(map.isVisible(62, 0));
+        REQUIRE_FALSE(map.isVisible(65, 0));
+        REQUIRE(map.isVisible(197, 0));
+        REQUIRE(map.isVisible(0, 1));
+        REQUIRE_FALSE(map.isVisible(1, 1));
+
+        map.setVisible(64, 0, false);
+        REQUIRE_FALSE(map.isVisible(64, 0));
+        REQUIRE(map.isExplored(64, 0));
+
+        map.clearVisibility();
+        REQUIRE_FALSE(map.isVisible(63, 0));
+        REQUIRE(map.isExplored(63, 0));
+
+        map.clearExploration();
+        REQUIRE_FALSE(map.isExplored(197, 0));
+    }
+
+    SECTION("Tile properties come from the constexpr table") {
+        static_assert(Map::getTileProperties(TileType::WALL).walkable == false);
+        REQUIRE(&Map::getTileProperties(TileType::LAVA) == &TILE_PROPERTIES[static_cast<size_t>(TileType::LAVA)]);
+        REQUIRE(Map::getTileProperties(TileType::LAVA).name == "Lava");
+    }
+}
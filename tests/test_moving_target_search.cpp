@@ -0,0 +1,235 @@
+#include <catch2/catch_test_macros.hpp>
+#include "moving_target_search.h"
+#include "map.h"
+#include "map_generator.h"
+#include "pathfinding.h"
+#include "path_test_utils.h"
+#include "../include/ecs/ai_system.h"
+#include "../include/ecs/movement_system.h"
+#include "../include/ecs/system_manager.h"
+#include <chrono>
+#include <random>
+
+using namespace ecs;
+
+namespace {
+
+// A winding corridor of switchbacks: long routes, no shortcuts
+void buildSwitchbacks(Map& map) {
+    map.fill(TileType::WALL);
+    for (int y = 1; y < map.getHeight() - 1; y += 2) {
+        for (int x = 1; x < map.getWidth() - 1; x++) {
+            map.setTile(x, y, TileType::FLOOR);
+        }
+        if (y + 1 < map.getHeight() - 1) {
+            int link = (y / 2) % 2 == 0 ? map.getWidth() - 2 : 1;
+            map.setTile(link, y + 1, TileType::FLOOR);
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("MovingTargetSearch: Shortest paths while both ends move", "[pathfinding][incremental]") {
+    Map map(198, 66);
+    MapGenerator::generate(map, MapType::PROCEDURAL, 8080);
+    for (int y = 0; y < map.getHeight(); y++) {
+        for (int x = 0; x < map.getWidth(); x++) {
+            if (map.getTile(x, y) == TileType::DOOR_CLOSED) map.setTile(x, y, TileType::DOOR_OPEN);
+        }
+    }
+    std::vector<Point> tiles = walkableTiles(map);
+
+    std::mt19937 rng(13);
+    MovingTargetSearch search(1u << 16);
+    PathfindingContext context;
+    std::vector<Point> path;
+    std::vector<Point> exact;
+
+    for (int chase = 0; chase < 10; chase++) {
+        Point hunter = tiles[rng() % tiles.size()];
+        Point target = tiles[rng() % tiles.size()];
+        for (int turn = 0; turn < 30; turn++) {
+            bool reachable = Pathfinding::findPath(hunter, target, map, context, exact, false);
+            REQUIRE(search.findPath(map, hunter, target, path) == reachable);
+            if (!reachable) break;
+            if (hunter == target) {
+                REQUIRE(path.empty());
+                break;
+            }
+            requireValidPath(hunter, target, path, map);
+            REQUIRE(path.size() == exact.size());
+
+            // The hunter follows its path; the target wanders
+            hunter = path.front();
+            Point step = target + Pathfinding::DIRECTIONS_4[rng() % 4];
+            if (map.isWalkable(step.x, step.y)) target = step;
+        }
+    }
+}
+
+TEST_CASE("MovingTargetSearch: Corridor chase reuses the search", "[pathfinding][incremental]") {
+    Map map(80, 5);
+    map.fill(TileType::WALL);
+    for (int x = 1; x < 79; x++) {
+        map.setTile(x, 2, TileType::FLOOR);
+    }
+
+    MovingTargetSearch search;
+    std::vector<Point> path;
+    Point hunter(1, 2);
+    Point target(40, 2);
+    REQUIRE(search.findPath(map, hunter, target, path));
+    REQUIRE(search.getExpandedCount() == 40);
+
+    for (int turn = 0; turn < 20; turn++) {
+        hunter = path.front();
+        target.x++;  // fleeing down the corridor
+        REQUIRE(search.findPath(map, hunter, target, path));
+        REQUIRE(path.back() == target);
+        REQUIRE(search.getExpandedCount() <= 3);
+    }
+}
+
+TEST_CASE("MovingTargetSearch: Doors repair the tree", "[pathfinding][incremental]") {
+    // Two routes from left to right: a short one through a door, a long loop
+    Map map(40, 13);
+    map.fill(TileType::WALL);
+    for (int x = 1; x < 39; x++) {
+        map.setTile(x, 6, TileType::FLOOR);
+        map.setTile(x, 1, TileType::FLOOR);
+    }
+    for (int y = 1; y < 7; y++) {
+        map.setTile(1, y, TileType::FLOOR);
+        map.setTile(38, y, TileType::FLOOR);
+    }
+    map.setTile(20, 6, TileType::DOOR_OPEN);
+
+    MovingTargetSearch search;
+    std::vector<Point> path;
+    REQUIRE(search.findPath(map, Point(2, 6), Point(36, 6), path));
+    REQUIRE(path.size() == 34);
+
+    map.setTile(20, 6, TileType::DOOR_CLOSED);
+    REQUIRE(search.findPath(map, Point(2, 6), Point(36, 6), path));
+    requireValidPath(Point(2, 6), Point(36, 6), path, map);
+    REQUIRE(path.size() == 1 + 5 + 37 + 5 + 2);
+
+    map.setTile(20, 6, TileType::DOOR_OPEN);
+    REQUIRE(search.findPath(map, Point(2, 6), Point(36, 6), path));
+    REQUIRE(path.size() == 34);
+
+    SECTION("Water blocks the short route without changing sight") {
+        map.setTile(20, 6, TileType::WATER);
+        REQUIRE(search.findPath(map, Point(2, 6), Point(36, 6), path));
+        requireValidPath(Point(2, 6), Point(36, 6), path, map);
+        REQUIRE(path.size() == 1 + 5 + 37 + 5 + 2);
+    }
+
+    SECTION("Doors away from the tree change nothing") {
+        map.setTile(0, 0, TileType::FLOOR);
+        REQUIRE(search.findPath(map, Point(2, 6), Point(36, 6), path));
+        REQUIRE(search.getExpandedCount() == 0);
+    }
+}
+
+TEST_CASE("MovingTargetSearch: Node limit bounds memory", "[pathfinding][incremental]") {
+    Map map(100, 100);
+    map.fill(TileType::FLOOR);
+    for (int y = 0; y < 99; y++) {
+        map.setTile(50, y, TileType::WALL);
+    }
+
+    MovingTargetSearch search(256);
+    std::vector<Point> path;
+    REQUIRE_FALSE(search.findPath(map, Point(45, 5), Point(55, 5), path));
+    REQUIRE(search.hitNodeLimit());
+    REQUIRE(search.getNodeCount() == 0);
+
+    REQUIRE(search.findPath(map, Point(45, 5), Point(40, 8), path));
+    REQUIRE_FALSE(search.hitNodeLimit());
+    REQUIRE(search.getNodeCount() <= search.getNodeLimit());
+}
+
+TEST_CASE("AISystem: Hunters keep their search between turns", "[pathfinding][incremental][ai]") {
+    Map map(60, 5);
+    map.fill(TileType::WALL);
+    for (int x = 1; x < 59; x++) {
+        map.setTile(x, 2, TileType::FLOOR);
+    }
+
+    World world;
+    auto& movement = world.registerSystem<MovementSystem>(&map);
+    movement.setWorld(&world);
+    AISystem ai_system(&map, &movement, nullptr, nullptr);
+    ai_system.setWorld(&world);
+
+    Entity& player = world.createEntity();
+    player.addComponent<PositionComponent>(50, 2);
+    ai_system.setPlayerId(player.getID());
+
+    // Out of sight, heading for where the player was last seen
+    Entity& monster = world.createEntity();
+    monster.addComponent<PositionComponent>(5, 2);
+    auto& ai = monster.addComponent<AIComponent>();
+    ai.behavior = AIBehavior::AGGRESSIVE;
+    ai.vision_range = 3;
+    ai.has_seen_player = true;
+    ai.last_player_position = Point(25, 2);
+
+    ai_system.update(world, 0.0);
+    movement.update(world.getEntities(), 0.0);
+    REQUIRE(monster.getComponent<PositionComponent>()->position == Point(6, 2));
+    REQUIRE(ai.search.getExpandedCount() == 21);
+
+    // The remembered position shifts; the search is repaired, not redone
+    ai.last_player_position = Point(26, 2);
+    ai_system.update(world, 0.0);
+    movement.update(world.getEntities(), 0.0);
+    REQUIRE(monster.getComponent<PositionComponent>()->position == Point(7, 2));
+    REQUIRE(ai.search.getExpandedCount() <= 2);
+    REQUIRE(ai.path.size() == 19);
+}
+
+TEST_CASE("MovingTargetSearch: Corridor chase benchmark", "[pathfinding][incremental][!benchmark][.]") {
+    constexpr int TURNS = 400;
+    Map map(200, 101);
+    buildSwitchbacks(map);
+
+    auto run = [&](bool incremental, long& expansions) {
+        MovingTargetSearch search(1u << 16);
+        PathfindingContext context;
+        std::vector<Point> path;
+        Point hunter(1, 1);
+        Point target(60, 5);
+        expansions = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int turn = 0; turn < TURNS; turn++) {
+            if (incremental) {
+                search.findPath(map, hunter, target, path);
+                expansions += search.getExpandedCount();
+            } else {
+                Pathfinding::findPath(hunter, target, map, context, path, false);
+                expansions += context.getExpandedCount();
+            }
+            hunter = path.front();
+            // The target flees along the corridor, a door shuts now and then
+            Point step = target + Point(turn / 100 % 2 ? -1 : 1, 0);
+            if (map.isWalkable(step.x, step.y)) target = step;
+            if (turn % 50 == 25) {
+                map.setTile(3, 99, map.isWalkable(3, 99) ? TileType::DOOR_CLOSED : TileType::DOOR_OPEN);
+            }
+        }
+        return std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - start).count() / TURNS;
+    };
+
+    long full_expansions = 0;
+    long incremental_expansions = 0;
+    double full = run(false, full_expansions);
+    double incremental = run(true, incremental_expansions);
+    WARN("Corridor chase: full replanning " << full_expansions / TURNS << " expansions/turn ("
+         << full << " us), incremental " << incremental_expansions / static_cast<double>(TURNS)
+         << " expansions/turn (" << incremental << " us)");
+    REQUIRE(incremental_expansions < full_expansions);
+}
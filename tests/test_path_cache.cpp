@@ -0,0 +1,316 @@
+#include <catch2/catch_test_macros.hpp>
+#include "path_cache.h"
+#include "frame_stats.h"
+#include "map.h"
+#include "map_generator.h"
+#include "pathfinding.h"
+#include "path_test_utils.h"
+#include "../include/ecs/ai_system.h"
+#include "../include/ecs/movement_system.h"
+#include "../include/ecs/system_manager.h"
+#include <chrono>
+#include <deque>
+#include <random>
+
+using namespace ecs;
+
+TEST_CASE("Map: Chunk versions follow walkability", "[map][path_cache]") {
+    Map map(40, 20);
+    map.fill(TileType::FLOOR);
+    const int chunk = map.getChunkIndex(5, 5);
+    const int other = map.getChunkIndex(30, 5);
+    REQUIRE(chunk != other);
+    REQUIRE(map.getChunkIndex(Point(15, 15)) == chunk);
+
+    uint32_t version = map.getChunkVersion(chunk);
+    uint32_t other_version = map.getChunkVersion(other);
+    map.setTile(5, 5, TileType::WALL);
+    REQUIRE(map.getChunkVersion(chunk) == version + 1);
+    REQUIRE(map.getChunkVersion(other) == other_version);
+
+    // Same walkability, same version
+    map.setTile(5, 6, TileType::STAIRS_DOWN);
+    REQUIRE(map.getChunkVersion(chunk) == version + 1);
+
+    map.fill(TileType::WALL);
+    REQUIRE(map.getChunkVersion(chunk) == version + 2);
+    REQUIRE(map.getChunkVersion(other) == other_version + 1);
+}
+
+TEST_CASE("Map: Walkability changes are logged", "[map][path_cache]") {
+    Map map(40, 20);
+    map.fill(TileType::FLOOR);
+    const uint32_t version = map.getWalkabilityVersion();
+    const uint32_t transparency = map.getTransparencyVersion();
+
+    map.setTile(5, 5, TileType::LAVA);
+    map.setTile(6, 5, TileType::STAIRS_DOWN);  // still walkable
+    map.setTile(7, 5, TileType::WATER);
+    REQUIRE(map.getWalkabilityVersion() == version + 2);
+    REQUIRE(map.getTransparencyVersion() == transparency);
+
+    std::vector<Point> changes;
+    REQUIRE(map.getWalkabilityChanges(version, changes));
+    REQUIRE(changes == std::vector<Point>{Point(5, 5), Point(7, 5)});
+
+    map.fill(TileType::FLOOR);
+    changes.clear();
+    REQUIRE_FALSE(map.getWalkabilityChanges(version, changes));
+    REQUIRE(map.getWalkabilityChanges(map.getWalkabilityVersion(), changes));
+    REQUIRE(changes.empty());
+}
+
+TEST_CASE("PathCache: Walkers from one chunk share a path", "[pathfinding][path_cache]") {
+    Map map(80, 40);
+    map.fill(TileType::FLOOR);
+    for (int y = 0; y < 30; y++) {
+        map.setTile(40, y, TileType::WALL);
+    }
+
+    PathCache cache;
+    const Point goal(70, 5);
+    SharedPath first;
+    REQUIRE_FALSE(cache.lookup(map, Point(3, 3), goal, false, first));
+    first = cache.store(map, Point(3, 3), goal, false, Pathfinding::findPath(Point(3, 3), goal, map, false));
+    REQUIRE(cache.size() == 1);
+    REQUIRE(first.isShared());
+
+    SECTION("From the same tile the steps are shared, not copied") {
+        SharedPath again;
+        REQUIRE(cache.lookup(map, Point(3, 3), goal, false, again));
+        REQUIRE(again.size() == first.size());
+        REQUIRE(again.span().data() == first.span().data());
+    }
+
+    SECTION("From a tile on the path, the rest of it") {
+        SharedPath rest;
+        Point on = first[4];
+        REQUIRE(cache.lookup(map, on, goal, false, rest));
+        REQUIRE(rest.size() == first.size() - 5);
+        REQUIRE(rest.span().data() == first.span().data() + 5);
+        requireValidPath(on, goal, rest, map);
+    }
+
+    SECTION("From elsewhere in the chunk, a short leg onto the path") {
+        SharedPath joined;
+        REQUIRE(cache.lookup(map, Point(12, 12), goal, false, joined));
+        requireValidPath(Point(12, 12), goal, joined, map);
+        std::vector<Point> exact = Pathfinding::findPath(Point(12, 12), goal, map, false);
+        REQUIRE(joined.size() <= exact.size() + 2 * Map::CHUNK_SIZE);
+
+        // Walking it works like a deque
+        Point prev = Point(12, 12);
+        while (!joined.empty()) {
+            REQUIRE(std::abs(joined.front().x - prev.x) + std::abs(joined.front().y - prev.y) == 1);
+            prev = joined.front();
+            joined.pop_front();
+        }
+        REQUIRE(prev == goal);
+    }
+
+    SECTION("Other chunks, goals and movement modes miss") {
+        SharedPath path;
+        REQUIRE_FALSE(cache.lookup(map, Point(20, 3), goal, false, path));
+        REQUIRE_FALSE(cache.lookup(map, Point(3, 3), Point(70, 6), false, path));
+        REQUIRE_FALSE(cache.lookup(map, Point(3, 3), goal, true, path));
+        REQUIRE(path.empty());
+    }
+
+    REQUIRE(cache.getHits() + cache.getMisses() > 0);
+    cache.resetStats();
+    REQUIRE(cache.getHits() == 0);
+    REQUIRE(cache.getMisses() == 0);
+}
+
+TEST_CASE("PathCache: Changed chunks invalidate entries", "[pathfinding][path_cache]") {
+    Map map(80, 40);
+    map.fill(TileType::FLOOR);
+
+    PathCache cache;
+    const Point start(3, 3);
+    const Point goal(70, 3);
+    SharedPath path = cache.store(map, start, goal, false, Pathfinding::findPath(start, goal, map, false));
+
+    // Far from the path: still good
+    map.setTile(40, 35, TileType::WALL);
+    REQUIRE(cache.lookup(map, start, goal, false, path));
+
+    // On a chunk the path crosses: gone, even though the path itself is clear
+    map.setTile(40, 10, TileType::WALL);
+    REQUIRE_FALSE(cache.lookup(map, start, goal, false, path));
+    REQUIRE(cache.size() == 0);
+
+    SECTION("Walkers keep their steps after the entry is dropped") {
+        SharedPath walker = cache.store(map, start, goal, false, Pathfinding::findPath(start, goal, map, false));
+        cache.clear();
+        REQUIRE_FALSE(walker.isShared());
+        requireValidPath(start, goal, walker, map);
+    }
+
+    SECTION("Another map clears the cache") {
+        cache.store(map, start, goal, false, Pathfinding::findPath(start, goal, map, false));
+        Map other(80, 40);
+        other.fill(TileType::FLOOR);
+        REQUIRE_FALSE(cache.lookup(other, start, goal, false, path));
+        REQUIRE(cache.size() == 0);
+    }
+}
+
+TEST_CASE("PathCache: Capacity evicts the least recently used", "[pathfinding][path_cache]") {
+    Map map(64, 64);
+    map.fill(TileType::FLOOR);
+
+    PathCache cache(2);
+    SharedPath path;
+    auto add = [&](const Point& goal) {
+        cache.store(map, Point(1, 1), goal, false, Pathfinding::findPath(Point(1, 1), goal, map, false));
+    };
+    add(Point(50, 1));
+    add(Point(50, 2));
+    REQUIRE(cache.lookup(map, Point(1, 1), Point(50, 1), false, path));
+    add(Point(50, 3));
+    REQUIRE(cache.size() == 2);
+    REQUIRE(cache.lookup(map, Point(1, 1), Point(50, 1), false, path));
+    REQUIRE_FALSE(cache.lookup(map, Point(1, 1), Point(50, 2), false, path));
+    REQUIRE(cache.lookup(map, Point(1, 1), Point(50, 3), false, path));
+}
+
+TEST_CASE("PathCache: Hits are valid and near-optimal", "[pathfinding][path_cache]") {
+    Map map(198, 66);
+    MapGenerator::generate(map, MapType::PROCEDURAL, 8080);
+    for (int y = 0; y < map.getHeight(); y++) {
+        for (int x = 0; x < map.getWidth(); x++) {
+            if (map.getTile(x, y) == TileType::DOOR_CLOSED) map.setTile(x, y, TileType::DOOR_OPEN);
+        }
+    }
+    std::vector<Point> tiles = walkableTiles(map);
+
+    std::mt19937 rng(21);
+    std::vector<Point> goals;
+    for (int i = 0; i < 4; i++) {
+        goals.push_back(tiles[rng() % tiles.size()]);
+    }
+
+    PathCache cache;
+    SharedPath path;
+    size_t exact_steps = 0;
+    size_t cached_steps = 0;
+    for (int i = 0; i < 400; i++) {
+        Point start = tiles[rng() % tiles.size()];
+        Point goal = goals[rng() % goals.size()];
+        std::vector<Point> exact = Pathfinding::findPath(start, goal, map, false);
+        bool hit = cache.lookup(map, start, goal, false, path);
+        if (!hit) {
+            if (exact.empty()) continue;
+            path = cache.store(map, start, goal, false, exact);
+        }
+        if (start == goal) continue;
+        REQUIRE_FALSE(exact.empty());
+        requireValidPath(start, goal, path, map);
+        exact_steps += exact.size();
+        cached_steps += path.size();
+    }
+    REQUIRE(cache.getHits() > 0);
+    REQUIRE(cached_steps * 100 <= exact_steps * 115);
+}
+
+TEST_CASE("AISystem: Monsters on the same errand share a path", "[pathfinding][path_cache][ai]") {
+    Map map(100, 7);
+    map.fill(TileType::WALL);
+    for (int y = 1; y < 6; y++) {
+        for (int x = 1; x < 99; x++) {
+            map.setTile(x, y, TileType::FLOOR);
+        }
+    }
+
+    World world;
+    auto& movement = world.registerSystem<MovementSystem>(&map);
+    movement.setWorld(&world);
+    AISystem ai_system(&map, &movement, nullptr, nullptr);
+    ai_system.setWorld(&world);
+
+    Entity& player = world.createEntity();
+    player.addComponent<PositionComponent>(95, 3);
+    ai_system.setPlayerId(player.getID());
+
+    // Both heading for where the player was last seen, far down the hall
+    std::vector<AIComponent*> hunters;
+    for (int y : {2, 4}) {
+        Entity& monster = world.createEntity();
+        monster.addComponent<PositionComponent>(4, y);
+        auto& ai = monster.addComponent<AIComponent>();
+        ai.behavior = AIBehavior::AGGRESSIVE;
+        ai.vision_range = 3;
+        ai.has_seen_player = true;
+        ai.last_player_position = Point(90, 3);
+        hunters.push_back(&ai);
+    }
+
+    ai_system.update(world, 0.0);
+    REQUIRE(ai_system.getPathCache().getMisses() == 1);
+    REQUIRE(ai_system.getPathCache().getHits() == 1);
+    for (AIComponent* ai : hunters) {
+        REQUIRE(ai->path.isShared());
+        REQUIRE(ai->path.back() == Point(90, 3));
+    }
+
+    FrameStats stats;
+    stats.recordPathQueries(ai_system.getPathCache().getHits(), ai_system.getPathCache().getMisses());
+    REQUIRE(stats.getPathHits() == 1);
+    REQUIRE(stats.getPathMisses() == 1);
+    REQUIRE(stats.formatDetailed().find("Paths: 1 hit/1 miss") != std::string::npos);
+
+    // Following their paths needs no new queries
+    movement.update(world.getEntities(), 0.0);
+    ai_system.update(world, 0.0);
+    REQUIRE(ai_system.getPathCache().getHits() + ai_system.getPathCache().getMisses() == 0);
+}
+
+TEST_CASE("PathCache: Shared errand benchmark", "[pathfinding][path_cache][!benchmark][.]") {
+    using Clock = std::chrono::steady_clock;
+    Map map(198, 66);
+    MapGenerator::generate(map, MapType::PROCEDURAL, 4242);
+    for (int y = 0; y < map.getHeight(); y++) {
+        for (int x = 0; x < map.getWidth(); x++) {
+            if (map.getTile(x, y) == TileType::DOOR_CLOSED) map.setTile(x, y, TileType::DOOR_OPEN);
+        }
+    }
+
+    // Every room's monsters head for the same far-off stairs
+    std::vector<Point> tiles = walkableTiles(map);
+    const Point stairs = tiles.back();
+    std::vector<Point> starts;
+    for (const Room& room : map.getRooms()) {
+        for (int k = 0; k < 8; k++) {
+            Point p(room.left() + 1 + k % std::max(1, room.width - 2), room.top() + 1 + k / 4 % std::max(1, room.height - 2));
+            if (map.isWalkable(p.x, p.y)) starts.push_back(p);
+        }
+    }
+
+    PathfindingContext context;
+    std::vector<Point> steps;
+    auto t0 = Clock::now();
+    size_t copied = 0;
+    for (const Point& start : starts) {
+        Pathfinding::findPath(start, stairs, map, context, steps, false);
+        std::deque<Point> path(steps.begin(), steps.end());
+        copied += path.size();
+    }
+    double uncached = std::chrono::duration<double, std::micro>(Clock::now() - t0).count() / starts.size();
+
+    PathCache cache;
+    SharedPath path;
+    t0 = Clock::now();
+    for (const Point& start : starts) {
+        if (!cache.lookup(map, start, stairs, false, path) &&
+            Pathfinding::findPath(start, stairs, map, context, steps, false)) {
+            path = cache.store(map, start, stairs, false, steps);
+        }
+    }
+    double cached = std::chrono::duration<double, std::micro>(Clock::now() - t0).count() / starts.size();
+
+    WARN(starts.size() << " monsters to one staircase: A* + deque copy " << uncached << " us each, cache "
+         << cached << " us each (" << cache.getHits() << " hits, " << cache.getMisses() << " misses)");
+    REQUIRE(copied > 0);
+    REQUIRE(cache.getHits() > 0);
+}
@@ -0,0 +1,200 @@
+#include <catch2/catch_test_macros.hpp>
+#include "map.h"
+#include "map_generator.h"
+#include "path_test_utils.h"
+#include "thread_pool.h"
+#include "../include/ecs/ai_system.h"
+#include "../include/ecs/combat_component.h"
+#include "../include/ecs/movement_system.h"
+#include "../include/ecs/system_manager.h"
+#include <chrono>
+#include <random>
+
+using namespace ecs;
+
+namespace {
+
+// A generated level with every door open: one big connected space
+void buildStressMap(Map& map, unsigned seed) {
+    MapGenerator::generate(map, MapType::PROCEDURAL, seed);
+    for (int y = 0; y < map.getHeight(); y++) {
+        for (int x = 0; x < map.getWidth(); x++) {
+            if (map.getTile(x, y) == TileType::DOOR_CLOSED) map.setTile(x, y, TileType::DOOR_OPEN);
+        }
+    }
+}
+
+/**
+ * Hunters heading for remembered player positions that drift every
+ * turn; most are near (searched as jobs), some far (route planner)
+ */
+class HuntScenario {
+public:
+    HuntScenario(Map& map, int hunters, unsigned seed, ThreadPool* pool)
+        : map(map)
+        , movement(world.registerSystem<MovementSystem>(&map))
+        , ai_system(&map, &movement, nullptr, nullptr)
+        , rng(seed) {
+        movement.setWorld(&world);
+        ai_system.setWorld(&world);
+        ai_system.setThreadPool(pool);
+
+        tiles = walkableTiles(map);
+        // The player is out of everyone's sight; only memories are chased
+        Entity& player = world.createEntity();
+        player.addComponent<PositionComponent>(0, 0);
+        ai_system.setPlayerId(player.getID());
+
+        for (int i = 0; i < hunters; i++) {
+            Entity& monster = world.createEntity();
+            Point start = tiles[rng() % tiles.size()];
+            monster.addComponent<PositionComponent>(start.x, start.y);
+            monster.addComponent<CombatComponent>();  // monsters block each other
+            auto& ai = monster.addComponent<AIComponent>();
+            ai.behavior = AIBehavior::AGGRESSIVE;
+            ai.vision_range = 1;
+            ai.has_seen_player = true;
+            ai.last_player_position = i % 8 == 0 ? tiles[rng() % tiles.size()] : nearbyTile(start);
+            monsters.push_back(&monster);
+        }
+    }
+
+    // One AI turn and its movement phase
+    void turn() {
+        for (Entity* monster : monsters) {
+            auto& ai = *monster->getComponent<AIComponent>();
+            ai.turns_since_player_seen = 0;
+            Point drift = ai.last_player_position + Pathfinding::DIRECTIONS_4[rng() % 4];
+            if (map.isWalkable(drift.x, drift.y)) ai.last_player_position = drift;
+        }
+        ai_system.update(world, 0.0);
+        movement.update(world.getEntities(), 0.0);
+    }
+
+    std::vector<Point> positions() const {
+        std::vector<Point> result;
+        for (Entity* monster : monsters) {
+            result.push_back(monster->getComponent<PositionComponent>()->position);
+        }
+        return result;
+    }
+
+    AISystem& getAISystem() { return ai_system; }
+
+private:
+    Map& map;
+    World world;
+    MovementSystem& movement;
+    AISystem ai_system;
+    std::mt19937 rng;
+    std::vector<Point> tiles;
+    std::vector<Entity*> monsters;
+
+    Point nearbyTile(const Point& from) {
+        for (int tries = 0; tries < 50; tries++) {
+            Point p = tiles[rng() % tiles.size()];
+            int distance = std::abs(p.x - from.x) + std::abs(p.y - from.y);
+            if (distance > 4 && distance < AISystem::LONG_PATH_DISTANCE) return p;
+        }
+        return from;
+    }
+};
+
+} // namespace
+
+TEST_CASE("AISystem: Batched path searches match any worker count", "[pathfinding][ai][threads]") {
+    Map map(198, 66);
+    buildStressMap(map, 515);
+
+    std::vector<std::vector<Point>> serial;
+    {
+        HuntScenario scenario(map, 200, 3, nullptr);
+        for (int t = 0; t < 6; t++) {
+            scenario.turn();
+            serial.push_back(scenario.positions());
+        }
+        REQUIRE(scenario.getAISystem().getPathJobCount() == 0);
+    }
+    // Monsters actually moved
+    REQUIRE(serial.front() != serial.back());
+
+    for (size_t workers : {1u, 2u, 4u}) {
+        ThreadPool pool(workers);
+        HuntScenario scenario(map, 200, 3, &pool);
+        for (int t = 0; t < 6; t++) {
+            scenario.turn();
+            REQUIRE(scenario.getAISystem().getPathJobCount() > 0);
+            REQUIRE(scenario.positions() == serial[t]);
+        }
+    }
+}
+
+TEST_CASE("AISystem: Batched moves keep their turn order", "[pathfinding][ai][threads]") {
+    // Two hunters want the same tile; the first to decide gets it
+    Map map(20, 5);
+    map.fill(TileType::WALL);
+    for (int x = 1; x < 19; x++) {
+        map.setTile(x, 2, TileType::FLOOR);
+    }
+    map.setTile(10, 1, TileType::FLOOR);
+    map.setTile(10, 3, TileType::FLOOR);
+
+    ThreadPool pool(2);
+    World world;
+    auto& movement = world.registerSystem<MovementSystem>(&map);
+    movement.setWorld(&world);
+    AISystem ai_system(&map, &movement, nullptr, nullptr);
+    ai_system.setWorld(&world);
+    ai_system.setThreadPool(&pool);
+
+    Entity& player = world.createEntity();
+    player.addComponent<PositionComponent>(1, 2);
+    ai_system.setPlayerId(player.getID());
+
+    std::vector<Entity*> hunters;
+    for (int y : {1, 3}) {
+        Entity& monster = world.createEntity();
+        monster.addComponent<PositionComponent>(10, y);
+        monster.addComponent<CombatComponent>();
+        auto& ai = monster.addComponent<AIComponent>();
+        ai.behavior = AIBehavior::AGGRESSIVE;
+        ai.vision_range = 1;
+        ai.has_seen_player = true;
+        ai.last_player_position = Point(15, 2);
+        hunters.push_back(&monster);
+    }
+
+    ai_system.update(world, 0.0);
+    REQUIRE(ai_system.getPathJobCount() == 2);
+    movement.update(world.getEntities(), 0.0);
+    REQUIRE(hunters[0]->getComponent<PositionComponent>()->position == Point(10, 2));
+    REQUIRE(hunters[1]->getComponent<PositionComponent>()->position == Point(10, 3));
+}
+
+TEST_CASE("AISystem: Batched pathfinding benchmark", "[pathfinding][ai][threads][!benchmark][.]") {
+    using Clock = std::chrono::steady_clock;
+    constexpr int HUNTERS = 600;
+    constexpr int TURNS = 20;
+    Map map(198, 66);
+    buildStressMap(map, 4242);
+
+    auto run = [&](ThreadPool* pool) {
+        HuntScenario scenario(map, HUNTERS, 11, pool);
+        scenario.turn();  // first searches from scratch
+        auto start = Clock::now();
+        for (int t = 0; t < TURNS; t++) {
+            scenario.turn();
+        }
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count() / TURNS;
+    };
+
+    double serial = run(nullptr);
+    WARN(HUNTERS << " hunters, synchronous: " << serial << " ms/turn");
+    for (size_t workers : {1u, 2u, 4u, 8u}) {
+        ThreadPool pool(workers);
+        double batched = run(&pool);
+        WARN(HUNTERS << " hunters, " << workers << " workers: " << batched << " ms/turn ("
+             << serial / batched << "x)");
+    }
+    REQUIRE(serial > 0.0);
+}
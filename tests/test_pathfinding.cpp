@@ -0,0 +1,252 @@
+#include <catch2/catch_test_macros.hpp>
+#include "pathfinding.h"
+#include "map.h"
+#include "map_generator.h"
+#include "path_test_utils.h"
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <queue>
+#include <random>
+
+namespace {
+
+// Reference Dijkstra over the same step costs as Pathfinding
+uint32_t dijkstraCost(const Point& start, const Point& goal, const Map& map, bool allow_diagonals) {
+    const int width = map.getWidth();
+    std::vector<uint32_t> dist(static_cast<size_t>(width) * map.getHeight(), UINT32_MAX);
+    using Entry = std::pair<uint32_t, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    dist[start.y * width + start.x] = 0;
+    open.push({0, start.y * width + start.x});
+
+    const Point* dirs = allow_diagonals ? Pathfinding::DIRECTIONS_8 : Pathfinding::DIRECTIONS_4;
+    const int count = allow_diagonals ? 8 : 4;
+    while (!open.empty()) {
+        auto [d, index] = open.top();
+        open.pop();
+        if (d > dist[index]) continue;
+        Point p(index % width, index / width);
+        if (p == goal) return d;
+        for (int i = 0; i < count; i++) {
+            Point n = p + dirs[i];
+            if (!map.isWalkable(n.x, n.y)) continue;
+            uint32_t cost = d + ((dirs[i].x && dirs[i].y) ? Pathfinding::DIAGONAL_COST : Pathfinding::STRAIGHT_COST);
+            int ni = n.y * width + n.x;
+            if (cost < dist[ni]) {
+                dist[ni] = cost;
+                open.push({cost, ni});
+            }
+        }
+    }
+    return UINT32_MAX;
+}
+
+// Cost of a path, checking every step is a legal move
+uint32_t pathCost(const Point& start, const std::vector<Point>& path, const Map& map, bool allow_diagonals) {
+    uint32_t cost = 0;
+    Point prev = start;
+    for (const Point& p : path) {
+        int dx = std::abs(p.x - prev.x);
+        int dy = std::abs(p.y - prev.y);
+        REQUIRE(map.isWalkable(p.x, p.y));
+        REQUIRE(std::max(dx, dy) == 1);
+        if (!allow_diagonals) REQUIRE(dx + dy == 1);
+        cost += (dx && dy) ? Pathfinding::DIAGONAL_COST : Pathfinding::STRAIGHT_COST;
+        prev = p;
+    }
+    return cost;
+}
+
+// The std::map based A* this engine replaced, kept for the benchmark
+std::vector<Point> legacyFindPath(const Point& start, const Point& goal, const Map& map) {
+    struct Node {
+        Point pos;
+        float g_cost;
+        float f_cost;
+        bool operator>(const Node& other) const { return f_cost > other.f_cost; }
+    };
+    std::priority_queue<Node, std::vector<Node>, std::greater<Node>> open_set;
+    std::map<Point, float> g_scores;
+    std::map<Point, Point> came_from;
+    open_set.push({start, 0, Pathfinding::getDistance(start, goal)});
+    g_scores[start] = 0;
+
+    while (!open_set.empty()) {
+        Node current = open_set.top();
+        open_set.pop();
+        if (current.pos == goal) {
+            std::vector<Point> path;
+            for (Point cur = goal; came_from.count(cur); cur = came_from.at(cur)) {
+                path.push_back(cur);
+            }
+            std::reverse(path.begin(), path.end());
+            return path;
+        }
+        if (g_scores.count(current.pos) && current.g_cost > g_scores[current.pos]) continue;
+
+        std::vector<Point> neighbors;
+        for (const Point& dir : Pathfinding::DIRECTIONS_8) {
+            Point n = current.pos + dir;
+            if (map.isWalkable(n.x, n.y)) neighbors.push_back(n);
+        }
+        for (const Point& neighbor : neighbors) {
+            bool is_diagonal = (neighbor.x != current.pos.x) && (neighbor.y != current.pos.y);
+            float tentative_g = current.g_cost + (is_diagonal ? 1.41f : 1.0f);
+            if (!g_scores.count(neighbor) || tentative_g < g_scores[neighbor]) {
+                g_scores[neighbor] = tentative_g;
+                came_from[neighbor] = current.pos;
+                open_set.push({neighbor, tentative_g, tentative_g + Pathfinding::getDistance(neighbor, goal)});
+            }
+        }
+    }
+    return {};
+}
+
+// Open floor with scattered rubble and long walls that force detours
+void buildStressMap(Map& map, unsigned seed) {
+    map.fill(TileType::FLOOR);
+    std::mt19937 rng(seed);
+    for (int y = 0; y < map.getHeight(); y++) {
+        for (int x = 0; x < map.getWidth(); x++) {
+            if (rng() % 100 < 25) map.setTile(x, y, TileType::WALL);
+        }
+    }
+    for (int x = 64; x < map.getWidth(); x += 64) {
+        int gap = static_cast<int>(rng() % map.getHeight());
+        for (int y = 0; y < map.getHeight(); y++) {
+            if (std::abs(y - gap) > 2) map.setTile(x, y, TileType::WALL);
+        }
+    }
+    map.setTile(1, 1, TileType::FLOOR);
+    map.setTile(map.getWidth() - 2, map.getHeight() - 2, TileType::FLOOR);
+}
+
+} // namespace
+
+TEST_CASE("Pathfinding: Basic paths", "[pathfinding]") {
+    Map map(20, 10);
+    map.fill(TileType::FLOOR);
+
+    SECTION("Start and goal equal") {
+        auto path = Pathfinding::findPath(Point(3, 3), Point(3, 3), map);
+        REQUIRE(path.size() == 1);
+        REQUIRE(path[0] == Point(3, 3));
+    }
+
+    SECTION("Diagonal shortcut") {
+        auto path = Pathfinding::findPath(Point(0, 0), Point(5, 5), map);
+        REQUIRE(path.size() == 5);
+        REQUIRE(path.back() == Point(5, 5));
+        REQUIRE(pathCost(Point(0, 0), path, map, true) == 5 * Pathfinding::DIAGONAL_COST);
+    }
+
+    SECTION("Cardinal only") {
+        auto path = Pathfinding::findPath(Point(0, 0), Point(5, 5), map, false);
+        REQUIRE(path.size() == 10);
+        REQUIRE(pathCost(Point(0, 0), path, map, false) == 10 * Pathfinding::STRAIGHT_COST);
+    }
+
+    SECTION("Blocked goal") {
+        for (int y = 0; y < 10; y++) {
+            map.setTile(10, y, TileType::WALL);
+        }
+        PathfindingContext context;
+        std::vector<Point> path{Point(1, 1)};
+        REQUIRE_FALSE(Pathfinding::findPath(Point(2, 2), Point(15, 5), map, context, path));
+        REQUIRE(path.empty());
+        REQUIRE_FALSE(Pathfinding::findPath(Point(2, 2), Point(10, 5), map, context, path));
+    }
+}
+
+TEST_CASE("Pathfinding: Optimal on generated maps", "[pathfinding]") {
+    Map map(198, 66);
+    MapGenerator::generate(map, MapType::PROCEDURAL, 8080);
+    std::vector<Point> tiles = walkableTiles(map);
+    REQUIRE(tiles.size() > 100);
+
+    PathfindingContext context;
+    std::vector<Point> path;
+    std::mt19937 rng(5);
+    for (int i = 0; i < 40; i++) {
+        Point start = tiles[rng() % tiles.size()];
+        Point goal = tiles[rng() % tiles.size()];
+        for (bool diagonals : {true, false}) {
+            uint32_t expected = dijkstraCost(start, goal, map, diagonals);
+            bool found = Pathfinding::findPath(start, goal, map, context, path, diagonals);
+            REQUIRE(found == (expected != UINT32_MAX));
+            if (found && start != goal) {
+                REQUIRE(path.back() == goal);
+                REQUIRE(pathCost(start, path, map, diagonals) == expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("Pathfinding: Context reuse across maps", "[pathfinding]") {
+    Map small(30, 20);
+    MapGenerator::generate(small, MapType::TEST_ROOM);
+    Map large(198, 66);
+    MapGenerator::generate(large, MapType::PROCEDURAL, 17);
+    std::vector<Point> small_tiles = walkableTiles(small);
+    std::vector<Point> large_tiles = walkableTiles(large);
+
+    PathfindingContext shared;
+    std::vector<Point> shared_path;
+    std::vector<Point> fresh_path;
+    std::mt19937 rng(9);
+    for (int i = 0; i < 30; i++) {
+        const Map& map = (i % 3 == 0) ? small : large;
+        const auto& tiles = (i % 3 == 0) ? small_tiles : large_tiles;
+        Point start = tiles[rng() % tiles.size()];
+        Point goal = tiles[rng() % tiles.size()];
+
+        PathfindingContext fresh;
+        bool a = Pathfinding::findPath(start, goal, map, shared, shared_path);
+        bool b = Pathfinding::findPath(start, goal, map, fresh, fresh_path);
+        REQUIRE(a == b);
+        REQUIRE(shared_path == fresh_path);
+    }
+}
+
+TEST_CASE("Pathfinding: Long path benchmark", "[pathfinding][!benchmark][.]") {
+    using Clock = std::chrono::steady_clock;
+
+    auto run = [](const char* name, const Map& map, const Point& start, const Point& goal,
+                  int repeats, bool with_legacy) {
+        PathfindingContext context;
+        std::vector<Point> path;
+        auto t0 = Clock::now();
+        for (int i = 0; i < repeats; i++) {
+            Pathfinding::findPath(start, goal, map, context, path);
+        }
+        double fast = std::chrono::duration<double, std::micro>(Clock::now() - t0).count() / repeats;
+        REQUIRE_FALSE(path.empty());
+
+        double legacy = 0.0;
+        if (with_legacy) {
+            t0 = Clock::now();
+            std::vector<Point> old_path;
+            for (int i = 0; i < repeats; i++) {
+                old_path = legacyFindPath(start, goal, map);
+            }
+            legacy = std::chrono::duration<double, std::micro>(Clock::now() - t0).count() / repeats;
+            REQUIRE_FALSE(old_path.empty());
+        }
+
+        WARN(name << ": " << path.size() << " steps, " << context.getExpandedCount()
+             << " nodes expanded; context A* " << fast << " us"
+             << (with_legacy ? ", std::map A* " + std::to_string(legacy) + " us" : std::string()));
+    };
+
+    Map dungeon(198, 66);
+    MapGenerator::generate(dungeon, MapType::PROCEDURAL, 4242);
+    std::vector<Point> tiles = walkableTiles(dungeon);
+    auto far_pair = std::minmax_element(tiles.begin(), tiles.end(),
+        [](const Point& a, const Point& b) { return a.x + a.y < b.x + b.y; });
+    run("198x66 dungeon", dungeon, *far_pair.first, *far_pair.second, 50, true);
+
+    Map stress(1024, 1024);
+    buildStressMap(stress, 1);
+    run("1024x1024 stress", stress, Point(1, 1), Point(1022, 1022), 3, true);
+}
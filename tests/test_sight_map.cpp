@@ -0,0 +1,227 @@
+#include <catch2/catch_test_macros.hpp>
+#include "sight_map.h"
+#include "fov.h"
+#include "map.h"
+#include "map_generator.h"
+#include "pathfinding.h"
+#include "../include/ecs/ai_system.h"
+#include "../include/ecs/system_manager.h"
+#include <chrono>
+#include <cstdlib>
+#include <random>
+
+using namespace ecs;
+
+TEST_CASE("SightMap: Matches a full FOV", "[fov][sight]") {
+    Map map(198, 66);
+    MapGenerator::generate(map, MapType::PROCEDURAL, 777);
+    Point player = MapGenerator::findSafeSpawnPoint(map);
+
+    SightMap sight;
+    REQUIRE(sight.compute(map, player, 12));
+
+    std::vector<std::vector<bool>> visible;
+    FOV::calculate(map, player, 12, visible);
+    for (int y = 0; y < map.getHeight(); y++) {
+        for (int x = 0; x < map.getWidth(); x++) {
+            REQUIRE(sight.canSee(x, y) == visible[y][x]);
+        }
+    }
+
+    SECTION("Smaller ranges agree with a smaller FOV") {
+        FOV::calculate(map, player, 5, visible);
+        for (int y = 0; y < map.getHeight(); y++) {
+            for (int x = 0; x < map.getWidth(); x++) {
+                REQUIRE(sight.canSee(Point(x, y), 5) == visible[y][x]);
+            }
+        }
+    }
+
+    SECTION("Ranges beyond the cast radius are refused") {
+        REQUIRE_FALSE(sight.canSee(player, 13));
+    }
+
+    SECTION("Unchanged inputs are not recomputed") {
+        REQUIRE_FALSE(sight.compute(map, player, 12));
+        map.setTile(player.x + 1, player.y, TileType::DOOR_CLOSED);
+        REQUIRE(sight.compute(map, player, 12));
+        REQUIRE(sight.canSee(player.x + 1, player.y));
+        REQUIRE_FALSE(sight.canSee(player.x + 2, player.y));
+    }
+}
+
+TEST_CASE("FOV: Point query agrees with calculate", "[fov][sight]") {
+    Map map(40, 40);
+    map.fill(TileType::FLOOR);
+    for (int i = 0; i < 40; i += 3) {
+        map.setTile(i, (i * 7) % 40, TileType::WALL);
+        map.setTile((i * 11) % 40, i, TileType::WALL);
+    }
+
+    Point origin(20, 20);
+    std::vector<std::vector<bool>> visible;
+    FOV::calculate(map, origin, 10, visible);
+    for (int y = 0; y < 40; y++) {
+        for (int x = 0; x < 40; x++) {
+            REQUIRE(FOV::isVisible(map, origin, Point(x, y), 10) == visible[y][x]);
+        }
+    }
+}
+
+TEST_CASE("AISystem: Walls hide the player", "[ai][sight]") {
+    Map map(30, 10);
+    map.fill(TileType::FLOOR);
+    for (int y = 0; y < 10; y++) {
+        map.setTile(15, y, TileType::WALL);
+    }
+
+    World world;
+    AISystem ai_system(&map, nullptr, nullptr, nullptr);
+    ai_system.setWorld(&world);
+
+    Entity& player = world.createEntity();
+    player.addComponent<PositionComponent>(12, 5);
+    ai_system.setPlayerId(player.getID());
+
+    auto spawn = [&world](int x, int y, int range) -> AIComponent& {
+        Entity& monster = world.createEntity();
+        monster.addComponent<PositionComponent>(x, y);
+        auto& ai = monster.addComponent<AIComponent>();
+        ai.behavior = AIBehavior::PASSIVE;
+        ai.vision_range = range;
+        return ai;
+    };
+    AIComponent& near = spawn(9, 5, 6);
+    AIComponent& behind_wall = spawn(17, 5, 6);
+    AIComponent& too_far = spawn(2, 5, 6);
+    AIComponent& far_sighted = spawn(1, 5, 20);
+
+    ai_system.update(world, 0.0);
+
+    REQUIRE(near.has_seen_player);
+    REQUIRE_FALSE(behind_wall.has_seen_player);
+    REQUIRE_FALSE(too_far.has_seen_player);
+    REQUIRE(far_sighted.has_seen_player);
+    REQUIRE(ai_system.getPlayerSight().getRadius() == 20);
+}
+
+TEST_CASE("SightMap: Answers from the observer's side", "[fov][sight]") {
+    // The player's cast stands in for each monster's own view, so the two
+    // must agree for every observer on a real map
+    std::mt19937 rng(42);
+    for (unsigned seed : {42u, 777u}) {
+        Map map(198, 66);
+        MapGenerator::generate(map, MapType::PROCEDURAL, seed);
+        std::vector<Point> floors;
+        for (int y = 0; y < map.getHeight(); y++) {
+            for (int x = 0; x < map.getWidth(); x++) {
+                if (map.isTransparent(x, y)) floors.emplace_back(x, y);
+            }
+        }
+
+        std::vector<std::vector<bool>> observer_view;
+        for (int trial = 0; trial < 8; trial++) {
+            Point player = floors[rng() % floors.size()];
+            SightMap sight;
+            sight.compute(map, player, 12);
+            for (int range : {6, 12}) {
+                for (const Point& from : floors) {
+                    int dx = from.x - player.x;
+                    int dy = from.y - player.y;
+                    if (dx * dx + dy * dy > range * range) continue;
+                    FOV::calculate(map, from, range, observer_view);
+                    REQUIRE(sight.canSee(from, range) == observer_view[player.y][player.x]);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("AISystem: Monsters see the player exactly when their own view does", "[ai][sight]") {
+    Map map(198, 66);
+    MapGenerator::generate(map, MapType::PROCEDURAL, 42);
+    Point player_pos = MapGenerator::findSafeSpawnPoint(map);
+    constexpr int RANGE = 8;
+
+    World world;
+    AISystem ai_system(&map, nullptr, nullptr, nullptr);
+    ai_system.setWorld(&world);
+    Entity& player = world.createEntity();
+    player.addComponent<PositionComponent>(player_pos.x, player_pos.y);
+    ai_system.setPlayerId(player.getID());
+
+    // A watcher on every floor tile in walking range of the player
+    std::vector<std::pair<Point, AIComponent*>> watchers;
+    for (int y = player_pos.y - RANGE; y <= player_pos.y + RANGE; y++) {
+        for (int x = player_pos.x - RANGE; x <= player_pos.x + RANGE; x++) {
+            if (Point(x, y) == player_pos || !map.isTransparent(x, y)) continue;
+            if (std::abs(x - player_pos.x) + std::abs(y - player_pos.y) > RANGE) continue;
+            Entity& monster = world.createEntity();
+            monster.addComponent<PositionComponent>(x, y);
+            auto& ai = monster.addComponent<AIComponent>();
+            ai.behavior = AIBehavior::PASSIVE;
+            ai.vision_range = RANGE;
+            watchers.emplace_back(Point(x, y), &ai);
+        }
+    }
+    REQUIRE(watchers.size() > 20);
+
+    ai_system.update(world, 0.0);
+
+    std::vector<std::vector<bool>> own_view;
+    int seen = 0;
+    for (const auto& [pos, ai] : watchers) {
+        FOV::calculate(map, pos, RANGE, own_view);
+        REQUIRE(ai->has_seen_player == own_view[player_pos.y][player_pos.x]);
+        seen += ai->has_seen_player;
+    }
+    REQUIRE(seen > 0);
+}
+
+TEST_CASE("SightMap: Batched LOS benchmark", "[fov][sight][!benchmark][.]") {
+    constexpr int MONSTERS = 500;
+    constexpr int TURNS = 50;
+    constexpr int RANGE = 12;
+
+    Map map(198, 66);
+    MapGenerator::generate(map, MapType::STRESS_TEST);
+    Point player = MapGenerator::getDefaultSpawnPoint(map, MapType::STRESS_TEST);
+
+    std::vector<Point> monsters;
+    for (int i = 0; monsters.size() < MONSTERS; i++) {
+        Point p(player.x - RANGE + (i * 7) % (2 * RANGE + 1),
+                player.y - RANGE + (i * 13) % (2 * RANGE + 1));
+        if (map.isWalkable(p)) {
+            monsters.push_back(p);
+        }
+        if (i > 100000) break;
+    }
+
+    int seen_ray = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int turn = 0; turn < TURNS; turn++) {
+        for (const Point& m : monsters) {
+            seen_ray += Pathfinding::hasLineOfSight(m, player, map);
+        }
+    }
+    auto ray_time = std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - start).count() / TURNS;
+
+    int seen_bits = 0;
+    SightMap sight;
+    start = std::chrono::steady_clock::now();
+    for (int turn = 0; turn < TURNS; turn++) {
+        sight.invalidate();  // player moved; recast every turn
+        sight.compute(map, player, RANGE);
+        for (const Point& m : monsters) {
+            seen_bits += sight.canSee(m, RANGE);
+        }
+    }
+    auto bits_time = std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - start).count() / TURNS;
+
+    WARN(monsters.size() << " monsters: per-monster rays " << ray_time << " us/turn ("
+         << seen_ray / TURNS << " seen), shared bitset " << bits_time << " us/turn ("
+         << seen_bits / TURNS << " seen)");
+    REQUIRE(bits_time > 0.0);
+}
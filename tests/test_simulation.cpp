@@ -0,0 +1,76 @@
+#include <catch2/catch_test_macros.hpp>
+#include "simulation.h"
+#include "game_state.h"
+#include "map.h"
+#include <string>
+
+TEST_CASE("Simulation: Report formatting", "[simulation]") {
+    SimulationReport report;
+    report.turns = 500;
+    report.world_time = 50000;
+    report.seconds = 0.25;
+    report.kills = 3;
+    report.world_ms = 100.0;
+    report.peak_memory_kb = 2048;
+    report.systems.push_back({"AISystem", 0.5, 40.0, 500});
+    report.systems.push_back({"RenderSystem", 0.0, 0.0, 0});
+
+    REQUIRE(report.getTurnsPerSecond() == 2000.0);
+    const std::string text = report.format();
+    REQUIRE(text.find("2000 turns/s") != std::string::npos);
+    REQUIRE(text.find("monsters killed: 3") != std::string::npos);
+    REQUIRE(text.find("Peak memory: 2.0 MB") != std::string::npos);
+    REQUIRE(text.find("World turn") != std::string::npos);
+    REQUIRE(text.find("AISystem") != std::string::npos);
+    REQUIRE(text.find("RenderSystem") == std::string::npos);  // never ran
+
+    REQUIRE(SimulationReport{}.getTurnsPerSecond() == 0.0);
+}
+
+TEST_CASE("Simulation: Peak memory is known", "[simulation]") {
+#if defined(PLATFORM_LINUX) || defined(PLATFORM_MACOS) || defined(PLATFORM_WINDOWS)
+    REQUIRE(Simulation::getPeakMemoryKB() > 0);
+#endif
+}
+
+TEST_CASE("Simulation: Headless run", "[simulation]") {
+    SimulationOptions options;
+    options.turns = 40;
+    options.seed = 7;
+    options.map_type = MapType::TEST_DUNGEON;
+    Simulation simulation(options);
+
+    const Map& map = *simulation.getGameManager().getMap();
+    auto explored = [&map] {
+        int tiles = 0;
+        for (int y = 0; y < map.getHeight(); y++) {
+            for (int x = 0; x < map.getWidth(); x++) {
+                tiles += map.isExplored(x, y);
+            }
+        }
+        return tiles;
+    };
+    const int explored_before = explored();
+
+    SimulationReport report = simulation.run();
+    REQUIRE(report.turns == 40);
+    REQUIRE(report.world_time == 40 * 100);  // every scripted action is a normal one
+    REQUIRE(report.levels == 1 + report.deaths);
+    REQUIRE(report.seconds > 0.0);
+
+    // The world turn calls systems directly; their time still shows up
+    auto timing = [&report](const std::string& name) {
+        for (const auto& system : report.systems) {
+            if (system.name == name) return system;
+        }
+        return ecs::SystemTiming{};
+    };
+    REQUIRE(timing("CombatSystem").calls >= 40);  // after every player action
+    REQUIRE(timing("StatusEffectSystem").calls >= 40);  // scheduled once per world turn
+    if (report.kills > 0 || report.monsters_left > 0) {
+        REQUIRE(timing("AISystem").calls > 0);
+    }
+    if (report.deaths == 0) {
+        REQUIRE(explored() > explored_before);
+    }
+}
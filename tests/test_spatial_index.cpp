@@ -0,0 +1,170 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../include/ecs/spatial_index.h"
+#include "../include/ecs/system_manager.h"
+#include "../include/ecs/position_component.h"
+#include "../include/ecs/combat_component.h"
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+using namespace ecs;
+
+namespace {
+
+/// World with a spatial index listening to PositionComponent
+struct IndexedWorld {
+    SpatialIndex index{64, 64};
+    World world;
+
+    IndexedWorld() {
+        world.getComponentStorage().addListener(componentTypeId<PositionComponent>(), &index);
+    }
+
+    Entity& spawn(int x, int y) {
+        Entity& entity = world.createEntity();
+        entity.addComponent<PositionComponent>(x, y);
+        return entity;
+    }
+};
+
+bool containsEntity(const std::vector<Entity*>& entities, const Entity* entity) {
+    return std::find(entities.begin(), entities.end(), entity) != entities.end();
+}
+
+} // anonymous namespace
+
+TEST_CASE("SpatialIndex tracks positioned entities", "[ecs][spatial]") {
+    IndexedWorld w;
+
+    SECTION("Point queries") {
+        Entity& a = w.spawn(5, 5);
+        Entity& b = w.spawn(5, 5);
+        Entity& c = w.spawn(6, 5);
+
+        auto here = w.index.queryPoint(5, 5);
+        REQUIRE(here.size() == 2);
+        REQUIRE(containsEntity(here, &a));
+        REQUIRE(containsEntity(here, &b));
+        REQUIRE(w.index.queryPoint(6, 5) == std::vector<Entity*>{&c});
+        REQUIRE(w.index.queryPoint(7, 5).empty());
+    }
+
+    SECTION("Entities without position are not indexed") {
+        w.world.createEntity().addComponent<CombatComponent>();
+        REQUIRE(w.index.size() == 0);
+    }
+
+    SECTION("Component removal and entity removal unindex") {
+        Entity& a = w.spawn(1, 1);
+        Entity& b = w.spawn(2, 2);
+
+        a.removeComponent<PositionComponent>();
+        REQUIRE(w.index.queryPoint(1, 1).empty());
+
+        w.world.removeEntity(b.getID());
+        REQUIRE(w.index.queryPoint(2, 2).empty());
+        REQUIRE(w.index.size() == 0);
+    }
+
+    SECTION("Moves update point and bucket queries") {
+        Entity& a = w.spawn(1, 1);
+        auto* pos = a.getComponent<PositionComponent>();
+        pos->moveTo(40, 40);
+        w.index.move(a.getID(), pos->position);
+
+        REQUIRE(w.index.queryPoint(1, 1).empty());
+        REQUIRE(w.index.queryPoint(40, 40) == std::vector<Entity*>{&a});
+        REQUIRE(w.index.queryRect(32, 32, 47, 47).size() == 1);
+        REQUIRE(w.index.queryRect(0, 0, 31, 31).empty());
+    }
+
+    SECTION("Replacing the position component re-indexes") {
+        Entity& a = w.spawn(3, 3);
+        a.addComponent<PositionComponent>(9, 9);
+
+        REQUIRE(w.index.queryPoint(3, 3).empty());
+        REQUIRE(w.index.queryPoint(9, 9).size() == 1);
+        REQUIRE(w.index.size() == 1);
+    }
+
+    SECTION("Rect and radius queries") {
+        Entity& inside = w.spawn(10, 10);
+        Entity& edge = w.spawn(13, 10);
+        Entity& corner = w.spawn(13, 13);
+        w.spawn(30, 30);
+
+        auto rect = w.index.queryRect(10, 10, 13, 13);
+        REQUIRE(rect.size() == 3);
+
+        auto radius = w.index.queryRadius(Point(10, 10), 3);
+        REQUIRE(radius.size() == 2);
+        REQUIRE(containsEntity(radius, &inside));
+        REQUIRE(containsEntity(radius, &edge));
+        REQUIRE_FALSE(containsEntity(radius, &corner));
+    }
+
+    SECTION("Grid grows and negative coordinates overflow") {
+        Entity& far = w.spawn(500, 300);
+        Entity& negative = w.spawn(-4, 2);
+
+        REQUIRE(w.index.queryPoint(500, 300) == std::vector<Entity*>{&far});
+        REQUIRE(w.index.queryPoint(-4, 2) == std::vector<Entity*>{&negative});
+        REQUIRE(w.index.queryRect(-10, 0, 10, 10).size() == 1);
+    }
+}
+
+TEST_CASE("SpatialIndex vs linear scan", "[ecs][spatial][!benchmark][.]") {
+    constexpr int MAP_SIZE = 512;
+    constexpr int QUERIES = 1000;
+
+    for (int count : {1000, 10000, 100000}) {
+        IndexedWorld w;
+        w.index.resize(MAP_SIZE, MAP_SIZE);
+
+        std::mt19937 rng(12345);
+        std::uniform_int_distribution<int> coord(0, MAP_SIZE - 1);
+        for (int i = 0; i < count; ++i) {
+            w.spawn(coord(rng), coord(rng));
+        }
+
+        std::vector<Point> probes;
+        for (int i = 0; i < QUERIES; ++i) {
+            probes.emplace_back(coord(rng), coord(rng));
+        }
+
+        size_t scan_hits = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (const Point& p : probes) {
+            for (const auto& entity : w.world.getEntities()) {
+                auto* pos = entity->getComponent<PositionComponent>();
+                if (pos && pos->isAt(p.x, p.y)) {
+                    ++scan_hits;
+                }
+            }
+        }
+        auto scan_time = std::chrono::high_resolution_clock::now() - start;
+
+        size_t index_hits = 0;
+        start = std::chrono::high_resolution_clock::now();
+        for (const Point& p : probes) {
+            index_hits += w.index.queryPoint(p.x, p.y).size();
+        }
+        auto index_time = std::chrono::high_resolution_clock::now() - start;
+
+        size_t radius_hits = 0;
+        start = std::chrono::high_resolution_clock::now();
+        for (const Point& p : probes) {
+            radius_hits += w.index.queryRadius(p, 8).size();
+        }
+        auto radius_time = std::chrono::high_resolution_clock::now() - start;
+
+        REQUIRE(scan_hits == index_hits);
+
+        using us = std::chrono::microseconds;
+        WARN(count << " entities, " << QUERIES << " point queries: scan "
+             << std::chrono::duration_cast<us>(scan_time).count() << "us, index "
+             << std::chrono::duration_cast<us>(index_time).count() << "us; radius-8 "
+             << std::chrono::duration_cast<us>(radius_time).count() << "us ("
+             << radius_hits << " hits)");
+    }
+}
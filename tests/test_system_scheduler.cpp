@@ -0,0 +1,333 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../include/ecs/system_manager.h"
+#include "../include/ecs/status_effect_system.h"
+#include "../include/ecs/render_system.h"
+#include "../include/ecs/light_system.h"
+#include "../include/ecs/movement_system.h"
+#include "../include/ecs/combat_system.h"
+#include "../include/ecs/ai_system.h"
+#include "../include/ecs/inventory_system.h"
+#include "../include/ecs/equipment_system.h"
+#include "../include/ecs/experience_system.h"
+#include "../include/ecs/loot_system.h"
+#include "../include/ecs/position_component.h"
+#include "../include/ecs/health_component.h"
+#include "../include/thread_pool.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+using namespace ecs;
+
+namespace {
+
+/// Configurable test system that records when it runs
+class ProbeSystem : public ISystem {
+public:
+    ProbeSystem(std::string name, int priority, SystemAccess access,
+                std::function<void(World&)> body)
+        : name(std::move(name)), priority(priority),
+          access(std::move(access)), body(std::move(body)) {}
+
+    void update(const std::vector<std::unique_ptr<Entity>>&, double) override {}
+    void update(World& world, double) override { body(world); }
+    std::string getName() const override { return name; }
+    bool shouldProcess(const Entity&) const override { return true; }
+    int getPriority() const override { return priority; }
+    SystemAccess getAccess() const override { return access; }
+
+private:
+    std::string name;
+    int priority;
+    SystemAccess access;
+    std::function<void(World&)> body;
+};
+
+// Distinct system types so each can be registered once
+template<int N>
+class Probe : public ProbeSystem {
+public:
+    using ProbeSystem::ProbeSystem;
+};
+
+// Wait until a counter reaches a value, or give up after a second
+bool waitFor(const std::atomic<int>& counter, int value) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (counter.load() < value) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_CASE("SystemAccess conflicts", "[ecs][scheduler]") {
+    SECTION("Undeclared access is exclusive") {
+        SystemAccess reader;
+        reader.read<PositionComponent>();
+        REQUIRE(SystemAccess().conflictsWith(reader));
+        REQUIRE(reader.conflictsWith(SystemAccess()));
+    }
+
+    SECTION("Readers share, writers do not") {
+        SystemAccess a, b, c;
+        a.read<PositionComponent>();
+        b.read<PositionComponent, HealthComponent>();
+        c.write<HealthComponent>();
+
+        REQUIRE_FALSE(a.conflictsWith(b));
+        REQUIRE_FALSE(a.conflictsWith(c));
+        REQUIRE(b.conflictsWith(c));
+        REQUIRE(c.conflictsWith(b));
+    }
+
+    SECTION("Resources conflict on write") {
+        SystemAccess a, b;
+        a.readResource(SystemResource::MAP);
+        b.readResource(SystemResource::MAP);
+        REQUIRE_FALSE(a.conflictsWith(b));
+
+        b.writeResource(SystemResource::MAP);
+        REQUIRE(a.conflictsWith(b));
+    }
+
+    SECTION("Render gathering and effect ticking are independent") {
+        RenderSystem render;
+        StatusEffectSystem effects;
+        REQUIRE_FALSE(SystemManager::conflicts(render, effects));
+    }
+
+    SECTION("Game systems declare their access") {
+        MovementSystem movement(nullptr);
+        CombatSystem combat(nullptr);
+        AISystem ai(nullptr, &movement, &combat, nullptr);
+        InventorySystem inventory(nullptr);
+        EquipmentSystem equipment;
+        ExperienceSystem experience;
+        LootSystem loot(nullptr);
+        LightSystem light;
+        RenderSystem render;
+        StatusEffectSystem effects;
+        const ISystem* systems[] = {&movement, &combat, &ai, &inventory, &equipment,
+                                    &experience, &loot, &light, &render, &effects};
+        for (const ISystem* system : systems) {
+            INFO(system->getName());
+            REQUIRE_FALSE(system->getAccess().exclusive);
+        }
+
+        // AI queues what movement and combat drain
+        REQUIRE(SystemManager::conflicts(ai, movement));
+        REQUIRE(SystemManager::conflicts(ai, combat));
+        // Both advance the change tick their caches are keyed on
+        REQUIRE(SystemManager::conflicts(light, render));
+        REQUIRE_FALSE(SystemManager::conflicts(experience, effects));
+    }
+}
+
+TEST_CASE("ThreadPool runs submitted tasks", "[scheduler][threads]") {
+    ThreadPool pool(3);
+    REQUIRE(pool.getThreadCount() == 3);
+
+    std::atomic<int> done{0};
+    for (int i = 0; i < 100; ++i) {
+        pool.submit([&pool, &done] {
+            // Nested submissions land on the worker's own queue
+            pool.submit([&done] { ++done; });
+            ++done;
+        });
+    }
+    pool.helpUntil([&done] { return done.load() == 200; });
+    REQUIRE(done.load() == 200);
+}
+
+TEST_CASE("ThreadPool pending count never wraps", "[scheduler][threads]") {
+    constexpr int TASKS = 20000;
+    ThreadPool pool(3);
+
+    // Workers pop tasks the moment they are queued; a task taken before
+    // it was counted would briefly wrap the count below zero
+    std::atomic<bool> running{true};
+    std::atomic<size_t> highest{0};
+    std::thread watcher([&] {
+        while (running.load()) {
+            size_t pending = pool.getPendingCount();
+            if (pending > highest.load()) {
+                highest = pending;
+            }
+        }
+    });
+
+    std::atomic<int> done{0};
+    for (int i = 0; i < TASKS; ++i) {
+        pool.submit([&done] { ++done; });
+    }
+    pool.helpUntil([&done] { return done.load() == TASKS; });
+    running = false;
+    watcher.join();
+
+    REQUIRE(highest.load() <= static_cast<size_t>(TASKS));
+    REQUIRE(pool.getPendingCount() == 0);
+}
+
+TEST_CASE("Parallel system updates", "[ecs][scheduler]") {
+    World world;
+    ThreadPool pool(2);
+    world.getSystemManager().setThreadPool(&pool);
+
+    SECTION("Non-conflicting systems overlap") {
+        std::atomic<int> started{0};
+        bool a_saw_b = false;
+        bool b_saw_a = false;
+
+        world.registerSystem<Probe<0>>("A", 10, SystemAccess().read<PositionComponent>(),
+            [&](World&) { ++started; a_saw_b = waitFor(started, 2); });
+        world.registerSystem<Probe<1>>("B", 20, SystemAccess().write<HealthComponent>(),
+            [&](World&) { ++started; b_saw_a = waitFor(started, 2); });
+
+        world.update(0.0);
+        REQUIRE(a_saw_b);
+        REQUIRE(b_saw_a);
+    }
+
+    SECTION("Conflicting systems keep priority order") {
+        std::mutex mutex;
+        std::vector<std::string> order;
+        auto record = [&](const char* name) {
+            return [&, name](World&) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                std::lock_guard<std::mutex> lock(mutex);
+                order.push_back(name);
+            };
+        };
+
+        world.registerSystem<Probe<2>>("reader", 30, SystemAccess().read<HealthComponent>(), record("reader"));
+        world.registerSystem<Probe<3>>("writer", 10, SystemAccess().write<HealthComponent>(), record("writer"));
+        world.registerSystem<Probe<4>>("exclusive", 20, SystemAccess(), record("exclusive"));
+
+        for (int i = 0; i < 5; ++i) {
+            order.clear();
+            world.update(0.0);
+            REQUIRE(order == std::vector<std::string>{"writer", "exclusive", "reader"});
+        }
+    }
+
+    SECTION("Results match a sequential update") {
+        auto populate = [](World& target) {
+            for (int i = 0; i < 200; ++i) {
+                Entity& entity = target.createEntity();
+                entity.addComponent<PositionComponent>(i % 20, i / 20);
+                entity.addComponent<HealthComponent>(100);
+                entity.addComponent<RenderableComponent>("m", ftxui::Color::Red);
+                auto& effects = entity.addComponent<EffectsComponent>();
+                effects.addEffect(StatusEffectSystem::createEffect(
+                    i % 2 ? EffectType::POISON : EffectType::BURN, 3, 1 + i % 5));
+            }
+            target.registerSystem<StatusEffectSystem>();
+            target.registerSystem<RenderSystem>();
+        };
+
+        World sequential;
+        populate(sequential);
+        populate(world);
+
+        for (int turn = 0; turn < 4; ++turn) {
+            sequential.update(1.0);
+            world.update(1.0);
+        }
+
+        const auto& expected = sequential.getEntities();
+        const auto& actual = world.getEntities();
+        REQUIRE(expected.size() == actual.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            REQUIRE(expected[i]->getComponent<HealthComponent>()->hp ==
+                    actual[i]->getComponent<HealthComponent>()->hp);
+        }
+        REQUIRE(world.getSystem<RenderSystem>()->getRenderData().size() == 200);
+    }
+
+    SECTION("Timings are recorded per system") {
+        world.registerSystem<Probe<5>>("slow", 10, SystemAccess().read<PositionComponent>(),
+            [](World&) { std::this_thread::sleep_for(std::chrono::milliseconds(5)); });
+        world.registerSystem<Probe<6>>("fast", 20, SystemAccess().read<HealthComponent>(),
+            [](World&) {});
+
+        world.update(0.0);
+        world.update(0.0);
+
+        const auto& timings = world.getSystemManager().getTimings();
+        REQUIRE(timings.size() == 2);
+        REQUIRE(timings[0].name == "slow");
+        REQUIRE(timings[0].calls == 2);
+        REQUIRE(timings[0].last_ms >= 4.0);
+        REQUIRE(timings[0].total_ms >= timings[0].last_ms);
+        REQUIRE(world.getSystemManager().getLastUpdateTime() > 0.0);
+
+        // Runs made outside update() (turn-based calls) add to the same entry
+        world.getSystemManager().recordTiming(*world.getSystem<Probe<6>>(), 3.0);
+        REQUIRE(timings[1].calls == 3);
+        REQUIRE(timings[1].last_ms == 3.0);
+        REQUIRE(timings[1].total_ms >= 3.0);
+    }
+
+    SECTION("Exceptions propagate and skip dependent systems") {
+        bool later_ran = false;
+        world.registerSystem<Probe<7>>("throws", 10, SystemAccess(),
+            [](World&) { throw std::runtime_error("system failure"); });
+        world.registerSystem<Probe<8>>("later", 20, SystemAccess(),
+            [&later_ran](World&) { later_ran = true; });
+
+        REQUIRE_THROWS(world.update(0.0));
+        REQUIRE_FALSE(later_ran);
+    }
+}
+
+TEST_CASE("Parallel system scheduler benchmark", "[ecs][scheduler][!benchmark][.]") {
+    // Four independent read-only systems doing comparable work
+    std::atomic<long> sink{0};
+    auto busy = [&sink](World& world) {
+        long sum = 0;
+        for (int pass = 0; pass < 200; ++pass) {
+            world.view<PositionComponent, HealthComponent>().each(
+                [&sum](Entity&, PositionComponent& pos, HealthComponent& health) {
+                    sum += pos.position.x * health.hp + pos.position.y;
+                });
+        }
+        sink += sum;
+    };
+    auto access = SystemAccess().read<PositionComponent, HealthComponent>();
+
+    auto run = [&](ThreadPool* pool) {
+        World world;
+        for (int i = 0; i < 10000; ++i) {
+            Entity& entity = world.createEntity();
+            entity.addComponent<PositionComponent>(i % 100, i / 100 + 1);
+            entity.addComponent<HealthComponent>(10 + i % 7);
+        }
+        world.registerSystem<Probe<10>>("gather_a", 10, access, busy);
+        world.registerSystem<Probe<11>>("gather_b", 20, access, busy);
+        world.registerSystem<Probe<12>>("gather_c", 30, access, busy);
+        world.registerSystem<Probe<13>>("gather_d", 40, access, busy);
+        world.getSystemManager().setThreadPool(pool);
+
+        world.update(0.0);
+        const auto& manager = world.getSystemManager();
+        for (const auto& timing : manager.getTimings()) {
+            WARN(timing.name << ": " << timing.last_ms << " ms");
+        }
+        WARN("wall " << manager.getLastUpdateTime() << " ms, speedup x"
+             << manager.getParallelSpeedup());
+        return manager.getLastUpdateTime();
+    };
+
+    double sequential_ms = run(nullptr);
+    ThreadPool pool;
+    double parallel_ms = run(&pool);
+    WARN("workers " << pool.getThreadCount() << ": sequential " << sequential_ms
+         << " ms, parallel " << parallel_ms << " ms");
+    REQUIRE(sink.load() != 0);
+}
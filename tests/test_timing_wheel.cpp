@@ -0,0 +1,115 @@
+#include <catch2/catch_test_macros.hpp>
+#include "timing_wheel.h"
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Timer : TimerNode {
+    int label = 0;
+};
+
+} // namespace
+
+TEST_CASE("TimingWheel: Pops in due order", "[timing_wheel]") {
+    TimingWheel wheel;
+    std::mt19937 rng(99);
+    std::vector<Timer> timers(2000);
+    for (size_t i = 0; i < timers.size(); i++) {
+        timers[i].label = static_cast<int>(i);
+        // Every level and the overflow list, with plenty of ties
+        int64_t when;
+        switch (i % 4) {
+            case 0: when = rng() % 64; break;
+            case 1: when = rng() % 5000; break;
+            case 2: when = rng() % 300000; break;
+            default: when = (int64_t{1} << 24) + rng() % (int64_t{1} << 26); break;
+        }
+        wheel.schedule(timers[i], when);
+    }
+    REQUIRE(wheel.size() == timers.size());
+
+    std::vector<const Timer*> expected;
+    for (const Timer& timer : timers) expected.push_back(&timer);
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const Timer* a, const Timer* b) { return a->when < b->when; });
+
+    std::vector<const Timer*> popped;
+    while (TimerNode* node = wheel.pop(INT64_MAX)) {
+        REQUIRE(node->when == wheel.now());
+        popped.push_back(static_cast<const Timer*>(node));
+    }
+    REQUIRE(popped == expected);
+    REQUIRE(wheel.empty());
+}
+
+TEST_CASE("TimingWheel: Due limits, cancelling and rescheduling", "[timing_wheel]") {
+    TimingWheel wheel;
+    Timer early, late, later;
+    wheel.schedule(early, 10);
+    wheel.schedule(late, 100);
+    wheel.schedule(later, 5000);
+
+    SECTION("Nothing comes out before its time") {
+        REQUIRE(wheel.pop(9) == nullptr);
+        REQUIRE(wheel.pop(10) == &early);
+        REQUIRE(wheel.pop(99) == nullptr);
+        REQUIRE(wheel.size() == 2);
+    }
+
+    SECTION("Cancelled nodes never come out") {
+        wheel.cancel(late);
+        REQUIRE_FALSE(late.linked);
+        REQUIRE(wheel.pop(1000) == &early);
+        REQUIRE(wheel.pop(1000) == nullptr);
+        wheel.cancel(late);  // harmless when not scheduled
+        REQUIRE(wheel.size() == 1);
+    }
+
+    SECTION("Rescheduling moves a node") {
+        wheel.schedule(later, 50);
+        REQUIRE(wheel.pop(1000) == &early);
+        REQUIRE(wheel.pop(1000) == &later);
+        REQUIRE(wheel.pop(1000) == &late);
+    }
+
+    SECTION("Overdue nodes are due at once") {
+        REQUIRE(wheel.pop(100) == &early);
+        REQUIRE(wheel.pop(100) == &late);
+        wheel.schedule(early, 20);
+        REQUIRE(wheel.pop(100) == &early);
+        REQUIRE(wheel.now() == 100);
+    }
+
+    SECTION("Clearing unlinks everything") {
+        wheel.clear(7);
+        REQUIRE(wheel.empty());
+        REQUIRE_FALSE(early.linked);
+        REQUIRE(wheel.now() == 7);
+        REQUIRE(wheel.pop(INT64_MAX) == nullptr);
+    }
+}
+
+TEST_CASE("TimingWheel: Repeating timers keep their cadence", "[timing_wheel]") {
+    // Timers rescheduled from their own due time, as actors are
+    TimingWheel wheel;
+    std::vector<Timer> timers(3);
+    const int periods[] = {7, 64, 333};
+    for (int i = 0; i < 3; i++) {
+        timers[i].label = i;
+        wheel.schedule(timers[i], periods[i]);
+    }
+
+    int fired[3] = {};
+    while (TimerNode* node = wheel.pop(100000)) {
+        auto& timer = static_cast<Timer&>(*node);
+        REQUIRE(timer.when % periods[timer.label] == 0);
+        fired[timer.label]++;
+        wheel.schedule(timer, timer.when + periods[timer.label]);
+    }
+    REQUIRE(fired[0] == 100000 / 7);
+    REQUIRE(fired[1] == 100000 / 64);
+    REQUIRE(fired[2] == 100000 / 333);
+}
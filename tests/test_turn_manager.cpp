@@ -1,6 +1,10 @@
 #include <catch2/catch_test_macros.hpp>
 #include "turn_manager.h"
 #include "game_state.h"
+#include <chrono>
+#include <map>
+#include <random>
+#include <vector>
 
 TEST_CASE("TurnManager: Basic turn tracking", "[turn_manager]") {
     GameManager game_manager;
@@ -155,4 +159,152 @@ TEST_CASE("TurnManager: Action queue", "[turn_manager]") {
         REQUIRE(actual_time == expected_time);
         REQUIRE(turn_manager.getCurrentTurn() == static_cast<int>(actions.size()));
     }
-}
\ No newline at end of file
+}
+
+namespace {
+
+// Records who acted at which world time
+struct ActorLog {
+    explicit ActorLog(TurnManager* turns) : turns(turns) {}
+
+    TurnManager* turns;
+    std::map<ecs::EntityID, int> actions;
+    std::vector<std::pair<int, std::vector<ecs::EntityID>>> batches;
+
+    static void record(void* context, const std::vector<ecs::EntityID>& actors) {
+        auto& log = *static_cast<ActorLog*>(context);
+        log.batches.emplace_back(log.turns->getWorldTime(), actors);
+        for (ecs::EntityID id : actors) log.actions[id]++;
+    }
+};
+
+} // namespace
+
+TEST_CASE("TurnManager: Actors act by speed", "[turn_manager]") {
+    TurnManager turn_manager(nullptr);
+    ActorLog log(&turn_manager);
+    turn_manager.setActorHandler(&ActorLog::record, &log);
+
+    const ecs::EntityID normal = ecs::makeEntityID(1, 1);
+    const ecs::EntityID fast = ecs::makeEntityID(2, 1);
+    const ecs::EntityID slow = ecs::makeEntityID(3, 1);
+    const ecs::EntityID nimble = ecs::makeEntityID(4, 1);
+    turn_manager.addActor(normal);
+    turn_manager.addActor(fast, 200);
+    turn_manager.addActor(slow, 50);
+    turn_manager.addActor(nimble, 130);
+    REQUIRE(turn_manager.getActorCount() == 4);
+
+    for (int i = 0; i < 20; ++i) {
+        turn_manager.executePlayerAction(ActionSpeed::NORMAL);
+    }
+    REQUIRE(turn_manager.getWorldTime() == 2000);
+    REQUIRE(log.actions[normal] == 20);
+    REQUIRE(log.actions[fast] == 40);
+    REQUIRE(log.actions[slow] == 10);
+    REQUIRE(log.actions[nimble] == 26);  // leftover energy carries over
+
+    // Batches run in time order; actors due together come in together
+    REQUIRE(log.batches.front().first == 0);
+    REQUIRE(log.batches.front().second == std::vector<ecs::EntityID>{normal, fast, slow, nimble});
+    for (size_t i = 1; i < log.batches.size(); ++i) {
+        REQUIRE(log.batches[i - 1].first < log.batches[i].first);
+    }
+
+    SECTION("Fast player actions give monsters fewer turns") {
+        log.actions.clear();
+        for (int i = 0; i < 4; ++i) {
+            turn_manager.executePlayerAction(ActionSpeed::FAST);
+        }
+        REQUIRE(log.actions[normal] == 2);
+        REQUIRE(log.actions[fast] == 4);
+    }
+}
+
+TEST_CASE("TurnManager: Actors come and go", "[turn_manager]") {
+    TurnManager turn_manager(nullptr);
+    ActorLog log(&turn_manager);
+    turn_manager.setActorHandler(&ActorLog::record, &log);
+
+    const ecs::EntityID first = ecs::makeEntityID(1, 1);
+    const ecs::EntityID second = ecs::makeEntityID(2, 1);
+    turn_manager.addActor(first);
+    turn_manager.addActor(second);
+    turn_manager.executePlayerAction(ActionSpeed::NORMAL);
+
+    SECTION("Removed actors stop acting") {
+        turn_manager.removeActor(first);
+        REQUIRE_FALSE(turn_manager.hasActor(first));
+        turn_manager.executePlayerAction(ActionSpeed::NORMAL);
+        REQUIRE(log.actions[first] == 1);
+        REQUIRE(log.actions[second] == 2);
+        REQUIRE(turn_manager.getActorCount() == 1);
+    }
+
+    SECTION("A recycled entity slot starts afresh") {
+        const ecs::EntityID reborn = ecs::makeEntityID(1, 2);
+        turn_manager.addActor(reborn, 200);
+        REQUIRE_FALSE(turn_manager.hasActor(first));
+        REQUIRE(turn_manager.getActorCount() == 2);
+        turn_manager.executePlayerAction(ActionSpeed::NORMAL);
+        REQUIRE(log.actions[reborn] == 2);
+    }
+
+    SECTION("Speed changes apply from the next turn") {
+        turn_manager.setActorSpeed(second, 50);
+        for (int i = 0; i < 4; ++i) {
+            turn_manager.executePlayerAction(ActionSpeed::NORMAL);
+        }
+        REQUIRE(log.actions[second] == 3);
+    }
+}
+
+TEST_CASE("TurnManager: Scheduled actions", "[turn_manager]") {
+    TurnManager turn_manager(nullptr);
+    std::vector<int> fired;
+    struct Note {
+        std::vector<int>* fired;
+        TurnManager* turns;
+        static void run(void* context) {
+            auto& note = *static_cast<Note*>(context);
+            note.fired->push_back(note.turns->getWorldTime());
+        }
+    } note{&fired, &turn_manager};
+
+    turn_manager.scheduleAction(250, &Note::run, &note);
+    turn_manager.scheduleAction(100, &Note::run, &note);
+    turn_manager.scheduleAction(30, &Note::run, &note);
+
+    turn_manager.executePlayerAction(ActionSpeed::NORMAL);
+    REQUIRE(fired == std::vector<int>{30, 100});
+    turn_manager.executePlayerAction(ActionSpeed::SLOW);
+    REQUIRE(fired == std::vector<int>{30, 100, 250});
+}
+
+TEST_CASE("TurnManager: Scheduling cost with many actors", "[turn_manager][!benchmark][.]") {
+    using Clock = std::chrono::steady_clock;
+    struct Counter {
+        static void count(void* context, const std::vector<ecs::EntityID>& actors) {
+            *static_cast<size_t*>(context) += actors.size();
+        }
+    };
+
+    for (int count : {100, 1000, 10000}) {
+        TurnManager turn_manager(nullptr);
+        size_t actions = 0;
+        turn_manager.setActorHandler(&Counter::count, &actions);
+        std::mt19937 rng(5);
+        for (int i = 1; i <= count; ++i) {
+            turn_manager.addActor(ecs::makeEntityID(static_cast<uint32_t>(i), 1), 70 + static_cast<int>(rng() % 61));
+        }
+
+        auto start = Clock::now();
+        for (int i = 0; i < 100; ++i) {
+            turn_manager.executePlayerAction(ActionSpeed::NORMAL);
+        }
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        WARN(count << " actors at mixed speeds: " << actions << " actions, "
+             << ns / static_cast<double>(actions) << " ns/action");
+        REQUIRE(actions > static_cast<size_t>(count) * 90);
+    }
+}